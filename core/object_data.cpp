@@ -5,12 +5,16 @@
 
 NS_NAMESPACE_BEGIN
 
-VarDescriptor::VarDescriptor(VarId p_id, const StringName &p_name, const Variant &p_val, bool p_skip_rewinding, bool p_enabled) :
+VarId VarLayout::find_variable_id(const std::string &p_var_name) const {
+	auto it = ids.find(p_var_name);
+	return it == ids.end() ? VarId::NONE : it->second;
+}
+
+VarDescriptor::VarDescriptor(VarId p_id, const Variant &p_val, bool p_skip_rewinding, bool p_enabled) :
 		id(p_id),
+		value(p_val.duplicate(true)),
 		skip_rewinding(p_skip_rewinding),
 		enabled(p_enabled) {
-	var.name = String(p_name).utf8();
-	var.value = p_val.duplicate(true);
 }
 
 bool VarDescriptor::operator<(const VarDescriptor &p_other) const {
@@ -18,7 +22,8 @@ bool VarDescriptor::operator<(const VarDescriptor &p_other) const {
 }
 
 ObjectData::ObjectData(ObjectDataStorage &p_storage) :
-		storage(p_storage) {
+		storage(p_storage),
+		var_layout(p_storage.get_empty_var_layout()) {
 }
 
 void ObjectData::set_net_id(ObjectNetId p_id) {
@@ -59,14 +64,23 @@ NetworkedControllerBase *ObjectData::get_controller() const {
 	return controller;
 }
 
-VarId ObjectData::find_variable_id(const std::string &p_var_name) const {
-	for (const auto &v : vars) {
-		if (v.var.name == p_var_name) {
-			return v.id;
-		}
-	}
+VarId ObjectData::add_variable(const std::string &p_var_name, const Variant &p_value, bool p_skip_rewinding) {
+	const VarId id = VarId{ uint32_t(vars.size()) };
+	var_layout = storage.get_next_var_layout(*var_layout, p_var_name);
+	vars.push_back(VarDescriptor(id, p_value, p_skip_rewinding, true));
+	return id;
+}
 
-	return VarId::NONE;
+const VarLayout &ObjectData::get_var_layout() const {
+	return *var_layout;
+}
+
+const std::string &ObjectData::get_variable_name(VarId p_id) const {
+	return var_layout->names[p_id.id];
+}
+
+VarId ObjectData::find_variable_id(const std::string &p_var_name) const {
+	return var_layout->find_variable_id(p_var_name);
 }
 
 NS_NAMESPACE_END
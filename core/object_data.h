@@ -4,6 +4,7 @@
 #include "core/templates/local_vector.h"
 #include "core/variant/variant.h"
 #include "processor.h"
+#include <map>
 #include <string>
 #include <vector>
 
@@ -14,15 +15,36 @@ struct NameAndVar {
 	Variant value;
 };
 
+/// The names of the variables of an object, by `VarId`.
+/// The objects that register the same variables in the same order share the
+/// same layout, which is owned by the `ObjectDataStorage`: so the names are
+/// stored once per kind of object, rather than once per object.
+struct VarLayout {
+	friend class ObjectDataStorage;
+
+	std::vector<std::string> names;
+	/// The same `names`, so the application doesn't need to convert them.
+	std::vector<StringName> string_names;
+
+private:
+	/// Maps the variable name to its `VarId`.
+	std::map<std::string, VarId> ids;
+	/// The layouts with one more variable, by name of that variable.
+	std::map<std::string, VarLayout *> next_layouts;
+
+public:
+	VarId find_variable_id(const std::string &p_var_name) const;
+};
+
 struct VarDescriptor {
 	VarId id = VarId::NONE;
-	NameAndVar var;
+	Variant value;
 	bool skip_rewinding = false;
 	bool enabled = false;
 	std::vector<struct ChangesListener *> changes_listeners;
 
 	VarDescriptor() = default;
-	VarDescriptor(VarId p_id, const StringName &p_name, const Variant &p_val, bool p_skip_rewinding, bool p_enabled);
+	VarDescriptor(VarId p_id, const Variant &p_val, bool p_skip_rewinding, bool p_enabled);
 
 	bool operator<(const VarDescriptor &p_other) const;
 };
@@ -43,6 +65,9 @@ private:
 	/// Associated controller.
 	class NetworkedControllerBase *controller = nullptr;
 
+	/// The names of `vars`.
+	VarLayout *var_layout = nullptr;
+
 public:
 	uint64_t instance_id = 0; // TODO remove this?
 	std::string object_name;
@@ -51,8 +76,25 @@ public:
 
 	bool realtime_sync_enabled_on_client = false;
 
+	/// True while this object is registered by `register_app_objects`: the
+	/// synchronizer is not yet aware of it.
+	bool bulk_registration_pending = false;
+
+	/// When not 0, the object falls asleep after this amount of ticks without
+	/// changes. Check `SceneSynchronizerBase::set_sleep_idle_ticks`.
+	uint32_t sleep_idle_ticks = 0;
+	uint32_t idle_ticks = 0;
+	bool sleeping = false;
+	/// The objects to wake up when any variable of this object changes.
+	std::vector<ObjectLocalId> wake_dependents;
+
+	/// The process functions run once every `process_rate_divisor` ticks.
+	/// Check `SceneSynchronizerBase::set_process_rate_divisor`.
+	uint32_t process_rate_divisor = 1;
+	uint64_t process_last_tick = 0;
+
 	/// The sync variables of this node. The order of this vector matters
-	/// because the index is the `VarId`.
+	/// because the index is the `VarId`. The names are in the `VarLayout`.
 	std::vector<VarDescriptor> vars;
 	NS::Processor<float> functions[PROCESSPHASE_COUNT];
 
@@ -62,6 +104,11 @@ public:
 	// func _apply_epoch(delta: float, interpolation_alpha: float, past_buffer: DataBuffer, future_buffer: DataBuffer):
 	Callable apply_epoch_func;
 
+	/// How far, in intervals between two epochs, the client keeps calling
+	/// `apply_epoch_func` past the last received epoch, so it can extrapolate.
+	/// Check `SceneSynchronizerBase::set_deferred_max_extrapolation`.
+	real_t deferred_max_extrapolation = 0.0;
+
 public:
 	void set_net_id(ObjectNetId p_id);
 	ObjectNetId get_net_id() const;
@@ -74,6 +121,11 @@ public:
 	void set_controller(class NetworkedControllerBase *p_controller);
 	class NetworkedControllerBase *get_controller() const;
 
+	/// Adds a variable at the end of `vars`, and returns its `VarId`.
+	VarId add_variable(const std::string &p_var_name, const Variant &p_value, bool p_skip_rewinding);
+
+	const VarLayout &get_var_layout() const;
+	const std::string &get_variable_name(VarId p_id) const;
 	VarId find_variable_id(const std::string &p_var_name) const;
 };
 
@@ -11,6 +11,7 @@ NS_NAMESPACE_BEGIN
 
 ObjectDataStorage::ObjectDataStorage(SceneSynchronizerBase &p_sync) :
 		sync(p_sync) {
+	var_layouts.push_back(std::make_unique<VarLayout>());
 }
 
 ObjectDataStorage::~ObjectDataStorage() {
@@ -24,6 +25,7 @@ ObjectDataStorage::~ObjectDataStorage() {
 	objects_data.clear();
 	objects_data_organized_by_netid.clear();
 	objects_data_controllers.clear();
+	local_ids_by_handle.clear();
 }
 
 ObjectData *ObjectDataStorage::allocate_object_data() {
@@ -56,6 +58,11 @@ void ObjectDataStorage::deallocate_object_data(ObjectData &p_object_data) {
 	if (objects_data_organized_by_netid.size() > net_id.id) {
 		CRASH_COND(objects_data_organized_by_netid[net_id.id] != (&p_object_data));
 		objects_data_organized_by_netid[net_id.id] = nullptr;
+		net_ids_in_use -= 1;
+	}
+
+	if (p_object_data.app_object_handle != ObjectHandle::NONE) {
+		local_ids_by_handle.remove(uint64_t(p_object_data.app_object_handle.id));
 	}
 
 	// Clear the controller pointer.
@@ -69,13 +76,20 @@ void ObjectDataStorage::deallocate_object_data(ObjectData &p_object_data) {
 	free_local_indices.push_back(local_id);
 }
 
+void ObjectDataStorage::reserve(int p_count) {
+	ERR_FAIL_COND(p_count < 0);
+	objects_data.reserve(objects_data.size() + p_count);
+	objects_data_organized_by_netid.reserve(objects_data_organized_by_netid.size() + p_count);
+}
+
 void ObjectDataStorage::object_set_net_id(ObjectData &p_object_data, ObjectNetId p_new_id) {
 	if (p_object_data.net_id == p_new_id) {
 		return;
 	}
 
-	if (objects_data_organized_by_netid.size() > p_object_data.net_id.id) {
+	if (objects_data_organized_by_netid.size() > p_object_data.net_id.id && objects_data_organized_by_netid[p_object_data.net_id.id]) {
 		objects_data_organized_by_netid[p_object_data.net_id.id] = nullptr;
+		net_ids_in_use -= 1;
 	}
 
 	p_object_data.net_id = ObjectNetId::NONE;
@@ -98,18 +112,33 @@ void ObjectDataStorage::object_set_net_id(ObjectData &p_object_data, ObjectNetId
 		memset(objects_data_organized_by_netid.data() + old_size, 0, sizeof(void *) * (new_size - old_size));
 	}
 
+	if (objects_data_organized_by_netid[p_new_id.id] == nullptr) {
+		net_ids_in_use += 1;
+	}
 	objects_data_organized_by_netid[p_new_id.id] = &p_object_data;
 	p_object_data.net_id = p_new_id;
 	sync.notify_object_data_net_id_changed(p_object_data);
 }
 
-ObjectLocalId ObjectDataStorage::find_object_local_id(ObjectHandle p_handle) const {
-	for (auto od : objects_data) {
-		if (od && od->app_object_handle == p_handle) {
-			return od->local_id;
-		}
+void ObjectDataStorage::object_set_app_object_handle(ObjectData &p_object_data, ObjectHandle p_handle) {
+	if (p_object_data.app_object_handle == p_handle) {
+		return;
+	}
+
+	if (p_object_data.app_object_handle != ObjectHandle::NONE) {
+		local_ids_by_handle.remove(uint64_t(p_object_data.app_object_handle.id));
+	}
+
+	p_object_data.app_object_handle = p_handle;
+
+	if (p_handle != ObjectHandle::NONE) {
+		local_ids_by_handle.insert(uint64_t(p_handle.id), p_object_data.local_id);
 	}
-	return ObjectLocalId::NONE;
+}
+
+ObjectLocalId ObjectDataStorage::find_object_local_id(ObjectHandle p_handle) const {
+	const ObjectLocalId *id = local_ids_by_handle.lookup_ptr(uint64_t(p_handle.id));
+	return id ? *id : ObjectLocalId::NONE;
 }
 
 ObjectLocalId ObjectDataStorage::find_object_local_id(const NetworkedControllerBase &p_controller) const {
@@ -185,7 +214,41 @@ const std::vector<ObjectData *> &ObjectDataStorage::get_sorted_objects_data() co
 	return objects_data_organized_by_netid;
 }
 
+VarLayout *ObjectDataStorage::get_empty_var_layout() {
+	return var_layouts[0].get();
+}
+
+VarLayout *ObjectDataStorage::get_next_var_layout(VarLayout &p_layout, const std::string &p_var_name) {
+	auto it = p_layout.next_layouts.find(p_var_name);
+	if (it != p_layout.next_layouts.end()) {
+		return it->second;
+	}
+
+	CRASH_COND_MSG(p_layout.ids.find(p_var_name) != p_layout.ids.end(), "The variable `" + String(p_var_name.c_str()) + "` is already part of this layout.");
+
+	var_layouts.push_back(std::make_unique<VarLayout>());
+	VarLayout *layout = var_layouts.back().get();
+	layout->names = p_layout.names;
+	layout->string_names = p_layout.string_names;
+	layout->ids = p_layout.ids;
+	layout->names.push_back(p_var_name);
+	layout->string_names.push_back(StringName(p_var_name.c_str()));
+	layout->ids[p_var_name] = VarId{ uint32_t(p_layout.names.size()) };
+
+	p_layout.next_layouts[p_var_name] = layout;
+	return layout;
+}
+
+int ObjectDataStorage::get_var_layouts_count() const {
+	return int(var_layouts.size());
+}
+
 ObjectNetId ObjectDataStorage::generate_net_id() const {
+	if (net_ids_in_use == objects_data_organized_by_netid.size()) {
+		// No free slots, create a new NetId.
+		return { uint32_t(objects_data_organized_by_netid.size()) };
+	}
+
 	uint32_t i = 0;
 	for (auto od : objects_data_organized_by_netid) {
 		if (!od) {
@@ -1,8 +1,10 @@
 #pragma once
 
 #include "core.h"
+#include "core/templates/oa_hash_map.h"
 #include "modules/network_synchronizer/core/object_data.h"
 #include "modules/network_synchronizer/net_utilities.h"
+#include <memory>
 #include <vector>
 
 NS_NAMESPACE_BEGIN
@@ -21,6 +23,16 @@ class ObjectDataStorage {
 	// All the controller nodes.
 	std::vector<ObjectData *> objects_data_controllers;
 
+	// The variables layouts shared by the objects. The first is the empty one.
+	std::vector<std::unique_ptr<VarLayout>> var_layouts;
+
+	// Maps the application object handle to the `ObjectLocalId`.
+	OAHashMap<uint64_t, ObjectLocalId> local_ids_by_handle;
+
+	// The amount of `objects_data_organized_by_netid` slots in use: when all
+	// of them are, the next NetId is generated without searching a free slot.
+	uint32_t net_ids_in_use = 0;
+
 public:
 	ObjectDataStorage(class SceneSynchronizerBase &p_sync);
 	~ObjectDataStorage();
@@ -28,7 +40,11 @@ public:
 	ObjectData *allocate_object_data();
 	void deallocate_object_data(ObjectData &p_object_data);
 
+	/// Pre-sizes the storage for `p_count` more objects.
+	void reserve(int p_count);
+
 	void object_set_net_id(ObjectData &p_object_data, ObjectNetId p_new_id);
+	void object_set_app_object_handle(ObjectData &p_object_data, ObjectHandle p_handle);
 
 	ObjectLocalId find_object_local_id(ObjectHandle p_handle) const;
 	ObjectLocalId find_object_local_id(const class NetworkedControllerBase &p_controller) const;
@@ -45,6 +61,13 @@ public:
 	const std::vector<ObjectData *> &get_controllers_objects_data() const;
 	const std::vector<ObjectData *> &get_sorted_objects_data() const;
 
+	VarLayout *get_empty_var_layout();
+	/// Returns the layout having all the `p_layout` variables plus `p_var_name`.
+	/// The layouts are interned, so the objects registering the same
+	/// variables in the same order get the same layout.
+	VarLayout *get_next_var_layout(VarLayout &p_layout, const std::string &p_var_name);
+	int get_var_layouts_count() const;
+
 	ObjectNetId generate_net_id() const;
 	bool is_empty() const;
 
@@ -0,0 +1,86 @@
+#include "deferred_kinematics.h"
+
+#include "core/math/math_funcs.h"
+
+NS_NAMESPACE_BEGIN
+
+void DeferredKinematics::write(DataBuffer &r_buffer, const State &p_state, DataBuffer::CompressionLevel p_compression_level) {
+	r_buffer.add_vector3(p_state.position, p_compression_level);
+	r_buffer.add_vector3(p_state.velocity, p_compression_level);
+	r_buffer.add_vector3(p_state.acceleration, p_compression_level);
+}
+
+DeferredKinematics::State DeferredKinematics::read(DataBuffer &p_buffer, DataBuffer::CompressionLevel p_compression_level) {
+	State state;
+	state.position = p_buffer.read_vector3(p_compression_level);
+	state.velocity = p_buffer.read_vector3(p_compression_level);
+	state.acceleration = p_buffer.read_vector3(p_compression_level);
+	return state;
+}
+
+DeferredKinematics::State DeferredKinematics::extrapolate(const State &p_state, real_t p_time) {
+	State state;
+	state.position = p_state.position + p_state.velocity * p_time + p_state.acceleration * (0.5 * p_time * p_time);
+	state.velocity = p_state.velocity + p_state.acceleration * p_time;
+	state.acceleration = p_state.acceleration;
+	return state;
+}
+
+Vector3 DeferredKinematics::interpolate(const State &p_past, const State &p_future, real_t p_interval, real_t p_alpha) {
+	const real_t t = p_alpha;
+	const real_t t2 = t * t;
+	const real_t t3 = t2 * t;
+	const real_t h00 = 2.0 * t3 - 3.0 * t2 + 1.0;
+	const real_t h10 = t3 - 2.0 * t2 + t;
+	const real_t h01 = -2.0 * t3 + 3.0 * t2;
+	const real_t h11 = t3 - t2;
+	return p_past.position * h00 +
+			p_past.velocity * (h10 * p_interval) +
+			p_future.position * h01 +
+			p_future.velocity * (h11 * p_interval);
+}
+
+Vector3 DeferredKinematics::apply(double p_delta, double p_alpha, DataBuffer &p_past_buffer, DataBuffer &p_future_buffer, DataBuffer::CompressionLevel p_compression_level) {
+	const State past = read(p_past_buffer, p_compression_level);
+	const State future = read(p_future_buffer, p_compression_level);
+
+	// The alpha is reset each time an epoch arrives, and it advances by the
+	// same amount each frame: so the interval is measured from its speed.
+	const bool new_interval = !started || p_alpha < last_alpha;
+	const double alpha_step = new_interval ? p_alpha : p_alpha - last_alpha;
+	if (alpha_step > 0.0) {
+		interval = p_delta / alpha_step;
+	}
+	last_alpha = p_alpha;
+
+	Vector3 position;
+	if (p_alpha <= 1.0) {
+		position = interpolate(past, future, interval, p_alpha);
+	} else {
+		position = extrapolate(future, (p_alpha - 1.0) * interval).position;
+	}
+
+	if (new_interval && started) {
+		// Start from where the object is, rather than jumping to the new path.
+		correction = last_position - position;
+		if (correction.length() > max_correction) {
+			correction = Vector3();
+		}
+	} else if (correction_time > 0.0) {
+		correction = correction * MAX(0.0, 1.0 - p_delta / correction_time);
+	} else {
+		correction = Vector3();
+	}
+
+	started = true;
+	last_position = position + correction;
+	return last_position;
+}
+
+void DeferredKinematics::reset() {
+	started = false;
+	last_alpha = 0.0;
+	correction = Vector3();
+}
+
+NS_NAMESPACE_END
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "core/math/vector3.h"
+#include "modules/network_synchronizer/core/core.h"
+#include "modules/network_synchronizer/data_buffer.h"
+
+NS_NAMESPACE_BEGIN
+
+/// Kinematic model for the deferred sync nodes: the epoch carries position,
+/// velocity and acceleration, so the client can interpolate them smoothly and
+/// extrapolate when the next epoch is late.
+/// Use `write` from the collect epoch function and `apply` from the apply
+/// epoch function; the extrapolation needs
+/// `SceneSynchronizerBase::set_deferred_max_extrapolation`.
+///
+/// When the next epoch arrives, the distance between the extrapolated and the
+/// received state is blended away in `correction_time` seconds, unless it's
+/// greater than `max_correction`: in that case the object snaps.
+class DeferredKinematics {
+public:
+	struct State {
+		Vector3 position;
+		Vector3 velocity;
+		Vector3 acceleration;
+	};
+
+	real_t max_correction = 2.0;
+	real_t correction_time = 0.15;
+
+private:
+	bool started = false;
+	double last_alpha = 0.0;
+	/// The duration, in seconds, of the interval between the two epochs.
+	double interval = 0.0;
+	Vector3 last_position;
+	Vector3 correction;
+
+public:
+	static void write(DataBuffer &r_buffer, const State &p_state, DataBuffer::CompressionLevel p_compression_level = DataBuffer::COMPRESSION_LEVEL_1);
+	static State read(DataBuffer &p_buffer, DataBuffer::CompressionLevel p_compression_level = DataBuffer::COMPRESSION_LEVEL_1);
+
+	/// Returns the state `p_time` seconds after `p_state`.
+	static State extrapolate(const State &p_state, real_t p_time);
+	/// Returns the position at `p_alpha`, using a cubic Hermite spline: so the
+	/// object is at `p_past` and `p_future` with their velocities.
+	static Vector3 interpolate(const State &p_past, const State &p_future, real_t p_interval, real_t p_alpha);
+
+	/// Reads the two epochs and returns the position to apply: interpolated
+	/// when `p_alpha` is within 0 and 1, extrapolated when it's greater.
+	Vector3 apply(double p_delta, double p_alpha, DataBuffer &p_past_buffer, DataBuffer &p_future_buffer, DataBuffer::CompressionLevel p_compression_level = DataBuffer::COMPRESSION_LEVEL_1);
+
+	/// Drops the correction, the next `apply` snaps to the received state.
+	void reset();
+
+	const Vector3 &get_correction() const { return correction; }
+	double get_interval() const { return interval; }
+};
+
+NS_NAMESPACE_END
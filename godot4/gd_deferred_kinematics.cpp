@@ -0,0 +1,68 @@
+#include "gd_deferred_kinematics.h"
+
+#include "core/object/class_db.h"
+
+void GdDeferredKinematics::_bind_methods() {
+	ClassDB::bind_static_method("GdDeferredKinematics", D_METHOD("write_state", "buffer", "position", "velocity", "acceleration", "compression_level"), &GdDeferredKinematics::write_state, DEFVAL(DataBuffer::COMPRESSION_LEVEL_1));
+
+	ClassDB::bind_method(D_METHOD("apply", "delta", "alpha", "past_buffer", "future_buffer", "compression_level"), &GdDeferredKinematics::apply, DEFVAL(DataBuffer::COMPRESSION_LEVEL_1));
+	ClassDB::bind_method(D_METHOD("reset"), &GdDeferredKinematics::reset);
+
+	ClassDB::bind_method(D_METHOD("set_max_correction", "distance"), &GdDeferredKinematics::set_max_correction);
+	ClassDB::bind_method(D_METHOD("get_max_correction"), &GdDeferredKinematics::get_max_correction);
+
+	ClassDB::bind_method(D_METHOD("set_correction_time", "time"), &GdDeferredKinematics::set_correction_time);
+	ClassDB::bind_method(D_METHOD("get_correction_time"), &GdDeferredKinematics::get_correction_time);
+
+	ClassDB::bind_method(D_METHOD("get_correction"), &GdDeferredKinematics::get_correction);
+	ClassDB::bind_method(D_METHOD("get_interval"), &GdDeferredKinematics::get_interval);
+
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "max_correction", PROPERTY_HINT_RANGE, "0.0,100.0,0.01"), "set_max_correction", "get_max_correction");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "correction_time", PROPERTY_HINT_RANGE, "0.0,2.0,0.01"), "set_correction_time", "get_correction_time");
+}
+
+void GdDeferredKinematics::write_state(Object *p_buffer, const Vector3 &p_position, const Vector3 &p_velocity, const Vector3 &p_acceleration, DataBuffer::CompressionLevel p_compression_level) {
+	DataBuffer *db = Object::cast_to<DataBuffer>(p_buffer);
+	ERR_FAIL_COND_MSG(db == nullptr, "The `buffer` is not a DataBuffer.");
+
+	NS::DeferredKinematics::State state;
+	state.position = p_position;
+	state.velocity = p_velocity;
+	state.acceleration = p_acceleration;
+	NS::DeferredKinematics::write(*db, state, p_compression_level);
+}
+
+Vector3 GdDeferredKinematics::apply(double p_delta, double p_alpha, Object *p_past_buffer, Object *p_future_buffer, DataBuffer::CompressionLevel p_compression_level) {
+	DataBuffer *past = Object::cast_to<DataBuffer>(p_past_buffer);
+	DataBuffer *future = Object::cast_to<DataBuffer>(p_future_buffer);
+	ERR_FAIL_COND_V_MSG(past == nullptr || future == nullptr, Vector3(), "The `past_buffer` and `future_buffer` must be DataBuffers.");
+	return kinematics.apply(p_delta, p_alpha, *past, *future, p_compression_level);
+}
+
+void GdDeferredKinematics::reset() {
+	kinematics.reset();
+}
+
+void GdDeferredKinematics::set_max_correction(real_t p_distance) {
+	kinematics.max_correction = p_distance;
+}
+
+real_t GdDeferredKinematics::get_max_correction() const {
+	return kinematics.max_correction;
+}
+
+void GdDeferredKinematics::set_correction_time(real_t p_time) {
+	kinematics.correction_time = p_time;
+}
+
+real_t GdDeferredKinematics::get_correction_time() const {
+	return kinematics.correction_time;
+}
+
+Vector3 GdDeferredKinematics::get_correction() const {
+	return kinematics.get_correction();
+}
+
+double GdDeferredKinematics::get_interval() const {
+	return kinematics.get_interval();
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "core/object/ref_counted.h"
+#include "modules/network_synchronizer/data_buffer.h"
+#include "modules/network_synchronizer/deferred_kinematics.h"
+
+/// Exposes `NS::DeferredKinematics` to script: use `write_state` from the
+/// collect epoch function and `apply` from the apply epoch function of a
+/// deferred sync node. Keep one instance per node, since it stores the
+/// correction.
+class GdDeferredKinematics : public RefCounted {
+	GDCLASS(GdDeferredKinematics, RefCounted);
+
+	NS::DeferredKinematics kinematics;
+
+public:
+	static void _bind_methods();
+
+public:
+	static void write_state(Object *p_buffer, const Vector3 &p_position, const Vector3 &p_velocity, const Vector3 &p_acceleration, DataBuffer::CompressionLevel p_compression_level);
+
+	Vector3 apply(double p_delta, double p_alpha, Object *p_past_buffer, Object *p_future_buffer, DataBuffer::CompressionLevel p_compression_level);
+	void reset();
+
+	void set_max_correction(real_t p_distance);
+	real_t get_max_correction() const;
+
+	void set_correction_time(real_t p_time);
+	real_t get_correction_time() const;
+
+	Vector3 get_correction() const;
+	double get_interval() const;
+};
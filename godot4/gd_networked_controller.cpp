@@ -70,6 +70,20 @@ void GdNetworkedController::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_tick_acceleration", "acceleration"), &GdNetworkedController::set_tick_acceleration);
 	ClassDB::bind_method(D_METHOD("get_tick_acceleration"), &GdNetworkedController::get_tick_acceleration);
 
+	ClassDB::bind_method(D_METHOD("set_doll_input_prediction", "prediction"), &GdNetworkedController::set_doll_input_prediction);
+	ClassDB::bind_method(D_METHOD("get_doll_input_prediction"), &GdNetworkedController::get_doll_input_prediction);
+
+	ClassDB::bind_method(D_METHOD("set_doll_max_predicted_frames", "frames"), &GdNetworkedController::set_doll_max_predicted_frames);
+	ClassDB::bind_method(D_METHOD("get_doll_max_predicted_frames"), &GdNetworkedController::get_doll_max_predicted_frames);
+
+	ClassDB::bind_method(D_METHOD("set_doll_prediction_decay", "decay"), &GdNetworkedController::set_doll_prediction_decay);
+	ClassDB::bind_method(D_METHOD("get_doll_prediction_decay"), &GdNetworkedController::get_doll_prediction_decay);
+
+	ClassDB::bind_method(D_METHOD("set_input_size_prefixed", "prefixed"), &GdNetworkedController::set_input_size_prefixed);
+	ClassDB::bind_method(D_METHOD("get_input_size_prefixed"), &GdNetworkedController::get_input_size_prefixed);
+
+	ClassDB::bind_method(D_METHOD("get_doll_misprediction_rate"), &GdNetworkedController::get_doll_misprediction_rate);
+
 	ClassDB::bind_method(D_METHOD("get_current_input_id"), &GdNetworkedController::get_current_input_id);
 
 	ClassDB::bind_method(D_METHOD("player_get_pretended_delta"), &GdNetworkedController::player_get_pretended_delta);
@@ -86,6 +100,8 @@ void GdNetworkedController::_bind_methods() {
 	GDVIRTUAL_BIND(_controller_process, "delta", "buffer");
 	GDVIRTUAL_BIND(_are_inputs_different, "inputs_A", "inputs_B");
 	GDVIRTUAL_BIND(_count_input_size, "inputs");
+	GDVIRTUAL_BIND(_predict_doll_input, "frames", "last_input", "predicted_input");
+	GDVIRTUAL_BIND(_decay_doll_input, "factor", "last_input", "decayed_input");
 
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "server_controlled"), "set_server_controlled", "get_server_controlled");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "input_storage_size", PROPERTY_HINT_RANGE, "5,2000,1"), "set_player_input_storage_size", "get_player_input_storage_size");
@@ -96,6 +112,10 @@ void GdNetworkedController::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "min_frames_delay", PROPERTY_HINT_RANGE, "0,100,1"), "set_min_frames_delay", "get_min_frames_delay");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "max_frames_delay", PROPERTY_HINT_RANGE, "0,100,1"), "set_max_frames_delay", "get_max_frames_delay");
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "tick_acceleration", PROPERTY_HINT_RANGE, "0.1,20.0,0.01"), "set_tick_acceleration", "get_tick_acceleration");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "doll_input_prediction", PROPERTY_HINT_ENUM, "Repeat Last,Decay To Neutral,Custom"), "set_doll_input_prediction", "get_doll_input_prediction");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "doll_max_predicted_frames", PROPERTY_HINT_RANGE, "0,100,1"), "set_doll_max_predicted_frames", "get_doll_max_predicted_frames");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "doll_prediction_decay", PROPERTY_HINT_RANGE, "0.0,1.0,0.01"), "set_doll_prediction_decay", "get_doll_prediction_decay");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "input_size_prefixed"), "set_input_size_prefixed", "get_input_size_prefixed");
 
 	ADD_SIGNAL(MethodInfo("controller_reset"));
 	ADD_SIGNAL(MethodInfo("input_missed", PropertyInfo(Variant::INT, "missing_input_id")));
@@ -211,7 +231,7 @@ void GdNetworkedController::set_server_controlled(bool p_server_controlled) {
 		WARN_PRINT("In your script you must inherit the virtual method `_are_inputs_different` to correctly use the `NetworkedController`.");
 	}
 
-	if (GDVIRTUAL_IS_OVERRIDDEN(_count_input_size) == false && networked_controller.get_server_controlled() == false) {
+	if (GDVIRTUAL_IS_OVERRIDDEN(_count_input_size) == false && networked_controller.get_server_controlled() == false && networked_controller.get_input_size_prefixed() == false) {
 		WARN_PRINT("In your script you must inherit the virtual method `_count_input_size` to correctly use the `NetworkedController`.");
 	}
 #endif
@@ -277,6 +297,43 @@ double GdNetworkedController::get_tick_acceleration() const {
 	return networked_controller.get_tick_acceleration();
 }
 
+void GdNetworkedController::set_doll_input_prediction(int p_prediction) {
+	ERR_FAIL_COND(p_prediction < NS::NetworkedControllerBase::DOLL_INPUT_PREDICTION_REPEAT_LAST || p_prediction > NS::NetworkedControllerBase::DOLL_INPUT_PREDICTION_CUSTOM);
+	networked_controller.set_doll_input_prediction(NS::NetworkedControllerBase::DollInputPrediction(p_prediction));
+}
+
+int GdNetworkedController::get_doll_input_prediction() const {
+	return networked_controller.get_doll_input_prediction();
+}
+
+void GdNetworkedController::set_doll_max_predicted_frames(int p_frames) {
+	networked_controller.set_doll_max_predicted_frames(p_frames);
+}
+
+int GdNetworkedController::get_doll_max_predicted_frames() const {
+	return networked_controller.get_doll_max_predicted_frames();
+}
+
+void GdNetworkedController::set_doll_prediction_decay(double p_decay) {
+	networked_controller.set_doll_prediction_decay(p_decay);
+}
+
+double GdNetworkedController::get_doll_prediction_decay() const {
+	return networked_controller.get_doll_prediction_decay();
+}
+
+void GdNetworkedController::set_input_size_prefixed(bool p_prefixed) {
+	networked_controller.set_input_size_prefixed(p_prefixed);
+}
+
+bool GdNetworkedController::get_input_size_prefixed() const {
+	return networked_controller.get_input_size_prefixed();
+}
+
+double GdNetworkedController::get_doll_misprediction_rate() const {
+	return networked_controller.get_doll_misprediction_rate();
+}
+
 uint32_t GdNetworkedController::get_current_input_id() const {
 	return networked_controller.get_current_input_id();
 }
@@ -356,6 +413,27 @@ uint32_t GdNetworkedController::count_input_size(DataBuffer &p_buffer) {
 	return uint32_t(input_size >= 0 ? input_size : 0);
 }
 
+bool GdNetworkedController::predict_doll_input(int p_frames, DataBuffer &p_last_input, DataBuffer &r_predicted_input) {
+	PROFILE_NODE
+
+	bool predicted = false;
+	const bool executed = GDVIRTUAL_CALL(_predict_doll_input, p_frames, &p_last_input, &r_predicted_input, predicted);
+	if (executed == false) {
+		NET_DEBUG_ERR("The function `_predict_doll_input` was not executed, but the `doll_input_prediction` is `Custom`.");
+		return false;
+	}
+	return predicted;
+}
+
+bool GdNetworkedController::decay_doll_input(double p_factor, DataBuffer &p_last_input, DataBuffer &r_decayed_input) {
+	PROFILE_NODE
+
+	bool decayed = false;
+	// Optional: when not implemented the last input is repeated as is.
+	GDVIRTUAL_CALL(_decay_doll_input, p_factor, &p_last_input, &r_decayed_input, decayed);
+	return decayed;
+}
+
 void GdNetworkedController::_rpc_net_sync_reliable(const Vector<uint8_t> &p_args) {
 	static_cast<GdNetworkInterface *>(&networked_controller.get_network_interface())->gd_rpc_receive(p_args);
 }
@@ -368,5 +446,5 @@ void GdNetworkedController::validate_script_implementation() {
 	ERR_FAIL_COND_MSG(has_method("_collect_inputs") == false && networked_controller.get_server_controlled() == false, "In your script you must inherit the virtual method `_collect_inputs` to correctly use the `GdNetworkedController`.");
 	ERR_FAIL_COND_MSG(has_method("_controller_process") == false && networked_controller.get_server_controlled() == false, "In your script you must inherit the virtual method `_controller_process` to correctly use the `GdNetworkedController`.");
 	ERR_FAIL_COND_MSG(has_method("_are_inputs_different") == false && networked_controller.get_server_controlled() == false, "In your script you must inherit the virtual method `_are_inputs_different` to correctly use the `GdNetworkedController`.");
-	ERR_FAIL_COND_MSG(has_method("_count_input_size") == false && networked_controller.get_server_controlled() == false, "In your script you must inherit the virtual method `_count_input_size` to correctly use the `GdNetworkedController`.");
+	ERR_FAIL_COND_MSG(has_method("_count_input_size") == false && networked_controller.get_server_controlled() == false && networked_controller.get_input_size_prefixed() == false, "In your script you must inherit the virtual method `_count_input_size` to correctly use the `GdNetworkedController`.");
 }
@@ -66,6 +66,8 @@ public:
 	GDVIRTUAL2(_controller_process, real_t, DataBuffer *);
 	GDVIRTUAL2R(bool, _are_inputs_different, DataBuffer *, DataBuffer *);
 	GDVIRTUAL1RC(int, _count_input_size, DataBuffer *);
+	GDVIRTUAL3R(bool, _predict_doll_input, int, DataBuffer *, DataBuffer *);
+	GDVIRTUAL3R(bool, _decay_doll_input, real_t, DataBuffer *, DataBuffer *);
 
 private:
 	NS::NetworkedController<GdNetworkInterface> networked_controller;
@@ -110,6 +112,20 @@ public:
 	void set_tick_acceleration(double p_acceleration);
 	double get_tick_acceleration() const;
 
+	void set_doll_input_prediction(int p_prediction);
+	int get_doll_input_prediction() const;
+
+	void set_doll_max_predicted_frames(int p_frames);
+	int get_doll_max_predicted_frames() const;
+
+	void set_doll_prediction_decay(double p_decay);
+	double get_doll_prediction_decay() const;
+
+	void set_input_size_prefixed(bool p_prefixed);
+	bool get_input_size_prefixed() const;
+
+	double get_doll_misprediction_rate() const;
+
 	uint32_t get_current_input_id() const;
 
 	/// Returns the pretended delta used by the player.
@@ -126,6 +142,8 @@ public: // ----------------------------------------------------------- Interface
 	virtual void controller_process(double p_delta, DataBuffer &p_buffer) override;
 	virtual bool are_inputs_different(DataBuffer &p_buffer_A, DataBuffer &p_buffer_B) override;
 	virtual uint32_t count_input_size(DataBuffer &p_buffer) override;
+	virtual bool predict_doll_input(int p_frames, DataBuffer &p_last_input, DataBuffer &r_predicted_input) override;
+	virtual bool decay_doll_input(double p_factor, DataBuffer &p_last_input, DataBuffer &r_decayed_input) override;
 
 	// This funtion is used to sync data betweend the server and the client.
 	void _rpc_net_sync_reliable(const Vector<uint8_t> &p_args);
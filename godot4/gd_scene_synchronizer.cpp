@@ -11,9 +11,11 @@
 #include "modules/network_synchronizer/scene_synchronizer.h"
 #include "modules/network_synchronizer/scene_synchronizer_debugger.h"
 #include "modules/network_synchronizer/snapshot.h"
+#include "scene/3d/physics_body_3d.h"
 #include "scene/main/multiplayer_api.h"
 #include "scene/main/node.h"
 #include "scene/main/window.h"
+#include "servers/physics_server_3d.h"
 #include <vector>
 
 void GdSceneSynchronizer::_bind_methods() {
@@ -40,9 +42,24 @@ void GdSceneSynchronizer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_max_deferred_nodes_per_update", "rate"), &GdSceneSynchronizer::set_max_deferred_nodes_per_update);
 	ClassDB::bind_method(D_METHOD("get_max_deferred_nodes_per_update"), &GdSceneSynchronizer::get_max_deferred_nodes_per_update);
 
+	ClassDB::bind_method(D_METHOD("set_deferred_sync_delta_enabled", "enabled"), &GdSceneSynchronizer::set_deferred_sync_delta_enabled);
+	ClassDB::bind_method(D_METHOD("is_deferred_sync_delta_enabled"), &GdSceneSynchronizer::is_deferred_sync_delta_enabled);
+
+	ClassDB::bind_method(D_METHOD("set_deferred_sync_keyframe_interval", "interval"), &GdSceneSynchronizer::set_deferred_sync_keyframe_interval);
+	ClassDB::bind_method(D_METHOD("get_deferred_sync_keyframe_interval"), &GdSceneSynchronizer::get_deferred_sync_keyframe_interval);
+
 	ClassDB::bind_method(D_METHOD("set_server_notify_state_interval", "interval"), &GdSceneSynchronizer::set_server_notify_state_interval);
 	ClassDB::bind_method(D_METHOD("get_server_notify_state_interval"), &GdSceneSynchronizer::get_server_notify_state_interval);
 
+	ClassDB::bind_method(D_METHOD("set_join_stream_budget", "objects"), &GdSceneSynchronizer::set_join_stream_budget);
+	ClassDB::bind_method(D_METHOD("get_join_stream_budget"), &GdSceneSynchronizer::get_join_stream_budget);
+
+	ClassDB::bind_method(D_METHOD("set_spectator_mode", "enabled"), &GdSceneSynchronizer::set_spectator_mode);
+	ClassDB::bind_method(D_METHOD("is_spectator_mode"), &GdSceneSynchronizer::is_spectator_mode);
+
+	ClassDB::bind_method(D_METHOD("set_spectator_interpolation_delay", "delay"), &GdSceneSynchronizer::set_spectator_interpolation_delay);
+	ClassDB::bind_method(D_METHOD("get_spectator_interpolation_delay"), &GdSceneSynchronizer::get_spectator_interpolation_delay);
+
 	ClassDB::bind_method(D_METHOD("set_comparison_float_tolerance", "tolerance"), &GdSceneSynchronizer::set_comparison_float_tolerance);
 	ClassDB::bind_method(D_METHOD("get_comparison_float_tolerance"), &GdSceneSynchronizer::get_comparison_float_tolerance);
 
@@ -50,6 +67,8 @@ void GdSceneSynchronizer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_nodes_relevancy_update_time"), &GdSceneSynchronizer::get_nodes_relevancy_update_time);
 
 	ClassDB::bind_method(D_METHOD("register_node", "node"), &GdSceneSynchronizer::register_node_gdscript);
+	ClassDB::bind_method(D_METHOD("register_nodes", "nodes"), &GdSceneSynchronizer::register_nodes);
+	ClassDB::bind_method(D_METHOD("register_physics_body", "body"), &GdSceneSynchronizer::register_physics_body);
 	ClassDB::bind_method(D_METHOD("unregister_node", "node"), &GdSceneSynchronizer::unregister_node);
 	ClassDB::bind_method(D_METHOD("get_node_id", "node"), &GdSceneSynchronizer::get_node_id);
 	ClassDB::bind_method(D_METHOD("get_node_from_id", "id", "expected"), &GdSceneSynchronizer::get_node_from_id, DEFVAL(true));
@@ -61,23 +80,42 @@ void GdSceneSynchronizer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_skip_rewinding", "node", "variable", "skip_rewinding"), &GdSceneSynchronizer::set_skip_rewinding);
 
 	ClassDB::bind_method(D_METHOD("track_variable_changes", "nodes", "variables", "callable", "flags"), &GdSceneSynchronizer::track_variable_changes, DEFVAL(NetEventFlag::DEFAULT));
+	ClassDB::bind_method(D_METHOD("track_variable_changes_batched", "nodes", "variables", "callable", "flags"), &GdSceneSynchronizer::track_variable_changes_batched, DEFVAL(NetEventFlag::DEFAULT));
 	ClassDB::bind_method(D_METHOD("untrack_variable_changes", "handle"), &GdSceneSynchronizer::untrack_variable_changes);
 
 	ClassDB::bind_method(D_METHOD("register_process", "node", "phase", "function"), &GdSceneSynchronizer::register_process);
 	ClassDB::bind_method(D_METHOD("unregister_process", "node", "phase", "function"), &GdSceneSynchronizer::unregister_process);
 
 	ClassDB::bind_method(D_METHOD("setup_deferred_sync", "node", "collect_epoch_func", "apply_epoch_func"), &GdSceneSynchronizer::setup_deferred_sync);
+	ClassDB::bind_method(D_METHOD("set_deferred_max_extrapolation", "node", "max_intervals"), &GdSceneSynchronizer::set_deferred_max_extrapolation);
+	ClassDB::bind_method(D_METHOD("get_deferred_max_extrapolation", "node"), &GdSceneSynchronizer::get_deferred_max_extrapolation);
+
+	ClassDB::bind_method(D_METHOD("set_sleep_idle_ticks", "node", "idle_ticks"), &GdSceneSynchronizer::set_sleep_idle_ticks);
+	ClassDB::bind_method(D_METHOD("get_sleep_idle_ticks", "node"), &GdSceneSynchronizer::get_sleep_idle_ticks);
+	ClassDB::bind_method(D_METHOD("is_node_sleeping", "node"), &GdSceneSynchronizer::is_node_sleeping);
+	ClassDB::bind_method(D_METHOD("wake_up", "node"), &GdSceneSynchronizer::wake_up);
+	ClassDB::bind_method(D_METHOD("add_wake_trigger", "node", "trigger_node"), &GdSceneSynchronizer::add_wake_trigger);
+	ClassDB::bind_method(D_METHOD("remove_wake_trigger", "node", "trigger_node"), &GdSceneSynchronizer::remove_wake_trigger);
+
+	ClassDB::bind_method(D_METHOD("set_process_rate_divisor", "node", "divisor"), &GdSceneSynchronizer::set_process_rate_divisor);
+	ClassDB::bind_method(D_METHOD("get_process_rate_divisor", "node"), &GdSceneSynchronizer::get_process_rate_divisor);
 
 	ClassDB::bind_method(D_METHOD("sync_group_create"), &GdSceneSynchronizer::sync_group_create);
 	ClassDB::bind_method(D_METHOD("sync_group_add_node", "node_id", "group_id", "realtime"), &GdSceneSynchronizer::sync_group_add_node_by_id);
 	ClassDB::bind_method(D_METHOD("sync_group_remove_node", "node_id", "group_id"), &GdSceneSynchronizer::sync_group_remove_node_by_id);
+	ClassDB::bind_method(D_METHOD("sync_group_remove_nodes", "node_ids", "group_id"), &GdSceneSynchronizer::sync_group_remove_nodes_by_id);
+	ClassDB::bind_method(D_METHOD("sync_group_replace_nodes", "group_id", "realtime_node_ids", "deferred_node_ids", "deferred_update_rates"), &GdSceneSynchronizer::sync_group_replace_nodes_by_id, DEFVAL(PackedFloat32Array()));
 	ClassDB::bind_method(D_METHOD("sync_group_move_peer_to", "peer_id", "group_id"), &GdSceneSynchronizer::sync_group_move_peer_to);
 	ClassDB::bind_method(D_METHOD("sync_group_set_deferred_update_rate", "node_id", "group_id", "update_rate"), &GdSceneSynchronizer::sync_group_set_deferred_update_rate_by_id);
 	ClassDB::bind_method(D_METHOD("sync_group_get_deferred_update_rate", "node_id", "group_id"), &GdSceneSynchronizer::sync_group_get_deferred_update_rate_by_id);
+	ClassDB::bind_method(D_METHOD("sync_group_set_lod_policy", "group_id", "policy"), &GdSceneSynchronizer::sync_group_set_lod_policy);
+	ClassDB::bind_method(D_METHOD("sync_group_set_lod_metric", "node_id", "group_id", "metric"), &GdSceneSynchronizer::sync_group_set_lod_metric_by_id);
+	ClassDB::bind_method(D_METHOD("sync_group_get_lod_tier", "node_id", "group_id"), &GdSceneSynchronizer::sync_group_get_lod_tier_by_id);
+	ClassDB::bind_method(D_METHOD("sync_group_update_lod", "group_id"), &GdSceneSynchronizer::sync_group_update_lod);
 
 	ClassDB::bind_method(D_METHOD("start_tracking_scene_changes", "diff_handle"), &GdSceneSynchronizer::start_tracking_scene_changes);
 	ClassDB::bind_method(D_METHOD("stop_tracking_scene_changes", "diff_handle"), &GdSceneSynchronizer::stop_tracking_scene_changes);
-	ClassDB::bind_method(D_METHOD("pop_scene_changes", "diff_handle"), &GdSceneSynchronizer::pop_scene_changes);
+	ClassDB::bind_method(D_METHOD("pop_scene_changes", "diff_handle", "sync_data"), &GdSceneSynchronizer::pop_scene_changes);
 	ClassDB::bind_method(D_METHOD("apply_scene_changes", "sync_data"), &GdSceneSynchronizer::apply_scene_changes);
 
 	ClassDB::bind_method(D_METHOD("is_recovered"), &GdSceneSynchronizer::is_recovered);
@@ -85,6 +123,11 @@ void GdSceneSynchronizer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("is_rewinding"), &GdSceneSynchronizer::is_rewinding);
 	ClassDB::bind_method(D_METHOD("is_end_sync"), &GdSceneSynchronizer::is_end_sync);
 
+	ClassDB::bind_method(D_METHOD("set_rewind_profiler_enabled", "enabled"), &GdSceneSynchronizer::set_rewind_profiler_enabled);
+	ClassDB::bind_method(D_METHOD("is_rewind_profiler_enabled"), &GdSceneSynchronizer::is_rewind_profiler_enabled);
+	ClassDB::bind_method(D_METHOD("reset_rewind_profiler"), &GdSceneSynchronizer::reset_rewind_profiler);
+	ClassDB::bind_method(D_METHOD("get_rewind_profiler_report"), &GdSceneSynchronizer::get_rewind_profiler_report);
+
 	ClassDB::bind_method(D_METHOD("force_state_notify", "group_id"), &GdSceneSynchronizer::force_state_notify);
 	ClassDB::bind_method(D_METHOD("force_state_notify_all"), &GdSceneSynchronizer::force_state_notify_all);
 
@@ -94,7 +137,9 @@ void GdSceneSynchronizer::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("is_server"), &GdSceneSynchronizer::is_server);
 	ClassDB::bind_method(D_METHOD("is_client"), &GdSceneSynchronizer::is_client);
+	ClassDB::bind_method(D_METHOD("is_spectator"), &GdSceneSynchronizer::is_spectator);
 	ClassDB::bind_method(D_METHOD("is_networked"), &GdSceneSynchronizer::is_networked);
+	ClassDB::bind_method(D_METHOD("is_join_streaming"), &GdSceneSynchronizer::is_join_streaming);
 
 	ClassDB::bind_method(D_METHOD("_rpc_net_sync_reliable"), &GdSceneSynchronizer::_rpc_net_sync_reliable);
 	ClassDB::bind_method(D_METHOD("_rpc_net_sync_unreliable"), &GdSceneSynchronizer::_rpc_net_sync_unreliable);
@@ -104,6 +149,9 @@ void GdSceneSynchronizer::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "server_notify_state_interval", PROPERTY_HINT_RANGE, "0.001,10.0,0.0001"), "set_server_notify_state_interval", "get_server_notify_state_interval");
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "comparison_float_tolerance", PROPERTY_HINT_RANGE, "0.000001,0.01,0.000001"), "set_comparison_float_tolerance", "get_comparison_float_tolerance");
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "nodes_relevancy_update_time", PROPERTY_HINT_RANGE, "0.0,2.0,0.01"), "set_nodes_relevancy_update_time", "get_nodes_relevancy_update_time");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "join_stream_budget", PROPERTY_HINT_RANGE, "0,1000,1"), "set_join_stream_budget", "get_join_stream_budget");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "spectator_mode"), "set_spectator_mode", "is_spectator_mode");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "spectator_interpolation_delay", PROPERTY_HINT_RANGE, "0.0,2.0,0.01"), "set_spectator_interpolation_delay", "get_spectator_interpolation_delay");
 
 	ADD_SIGNAL(MethodInfo("sync_started"));
 	ADD_SIGNAL(MethodInfo("sync_paused"));
@@ -252,6 +300,8 @@ void GdSceneSynchronizer::on_init_synchronizer(bool p_was_generating_ids) {
 	String debugger_mode;
 	if (scene_synchronizer.is_server()) {
 		debugger_mode = "server";
+	} else if (scene_synchronizer.is_spectator()) {
+		debugger_mode = "spectator";
 	} else if (scene_synchronizer.is_client()) {
 		debugger_mode = "client";
 	} else if (scene_synchronizer.is_no_network()) {
@@ -269,6 +319,10 @@ void GdSceneSynchronizer::on_add_object_data(NS::ObjectData &p_object_data) {
 	SceneSynchronizerDebugger::singleton()->register_class_for_node_to_dump(SyncClass::from_handle(p_object_data.app_object_handle));
 }
 
+void GdSceneSynchronizer::on_drop_object_data(NS::ObjectData &p_object_data) {
+	physics_bodies.erase(SyncClass::from_handle(p_object_data.app_object_handle));
+}
+
 #ifdef DEBUG_ENABLED
 void GdSceneSynchronizer::debug_only_validate_nodes() {
 	LocalVector<NS::ObjectHandle> null_objects;
@@ -286,7 +340,7 @@ void GdSceneSynchronizer::debug_only_validate_nodes() {
 
 	// Removes the invalidated `NodeData`.
 	if (null_objects.size()) {
-		SceneSynchronizerDebugger::singleton()->debug_error(&scene_synchronizer.get_network_interface(), "At least one node has been removed from the tree without the SceneSynchronizer noticing. This shouldn't happen.");
+		NS_DEBUG_ERROR(&scene_synchronizer.get_network_interface(), "At least one node has been removed from the tree without the SceneSynchronizer noticing. This shouldn't happen.", false);
 		for (uint32_t i = 0; i < null_objects.size(); i += 1) {
 			scene_synchronizer.on_app_object_removed(null_objects[i]);
 		}
@@ -323,7 +377,7 @@ void GdSceneSynchronizer::setup_synchronizer_for(NS::ObjectHandle p_app_object_h
 	if (node->has_method("_setup_synchronizer")) {
 		node->call("_setup_synchronizer", p_id.id);
 	} else {
-		SceneSynchronizerDebugger::singleton()->debug_error(nullptr, "[ERROR] The registered node `" + node->get_path() + "` doesn't override the method `_setup_synchronizer`, which is called by the SceneSynchronizer to know the node sync properties. Pleaes implement it.");
+		NS_DEBUG_ERROR(nullptr, "[ERROR] The registered node `" + node->get_path() + "` doesn't override the method `_setup_synchronizer`, which is called by the SceneSynchronizer to know the node sync properties. Pleaes implement it.", false);
 	}
 }
 
@@ -342,6 +396,71 @@ bool GdSceneSynchronizer::get_variable(NS::ObjectHandle p_app_object_handle, con
 	return valid;
 }
 
+bool GdSceneSynchronizer::get_variables(NS::ObjectHandle p_app_object_handle, const NS::VarLayout &p_layout, std::vector<Variant> &r_values) const {
+	const Node *node = scene_synchronizer.from_handle(p_app_object_handle);
+	const PhysicsBodySync *body = physics_bodies.getptr(node);
+	PhysicsDirectBodyState3D *state = body ? PhysicsServer3D::get_singleton()->body_get_direct_state(body->rid) : nullptr;
+
+	r_values.resize(p_layout.string_names.size());
+	for (size_t v = 0; v < p_layout.string_names.size(); v++) {
+		if (state) {
+			const StringName &name = p_layout.string_names[v];
+			if (name == SNAME("global_transform")) {
+				r_values[v] = state->get_transform();
+				continue;
+			} else if (name == SNAME("linear_velocity")) {
+				r_values[v] = state->get_linear_velocity();
+				continue;
+			} else if (name == SNAME("angular_velocity")) {
+				r_values[v] = state->get_angular_velocity();
+				continue;
+			}
+		}
+
+		bool valid = false;
+		r_values[v] = node->get(p_layout.string_names[v], &valid);
+		if (valid) {
+			r_values[v] = r_values[v].duplicate(true);
+		}
+	}
+	return true;
+}
+
+bool GdSceneSynchronizer::set_variables(NS::ObjectHandle p_app_object_handle, const NS::VarLayout &p_layout, const std::vector<bool> &p_var_mask, const std::vector<Variant> &p_values) {
+	Node *node = scene_synchronizer.from_handle(p_app_object_handle);
+	PhysicsBodySync *body = physics_bodies.getptr(node);
+	PhysicsServer3D *physics_server = PhysicsServer3D::get_singleton();
+
+	for (size_t v = 0; v < p_var_mask.size(); v++) {
+		if (!p_var_mask[v]) {
+			continue;
+		}
+
+		const StringName &name = p_layout.string_names[v];
+		if (body) {
+			if (name == SNAME("global_transform")) {
+				physics_server->body_set_state(body->rid, PhysicsServer3D::BODY_STATE_TRANSFORM, p_values[v]);
+				// The body state is already set, though the scripts read the
+				// node transform even while rewinding.
+				RigidBody3D *rigid_body = static_cast<RigidBody3D *>(node);
+				rigid_body->set_ignore_transform_notification(true);
+				rigid_body->set_global_transform(p_values[v]);
+				rigid_body->set_ignore_transform_notification(false);
+				continue;
+			} else if (name == SNAME("linear_velocity")) {
+				physics_server->body_set_state(body->rid, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY, p_values[v]);
+				continue;
+			} else if (name == SNAME("angular_velocity")) {
+				physics_server->body_set_state(body->rid, PhysicsServer3D::BODY_STATE_ANGULAR_VELOCITY, p_values[v]);
+				continue;
+			}
+		}
+
+		node->set(name, p_values[v]);
+	}
+	return true;
+}
+
 NS::NetworkedControllerBase *GdSceneSynchronizer::extract_network_controller(NS::ObjectHandle p_app_object_handle) {
 	if (GdNetworkedController *c = Object::cast_to<GdNetworkedController>(scene_synchronizer.from_handle(p_app_object_handle))) {
 		return c->get_networked_controller();
@@ -364,6 +483,22 @@ int GdSceneSynchronizer::get_max_deferred_nodes_per_update() const {
 	return scene_synchronizer.get_max_deferred_nodes_per_update();
 }
 
+void GdSceneSynchronizer::set_deferred_sync_delta_enabled(bool p_enabled) {
+	scene_synchronizer.set_deferred_sync_delta_enabled(p_enabled);
+}
+
+bool GdSceneSynchronizer::is_deferred_sync_delta_enabled() const {
+	return scene_synchronizer.is_deferred_sync_delta_enabled();
+}
+
+void GdSceneSynchronizer::set_deferred_sync_keyframe_interval(int p_interval) {
+	scene_synchronizer.set_deferred_sync_keyframe_interval(p_interval);
+}
+
+int GdSceneSynchronizer::get_deferred_sync_keyframe_interval() const {
+	return scene_synchronizer.get_deferred_sync_keyframe_interval();
+}
+
 void GdSceneSynchronizer::set_server_notify_state_interval(real_t p_interval) {
 	scene_synchronizer.set_server_notify_state_interval(p_interval);
 }
@@ -372,6 +507,30 @@ real_t GdSceneSynchronizer::get_server_notify_state_interval() const {
 	return scene_synchronizer.get_server_notify_state_interval();
 }
 
+void GdSceneSynchronizer::set_join_stream_budget(int p_objects) {
+	scene_synchronizer.set_join_stream_budget(p_objects);
+}
+
+int GdSceneSynchronizer::get_join_stream_budget() const {
+	return scene_synchronizer.get_join_stream_budget();
+}
+
+void GdSceneSynchronizer::set_spectator_mode(bool p_enabled) {
+	scene_synchronizer.set_spectator_mode(p_enabled);
+}
+
+bool GdSceneSynchronizer::is_spectator_mode() const {
+	return scene_synchronizer.is_spectator_mode();
+}
+
+void GdSceneSynchronizer::set_spectator_interpolation_delay(real_t p_delay) {
+	scene_synchronizer.set_spectator_interpolation_delay(p_delay);
+}
+
+real_t GdSceneSynchronizer::get_spectator_interpolation_delay() const {
+	return scene_synchronizer.get_spectator_interpolation_delay();
+}
+
 void GdSceneSynchronizer::set_comparison_float_tolerance(real_t p_tolerance) {
 	comparison_float_tolerance = p_tolerance;
 }
@@ -415,6 +574,31 @@ uint32_t GdSceneSynchronizer::register_node_gdscript(Node *p_node) {
 	return id.id;
 }
 
+void GdSceneSynchronizer::register_nodes(const Array &p_nodes) {
+	std::vector<NS::ObjectHandle> handles;
+	handles.reserve(p_nodes.size());
+	for (int i = 0; i < p_nodes.size(); i++) {
+		Node *node = Object::cast_to<Node>(p_nodes[i]);
+		ERR_CONTINUE_MSG(node == nullptr, "The array must contain only nodes.");
+		handles.push_back(scene_synchronizer.to_handle(node));
+	}
+	scene_synchronizer.register_app_objects(handles);
+}
+
+uint32_t GdSceneSynchronizer::register_physics_body(RigidBody3D *p_body) {
+	ERR_FAIL_NULL_V(p_body, NS::ObjectLocalId::NONE.id);
+
+	const NS::ObjectLocalId id = register_node(p_body);
+	ERR_FAIL_COND_V(id == NS::ObjectLocalId::NONE, NS::ObjectLocalId::NONE.id);
+
+	PhysicsBodySync body;
+	body.rid = p_body->get_rid();
+	physics_bodies.insert(p_body, body);
+
+	scene_synchronizer.register_variables(id, { { SNAME("global_transform"), false }, { SNAME("linear_velocity"), false }, { SNAME("angular_velocity"), false } });
+	return id.id;
+}
+
 void GdSceneSynchronizer::unregister_node(Node *p_node) {
 	scene_synchronizer.unregister_app_object(scene_synchronizer.find_object_local_id(scene_synchronizer.to_handle(p_node)));
 }
@@ -489,6 +673,56 @@ uint64_t GdSceneSynchronizer::track_variable_changes(
 	return static_cast<uint64_t>(raw_handle.id);
 }
 
+uint64_t GdSceneSynchronizer::track_variable_changes_batched(
+		Array p_nodes,
+		Array p_vars,
+		const Callable &p_callable,
+		NetEventFlag p_flags) {
+	ERR_FAIL_COND_V(p_nodes.size() != p_vars.size(), 0);
+	ERR_FAIL_COND_V(p_nodes.size() == 0, 0);
+
+	std::vector<NS::ObjectLocalId> objects_ids;
+	std::vector<StringName> var_names;
+
+	for (int i = 0; i < int(p_nodes.size()); i++) {
+		Object *obj = p_nodes[i];
+		Node *node = dynamic_cast<Node *>(obj);
+		NS::ObjectLocalId lid = scene_synchronizer.find_object_local_id(scene_synchronizer.to_handle(node));
+		objects_ids.push_back(lid);
+		var_names.push_back(p_vars[i]);
+	}
+
+	NS::ListenerHandle raw_handle =
+			scene_synchronizer.track_variables_changes_batched(
+					objects_ids,
+					var_names,
+					[p_callable](const std::vector<NS::VarChange> &p_changes) {
+						PackedInt32Array object_ids;
+						PackedInt32Array var_ids;
+						Array old_values;
+						Array new_values;
+						object_ids.resize(p_changes.size());
+						var_ids.resize(p_changes.size());
+						old_values.resize(p_changes.size());
+						new_values.resize(p_changes.size());
+						for (int i = 0; i < int(p_changes.size()); i++) {
+							object_ids.set(i, p_changes[i].object_id.id);
+							var_ids.set(i, p_changes[i].var_id.id);
+							old_values[i] = p_changes[i].old_value;
+							new_values[i] = p_changes[i].new_value;
+						}
+						Array arguments;
+						arguments.push_back(object_ids);
+						arguments.push_back(var_ids);
+						arguments.push_back(old_values);
+						arguments.push_back(new_values);
+						p_callable.callv(arguments);
+					},
+					p_flags);
+
+	return static_cast<uint64_t>(raw_handle.id);
+}
+
 void GdSceneSynchronizer::untrack_variable_changes(uint64_t p_handle) {
 	scene_synchronizer.untrack_variable_changes({ static_cast<std::intptr_t>(p_handle) });
 }
@@ -517,6 +751,50 @@ void GdSceneSynchronizer::setup_deferred_sync(Node *p_node, const Callable &p_co
 	scene_synchronizer.setup_deferred_sync(scene_synchronizer.find_object_local_id(scene_synchronizer.to_handle(p_node)), p_collect_epoch_func, p_apply_epoch_func);
 }
 
+void GdSceneSynchronizer::set_deferred_max_extrapolation(Node *p_node, real_t p_max_intervals) {
+	scene_synchronizer.set_deferred_max_extrapolation(scene_synchronizer.find_object_local_id(scene_synchronizer.to_handle(p_node)), p_max_intervals);
+}
+
+real_t GdSceneSynchronizer::get_deferred_max_extrapolation(Node *p_node) {
+	return scene_synchronizer.get_deferred_max_extrapolation(scene_synchronizer.find_object_local_id(scene_synchronizer.to_handle(p_node)));
+}
+
+void GdSceneSynchronizer::set_sleep_idle_ticks(Node *p_node, uint32_t p_idle_ticks) {
+	scene_synchronizer.set_sleep_idle_ticks(scene_synchronizer.find_object_local_id(scene_synchronizer.to_handle(p_node)), p_idle_ticks);
+}
+
+uint32_t GdSceneSynchronizer::get_sleep_idle_ticks(Node *p_node) {
+	return scene_synchronizer.get_sleep_idle_ticks(scene_synchronizer.find_object_local_id(scene_synchronizer.to_handle(p_node)));
+}
+
+bool GdSceneSynchronizer::is_node_sleeping(Node *p_node) {
+	return scene_synchronizer.is_sleeping(scene_synchronizer.find_object_local_id(scene_synchronizer.to_handle(p_node)));
+}
+
+void GdSceneSynchronizer::wake_up(Node *p_node) {
+	scene_synchronizer.wake_up(scene_synchronizer.find_object_local_id(scene_synchronizer.to_handle(p_node)));
+}
+
+void GdSceneSynchronizer::set_process_rate_divisor(Node *p_node, uint32_t p_divisor) {
+	scene_synchronizer.set_process_rate_divisor(scene_synchronizer.find_object_local_id(scene_synchronizer.to_handle(p_node)), p_divisor);
+}
+
+uint32_t GdSceneSynchronizer::get_process_rate_divisor(Node *p_node) {
+	return scene_synchronizer.get_process_rate_divisor(scene_synchronizer.find_object_local_id(scene_synchronizer.to_handle(p_node)));
+}
+
+void GdSceneSynchronizer::add_wake_trigger(Node *p_node, Node *p_trigger_node) {
+	scene_synchronizer.add_wake_trigger(
+			scene_synchronizer.find_object_local_id(scene_synchronizer.to_handle(p_node)),
+			scene_synchronizer.find_object_local_id(scene_synchronizer.to_handle(p_trigger_node)));
+}
+
+void GdSceneSynchronizer::remove_wake_trigger(Node *p_node, Node *p_trigger_node) {
+	scene_synchronizer.remove_wake_trigger(
+			scene_synchronizer.find_object_local_id(scene_synchronizer.to_handle(p_node)),
+			scene_synchronizer.find_object_local_id(scene_synchronizer.to_handle(p_trigger_node)));
+}
+
 SyncGroupId GdSceneSynchronizer::sync_group_create() {
 	return scene_synchronizer.sync_group_create();
 }
@@ -545,6 +823,37 @@ void GdSceneSynchronizer::sync_group_replace_nodes(SyncGroupId p_group_id, Local
 	scene_synchronizer.sync_group_replace_nodes(p_group_id, std::move(p_new_realtime_nodes), std::move(p_new_deferred_nodes));
 }
 
+void GdSceneSynchronizer::sync_group_remove_nodes_by_id(const PackedInt32Array &p_net_ids, SyncGroupId p_group_id) {
+	LocalVector<NS::ObjectNetId> ids;
+	ids.resize(p_net_ids.size());
+	for (int i = 0; i < p_net_ids.size(); i++) {
+		ids[i] = NS::ObjectNetId{ uint32_t(p_net_ids[i]) };
+	}
+	scene_synchronizer.sync_group_remove_nodes_by_id(p_group_id, ids);
+}
+
+void GdSceneSynchronizer::sync_group_replace_nodes_by_id(SyncGroupId p_group_id, const PackedInt32Array &p_realtime_net_ids, const PackedInt32Array &p_deferred_net_ids, const PackedFloat32Array &p_deferred_update_rates) {
+	LocalVector<NS::ObjectNetId> realtime_ids;
+	realtime_ids.resize(p_realtime_net_ids.size());
+	for (int i = 0; i < p_realtime_net_ids.size(); i++) {
+		realtime_ids[i] = NS::ObjectNetId{ uint32_t(p_realtime_net_ids[i]) };
+	}
+
+	LocalVector<NS::ObjectNetId> deferred_ids;
+	deferred_ids.resize(p_deferred_net_ids.size());
+	for (int i = 0; i < p_deferred_net_ids.size(); i++) {
+		deferred_ids[i] = NS::ObjectNetId{ uint32_t(p_deferred_net_ids[i]) };
+	}
+
+	LocalVector<real_t> update_rates;
+	update_rates.resize(p_deferred_update_rates.size());
+	for (int i = 0; i < p_deferred_update_rates.size(); i++) {
+		update_rates[i] = p_deferred_update_rates[i];
+	}
+
+	scene_synchronizer.sync_group_replace_nodes_by_id(p_group_id, realtime_ids, deferred_ids, update_rates);
+}
+
 void GdSceneSynchronizer::sync_group_remove_all_nodes(SyncGroupId p_group_id) {
 	scene_synchronizer.sync_group_remove_all_nodes(p_group_id);
 }
@@ -577,6 +886,31 @@ real_t GdSceneSynchronizer::sync_group_get_deferred_update_rate(const NS::Object
 	return scene_synchronizer.sync_group_get_deferred_update_rate(p_object_data->get_local_id(), p_group_id);
 }
 
+void GdSceneSynchronizer::sync_group_set_lod_policy(SyncGroupId p_group_id, const Dictionary &p_policy) {
+	NS::LodPolicy policy;
+	policy.thresholds[NS::LOD_TIER_REALTIME] = p_policy.get("realtime_threshold", policy.thresholds[NS::LOD_TIER_REALTIME]);
+	policy.thresholds[NS::LOD_TIER_DEFERRED_HIGH] = p_policy.get("deferred_high_threshold", policy.thresholds[NS::LOD_TIER_DEFERRED_HIGH]);
+	policy.thresholds[NS::LOD_TIER_DEFERRED_LOW] = p_policy.get("deferred_low_threshold", policy.thresholds[NS::LOD_TIER_DEFERRED_LOW]);
+	policy.hysteresis = p_policy.get("hysteresis", policy.hysteresis);
+	policy.deferred_high_update_rate = p_policy.get("deferred_high_update_rate", policy.deferred_high_update_rate);
+	policy.deferred_low_update_rate = p_policy.get("deferred_low_update_rate", policy.deferred_low_update_rate);
+	policy.max_realtime_nodes = int64_t(p_policy.get("max_realtime_nodes", policy.max_realtime_nodes));
+	policy.max_deferred_update_rate = p_policy.get("max_deferred_update_rate", policy.max_deferred_update_rate);
+	scene_synchronizer.sync_group_set_lod_policy(p_group_id, policy);
+}
+
+void GdSceneSynchronizer::sync_group_set_lod_metric_by_id(uint32_t p_net_id, SyncGroupId p_group_id, real_t p_metric) {
+	scene_synchronizer.sync_group_set_lod_metric(NS::ObjectNetId{ p_net_id }, p_group_id, p_metric);
+}
+
+int GdSceneSynchronizer::sync_group_get_lod_tier_by_id(uint32_t p_net_id, SyncGroupId p_group_id) const {
+	return scene_synchronizer.sync_group_get_lod_tier(NS::ObjectNetId{ p_net_id }, p_group_id);
+}
+
+void GdSceneSynchronizer::sync_group_update_lod(SyncGroupId p_group_id) {
+	scene_synchronizer.sync_group_update_lod(p_group_id);
+}
+
 void GdSceneSynchronizer::sync_group_set_user_data(SyncGroupId p_group_id, uint64_t p_user_data) {
 	scene_synchronizer.sync_group_set_user_data(p_group_id, p_user_data);
 }
@@ -593,8 +927,10 @@ void GdSceneSynchronizer::stop_tracking_scene_changes(Object *p_diff_handle) con
 	scene_synchronizer.stop_tracking_scene_changes(p_diff_handle);
 }
 
-Variant GdSceneSynchronizer::pop_scene_changes(Object *p_diff_handle) const {
-	return scene_synchronizer.pop_scene_changes(p_diff_handle);
+bool GdSceneSynchronizer::pop_scene_changes(Object *p_diff_handle, Object *p_sync_data) const {
+	DataBuffer *db = Object::cast_to<DataBuffer>(p_sync_data);
+	ERR_FAIL_COND_V_MSG(db == nullptr, false, "The `sync_data` is not a DataBuffer.");
+	return scene_synchronizer.pop_scene_changes(p_diff_handle, *db);
 }
 
 void GdSceneSynchronizer::apply_scene_changes(Object *p_sync_data) {
@@ -620,6 +956,54 @@ bool GdSceneSynchronizer::is_end_sync() const {
 	return scene_synchronizer.is_end_sync();
 }
 
+void GdSceneSynchronizer::set_rewind_profiler_enabled(bool p_enabled) {
+	scene_synchronizer.set_rewind_profiler_enabled(p_enabled);
+}
+
+bool GdSceneSynchronizer::is_rewind_profiler_enabled() const {
+	return scene_synchronizer.is_rewind_profiler_enabled();
+}
+
+void GdSceneSynchronizer::reset_rewind_profiler() {
+	scene_synchronizer.get_rewind_profiler().reset();
+}
+
+static Dictionary rewind_histogram_to_dictionary(const NS::RewindHistogram &p_histogram) {
+	Dictionary d;
+	d["count"] = p_histogram.count;
+	d["average"] = p_histogram.get_average();
+	d["max"] = p_histogram.max;
+	d["p50"] = p_histogram.get_percentile(0.5);
+	d["p95"] = p_histogram.get_percentile(0.95);
+	d["p99"] = p_histogram.get_percentile(0.99);
+	return d;
+}
+
+Dictionary GdSceneSynchronizer::get_rewind_profiler_report() const {
+	const NS::RewindProfiler &profiler = scene_synchronizer.get_rewind_profiler();
+
+	Dictionary report;
+	report["rewinds_count"] = profiler.get_rewinds_count();
+	report["depth_frames"] = rewind_histogram_to_dictionary(profiler.get_depth_frames());
+	report["sync_usec"] = rewind_histogram_to_dictionary(profiler.get_sync_usec());
+	report["rewind_usec"] = rewind_histogram_to_dictionary(profiler.get_rewind_usec());
+	report["divergence"] = rewind_histogram_to_dictionary(profiler.get_divergence());
+
+	Array triggers;
+	for (const NS::RewindTriggerStats &stats : profiler.get_triggers()) {
+		Dictionary t;
+		t["object_name"] = String(stats.object_name.c_str());
+		t["var_name"] = String(stats.var_name.c_str());
+		t["rewinds_count"] = stats.rewinds_count;
+		t["frames_count"] = stats.frames_count;
+		t["rewinds_usec"] = stats.rewinds_usec;
+		t["divergence"] = rewind_histogram_to_dictionary(stats.divergence);
+		triggers.push_back(t);
+	}
+	report["triggers"] = triggers;
+	return report;
+}
+
 void GdSceneSynchronizer::force_state_notify(SyncGroupId p_sync_group_id) {
 	scene_synchronizer.force_state_notify(p_sync_group_id);
 }
@@ -648,6 +1032,10 @@ bool GdSceneSynchronizer::is_client() const {
 	return scene_synchronizer.is_client();
 }
 
+bool GdSceneSynchronizer::is_spectator() const {
+	return scene_synchronizer.is_spectator();
+}
+
 bool GdSceneSynchronizer::is_no_network() const {
 	return scene_synchronizer.is_no_network();
 }
@@ -655,3 +1043,7 @@ bool GdSceneSynchronizer::is_no_network() const {
 bool GdSceneSynchronizer::is_networked() const {
 	return scene_synchronizer.is_networked();
 }
+
+bool GdSceneSynchronizer::is_join_streaming() const {
+	return scene_synchronizer.is_join_streaming();
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "core/object/object.h"
+#include "core/templates/hash_map.h"
 #include "modules/network_synchronizer/core/processor.h"
 #include "modules/network_synchronizer/core/var_data.h"
 #include "modules/network_synchronizer/data_buffer.h"
@@ -11,9 +12,19 @@
 #include "modules/network_synchronizer/core/core.h"
 #include "modules/network_synchronizer/net_utilities.h"
 
+class RigidBody3D;
+
 class GdSceneSynchronizer : public Node, public NS::SynchronizerManager {
 	GDCLASS(GdSceneSynchronizer, Node);
 
+	/// A body registered with `register_physics_body`: its transform and
+	/// velocities are read and written through the physics server.
+	struct PhysicsBodySync {
+		RID rid;
+	};
+
+	HashMap<const Node *, PhysicsBodySync> physics_bodies;
+
 public:
 	static void _bind_methods();
 
@@ -44,9 +55,24 @@ public: // ---------------------------------------------------------- Properties
 	void set_max_deferred_nodes_per_update(int p_rate);
 	int get_max_deferred_nodes_per_update() const;
 
+	void set_deferred_sync_delta_enabled(bool p_enabled);
+	bool is_deferred_sync_delta_enabled() const;
+
+	void set_deferred_sync_keyframe_interval(int p_interval);
+	int get_deferred_sync_keyframe_interval() const;
+
 	void set_server_notify_state_interval(real_t p_interval);
 	real_t get_server_notify_state_interval() const;
 
+	void set_join_stream_budget(int p_objects);
+	int get_join_stream_budget() const;
+
+	void set_spectator_mode(bool p_enabled);
+	bool is_spectator_mode() const;
+
+	void set_spectator_interpolation_delay(real_t p_delay);
+	real_t get_spectator_interpolation_delay() const;
+
 	void set_comparison_float_tolerance(real_t p_tolerance);
 	real_t get_comparison_float_tolerance() const;
 
@@ -60,6 +86,7 @@ public: // ---------------------------------------- Scene Synchronizer Interface
 	virtual void debug_only_validate_nodes() override;
 
 	virtual void on_add_object_data(NS::ObjectData &p_object_data) override;
+	virtual void on_drop_object_data(NS::ObjectData &p_object_data) override;
 
 	virtual void update_nodes_relevancy() override;
 
@@ -69,6 +96,8 @@ public: // ---------------------------------------- Scene Synchronizer Interface
 	virtual void setup_synchronizer_for(NS::ObjectHandle p_app_object_handle, NS::ObjectLocalId p_id) override;
 	virtual void set_variable(NS::ObjectHandle p_app_object_handle, const char *p_name, const Variant &p_val) override;
 	virtual bool get_variable(NS::ObjectHandle p_app_object_handle, const char *p_name, Variant &p_val) const override;
+	virtual bool get_variables(NS::ObjectHandle p_app_object_handle, const NS::VarLayout &p_layout, std::vector<Variant> &r_values) const override;
+	virtual bool set_variables(NS::ObjectHandle p_app_object_handle, const NS::VarLayout &p_layout, const std::vector<bool> &p_var_mask, const std::vector<Variant> &p_values) override;
 
 	virtual NS::NetworkedControllerBase *extract_network_controller(NS::ObjectHandle p_app_object_handle) override;
 	virtual const NS::NetworkedControllerBase *extract_network_controller(NS::ObjectHandle p_app_object_handle) const override;
@@ -86,6 +115,11 @@ public: // ---------------------------------------------------------------- APIs
 	/// Register a new node and returns its `NodeData`.
 	NS::ObjectLocalId register_node(Node *p_node);
 	uint32_t register_node_gdscript(Node *p_node);
+	void register_nodes(const Array &p_nodes);
+	/// Registers the body with its `global_transform`, `linear_velocity` and
+	/// `angular_velocity`, which are read and written directly through the
+	/// `PhysicsServer3D`, rather than through the node properties.
+	uint32_t register_physics_body(RigidBody3D *p_body);
 	void unregister_node(Node *p_node);
 
 	/// Returns the node ID.
@@ -109,6 +143,8 @@ public: // ---------------------------------------------------------------- APIs
 	void set_skip_rewinding(Node *p_node, const StringName &p_variable, bool p_skip_rewinding);
 
 	uint64_t track_variable_changes(Array p_nodes, Array p_vars, const Callable &p_callable, NetEventFlag p_flags = NetEventFlag::DEFAULT);
+	/// The callable receives the changes of each flush with a single call.
+	uint64_t track_variable_changes_batched(Array p_nodes, Array p_vars, const Callable &p_callable, NetEventFlag p_flags = NetEventFlag::DEFAULT);
 	void untrack_variable_changes(uint64_t p_handle);
 
 	/// You can use the macro `callable_mp()` to register custom C++ function.
@@ -119,6 +155,18 @@ public: // ---------------------------------------------------------------- APIs
 	/// The deferred-sync is different from the realtime-sync because the data
 	/// is streamed and not simulated.
 	void setup_deferred_sync(Node *p_node, const Callable &p_collect_epoch_func, const Callable &p_apply_epoch_func);
+	void set_deferred_max_extrapolation(Node *p_node, real_t p_max_intervals);
+	real_t get_deferred_max_extrapolation(Node *p_node);
+
+	void set_sleep_idle_ticks(Node *p_node, uint32_t p_idle_ticks);
+	uint32_t get_sleep_idle_ticks(Node *p_node);
+	bool is_node_sleeping(Node *p_node);
+	void wake_up(Node *p_node);
+	void set_process_rate_divisor(Node *p_node, uint32_t p_divisor);
+	uint32_t get_process_rate_divisor(Node *p_node);
+
+	void add_wake_trigger(Node *p_node, Node *p_trigger_node);
+	void remove_wake_trigger(Node *p_node, Node *p_trigger_node);
 
 	/// Creates a realtime sync group containing a list of nodes.
 	/// The Peers listening to this group will receive the updates only
@@ -133,6 +181,8 @@ public: // ---------------------------------------------------------------- APIs
 
 	/// Use `std::move()` to transfer `p_new_realtime_nodes` and `p_new_deferred_nodes`.
 	void sync_group_replace_nodes(SyncGroupId p_group_id, LocalVector<NS::SyncGroup::RealtimeNodeInfo> &&p_new_realtime_nodes, LocalVector<NS::SyncGroup::DeferredNodeInfo> &&p_new_deferred_nodes);
+	void sync_group_remove_nodes_by_id(const PackedInt32Array &p_net_ids, SyncGroupId p_group_id);
+	void sync_group_replace_nodes_by_id(SyncGroupId p_group_id, const PackedInt32Array &p_realtime_net_ids, const PackedInt32Array &p_deferred_net_ids, const PackedFloat32Array &p_deferred_update_rates);
 
 	void sync_group_remove_all_nodes(SyncGroupId p_group_id);
 	void sync_group_move_peer_to(int p_peer_id, SyncGroupId p_group_id);
@@ -144,12 +194,17 @@ public: // ---------------------------------------------------------------- APIs
 	real_t sync_group_get_deferred_update_rate_by_id(uint32_t p_node_id, SyncGroupId p_group_id) const;
 	real_t sync_group_get_deferred_update_rate(const NS::ObjectData *p_object_data, SyncGroupId p_group_id) const;
 
+	void sync_group_set_lod_policy(SyncGroupId p_group_id, const Dictionary &p_policy);
+	void sync_group_set_lod_metric_by_id(uint32_t p_node_id, SyncGroupId p_group_id, real_t p_metric);
+	int sync_group_get_lod_tier_by_id(uint32_t p_node_id, SyncGroupId p_group_id) const;
+	void sync_group_update_lod(SyncGroupId p_group_id);
+
 	void sync_group_set_user_data(SyncGroupId p_group_id, uint64_t p_user_ptr);
 	uint64_t sync_group_get_user_data(SyncGroupId p_group_id) const;
 
 	void start_tracking_scene_changes(Object *p_diff_handle) const;
 	void stop_tracking_scene_changes(Object *p_diff_handle) const;
-	Variant pop_scene_changes(Object *p_diff_handle) const;
+	bool pop_scene_changes(Object *p_diff_handle, Object *p_sync_data) const;
 	void apply_scene_changes(Object *p_sync_data);
 
 	bool is_recovered() const;
@@ -157,6 +212,12 @@ public: // ---------------------------------------------------------------- APIs
 	bool is_rewinding() const;
 	bool is_end_sync() const;
 
+	void set_rewind_profiler_enabled(bool p_enabled);
+	bool is_rewind_profiler_enabled() const;
+	void reset_rewind_profiler();
+	/// Returns the rewinds statistics: the triggers are sorted by cost.
+	Dictionary get_rewind_profiler_report() const;
+
 	void force_state_notify(SyncGroupId p_sync_group_id);
 	void force_state_notify_all();
 
@@ -169,10 +230,14 @@ public: // ---------------------------------------------------------------- APIs
 	bool is_server() const;
 	/// Returns true if this peer is client.
 	bool is_client() const;
+	/// Returns true if this peer is a spectator client.
+	bool is_spectator() const;
 	/// Returns true if there is no network.
 	bool is_no_network() const;
 	/// Returns true if network is enabled.
 	bool is_networked() const;
+	/// Returns true while the server streams the world to this client.
+	bool is_join_streaming() const;
 };
 
 VARIANT_ENUM_CAST(NetEventFlag)
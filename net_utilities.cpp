@@ -34,6 +34,7 @@
 
 #include "net_utilities.h"
 #include "core/object_data.h"
+#include "data_buffer.h"
 
 // This was needed to optimize the godot stringify for byte arrays.. it was slowing down perfs.
 String NS::stringify_byte_array_fast(const Vector<uint8_t> &p_array) {
@@ -47,6 +48,245 @@ String NS::stringify_fast(const Variant &p_var) {
 	return p_var.get_type() == Variant::PACKED_BYTE_ARRAY ? stringify_byte_array_fast(p_var) : p_var.stringify();
 }
 
+// Returns the byte `p_index` of the data, masking out the bits past `p_bit_count`.
+static uint8_t read_masked_byte(const uint8_t *p_data, int p_bit_count, int p_index) {
+	const int remaining_bits = p_bit_count - (p_index * 8);
+	if (remaining_bits >= 8) {
+		return p_data[p_index];
+	}
+	return p_data[p_index] & uint8_t((1 << remaining_bits) - 1);
+}
+
+uint64_t NS::hash_bits(const uint8_t *p_data, int p_bit_count) {
+	// FNV-1a
+	uint64_t hash = 14695981039346656037ULL;
+	const int bytes_count = (p_bit_count + 7) / 8;
+	for (int i = 0; i < bytes_count; i++) {
+		hash ^= read_masked_byte(p_data, p_bit_count, i);
+		hash *= 1099511628211ULL;
+	}
+	return hash;
+}
+
+void NS::delta_encode_bits(const uint8_t *p_reference, const uint8_t *p_data, int p_bit_count, DataBuffer &r_delta) {
+	const int bytes_count = (p_bit_count + 7) / 8;
+	for (int i = 0; i < bytes_count; i++) {
+		const uint8_t x = read_masked_byte(p_reference, p_bit_count, i) ^ read_masked_byte(p_data, p_bit_count, i);
+		r_delta.add_bool(x != 0);
+		if (x != 0) {
+			r_delta.add_uint(x, DataBuffer::COMPRESSION_LEVEL_3);
+		}
+	}
+}
+
+int NS::delta_encoded_bits_size(const uint8_t *p_reference, const uint8_t *p_data, int p_bit_count) {
+	const int bytes_count = (p_bit_count + 7) / 8;
+	int size = bytes_count;
+	for (int i = 0; i < bytes_count; i++) {
+		if (read_masked_byte(p_reference, p_bit_count, i) != read_masked_byte(p_data, p_bit_count, i)) {
+			size += 8;
+		}
+	}
+	return size;
+}
+
+bool NS::delta_decode_bits(const uint8_t *p_reference, int p_bit_count, DataBuffer &p_delta, uint8_t *r_data) {
+	const int bytes_count = (p_bit_count + 7) / 8;
+	for (int i = 0; i < bytes_count; i++) {
+		if ((p_delta.size() - p_delta.get_bit_offset()) < 1) {
+			return false;
+		}
+		uint8_t x = 0;
+		if (p_delta.read_bool()) {
+			if ((p_delta.size() - p_delta.get_bit_offset()) < 8) {
+				return false;
+			}
+			x = p_delta.read_uint(DataBuffer::COMPRESSION_LEVEL_3);
+		}
+		r_data[i] = read_masked_byte(p_reference, p_bit_count, i) ^ x;
+	}
+	return true;
+}
+
+real_t NS::stagger_phase(uint32_t p_index) {
+	// The golden ratio sequence.
+	return Math::fmod(double(p_index) * 0.6180339887498949, 1.0);
+}
+
+void NS::ObjectResync::merge(const ObjectResync &p_other) {
+	if (vars.is_empty()) {
+		// Already requesting all the variables.
+		return;
+	}
+	if (p_other.vars.is_empty()) {
+		vars.clear();
+		return;
+	}
+	for (uint32_t i = 0; i < p_other.vars.size(); i++) {
+		if (vars.find(p_other.vars[i]) == -1) {
+			vars.push_back(p_other.vars[i]);
+		}
+	}
+}
+
+void NS::write_object_resync(const LocalVector<ObjectResync> &p_resync, DataBuffer &r_buffer) {
+	r_buffer.add_uint(p_resync.size(), DataBuffer::COMPRESSION_LEVEL_2);
+	for (uint32_t i = 0; i < p_resync.size(); i++) {
+		const ObjectResync &resync = p_resync[i];
+		r_buffer.add_uint(resync.net_id.id, DataBuffer::COMPRESSION_LEVEL_2);
+
+		// The var count, 0 meaning all the variables.
+		uint32_t vars_count = 0;
+		for (uint32_t v = 0; v < resync.vars.size(); v++) {
+			vars_count = MAX(vars_count, resync.vars[v].id + 1);
+		}
+		r_buffer.add_uint(vars_count, DataBuffer::COMPRESSION_LEVEL_3);
+		for (uint32_t v = 0; v < vars_count; v++) {
+			r_buffer.add_bool(resync.vars.find(VarId{ v }) != -1);
+		}
+	}
+}
+
+bool NS::read_object_resync(DataBuffer &p_buffer, LocalVector<ObjectResync> &r_resync) {
+	const uint32_t count = p_buffer.read_uint(DataBuffer::COMPRESSION_LEVEL_2);
+	if (p_buffer.is_buffer_failed()) {
+		return false;
+	}
+	for (uint32_t i = 0; i < count; i++) {
+		ObjectResync resync;
+		resync.net_id = ObjectNetId{ uint32_t(p_buffer.read_uint(DataBuffer::COMPRESSION_LEVEL_2)) };
+		const uint32_t vars_count = p_buffer.read_uint(DataBuffer::COMPRESSION_LEVEL_3);
+		if (p_buffer.is_buffer_failed()) {
+			return false;
+		}
+		for (uint32_t v = 0; v < vars_count; v++) {
+			if (p_buffer.read_bool()) {
+				resync.vars.push_back(VarId{ v });
+			}
+		}
+		if (p_buffer.is_buffer_failed()) {
+			return false;
+		}
+		merge_object_resync(r_resync, resync);
+	}
+	return true;
+}
+
+void NS::merge_object_resync(LocalVector<ObjectResync> &r_resync, const ObjectResync &p_resync) {
+	for (uint32_t i = 0; i < r_resync.size(); i++) {
+		if (r_resync[i].net_id == p_resync.net_id) {
+			r_resync[i].merge(p_resync);
+			return;
+		}
+	}
+	r_resync.push_back(p_resync);
+}
+
+void NS::ObjectResyncTracker::filter(LocalVector<ObjectResync> &r_resync, double p_now, double p_timeout) {
+	LocalVector<ObjectResync> to_request;
+	for (uint32_t i = 0; i < r_resync.size(); i++) {
+		auto it = requested.find(r_resync[i].net_id);
+		if (it == requested.end() || (p_now - it->second.at) >= p_timeout) {
+			Requested &r = requested[r_resync[i].net_id];
+			r.at = p_now;
+			r.resync = r_resync[i];
+			to_request.push_back(r_resync[i]);
+			continue;
+		}
+
+		// Already asked, the response is on its way: only the variables not
+		// asked yet are requested.
+		const ObjectResync &asked = it->second.resync;
+		if (asked.vars.is_empty()) {
+			continue;
+		}
+		ObjectResync follow_up;
+		follow_up.net_id = r_resync[i].net_id;
+		if (r_resync[i].vars.is_empty()) {
+			// All the variables are needed now: ask them all again.
+		} else {
+			for (uint32_t v = 0; v < r_resync[i].vars.size(); v++) {
+				if (asked.vars.find(r_resync[i].vars[v]) == -1) {
+					follow_up.vars.push_back(r_resync[i].vars[v]);
+				}
+			}
+			if (follow_up.vars.is_empty()) {
+				continue;
+			}
+		}
+		it->second.at = p_now;
+		it->second.resync.merge(follow_up);
+		to_request.push_back(follow_up);
+	}
+	r_resync = to_request;
+}
+
+void NS::ObjectResyncTracker::notify_received(ObjectNetId p_net_id) {
+	requested.erase(p_net_id);
+}
+
+bool NS::ObjectResyncTracker::is_requested(ObjectNetId p_net_id) const {
+	return requested.find(p_net_id) != requested.end();
+}
+
+void NS::ObjectResyncTracker::clear() {
+	requested.clear();
+}
+
+NS::PeerData *NS::PeerTable::find(int p_peer) {
+	const uint32_t *slot = slots.lookup_ptr(p_peer);
+	return slot == nullptr ? nullptr : &entries[*slot].data;
+}
+
+const NS::PeerData *NS::PeerTable::find(int p_peer) const {
+	const uint32_t *slot = slots.lookup_ptr(p_peer);
+	return slot == nullptr ? nullptr : &entries[*slot].data;
+}
+
+NS::PeerData &NS::PeerTable::insert(int p_peer) {
+	const uint32_t *slot = slots.lookup_ptr(p_peer);
+	if (slot != nullptr) {
+		return entries[*slot].data;
+	}
+	slots.insert(p_peer, entries.size());
+	entries.push_back(Entry());
+	entries[entries.size() - 1].peer = p_peer;
+	return entries[entries.size() - 1].data;
+}
+
+bool NS::PeerTable::remove(int p_peer) {
+	const uint32_t *slot_ptr = slots.lookup_ptr(p_peer);
+	if (slot_ptr == nullptr) {
+		return false;
+	}
+	const uint32_t slot = *slot_ptr;
+	const uint32_t last = entries.size() - 1;
+	if (slot != last) {
+		// Move the last entry into the freed slot, to keep the table dense.
+		entries[slot] = entries[last];
+		slots.set(entries[slot].peer, slot);
+	}
+	entries.resize(last);
+	slots.remove(p_peer);
+	return true;
+}
+
+void NS::PeerTable::clear() {
+	entries.clear();
+	slots.clear();
+}
+
+real_t NS::LodPolicy::get_update_rate(LodTier p_tier) const {
+	switch (p_tier) {
+		case LOD_TIER_DEFERRED_HIGH:
+			return deferred_high_update_rate;
+		case LOD_TIER_DEFERRED_LOW:
+			return deferred_low_update_rate;
+		default:
+			return 0.0;
+	}
+}
+
 bool NS::SyncGroup::is_realtime_node_list_changed() const {
 	return realtime_sync_nodes_list_changed;
 }
@@ -94,16 +334,7 @@ uint32_t NS::SyncGroup::add_new_node(ObjectData *p_object_data, bool p_realtime)
 
 		if (index <= -1) {
 			index = realtime_sync_nodes.size();
-			realtime_sync_nodes.push_back(p_object_data);
-			realtime_sync_nodes_list_changed = true;
-
-			RealtimeNodeInfo &info = realtime_sync_nodes[index];
-
-			info.change.unknown = true;
-
-			for (int i = 0; i < int(p_object_data->vars.size()); ++i) {
-				notify_new_variable(p_object_data, p_object_data->vars[i].var.name);
-			}
+			push_new_realtime_node(p_object_data);
 		}
 
 		return index;
@@ -120,16 +351,63 @@ uint32_t NS::SyncGroup::add_new_node(ObjectData *p_object_data, bool p_realtime)
 
 		if (index <= -1) {
 			index = deferred_sync_nodes.size();
-			deferred_sync_nodes.push_back(p_object_data);
-			deferred_sync_nodes[index]._unknown = true;
-			deferred_sync_nodes_list_changed = true;
+			push_new_deferred_node(p_object_data);
 		}
 
 		return index;
 	}
 }
 
+void NS::SyncGroup::add_new_realtime_nodes(const LocalVector<ObjectData *> &p_objects_data) {
+	notify_new_variables(p_objects_data);
+
+	OAHashMap<uint32_t, bool> known_nodes;
+	for (int i = 0; i < int(realtime_sync_nodes.size()); ++i) {
+		known_nodes.insert(realtime_sync_nodes[i].od->get_local_id().id, true);
+	}
+	for (int i = 0; i < int(deferred_sync_nodes.size()); ++i) {
+		known_nodes.insert(deferred_sync_nodes[i].od->get_local_id().id, true);
+	}
+
+	realtime_sync_nodes.reserve(realtime_sync_nodes.size() + p_objects_data.size());
+	for (ObjectData *od : p_objects_data) {
+		if (known_nodes.has(od->get_local_id().id)) {
+			continue;
+		}
+		known_nodes.insert(od->get_local_id().id, true);
+		push_new_realtime_node(od);
+	}
+}
+
+NS::SyncGroup::RealtimeNodeInfo &NS::SyncGroup::push_new_realtime_node(ObjectData *p_object_data) {
+	realtime_sync_nodes.push_back(p_object_data);
+	realtime_sync_nodes_list_changed = true;
+
+	RealtimeNodeInfo &info = realtime_sync_nodes[realtime_sync_nodes.size() - 1];
+	info.change.unknown = true;
+	for (int v = 0; v < int(p_object_data->vars.size()); ++v) {
+		info.change.vars.insert(p_object_data->get_var_layout().names[v]);
+		info.change.uknown_vars.insert(p_object_data->get_var_layout().names[v]);
+	}
+	return info;
+}
+
+NS::SyncGroup::DeferredNodeInfo &NS::SyncGroup::push_new_deferred_node(ObjectData *p_object_data) {
+	const uint32_t index = deferred_sync_nodes.size();
+	deferred_sync_nodes.push_back(p_object_data);
+	deferred_sync_nodes_list_changed = true;
+
+	DeferredNodeInfo &info = deferred_sync_nodes[index];
+	info._unknown = true;
+	// Start from a different priority, so the nodes with the same update rate
+	// are not all collected on the same tick.
+	info._update_priority = stagger_phase(index);
+	return info;
+}
+
 void NS::SyncGroup::remove_node(ObjectData *p_object_data) {
+	remove_lod_node(p_object_data);
+
 	{
 		const int index = realtime_sync_nodes.find(p_object_data);
 		if (index >= 0) {
@@ -149,64 +427,141 @@ void NS::SyncGroup::remove_node(ObjectData *p_object_data) {
 	}
 }
 
+/// Maps the `ObjectLocalId` of the nodes to their index into `p_nodes`,
+/// skipping the duplicates and the ones in `p_skip`.
+template <class T>
+void map_nodes_by_local_id(
+		const LocalVector<T> &p_nodes,
+		const OAHashMap<uint32_t, uint32_t> *p_skip,
+		OAHashMap<uint32_t, uint32_t> &r_map) {
+	for (uint32_t i = 0; i < p_nodes.size(); i++) {
+		const uint32_t id = p_nodes[i].od->get_local_id().id;
+#ifdef DEBUG_ENABLED
+		CRASH_COND_MSG(r_map.has(id), "The function `replace_nodes` must receive unique nodes on each array. Make sure not to add duplicates.");
+#endif
+		if (r_map.has(id) || (p_skip && p_skip->has(id))) {
+			continue;
+		}
+		r_map.insert(id, i);
+	}
+}
+
+/// Removes the nodes not in `p_new_nodes` and updates the others, marking
+/// these as consumed by removing them from `r_new_nodes_map`.
 template <class T>
-void replace_nodes_impl(
-		NS::SyncGroup &p_sync_group,
-		LocalVector<T> &&p_nodes_to_add,
-		bool p_is_realtime,
+void replace_nodes_keep_existing(
+		const LocalVector<T> &p_new_nodes,
+		OAHashMap<uint32_t, uint32_t> &r_new_nodes_map,
 		LocalVector<T> &r_sync_group_nodes,
 		bool &r_changed) {
 	for (int i = int(r_sync_group_nodes.size()) - 1; i >= 0; i--) {
-		const int64_t nta_index = p_nodes_to_add.find(r_sync_group_nodes[i].od);
-		if (nta_index == -1) {
+		const uint32_t id = r_sync_group_nodes[i].od->get_local_id().id;
+		const uint32_t *new_index = r_new_nodes_map.lookup_ptr(id);
+		if (new_index == nullptr) {
 			// This node is not part of this sync group, remove it.
 			r_sync_group_nodes.remove_at_unordered(i);
 			r_changed = true;
 		} else {
 			// This node is still part of this SyncGroup.
-			// Update the existing one.
-			r_sync_group_nodes[i].update_from(p_nodes_to_add[nta_index]);
-
-			// Then, make sure not to add again:
-			p_nodes_to_add.remove_at_unordered(nta_index);
+			// Update the existing one, and make sure not to add it again.
+			r_sync_group_nodes[i].update_from(p_new_nodes[*new_index]);
+			r_new_nodes_map.remove(id);
+		}
+	}
+}
 
-#ifdef DEBUG_ENABLED
-			// Make sure there are no duplicates:
-			CRASH_COND_MSG(p_nodes_to_add.find(r_sync_group_nodes[i].od) != -1, "The function `replace_nodes` must receive unique nodes on each array. Make sure not to add duplicates.");
-#endif
+void NS::SyncGroup::replace_nodes(LocalVector<RealtimeNodeInfo> &&p_new_realtime_nodes, LocalVector<DeferredNodeInfo> &&p_new_deferred_nodes) {
+	if (!lod_nodes.is_empty()) {
+		// The LOD stops managing the nodes removed from this group, or
+		// `update_lod` would add them back.
+		OAHashMap<uint32_t, bool> kept_nodes;
+		for (const RealtimeNodeInfo &info : p_new_realtime_nodes) {
+			kept_nodes.set(info.od->get_local_id().id, true);
+		}
+		for (const DeferredNodeInfo &info : p_new_deferred_nodes) {
+			kept_nodes.set(info.od->get_local_id().id, true);
+		}
+		for (int i = int(lod_nodes.size()) - 1; i >= 0; i--) {
+			if (!kept_nodes.has(lod_nodes[i].od->get_local_id().id)) {
+				remove_lod_node(lod_nodes[i].od);
+			}
 		}
 	}
 
-	// Add the missing nodes now.
-	for (int i = 0; i < int(p_nodes_to_add.size()); i++) {
-		NS::ObjectData *od = p_nodes_to_add[i].od;
+	replace_nodes_keep_lod(std::move(p_new_realtime_nodes), std::move(p_new_deferred_nodes));
+}
 
-#ifdef DEBUG_ENABLED
-		CRASH_COND_MSG(r_sync_group_nodes.find(od) != -1, "[FATAL] This is impossible to trigger, because the above loop cleaned this.");
-#endif
+void NS::SyncGroup::replace_nodes_keep_lod(LocalVector<RealtimeNodeInfo> &&p_new_realtime_nodes, LocalVector<DeferredNodeInfo> &&p_new_deferred_nodes) {
+	// The nodes are looked up by ID, so this takes a single pass over each
+	// array. When a node is in both arrays, it's deferred.
+	OAHashMap<uint32_t, uint32_t> new_deferred;
+	map_nodes_by_local_id(p_new_deferred_nodes, nullptr, new_deferred);
+	OAHashMap<uint32_t, uint32_t> new_realtime;
+	map_nodes_by_local_id(p_new_realtime_nodes, &new_deferred, new_realtime);
+
+	// First remove the nodes, so the ones changing array are not found in
+	// the other one when added.
+	replace_nodes_keep_existing(p_new_realtime_nodes, new_realtime, realtime_sync_nodes, realtime_sync_nodes_list_changed);
+	replace_nodes_keep_existing(p_new_deferred_nodes, new_deferred, deferred_sync_nodes, deferred_sync_nodes_list_changed);
+
+	// Add the missing nodes now, in the given order.
+	for (uint32_t i = 0; i < p_new_realtime_nodes.size(); i++) {
+		ObjectData *od = p_new_realtime_nodes[i].od;
+		const uint32_t *new_index = new_realtime.lookup_ptr(od->get_local_id().id);
+		if (new_index == nullptr || *new_index != i) {
+			// Already part of this group, or a duplicate.
+			continue;
+		}
 
-		const uint32_t index = p_sync_group.add_new_node(od, p_is_realtime);
-		r_sync_group_nodes[index].update_from(p_nodes_to_add[i]);
+		push_new_realtime_node(od).update_from(p_new_realtime_nodes[i]);
+	}
+
+	for (uint32_t i = 0; i < p_new_deferred_nodes.size(); i++) {
+		ObjectData *od = p_new_deferred_nodes[i].od;
+		const uint32_t *new_index = new_deferred.lookup_ptr(od->get_local_id().id);
+		if (new_index == nullptr || *new_index != i) {
+			// Already part of this group, or a duplicate.
+			continue;
+		}
+
+		push_new_deferred_node(od).update_from(p_new_deferred_nodes[i]);
 	}
 }
 
-void NS::SyncGroup::replace_nodes(LocalVector<RealtimeNodeInfo> &&p_new_realtime_nodes, LocalVector<DeferredNodeInfo> &&p_new_deferred_nodes) {
-	replace_nodes_impl(
-			*this,
-			std::move(p_new_realtime_nodes),
-			true,
-			realtime_sync_nodes,
-			realtime_sync_nodes_list_changed);
+void NS::SyncGroup::remove_nodes(const LocalVector<ObjectData *> &p_objects_data) {
+	OAHashMap<uint32_t, bool> removed_nodes;
+	for (ObjectData *od : p_objects_data) {
+		removed_nodes.set(od->get_local_id().id, true);
+		remove_lod_node(od);
+	}
 
-	replace_nodes_impl(
-			*this,
-			std::move(p_new_deferred_nodes),
-			false,
-			deferred_sync_nodes,
-			deferred_sync_nodes_list_changed);
+	for (int i = int(realtime_sync_nodes.size()) - 1; i >= 0; i--) {
+		if (removed_nodes.has(realtime_sync_nodes[i].od->get_local_id().id)) {
+			realtime_sync_nodes.remove_at_unordered(i);
+			realtime_sync_nodes_list_changed = true;
+		}
+	}
+
+	// Preserve the order of the deferred nodes, like `remove_node` does.
+	uint32_t kept = 0;
+	for (uint32_t i = 0; i < deferred_sync_nodes.size(); i++) {
+		if (removed_nodes.has(deferred_sync_nodes[i].od->get_local_id().id)) {
+			deferred_sync_nodes_list_changed = true;
+			continue;
+		}
+		if (kept != i) {
+			deferred_sync_nodes[kept] = std::move(deferred_sync_nodes[i]);
+		}
+		kept += 1;
+	}
+	deferred_sync_nodes.resize(kept);
 }
 
 void NS::SyncGroup::remove_all_nodes() {
+	// The LOD stops managing the removed nodes too.
+	lod_nodes.clear();
+	lod_nodes_index.clear();
+
 	if (!realtime_sync_nodes.is_empty()) {
 		realtime_sync_nodes.clear();
 		realtime_sync_nodes_list_changed = true;
@@ -218,6 +573,15 @@ void NS::SyncGroup::remove_all_nodes() {
 	}
 }
 
+bool NS::SyncGroup::notify_node_unknown(ObjectData *p_object_data) {
+	const int index = realtime_sync_nodes.find(p_object_data);
+	if (index >= 0) {
+		realtime_sync_nodes[index].change.unknown = true;
+		return true;
+	}
+	return false;
+}
+
 void NS::SyncGroup::notify_new_variable(ObjectData *p_object_data, const std::string &p_var_name) {
 	int index = realtime_sync_nodes.find(p_object_data);
 	if (index >= 0) {
@@ -226,6 +590,23 @@ void NS::SyncGroup::notify_new_variable(ObjectData *p_object_data, const std::st
 	}
 }
 
+void NS::SyncGroup::notify_new_variables(const LocalVector<ObjectData *> &p_objects_data) {
+	OAHashMap<uint32_t, bool> new_nodes;
+	for (ObjectData *od : p_objects_data) {
+		new_nodes.insert(od->get_local_id().id, true);
+	}
+
+	for (int i = 0; i < int(realtime_sync_nodes.size()); ++i) {
+		const ObjectData *od = realtime_sync_nodes[i].od;
+		if (new_nodes.has(od->get_local_id().id)) {
+			for (int v = 0; v < int(od->vars.size()); ++v) {
+				realtime_sync_nodes[i].change.vars.insert(od->get_var_layout().names[v]);
+				realtime_sync_nodes[i].change.uknown_vars.insert(od->get_var_layout().names[v]);
+			}
+		}
+	}
+}
+
 void NS::SyncGroup::notify_variable_changed(ObjectData *p_object_data, const std::string &p_var_name) {
 	int index = realtime_sync_nodes.find(p_object_data);
 	if (index >= 0) {
@@ -258,3 +639,188 @@ void NS::SyncGroup::sort_deferred_node_by_update_priority() {
 
 	deferred_sync_nodes.sort_custom<DNIComparator>();
 }
+
+void NS::SyncGroup::collect_join_backlog(ObjectNetId p_controller_id, LocalVector<ObjectNetId> &r_backlog) const {
+	struct JoinEntry {
+		ObjectNetId net_id;
+		int rank = 0;
+		real_t metric = 0.0;
+	};
+
+	struct JoinEntryComparator {
+		_FORCE_INLINE_ bool operator()(const JoinEntry &a, const JoinEntry &b) const {
+			return a.rank == b.rank ? a.metric < b.metric : a.rank < b.rank;
+		}
+	};
+
+	LocalVector<JoinEntry> entries;
+	auto add_entry = [&](const ObjectData *p_od, int p_rank) {
+		JoinEntry entry;
+		entry.net_id = p_od->get_net_id();
+		if (entry.net_id == p_controller_id) {
+			entry.rank = 0;
+		} else if (p_od->get_controller()) {
+			entry.rank = 1;
+		} else {
+			entry.rank = p_rank;
+		}
+		const uint32_t *index = lod_nodes_index.lookup_ptr(p_od->get_local_id().id);
+		if (index != nullptr) {
+			entry.metric = lod_nodes[*index].metric;
+		}
+		entries.push_back(entry);
+	};
+
+	for (const RealtimeNodeInfo &info : realtime_sync_nodes) {
+		add_entry(info.od, 2);
+	}
+	for (const DeferredNodeInfo &info : deferred_sync_nodes) {
+		add_entry(info.od, 3);
+	}
+
+	entries.sort_custom<JoinEntryComparator>();
+
+	r_backlog.clear();
+	for (const JoinEntry &entry : entries) {
+		r_backlog.push_back(entry.net_id);
+	}
+}
+
+void NS::SyncGroup::set_lod_metric(ObjectData *p_object_data, real_t p_metric) {
+	ERR_FAIL_COND(p_object_data == nullptr);
+	const uint32_t *index = lod_nodes_index.lookup_ptr(p_object_data->get_local_id().id);
+	if (index != nullptr) {
+		lod_nodes[*index].metric = p_metric;
+		return;
+	}
+
+	lod_nodes_index.insert(p_object_data->get_local_id().id, lod_nodes.size());
+	LodNodeInfo info;
+	info.od = p_object_data;
+	info.metric = p_metric;
+	lod_nodes.push_back(info);
+}
+
+NS::LodTier NS::SyncGroup::get_lod_tier(const ObjectData *p_object_data) const {
+	ERR_FAIL_COND_V(p_object_data == nullptr, LOD_TIER_COUNT);
+	const uint32_t *index = lod_nodes_index.lookup_ptr(p_object_data->get_local_id().id);
+	return index == nullptr ? LOD_TIER_COUNT : lod_nodes[*index].tier;
+}
+
+const LocalVector<NS::SyncGroup::LodNodeInfo> &NS::SyncGroup::get_lod_nodes() const {
+	return lod_nodes;
+}
+
+void NS::SyncGroup::remove_lod_node(ObjectData *p_object_data) {
+	const uint32_t *index_ptr = lod_nodes_index.lookup_ptr(p_object_data->get_local_id().id);
+	if (index_ptr == nullptr) {
+		return;
+	}
+	const uint32_t index = *index_ptr;
+	lod_nodes_index.remove(p_object_data->get_local_id().id);
+	if (index != lod_nodes.size() - 1) {
+		lod_nodes[index] = lod_nodes[lod_nodes.size() - 1];
+		lod_nodes_index.set(lod_nodes[index].od->get_local_id().id, index);
+	}
+	lod_nodes.resize(lod_nodes.size() - 1);
+}
+
+NS::LodTier NS::SyncGroup::compute_lod_tier(const LodNodeInfo &p_info) const {
+	int tier = LOD_TIER_REALTIME;
+	for (int i = 0; i < LOD_TIER_CULLED; i++) {
+		real_t threshold = lod_policy.thresholds[i];
+		if (p_info.assigned) {
+			// Moving away from the current tier requires crossing the margin.
+			threshold += int(p_info.tier) <= i ? lod_policy.hysteresis : -lod_policy.hysteresis;
+		}
+		if (p_info.metric > threshold) {
+			tier = i + 1;
+		}
+	}
+	return LodTier(tier);
+}
+
+bool NS::SyncGroup::update_lod() {
+	if (lod_nodes.is_empty()) {
+		return false;
+	}
+
+	// The nodes with the lowest metric get the budget first.
+	struct LodOrder {
+		real_t metric;
+		uint32_t index;
+	};
+	struct LodOrderComparator {
+		_FORCE_INLINE_ bool operator()(const LodOrder &a, const LodOrder &b) const {
+			return a.metric < b.metric;
+		}
+	};
+	LocalVector<LodOrder> order;
+	order.resize(lod_nodes.size());
+	for (uint32_t i = 0; i < lod_nodes.size(); i++) {
+		order[i] = { lod_nodes[i].metric, i };
+	}
+	order.sort_custom<LodOrderComparator>();
+
+	LocalVector<LodTier> new_tiers;
+	new_tiers.resize(lod_nodes.size());
+	bool changed = false;
+	uint32_t realtime_count = 0;
+	real_t deferred_update_rate = 0.0;
+	for (uint32_t i = 0; i < order.size(); i++) {
+		const LodNodeInfo &info = lod_nodes[order[i].index];
+		LodTier tier = compute_lod_tier(info);
+
+		if (tier == LOD_TIER_REALTIME && realtime_count >= lod_policy.max_realtime_nodes) {
+			tier = LOD_TIER_DEFERRED_HIGH;
+		}
+		if (tier == LOD_TIER_DEFERRED_HIGH && deferred_update_rate + lod_policy.deferred_high_update_rate > lod_policy.max_deferred_update_rate) {
+			tier = LOD_TIER_DEFERRED_LOW;
+		}
+		if (tier == LOD_TIER_DEFERRED_LOW && deferred_update_rate + lod_policy.deferred_low_update_rate > lod_policy.max_deferred_update_rate) {
+			tier = LOD_TIER_CULLED;
+		}
+
+		if (tier == LOD_TIER_REALTIME) {
+			realtime_count += 1;
+		}
+		deferred_update_rate += lod_policy.get_update_rate(tier);
+
+		new_tiers[order[i].index] = tier;
+		changed = changed || !info.assigned || tier != info.tier;
+	}
+
+	if (!changed) {
+		return false;
+	}
+
+	// Keep the nodes not managed by the LOD as they are.
+	LocalVector<RealtimeNodeInfo> new_realtime_nodes;
+	LocalVector<DeferredNodeInfo> new_deferred_nodes;
+	for (uint32_t i = 0; i < realtime_sync_nodes.size(); i++) {
+		if (!lod_nodes_index.has(realtime_sync_nodes[i].od->get_local_id().id)) {
+			new_realtime_nodes.push_back(realtime_sync_nodes[i]);
+		}
+	}
+	for (uint32_t i = 0; i < deferred_sync_nodes.size(); i++) {
+		if (!lod_nodes_index.has(deferred_sync_nodes[i].od->get_local_id().id)) {
+			new_deferred_nodes.push_back(deferred_sync_nodes[i]);
+		}
+	}
+
+	for (uint32_t i = 0; i < lod_nodes.size(); i++) {
+		LodNodeInfo &info = lod_nodes[i];
+		info.tier = new_tiers[i];
+		info.assigned = true;
+		if (info.tier == LOD_TIER_REALTIME) {
+			new_realtime_nodes.push_back(RealtimeNodeInfo(info.od));
+		} else if (info.tier != LOD_TIER_CULLED) {
+			DeferredNodeInfo deferred(info.od);
+			deferred.update_rate = lod_policy.get_update_rate(info.tier);
+			new_deferred_nodes.push_back(deferred);
+		}
+	}
+
+	replace_nodes_keep_lod(std::move(new_realtime_nodes), std::move(new_deferred_nodes));
+	return true;
+}
@@ -5,25 +5,20 @@
 #include "core/math/math_funcs.h"
 #include "core/processor.h"
 #include "core/templates/local_vector.h"
+#include "core/templates/oa_hash_map.h"
+#include <cfloat>
 #include <map>
-#include <stdexcept>
 #include <string>
 #include <vector>
 
 typedef uint32_t SyncGroupId;
 
+class DataBuffer;
+
 #ifdef DEBUG_ENABLED
-#define NET_DEBUG_PRINT(msg)                                                                                  \
-	if (ProjectSettings::get_singleton()->get_setting("NetworkSynchronizer/log_debug_warnings_and_messages")) \
-	print_line(String("[Net] ") + msg)
-#define NET_DEBUG_WARN(msg)                                                                                   \
-	if (ProjectSettings::get_singleton()->get_setting("NetworkSynchronizer/log_debug_warnings_and_messages")) \
-	WARN_PRINT(String("[Net] ") + msg)
 #define NET_DEBUG_ERR(msg) \
 	ERR_PRINT(String("[Net] ") + msg)
 #else
-#define NET_DEBUG_PRINT(msg)
-#define NET_DEBUG_WARN(msg)
 #define NET_DEBUG_ERR(msg)
 #endif
 
@@ -35,20 +30,14 @@ namespace MapFunc {
 
 template <class K, class V>
 V *at(std::map<K, V> &p_map, const K &p_key) {
-	try {
-		return &p_map.at(p_key);
-	} catch (std::out_of_range &e) {
-		return nullptr;
-	}
+	auto it = p_map.find(p_key);
+	return it == p_map.end() ? nullptr : &it->second;
 }
 
 template <class K, class V>
 const V *at(const std::map<K, V> &p_map, const K &p_key) {
-	try {
-		return &p_map.at(p_key);
-	} catch (std::out_of_range &e) {
-		return nullptr;
-	}
+	auto it = p_map.find(p_key);
+	return it == p_map.end() ? nullptr : &it->second;
 }
 }; //namespace MapFunc
 
@@ -62,15 +51,27 @@ struct ListeningVariable {
 	bool old_set = false;
 };
 
+/// A variable changed during the tracked phase, passed to the batched listeners.
+struct VarChange {
+	ObjectLocalId object_id = ObjectLocalId::NONE;
+	VarId var_id = VarId::NONE;
+	Variant old_value;
+	Variant new_value;
+};
+
 /// This can track the changes of many nodes and variables. It's dispatched
 /// if one or more tracked variable change during the tracked phase, specified
 /// by the `NetEventFlag`.
 struct ChangesListener {
 	std::function<void(const std::vector<Variant> &p_old_vars)> listener_func;
+	/// When set, this is called in place of `listener_func` once per flush,
+	/// with only the variables that changed.
+	std::function<void(const std::vector<VarChange> &p_changes)> batched_listener_func;
 	NetEventFlag flag;
 
 	std::vector<ListeningVariable> watching_vars;
 	std::vector<Variant> old_values;
+	std::vector<VarChange> changes;
 	bool emitted = true;
 };
 
@@ -114,6 +115,22 @@ inline static const ListenerHandle nulllistenerhandle = { 0 };
 String stringify_byte_array_fast(const Vector<uint8_t> &p_array);
 String stringify_fast(const Variant &p_var);
 
+/// Returns the hash of the first `p_bit_count` bits of `p_data`.
+uint64_t hash_bits(const uint8_t *p_data, int p_bit_count);
+
+/// Encodes `p_data` against `p_reference`, both of `p_bit_count` bits: for
+/// each byte a bit tells if it changed, followed by the XOR of the two bytes.
+void delta_encode_bits(const uint8_t *p_reference, const uint8_t *p_data, int p_bit_count, DataBuffer &r_delta);
+/// Returns the amount of bits written by `delta_encode_bits`.
+int delta_encoded_bits_size(const uint8_t *p_reference, const uint8_t *p_data, int p_bit_count);
+/// Decodes the `delta_encode_bits` data into `r_data`, which must have room
+/// for `p_bit_count` bits. Returns false if the delta is malformed.
+bool delta_decode_bits(const uint8_t *p_reference, int p_bit_count, DataBuffer &p_delta, uint8_t *r_data);
+
+/// Returns the phase, within 0 and 1, of the `p_index`-th element: any amount
+/// of consecutive indices is spread evenly, so they don't fire on the same tick.
+real_t stagger_phase(uint32_t p_index);
+
 template <class T>
 class StatisticalRingBuffer {
 	LocalVector<T> data;
@@ -282,18 +299,134 @@ void StatisticalRingBuffer<T>::force_recompute_avg_sum() {
 	}
 }
 
+/// What a client is missing about an object. Rather than a full snapshot,
+/// the server adds the object name and these variables to the next snapshot.
+struct ObjectResync {
+	ObjectNetId net_id = ObjectNetId::NONE;
+	/// When empty, all the variables are requested.
+	LocalVector<VarId> vars;
+
+	/// Merges the other request for the same object.
+	void merge(const ObjectResync &p_other);
+};
+
+/// Writes the resync requests: for each object the `NetId`, and a bitmap of
+/// the requested variables unless they are all requested.
+void write_object_resync(const LocalVector<ObjectResync> &p_resync, DataBuffer &r_buffer);
+/// Returns false if the data is malformed.
+bool read_object_resync(DataBuffer &p_buffer, LocalVector<ObjectResync> &r_resync);
+/// Merges `p_resync` into `r_resync`, one entry per object.
+void merge_object_resync(LocalVector<ObjectResync> &r_resync, const ObjectResync &p_resync);
+
+/// The objects a client already asked to the server, so they are not asked
+/// again while the response is on its way.
+class ObjectResyncTracker {
+	struct Requested {
+		double at = 0.0;
+		/// The variables already asked, empty when all are asked.
+		ObjectResync resync;
+	};
+	std::map<ObjectNetId, Requested> requested;
+
+public:
+	/// Removes from `r_resync` the variables requested less than `p_timeout`
+	/// seconds before `p_now`, and marks the others as requested at `p_now`:
+	/// the variables not asked yet are sent as a follow-up request.
+	void filter(LocalVector<ObjectResync> &r_resync, double p_now, double p_timeout);
+	/// The server sent the object: it can be asked again right away.
+	void notify_received(ObjectNetId p_net_id);
+	bool is_requested(ObjectNetId p_net_id) const;
+	void clear();
+};
+
 struct PeerData {
 	ObjectNetId controller_id = ObjectNetId::NONE;
 	// For new peers notify the state as soon as possible.
 	bool force_notify_snapshot = true;
 	// For new peers a full snapshot is needed.
 	bool need_full_snapshot = true;
+	// The objects this peer is missing, added to the next snapshot.
+	LocalVector<ObjectResync> pending_resync;
+	// The objects streamed to this joining peer, by priority: the ones before
+	// the cursor are already sent. Cleared once all are sent.
+	LocalVector<ObjectNetId> join_backlog;
+	uint32_t join_backlog_cursor = 0;
 	// Used to know if the peer is enabled.
 	bool enabled = true;
+	// The spectators don't predict the dolls, so their inputs are not relayed.
+	bool spectator = false;
 	// The Sync group this peer is in.
 	SyncGroupId sync_group_id;
 };
 
+/// Dense table of the connected peers: the `PeerData` are stored contiguously,
+/// so iterating them each tick is cache friendly, while the lookup by peer id
+/// goes through an index map and never throws.
+/// NOTE: `insert` and `remove` invalidate the pointers returned by `find`.
+class PeerTable {
+public:
+	struct Entry {
+		int peer = 0;
+		PeerData data;
+	};
+
+private:
+	LocalVector<Entry> entries;
+	OAHashMap<int, uint32_t> slots;
+
+public:
+	/// Returns the data of the peer or `nullptr` if the peer is not in the table.
+	PeerData *find(int p_peer);
+	const PeerData *find(int p_peer) const;
+	bool has(int p_peer) const { return slots.has(p_peer); }
+
+	/// Adds the peer, if missing, and returns its data.
+	PeerData &insert(int p_peer);
+	/// Returns `false` if the peer was not in the table.
+	bool remove(int p_peer);
+	void clear();
+
+	uint32_t size() const { return entries.size(); }
+	bool is_empty() const { return entries.is_empty(); }
+
+	Entry *begin() { return entries.ptr(); }
+	Entry *end() { return entries.ptr() + entries.size(); }
+	const Entry *begin() const { return entries.ptr(); }
+	const Entry *end() const { return entries.ptr() + entries.size(); }
+};
+
+enum LodTier {
+	LOD_TIER_REALTIME,
+	LOD_TIER_DEFERRED_HIGH,
+	LOD_TIER_DEFERRED_LOW,
+	LOD_TIER_CULLED,
+	LOD_TIER_COUNT
+};
+
+/// Assigns the LOD managed nodes of a `SyncGroup` to a tier, using a metric
+/// provided by the user (e.g. the distance from the peers): the lower the
+/// metric the higher the tier.
+struct LodPolicy {
+	/// The metric upper bound of the realtime, deferred high and deferred low
+	/// tiers. Above the last one the node is culled.
+	real_t thresholds[LOD_TIER_CULLED] = { 10.0, 30.0, 60.0 };
+	/// A node changes tier only when its metric crosses the threshold by this
+	/// margin, so the nodes close to a threshold don't switch back and forth.
+	real_t hysteresis = 2.0;
+
+	real_t deferred_high_update_rate = 0.5;
+	real_t deferred_low_update_rate = 0.1;
+
+	/// CPU budget: the max amount of realtime nodes. The exceeding nodes, with
+	/// the highest metric, are demoted.
+	uint32_t max_realtime_nodes = UINT32_MAX;
+	/// Bandwidth budget: the max sum of the deferred update rates, that is the
+	/// amount of epochs sent each frame. The exceeding nodes are demoted.
+	real_t max_deferred_update_rate = FLT_MAX;
+
+	real_t get_update_rate(LodTier p_tier) const;
+};
+
 struct SyncGroup {
 public:
 	struct Change {
@@ -332,6 +465,26 @@ public:
 		/// INTERNAL
 		bool _unknown = false;
 
+		/// INTERNAL: The last epoch sent for this node, used to skip the
+		///           identical epochs and as reference for the delta encoding.
+		uint64_t _last_epoch_hash = 0;
+		int _last_epoch_bit_count = -1;
+		uint32_t _last_epoch = 0;
+		/// INTERNAL: Only set when the delta encoding is enabled.
+		Vector<uint8_t> _last_epoch_data;
+		/// INTERNAL: The epochs skipped or delta encoded since the last full one.
+		uint32_t _epochs_since_keyframe = 0;
+		uint32_t _last_checked_epoch = 0;
+		bool _skipped_since_sent = false;
+
+		/// Forces the next epoch to be sent in full.
+		void reset_epoch_reference() {
+			_last_epoch_bit_count = -1;
+			_last_epoch_data.clear();
+			_epochs_since_keyframe = 0;
+			_skipped_since_sent = false;
+		}
+
 		DeferredNodeInfo() = default;
 		DeferredNodeInfo(const DeferredNodeInfo &) = default;
 		DeferredNodeInfo &operator=(const DeferredNodeInfo &) = default;
@@ -345,6 +498,14 @@ public:
 		}
 	};
 
+	struct LodNodeInfo {
+		struct ObjectData *od = nullptr;
+		real_t metric = 0.0;
+		LodTier tier = LOD_TIER_CULLED;
+		/// False till the first `update_lod`: the hysteresis is not applied.
+		bool assigned = false;
+	};
+
 private:
 	bool realtime_sync_nodes_list_changed = false;
 	LocalVector<RealtimeNodeInfo> realtime_sync_nodes;
@@ -352,8 +513,13 @@ private:
 	bool deferred_sync_nodes_list_changed = false;
 	LocalVector<DeferredNodeInfo> deferred_sync_nodes;
 
+	LocalVector<LodNodeInfo> lod_nodes;
+	/// Maps the `ObjectLocalId` to the `lod_nodes` index.
+	OAHashMap<uint32_t, uint32_t> lod_nodes_index;
+
 public:
 	uint64_t user_data = 0;
+	LodPolicy lod_policy;
 	LocalVector<int> peers;
 
 	real_t state_notifier_timer = 0.0;
@@ -370,17 +536,58 @@ public:
 
 	/// Returns the `index` or `UINT32_MAX` on error.
 	uint32_t add_new_node(struct ObjectData *p_object_data, bool p_realtime);
+	/// Adds the nodes as realtime, using a single pass over this group rather
+	/// than one per node. The nodes already part of this group stay where they
+	/// are, and have all their variables notified.
+	void add_new_realtime_nodes(const LocalVector<struct ObjectData *> &p_objects_data);
 	void remove_node(struct ObjectData *p_object_data);
+	/// Removes the nodes using a single pass over this group.
+	void remove_nodes(const LocalVector<struct ObjectData *> &p_objects_data);
+	/// Sets the nodes of this group, in a single pass: the nodes already part
+	/// of it are kept and updated, the others removed or added. The LOD stops
+	/// managing the removed nodes.
 	void replace_nodes(LocalVector<RealtimeNodeInfo> &&p_new_realtime_nodes, LocalVector<DeferredNodeInfo> &&p_new_deferred_nodes);
 	void remove_all_nodes();
 
+	/// The next snapshot sends the node as unknown, with its name. Returns
+	/// false when the node is not realtime in this group.
+	bool notify_node_unknown(struct ObjectData *p_object_data);
 	void notify_new_variable(struct ObjectData *p_object_data, const std::string &p_var_name);
+	/// Notifies all the variables of the nodes, when part of this group.
+	void notify_new_variables(const LocalVector<struct ObjectData *> &p_objects_data);
 	void notify_variable_changed(struct ObjectData *p_object_data, const std::string &p_var_name);
 
 	void set_deferred_update_rate(struct ObjectData *p_object_data, real_t p_update_rate);
 	real_t get_deferred_update_rate(const struct ObjectData *p_object_data) const;
 
 	void sort_deferred_node_by_update_priority();
+
+	/// Fills `r_backlog` with all the nodes of this group, ordered as they are
+	/// streamed to a joining peer: its controller, the other controllers, the
+	/// realtime and then the deferred nodes; each by ascending LOD metric.
+	void collect_join_backlog(ObjectNetId p_controller_id, LocalVector<ObjectNetId> &r_backlog) const;
+
+	/// Sets the metric of this node, and from now on its tier is managed by
+	/// `update_lod`. `remove_node`, `remove_nodes`, `replace_nodes` and
+	/// `remove_all_nodes` stop managing it.
+	void set_lod_metric(struct ObjectData *p_object_data, real_t p_metric);
+	/// Returns `LOD_TIER_COUNT` when the node is not LOD managed.
+	LodTier get_lod_tier(const struct ObjectData *p_object_data) const;
+	const LocalVector<LodNodeInfo> &get_lod_nodes() const;
+
+	/// Assigns the LOD managed nodes to their tier, following the
+	/// `lod_policy`, and moves the ones that changed tier in a single
+	/// `replace_nodes`. Returns true when any node changed tier.
+	bool update_lod();
+
+private:
+	/// Adds the node as unknown, with all its variables.
+	RealtimeNodeInfo &push_new_realtime_node(struct ObjectData *p_object_data);
+	DeferredNodeInfo &push_new_deferred_node(struct ObjectData *p_object_data);
+	/// `replace_nodes` used by `update_lod`, that keeps the culled nodes.
+	void replace_nodes_keep_lod(LocalVector<RealtimeNodeInfo> &&p_new_realtime_nodes, LocalVector<DeferredNodeInfo> &&p_new_deferred_nodes);
+	void remove_lod_node(struct ObjectData *p_object_data);
+	LodTier compute_lod_tier(const LodNodeInfo &p_info) const;
 };
 
 NS_NAMESPACE_END
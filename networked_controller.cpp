@@ -4,11 +4,10 @@
 #include "core/config/project_settings.h"
 #include "core/error/error_macros.h"
 #include "core/io/marshalls.h"
+#include "core/os/os.h"
 #include "core/templates/vector.h"
-#include "godot4/gd_network_interface.h"
 #include "modules/network_synchronizer/core/core.h"
 #include "modules/network_synchronizer/core/processor.h"
-#include "scene/main/multiplayer_api.h"
 #include "scene_synchronizer.h"
 #include "scene_synchronizer_debugger.h"
 #include <algorithm>
@@ -93,11 +92,11 @@ void NetworkedControllerBase::set_server_controlled(bool p_server_controlled) {
 						network_interface->get_unit_authority(),
 						server_controlled);
 			} else {
-				SceneSynchronizerDebugger::singleton()->debug_warning(network_interface, "The node is owned by the server, there is no client that can control it; please assign the proper authority.");
+				NS_DEBUG_WARNING(network_interface, "The node is owned by the server, there is no client that can control it; please assign the proper authority.", false);
 			}
 
 		} else if (is_player_controller() || is_doll_controller()) {
-			SceneSynchronizerDebugger::singleton()->debug_warning(network_interface, "You should never call the function `set_server_controlled` on the client, this has an effect only if called on the server.");
+			NS_DEBUG_WARNING(network_interface, "You should never call the function `set_server_controlled` on the client, this has an effect only if called on the server.", false);
 
 		} else if (is_nonet_controller()) {
 			// There is no networking, the same instance is both the client and the
@@ -176,6 +175,45 @@ double NetworkedControllerBase::get_tick_acceleration() const {
 	return tick_acceleration;
 }
 
+void NetworkedControllerBase::set_doll_input_prediction(DollInputPrediction p_prediction) {
+	doll_input_prediction = p_prediction;
+}
+
+NetworkedControllerBase::DollInputPrediction NetworkedControllerBase::get_doll_input_prediction() const {
+	return doll_input_prediction;
+}
+
+void NetworkedControllerBase::set_doll_max_predicted_frames(int p_frames) {
+	ERR_FAIL_COND_MSG(p_frames < 0, "The max predicted frames can't be negative.");
+	doll_max_predicted_frames = p_frames;
+}
+
+int NetworkedControllerBase::get_doll_max_predicted_frames() const {
+	return doll_max_predicted_frames;
+}
+
+void NetworkedControllerBase::set_doll_prediction_decay(double p_decay) {
+	ERR_FAIL_COND_MSG(p_decay < 0.0 || p_decay > 1.0, "The prediction decay must be within 0 and 1.");
+	doll_prediction_decay = p_decay;
+}
+
+double NetworkedControllerBase::get_doll_prediction_decay() const {
+	return doll_prediction_decay;
+}
+
+void NetworkedControllerBase::set_input_size_prefixed(bool p_prefixed) {
+	input_size_prefixed = p_prefixed;
+}
+
+bool NetworkedControllerBase::get_input_size_prefixed() const {
+	return input_size_prefixed;
+}
+
+double NetworkedControllerBase::get_doll_misprediction_rate() const {
+	const DollController *doll = get_doll_controller();
+	return doll ? doll->get_misprediction_rate() : 0.0;
+}
+
 uint32_t NetworkedControllerBase::get_current_input_id() const {
 	ERR_FAIL_NULL_V(controller, 0);
 	return controller->get_current_input_id();
@@ -380,15 +418,14 @@ void NetworkedControllerBase::rpc_notify_fps_acceleration(const Vector<uint8_t>
 	}
 
 #ifdef DEBUG_ENABLED
-	const bool debug = ProjectSettings::get_singleton()->get_setting("NetworkSynchronizer/debug_server_speedup");
-	if (debug) {
-		print_line(
-				String() +
-				"Client received speedup." +
-				" Frames to produce: `" + itos(additional_frames_to_produce) + "`" +
-				" Acceleration fps: `" + rtos(player_controller->acceleration_fps_speed) + "`" +
-				" Acceleration time: `" + rtos(player_controller->acceleration_fps_timer) + "`");
-	}
+	NS_DEBUG_PRINT_CATEGORY(
+			LOG_CATEGORY_SPEEDUP,
+			network_interface,
+			String() +
+					"Client received speedup." +
+					" Frames to produce: `" + itos(additional_frames_to_produce) + "`" +
+					" Acceleration fps: `" + rtos(player_controller->acceleration_fps_speed) + "`" +
+					" Acceleration time: `" + rtos(player_controller->acceleration_fps_timer) + "`");
 #endif
 }
 
@@ -422,6 +459,30 @@ void NetworkedControllerBase::notify_controller_reset() {
 	event_controller_reset.broadcast();
 }
 
+int NetworkedControllerBase::__input_size_encode(uint32_t p_size_in_bits, uint8_t *r_dst) {
+	// Seven bits per byte, the eighth tells if another byte follows: the
+	// inputs smaller than 128 bits take one byte.
+	int ofs = 0;
+	while (p_size_in_bits >= 0x80) {
+		r_dst[ofs] = uint8_t(p_size_in_bits & 0x7F) | 0x80;
+		p_size_in_bits >>= 7;
+		ofs += 1;
+	}
+	r_dst[ofs] = uint8_t(p_size_in_bits);
+	return ofs + 1;
+}
+
+int NetworkedControllerBase::__input_size_decode(const uint8_t *p_src, int p_len, uint32_t &r_size_in_bits) {
+	r_size_in_bits = 0;
+	for (int i = 0; i < p_len && i < 5; i++) {
+		r_size_in_bits |= uint32_t(p_src[i] & 0x7F) << (7 * i);
+		if ((p_src[i] & 0x80) == 0) {
+			return i + 1;
+		}
+	}
+	return 0;
+}
+
 bool NetworkedControllerBase::__input_data_parse(
 		const Vector<uint8_t> &p_data,
 		void *p_user_pointer,
@@ -430,6 +491,7 @@ bool NetworkedControllerBase::__input_data_parse(
 	// |- Four bytes for the first input ID.
 	// \- Array of inputs:
 	//      |-- First byte the amount of times this input is duplicated in the packet.
+	//      |-- The input size in bits, only when `input_size_prefixed`.
 	//      |-- inputs buffer.
 	//
 	// Let's decode it!
@@ -446,9 +508,12 @@ bool NetworkedControllerBase::__input_data_parse(
 
 	// Contains the entire packet and in turn it will be seek to specific location
 	// so I will not need to copy chunk of the packet data.
-	DataBuffer *pir = memnew(DataBuffer);
-	pir->copy(p_data);
-	pir->begin_read();
+	DataBuffer *pir = nullptr;
+	if (!input_size_prefixed) {
+		pir = memnew(DataBuffer);
+		pir->copy(p_data);
+		pir->begin_read();
+	}
 	// TODO this is for 3.2
 	//pir.get_buffer_mut().resize_in_bytes(data_len);
 	//memcpy(pir.get_buffer_mut().get_bytes_mut().ptrw(), p_data.ptr(), data_len);
@@ -459,14 +524,24 @@ bool NetworkedControllerBase::__input_data_parse(
 		const uint8_t duplication = p_data[ofs];
 		ofs += 1;
 
-		// Validate input
-		const int input_buffer_offset_bit = ofs * 8;
-		pir->shrink_to(input_buffer_offset_bit, (data_len - ofs) * 8);
-		pir->seek(input_buffer_offset_bit);
-		// Read metadata
-		const bool has_data = pir->read_bool();
-
-		const int input_size_in_bits = (has_data ? int(networked_controller_manager->count_input_size(*pir)) : 0) + METADATA_SIZE;
+		int input_size_in_bits;
+		if (input_size_prefixed) {
+			uint32_t prefixed_size;
+			const int prefix_len = __input_size_decode(p_data.ptr() + ofs, data_len - ofs, prefixed_size);
+			ERR_FAIL_COND_V_MSG(prefix_len == 0, false, "The arrived packet has a malformed input size.");
+			ERR_FAIL_COND_V_MSG(prefixed_size < METADATA_SIZE || prefixed_size > uint32_t(data_len * 8), false, "The arrived packet has an invalid input size.");
+			ofs += prefix_len;
+			input_size_in_bits = int(prefixed_size);
+		} else {
+			// Validate input
+			const int input_buffer_offset_bit = ofs * 8;
+			pir->shrink_to(input_buffer_offset_bit, (data_len - ofs) * 8);
+			pir->seek(input_buffer_offset_bit);
+			// Read metadata
+			const bool has_data = pir->read_bool();
+
+			input_size_in_bits = (has_data ? int(networked_controller_manager->count_input_size(*pir)) : 0) + METADATA_SIZE;
+		}
 
 		// Pad to 8 bits.
 		const int input_size_padded =
@@ -493,8 +568,10 @@ bool NetworkedControllerBase::__input_data_parse(
 		ofs += input_size_padded;
 	}
 
-	memdelete(pir);
-	pir = nullptr;
+	if (pir) {
+		memdelete(pir);
+		pir = nullptr;
+	}
 
 	ERR_FAIL_COND_V_MSG(ofs != data_len, false, "At the end was detected that the arrived packet has an unexpected size.");
 	return true;
@@ -572,17 +649,17 @@ bool RemotelyControlledController::fetch_next_input(real_t p_delta) {
 			set_frame_input(snapshots.front(), true);
 			snapshots.pop_front();
 			// Start tracing the packets from this moment on.
-			SceneSynchronizerDebugger::singleton()->debug_print(node->network_interface, "[RemotelyControlledController::fetch_next_input] Input `" + itos(current_input_buffer_id) + "` selected as first input.", true);
+			NS_DEBUG_PRINT(node->network_interface, "[RemotelyControlledController::fetch_next_input] Input `" + itos(current_input_buffer_id) + "` selected as first input.", true);
 		} else {
 			is_new_input = false;
-			SceneSynchronizerDebugger::singleton()->debug_print(node->network_interface, "[RemotelyControlledController::fetch_next_input] Still no inputs.", true);
+			NS_DEBUG_PRINT(node->network_interface, "[RemotelyControlledController::fetch_next_input] Still no inputs.", true);
 		}
 	} else {
 		const uint32_t next_input_id = current_input_buffer_id + 1;
-		SceneSynchronizerDebugger::singleton()->debug_print(node->network_interface, "[RemotelyControlledController::fetch_next_input] The server is looking for: " + itos(next_input_id), true);
+		NS_DEBUG_PRINT(node->network_interface, "[RemotelyControlledController::fetch_next_input] The server is looking for: " + itos(next_input_id), true);
 
 		if (unlikely(streaming_paused)) {
-			SceneSynchronizerDebugger::singleton()->debug_print(node->network_interface, "[RemotelyControlledController::fetch_next_input] The streaming is paused.", true);
+			NS_DEBUG_PRINT(node->network_interface, "[RemotelyControlledController::fetch_next_input] The streaming is paused.", true);
 			// Stream is paused.
 			if (snapshots.empty() == false &&
 					snapshots.front().id >= next_input_id) {
@@ -600,17 +677,17 @@ bool RemotelyControlledController::fetch_next_input(real_t p_delta) {
 			}
 		} else if (unlikely(snapshots.empty() == true)) {
 			// The input buffer is empty; a packet is missing.
-			SceneSynchronizerDebugger::singleton()->debug_print(node->network_interface, "[RemotelyControlledController::fetch_next_input] Missing input: " + itos(next_input_id) + " Input buffer is void, i'm using the previous one!");
+			NS_DEBUG_PRINT(node->network_interface, "[RemotelyControlledController::fetch_next_input] Missing input: " + itos(next_input_id) + " Input buffer is void, i'm using the previous one!", false);
 
 			is_new_input = false;
 			ghost_input_count += 1;
 
 		} else {
-			SceneSynchronizerDebugger::singleton()->debug_print(node->network_interface, "[RemotelyControlledController::fetch_next_input] The input buffer is not empty, so looking for the next input. Hopefully `" + itos(next_input_id) + "`", true);
+			NS_DEBUG_PRINT(node->network_interface, "[RemotelyControlledController::fetch_next_input] The input buffer is not empty, so looking for the next input. Hopefully `" + itos(next_input_id) + "`", true);
 
 			// The input buffer is not empty, search the new input.
 			if (next_input_id == snapshots.front().id) {
-				SceneSynchronizerDebugger::singleton()->debug_print(node->network_interface, "[RemotelyControlledController::fetch_next_input] The input `" + itos(next_input_id) + "` was found.", true);
+				NS_DEBUG_PRINT(node->network_interface, "[RemotelyControlledController::fetch_next_input] The input `" + itos(next_input_id) + "` was found.", true);
 
 				// Wow, the next input is perfect!
 				set_frame_input(snapshots.front(), false);
@@ -653,8 +730,8 @@ bool RemotelyControlledController::fetch_next_input(real_t p_delta) {
 				// For this reason we keep track the amount of missing packets
 				// using `ghost_input_count`.
 
-				SceneSynchronizerDebugger::singleton()->debug_print(node->network_interface, "[RemotelyControlledController::fetch_next_input] The input `" + itos(next_input_id) + "` was NOT found. Recovering process started.", true);
-				SceneSynchronizerDebugger::singleton()->debug_print(node->network_interface, "[RemotelyControlledController::fetch_next_input] ghost_input_count: `" + itos(ghost_input_count) + "`", true);
+				NS_DEBUG_PRINT(node->network_interface, "[RemotelyControlledController::fetch_next_input] The input `" + itos(next_input_id) + "` was NOT found. Recovering process started.", true);
+				NS_DEBUG_PRINT(node->network_interface, "[RemotelyControlledController::fetch_next_input] ghost_input_count: `" + itos(ghost_input_count) + "`", true);
 
 				const int size = MIN(ghost_input_count, snapshots.size());
 				const uint32_t ghost_packet_id = next_input_id + ghost_input_count;
@@ -667,14 +744,14 @@ bool RemotelyControlledController::fetch_next_input(real_t p_delta) {
 				pir_A->copy(node->get_inputs_buffer());
 
 				for (int i = 0; i < size; i += 1) {
-					SceneSynchronizerDebugger::singleton()->debug_print(node->network_interface, "[RemotelyControlledController::fetch_next_input] checking if `" + itos(snapshots.front().id) + "` can be used to recover `" + itos(next_input_id) + "`.", true);
+					NS_DEBUG_PRINT(node->network_interface, "[RemotelyControlledController::fetch_next_input] checking if `" + itos(snapshots.front().id) + "` can be used to recover `" + itos(next_input_id) + "`.", true);
 
 					if (ghost_packet_id < snapshots.front().id) {
-						SceneSynchronizerDebugger::singleton()->debug_print(node->network_interface, "[RemotelyControlledController::fetch_next_input] The input `" + itos(snapshots.front().id) + "` can't be used as the ghost_packet_id (`" + itos(ghost_packet_id) + "`) is more than the input.", true);
+						NS_DEBUG_PRINT(node->network_interface, "[RemotelyControlledController::fetch_next_input] The input `" + itos(snapshots.front().id) + "` can't be used as the ghost_packet_id (`" + itos(ghost_packet_id) + "`) is more than the input.", true);
 						break;
 					} else {
 						const uint32_t input_id = snapshots.front().id;
-						SceneSynchronizerDebugger::singleton()->debug_print(node->network_interface, "[RemotelyControlledController::fetch_next_input] The input `" + itos(input_id) + "` is eligible as next frame.", true);
+						NS_DEBUG_PRINT(node->network_interface, "[RemotelyControlledController::fetch_next_input] The input `" + itos(input_id) + "` is eligible as next frame.", true);
 
 						pi = snapshots.front();
 						snapshots.pop_front();
@@ -696,7 +773,7 @@ bool RemotelyControlledController::fetch_next_input(real_t p_delta) {
 
 						const bool are_different = node->networked_controller_manager->are_inputs_different(*pir_A, *pir_B);
 						if (are_different) {
-							SceneSynchronizerDebugger::singleton()->debug_print(node->network_interface, "[RemotelyControlledController::fetch_next_input] The input `" + itos(input_id) + "` is different from the one executed so far, so better to execute it.", true);
+							NS_DEBUG_PRINT(node->network_interface, "[RemotelyControlledController::fetch_next_input] The input `" + itos(input_id) + "` is different from the one executed so far, so better to execute it.", true);
 							break;
 						}
 					}
@@ -710,11 +787,11 @@ bool RemotelyControlledController::fetch_next_input(real_t p_delta) {
 				if (recovered) {
 					set_frame_input(pi, false);
 					ghost_input_count = 0;
-					SceneSynchronizerDebugger::singleton()->debug_print(node->network_interface, "Packet recovered. The new InputID is: `" + itos(current_input_buffer_id) + "`");
+					NS_DEBUG_PRINT(node->network_interface, "Packet recovered. The new InputID is: `" + itos(current_input_buffer_id) + "`", false);
 				} else {
 					ghost_input_count += 1;
 					is_new_input = false;
-					SceneSynchronizerDebugger::singleton()->debug_print(node->network_interface, "Packet still missing, the server is still using the old input.");
+					NS_DEBUG_PRINT(node->network_interface, "Packet still missing, the server is still using the old input.", false);
 				}
 			}
 		}
@@ -743,7 +820,7 @@ void RemotelyControlledController::process(double p_delta) {
 
 	if (unlikely(current_input_buffer_id == UINT32_MAX)) {
 		// Skip this until the first input arrive.
-		SceneSynchronizerDebugger::singleton()->debug_print(node->network_interface, "Server skips this frame as the current_input_buffer_id == UINT32_MAX", true);
+		NS_DEBUG_PRINT(node->network_interface, "Server skips this frame as the current_input_buffer_id == UINT32_MAX", true);
 		return;
 	}
 
@@ -753,7 +830,7 @@ void RemotelyControlledController::process(double p_delta) {
 	}
 #endif
 
-	SceneSynchronizerDebugger::singleton()->debug_print(node->network_interface, "RemotelyControlled process index: " + itos(current_input_buffer_id), true);
+	NS_DEBUG_PRINT(node->network_interface, "RemotelyControlled process index: " + itos(current_input_buffer_id), true);
 
 	node->get_inputs_buffer_mut().begin_read();
 	node->get_inputs_buffer_mut().seek(METADATA_SIZE);
@@ -788,6 +865,8 @@ bool RemotelyControlledController::receive_inputs(const Vector<uint8_t> &p_data)
 			[](void *p_user_pointer, uint32_t p_input_id, int p_input_size_in_bits, const BitArray &p_bit_array) -> void {
 				SCParseTmpData *pd = static_cast<SCParseTmpData *>(p_user_pointer);
 
+				pd->controller->on_input_parsed(p_input_id, p_input_size_in_bits, p_bit_array);
+
 				if (unlikely(pd->controller->current_input_buffer_id != UINT32_MAX && pd->controller->current_input_buffer_id >= p_input_id)) {
 					// We already have this input, so we don't need it anymore.
 					return;
@@ -826,7 +905,7 @@ bool RemotelyControlledController::receive_inputs(const Vector<uint8_t> &p_data)
 #endif
 
 	if (!success) {
-		SceneSynchronizerDebugger::singleton()->debug_print(node->network_interface, "[RemotelyControlledController::receive_input] Failed.");
+		NS_DEBUG_PRINT(node->network_interface, "[RemotelyControlledController::receive_input] Failed.", false);
 	}
 
 	return success;
@@ -837,7 +916,8 @@ ServerController::ServerController(
 		int p_traced_frames) :
 		RemotelyControlledController(p_node),
 		network_watcher(p_traced_frames, 0),
-		consecutive_input_watcher(p_traced_frames, 0) {
+		consecutive_input_watcher(p_traced_frames, 0),
+		packet_loss_watcher(p_traced_frames, 0.0) {
 }
 
 void ServerController::process(double p_delta) {
@@ -897,45 +977,128 @@ void ServerController::notify_send_state() {
 }
 
 bool ServerController::receive_inputs(const Vector<uint8_t> &p_data) {
-	Vector<uint8_t> data = p_data;
-
-	const bool success = RemotelyControlledController::receive_inputs(data);
-
-	if (success) {
-		uint32_t input_id;
-		const bool extraction_success = node->__input_data_get_first_input_id(data, input_id);
-		CRASH_COND(!extraction_success);
-
-		// The input parsing succeded on the server, now ping pong this to all the dolls.
-		const SyncGroupId sync_group = node->get_scene_synchronizer()->sync_group_get_peer_group(node->peer_id);
-		const LocalVector<int> *peers = node->get_scene_synchronizer()->sync_group_get_peers(sync_group);
-		if (peers) {
-			for (int i = 0; i < int(peers->size()); ++i) {
-				const int peer_id = (*peers)[i];
-				if (peer_id != node->peer_id) {
-					// Convert the `input_id` to peer_id :: input_id.
-					// So the peer can properly read the data.
-					const uint32_t peer_input_id = convert_input_id_to(peer_id, input_id);
-
-					if (peer_input_id == UINT32_MAX) {
-						SceneSynchronizerDebugger::singleton()->debug_print(node->network_interface, "The `input_id` conversion failed for the peer `" + itos(peer_id) + "`. This is expected untill the client is fully initialized.", true);
-						continue;
-					}
-
-					node->__input_data_set_first_input_id(data, peer_input_id);
+	// The inputs are stored into `relay_inputs` by `on_input_parsed`, so the
+	// `SceneSynchronizer` can relay them to the dolls in a single packet per peer.
+	parsed_newest_input_id = UINT32_MAX;
+	const bool success = RemotelyControlledController::receive_inputs(p_data);
+
+	const size_t relay_capacity = size_t(node->get_max_redundant_inputs() + 1);
+	while (relay_inputs.size() > relay_capacity) {
+		relay_inputs.pop_front();
+	}
 
-					node->rpc_handle_receive_input.rpc(
-							node->get_network_interface(),
-							peer_id,
-							data);
-				}
-			}
+	if (success && parsed_newest_input_id != UINT32_MAX) {
+		// The player sends a packet each frame, so the gap between the
+		// newest inputs of two packets is the amount of lost packets.
+		if (last_received_input_id != UINT32_MAX && parsed_newest_input_id > last_received_input_id) {
+			packet_loss_watcher.push(double(parsed_newest_input_id - last_received_input_id - 1));
+		}
+		if (last_received_input_id == UINT32_MAX || parsed_newest_input_id > last_received_input_id) {
+			last_received_input_id = parsed_newest_input_id;
 		}
 	}
 
 	return success;
 }
 
+void ServerController::on_input_parsed(uint32_t p_input_id, int p_input_size_in_bits, const BitArray &p_bit_array) {
+	parsed_newest_input_id = p_input_id;
+
+	if (!relay_inputs.empty() && relay_inputs.front().id > p_input_id) {
+		// Too old.
+		return;
+	}
+
+	FrameSnapshot rfs;
+	rfs.id = p_input_id;
+	auto it = std::lower_bound(relay_inputs.begin(), relay_inputs.end(), rfs, is_remote_frame_A_older);
+	if (it != relay_inputs.end() && it->id == p_input_id) {
+		// Already known.
+		return;
+	}
+
+	rfs.inputs_buffer = p_bit_array;
+	rfs.buffer_size_bit = p_input_size_in_bits;
+	rfs.similarity = UINT32_MAX;
+	rfs.received_timestamp = 0;
+	relay_inputs.insert(it, rfs);
+	relay_has_new_inputs = true;
+}
+
+double ServerController::get_packet_loss() const {
+	const double lost_per_packet = packet_loss_watcher.average();
+	return lost_per_packet / (1.0 + lost_per_packet);
+}
+
+int ServerController::compute_relay_redundancy(int p_max_redundancy) const {
+	const double loss = get_packet_loss();
+	if (loss <= 0.0) {
+		return MIN(1, p_max_redundancy);
+	}
+	if (loss >= 1.0) {
+		return p_max_redundancy;
+	}
+	// Repeat the input so that the chance of losing all the copies is < 0.1%.
+	const int copies = int(Math::ceil(Math::log(0.001) / Math::log(loss)));
+	return CLAMP(copies - 1, MIN(1, p_max_redundancy), p_max_redundancy);
+}
+
+bool ServerController::encode_relay_inputs(int p_peer, int p_redundancy, Vector<uint8_t> &r_data) const {
+	if (relay_inputs.empty()) {
+		return false;
+	}
+
+	// The packet format needs consecutive inputs: take the last run.
+	int first = int(relay_inputs.size()) - 1;
+	while (first > 0 &&
+			(int(relay_inputs.size()) - first) <= p_redundancy &&
+			relay_inputs[first - 1].id + 1 == relay_inputs[first].id) {
+		first -= 1;
+	}
+
+	const uint32_t peer_input_id = convert_input_id_to(p_peer, relay_inputs[first].id);
+	if (peer_input_id == UINT32_MAX) {
+		NS_DEBUG_PRINT(node->network_interface, "The `input_id` conversion failed for the peer `" + itos(p_peer) + "`. This is expected untill the client is fully initialized.", true);
+		return false;
+	}
+
+	// Same format of `PlayerController::send_frame_input_buffer_to_server`,
+	// the identical inputs are collapsed.
+	const bool prefixed = node->get_input_size_prefixed();
+	int size = 4;
+	for (int i = first; i < int(relay_inputs.size()); i++) {
+		size += 1 + (prefixed ? 5 : 0) + relay_inputs[i].inputs_buffer.get_bytes().size();
+	}
+	r_data.resize(size);
+
+	uint8_t *ptr = r_data.ptrw();
+	int ofs = encode_uint32(peer_input_id, ptr);
+	int duplication_ofs = -1;
+	const BitArray *previous = nullptr;
+	for (int i = first; i < int(relay_inputs.size()); i++) {
+		const BitArray &input = relay_inputs[i].inputs_buffer;
+		const int buffer_size = input.get_bytes().size();
+		if (previous != nullptr &&
+				ptr[duplication_ofs] < UINT8_MAX &&
+				previous->get_bytes().size() == buffer_size &&
+				memcmp(previous->get_bytes().ptr(), input.get_bytes().ptr(), buffer_size) == 0) {
+			ptr[duplication_ofs] += 1;
+			continue;
+		}
+		duplication_ofs = ofs;
+		ptr[ofs] = 0;
+		ofs += 1;
+		if (prefixed) {
+			ofs += NetworkedControllerBase::__input_size_encode(relay_inputs[i].buffer_size_bit, ptr + ofs);
+		}
+		memcpy(ptr + ofs, input.get_bytes().ptr(), buffer_size);
+		ofs += buffer_size;
+		previous = &input;
+	}
+	r_data.resize(ofs);
+	return true;
+}
+
 uint32_t ServerController::convert_input_id_to(int p_other_peer, uint32_t p_input_id) const {
 	ERR_FAIL_COND_V(p_input_id == UINT32_MAX, UINT32_MAX);
 	CRASH_COND(node->peer_id == p_other_peer); // This function must never be called for the same peer controlling this Character.
@@ -999,16 +1162,15 @@ void ServerController::adjust_player_tick_rate(double p_delta) {
 				sizeof(uint8_t));
 
 #ifdef DEBUG_ENABLED
-		const bool debug = ProjectSettings::get_singleton()->get_setting("NetworkSynchronizer/debug_server_speedup");
 		const int current_frame_delay = consecutive_inputs;
-		if (debug) {
-			print_line(
-					"Worst receival time (ms): `" + itos(worst_receival_time_ms) +
-					"` Optimal frame delay: `" + itos(optimal_frame_delay) +
-					"` Current frame delay: `" + itos(current_frame_delay) +
-					"` Distance to optimal: `" + itos(distance_to_optimal) +
-					"`");
-		}
+		NS_DEBUG_PRINT_CATEGORY(
+				LOG_CATEGORY_SPEEDUP,
+				&node->get_network_interface(),
+				"Worst receival time (ms): `" + itos(worst_receival_time_ms) +
+						"` Optimal frame delay: `" + itos(optimal_frame_delay) +
+						"` Current frame delay: `" + itos(current_frame_delay) +
+						"` Distance to optimal: `" + itos(distance_to_optimal) +
+						"`");
 		node->event_client_speedup_adjusted.broadcast(worst_receival_time_ms, optimal_frame_delay, current_frame_delay, distance_to_optimal);
 #endif
 
@@ -1029,7 +1191,7 @@ AutonomousServerController::AutonomousServerController(
 }
 
 bool AutonomousServerController::receive_inputs(const Vector<uint8_t> &p_data) {
-	SceneSynchronizerDebugger::singleton()->debug_warning(&node->get_network_interface(), "`receive_input` called on the `AutonomousServerController` - If this is called just after `set_server_controlled(true)` is called, you can ignore this warning, as the client is not aware about the switch for a really small window after this function call.");
+	NS_DEBUG_WARNING(&node->get_network_interface(), "`receive_input` called on the `AutonomousServerController` - If this is called just after `set_server_controlled(true)` is called, you can ignore this warning, as the client is not aware about the switch for a really small window after this function call.", false);
 	return false;
 }
 
@@ -1039,7 +1201,7 @@ int AutonomousServerController::get_inputs_count() const {
 }
 
 bool AutonomousServerController::fetch_next_input(real_t p_delta) {
-	SceneSynchronizerDebugger::singleton()->debug_print(&node->get_network_interface(), "Autonomous server fetch input.", true);
+	NS_DEBUG_PRINT(&node->get_network_interface(), "Autonomous server fetch input.", true);
 
 	node->get_inputs_buffer_mut().begin_write(METADATA_SIZE);
 	node->get_inputs_buffer_mut().seek(METADATA_SIZE);
@@ -1104,7 +1266,7 @@ int PlayerController::calculates_sub_ticks(const double p_delta, const double p_
 void PlayerController::notify_input_checked(uint32_t p_input_id) {
 	if (frames_snapshot.empty() || p_input_id < frames_snapshot.front().id || p_input_id > frames_snapshot.back().id) {
 		// The received p_input_id is not known, so nothing to do.
-		SceneSynchronizerDebugger::singleton()->debug_error(&node->get_network_interface(), "The received snapshot, with input id: " + itos(p_input_id) + " is not known. This is a bug or someone is trying to hack.");
+		NS_DEBUG_ERROR(&node->get_network_interface(), "The received snapshot, with input id: " + itos(p_input_id) + " is not known. This is a bug or someone is trying to hack.", false);
 		return;
 	}
 
@@ -1201,7 +1363,7 @@ void PlayerController::process(double p_delta) {
 		if (accept_new_inputs) {
 			current_input_id = input_buffers_counter;
 
-			SceneSynchronizerDebugger::singleton()->debug_print(&node->get_network_interface(), "Player process index: " + itos(current_input_id), true);
+			NS_DEBUG_PRINT(&node->get_network_interface(), "Player process index: " + itos(current_input_id), true);
 
 			node->get_inputs_buffer_mut().begin_write(METADATA_SIZE);
 
@@ -1220,7 +1382,7 @@ void PlayerController::process(double p_delta) {
 				node->get_inputs_buffer_mut().add_bool(false);
 			}
 		} else {
-			SceneSynchronizerDebugger::singleton()->debug_warning(&node->get_network_interface(), "It's not possible to accept new inputs. Is this lagging?");
+			NS_DEBUG_WARNING(&node->get_network_interface(), "It's not possible to accept new inputs. Is this lagging?", false);
 		}
 
 		node->get_inputs_buffer_mut().dry();
@@ -1250,7 +1412,7 @@ uint32_t PlayerController::get_current_input_id() const {
 }
 
 bool PlayerController::receive_inputs(const Vector<uint8_t> &p_data) {
-	SceneSynchronizerDebugger::singleton()->debug_error(&node->get_network_interface(), "`receive_input` called on the `PlayerServerController` -This function is not supposed to be called on the player controller. Only the server and the doll should receive this.");
+	NS_DEBUG_ERROR(&node->get_network_interface(), "`receive_input` called on the `PlayerServerController` -This function is not supposed to be called on the player controller. Only the server and the doll should receive this.", false);
 	return false;
 }
 
@@ -1269,6 +1431,7 @@ void PlayerController::send_frame_input_buffer_to_server() {
 	// - The following four bytes for the first input ID.
 	// - Array of inputs:
 	// |-- First byte the amount of times this input is duplicated in the packet.
+	// |-- The input size in bits, only when `input_size_prefixed`.
 	// |-- Input buffer.
 
 	const size_t inputs_count = MIN(frames_snapshot.size(), static_cast<size_t>(node->get_max_redundant_inputs() + 1));
@@ -1287,7 +1450,7 @@ void PlayerController::send_frame_input_buffer_to_server() {
 
 	uint32_t previous_input_id = UINT32_MAX;
 	uint32_t previous_input_similarity = UINT32_MAX;
-	int previous_buffer_size = 0;
+	int previous_duplication_ofs = 0;
 	uint8_t duplication_count = 0;
 
 	DataBuffer *pir_A = memnew(DataBuffer);
@@ -1358,7 +1521,7 @@ void PlayerController::send_frame_input_buffer_to_server() {
 
 			if (previous_input_id != UINT32_MAX) {
 				// We can finally finalize the previous input
-				cached_packet_data[ofs - previous_buffer_size - 1] = duplication_count;
+				cached_packet_data[previous_duplication_ofs] = duplication_count;
 			}
 
 			// Resets the duplication count.
@@ -1366,9 +1529,15 @@ void PlayerController::send_frame_input_buffer_to_server() {
 
 			// Writes the duplication_count for this new input
 			MAKE_ROOM(1);
+			previous_duplication_ofs = ofs;
 			cached_packet_data[ofs] = 0;
 			ofs += 1;
 
+			if (node->get_input_size_prefixed()) {
+				MAKE_ROOM(5);
+				ofs += NetworkedControllerBase::__input_size_encode(frames_snapshot[i].buffer_size_bit, cached_packet_data.ptr() + ofs);
+			}
+
 			// Write the inputs
 			const int buffer_size = frames_snapshot[i].inputs_buffer.get_bytes().size();
 			MAKE_ROOM(buffer_size);
@@ -1381,7 +1550,6 @@ void PlayerController::send_frame_input_buffer_to_server() {
 			// Let's see if we can duplicate this input.
 			previous_input_id = frames_snapshot[i].id;
 			previous_input_similarity = frames_snapshot[i].similarity;
-			previous_buffer_size = buffer_size;
 
 			pir_A->get_buffer_mut() = frames_snapshot[i].inputs_buffer;
 			pir_A->shrink_to(METADATA_SIZE, frames_snapshot[i].buffer_size_bit - METADATA_SIZE);
@@ -1394,7 +1562,7 @@ void PlayerController::send_frame_input_buffer_to_server() {
 	pir_B = nullptr;
 
 	// Finalize the last added input_buffer.
-	cached_packet_data[ofs - previous_buffer_size - 1] = duplication_count;
+	cached_packet_data[previous_duplication_ofs] = duplication_count;
 
 	// Make the packet data.
 	Vector<uint8_t> packet_data;
@@ -1466,11 +1634,16 @@ bool DollController::receive_inputs(const Vector<uint8_t> &p_data) {
 							pd->controller->snapshots.begin(),
 							pd->controller->snapshots.end(),
 							is_remote_frame_A_older);
+
+					if (pd->controller->last_received_input.id == UINT32_MAX || pd->controller->last_received_input.id < p_input_id) {
+						pd->controller->last_received_input = rfs;
+					}
+					pd->controller->verify_prediction(rfs);
 				}
 			});
 
 	if (!success) {
-		SceneSynchronizerDebugger::singleton()->debug_print(&node->get_network_interface(), "[DollController::receive_input] Failed.");
+		NS_DEBUG_PRINT(&node->get_network_interface(), "[DollController::receive_input] Failed.", false);
 	}
 
 	return success;
@@ -1488,7 +1661,7 @@ void DollController::queue_instant_process(uint32_t p_input_id, int p_index, int
 		}
 	}
 
-	SceneSynchronizerDebugger::singleton()->debug_warning(&node->get_network_interface(), "DollController was uable to find the input: " + itos(p_input_id) + " maybe it was never received?", true);
+	NS_DEBUG_WARNING(&node->get_network_interface(), "DollController was uable to find the input: " + itos(p_input_id) + " maybe it was never received?", true);
 	queued_instant_to_process = snapshots.size();
 	return;
 }
@@ -1520,37 +1693,157 @@ bool DollController::fetch_next_input(real_t p_delta) {
 				// NOTE: the snapshots are sorted.
 				if (snapshots[i].id >= next_input_id) {
 					set_frame_input(snapshots[i], false);
+					predicted_frames = 0;
 					return true;
 				}
 			}
-			if (snapshots.size() > 0) {
-				set_frame_input(snapshots.back(), false);
-				// true anyway, don't stop the processing, just use the input.
-				return true;
+			// The next input didn't arrive yet.
+			return predict_next_input(next_input_id);
+		}
+	}
+	return false;
+}
+
+bool DollController::predict_next_input(uint32_t p_input_id) {
+	if (last_received_input.id == UINT32_MAX || predicted_frames >= node->get_doll_max_predicted_frames()) {
+		return false;
+	}
+
+	FrameSnapshot prediction;
+	prediction.id = p_input_id;
+	prediction.similarity = UINT32_MAX;
+	prediction.received_timestamp = 0;
+
+	switch (node->get_doll_input_prediction()) {
+		case NetworkedControllerBase::DOLL_INPUT_PREDICTION_CUSTOM:
+		case NetworkedControllerBase::DOLL_INPUT_PREDICTION_DECAY_TO_NEUTRAL: {
+			const bool is_custom = node->get_doll_input_prediction() == NetworkedControllerBase::DOLL_INPUT_PREDICTION_CUSTOM;
+
+			DataBuffer last_input(last_received_input.inputs_buffer);
+			last_input.shrink_to(METADATA_SIZE, last_received_input.buffer_size_bit - METADATA_SIZE);
+			last_input.begin_read();
+			last_input.seek(METADATA_SIZE);
+
+			DataBuffer predicted_input;
+			predicted_input.begin_write(METADATA_SIZE);
+			predicted_input.seek(METADATA_SIZE);
+			const bool predicted = is_custom ?
+					node->networked_controller_manager->predict_doll_input(predicted_frames + 1, last_input, predicted_input) :
+					node->networked_controller_manager->decay_doll_input(Math::pow(node->get_doll_prediction_decay(), double(predicted_frames + 1)), last_input, predicted_input);
+
+			if (predicted) {
+				const bool has_data = predicted_input.size() > 0;
+				predicted_input.seek(0);
+				predicted_input.add_bool(has_data);
+				predicted_input.dry();
+
+				prediction.inputs_buffer = predicted_input.get_buffer();
+				prediction.buffer_size_bit = predicted_input.size() + METADATA_SIZE;
+			} else if (is_custom) {
+				return false;
+			} else {
+				// The input can't be decayed, repeat it as is.
+				prediction.inputs_buffer = last_received_input.inputs_buffer;
+				prediction.buffer_size_bit = last_received_input.buffer_size_bit;
 			}
+		} break;
+		case NetworkedControllerBase::DOLL_INPUT_PREDICTION_REPEAT_LAST:
+			prediction.inputs_buffer = last_received_input.inputs_buffer;
+			prediction.buffer_size_bit = last_received_input.buffer_size_bit;
+			break;
+	}
+
+	predicted_frames += 1;
+	set_frame_input(prediction, false);
+
+	predicted_inputs.push_back(prediction);
+	while (predicted_inputs.size() > size_t(node->get_player_input_storage_size())) {
+		predicted_inputs.pop_front();
+	}
+	return true;
+}
+
+void DollController::verify_prediction(const FrameSnapshot &p_received) {
+	for (auto it = predicted_inputs.begin(); it != predicted_inputs.end(); ++it) {
+		if (it->id != p_received.id) {
+			continue;
+		}
+
+		DataBuffer predicted_input(it->inputs_buffer);
+		predicted_input.shrink_to(METADATA_SIZE, it->buffer_size_bit - METADATA_SIZE);
+		predicted_input.begin_read();
+		predicted_input.seek(METADATA_SIZE);
+
+		DataBuffer received_input(p_received.inputs_buffer);
+		received_input.shrink_to(METADATA_SIZE, p_received.buffer_size_bit - METADATA_SIZE);
+		received_input.begin_read();
+		received_input.seek(METADATA_SIZE);
+
+		const bool mispredicted =
+				it->buffer_size_bit != p_received.buffer_size_bit ||
+				node->networked_controller_manager->are_inputs_different(predicted_input, received_input);
+
+		verified_predictions_count += 1;
+		if (mispredicted) {
+			mispredictions_count += 1;
 		}
+
+		if (mispredicted) {
+			replay_from_input_id = MIN(replay_from_input_id, p_received.id);
+		}
+
+		predicted_inputs.erase(it);
+		return;
 	}
+}
+
+bool DollController::replay_input(uint32_t p_input_id, double p_delta) {
+	for (size_t i = 0; i < snapshots.size(); ++i) {
+		if (snapshots[i].id == p_input_id) {
+			set_frame_input(snapshots[i], false);
+			process_current_input(p_delta);
+			return true;
+		}
+	}
+
+	for (size_t i = 0; i < predicted_inputs.size(); ++i) {
+		if (predicted_inputs[i].id == p_input_id) {
+			set_frame_input(predicted_inputs[i], false);
+			process_current_input(p_delta);
+			return true;
+		}
+	}
+
 	return false;
 }
 
+double DollController::get_misprediction_rate() const {
+	if (verified_predictions_count == 0) {
+		return 0.0;
+	}
+	return double(mispredictions_count) / double(verified_predictions_count);
+}
+
 void DollController::process(double p_delta) {
 	const bool is_new_input = fetch_next_input(p_delta);
 
 	if (is_new_input) {
-		SceneSynchronizerDebugger::singleton()->debug_print(&node->get_network_interface(), "Doll process index: " + itos(current_input_buffer_id), true);
-
-		node->get_inputs_buffer_mut().begin_read();
-		node->get_inputs_buffer_mut().seek(METADATA_SIZE);
-		SceneSynchronizerDebugger::singleton()->databuffer_operation_begin_record(&node->get_network_interface(), SceneSynchronizerDebugger::READ);
-		node->networked_controller_manager->controller_process(
-				p_delta,
-				node->get_inputs_buffer_mut());
-		SceneSynchronizerDebugger::singleton()->databuffer_operation_end_record();
+		process_current_input(p_delta);
 	}
 
 	queued_instant_to_process = -1;
 }
 
+void DollController::process_current_input(double p_delta) {
+	NS_DEBUG_PRINT(&node->get_network_interface(), "Doll process index: " + itos(current_input_buffer_id), true);
+
+	node->get_inputs_buffer_mut().begin_read();
+	node->get_inputs_buffer_mut().seek(METADATA_SIZE);
+	SceneSynchronizerDebugger::singleton()->databuffer_operation_begin_record(&node->get_network_interface(), SceneSynchronizerDebugger::READ);
+	node->networked_controller_manager->controller_process(p_delta, node->get_inputs_buffer_mut());
+	SceneSynchronizerDebugger::singleton()->databuffer_operation_end_record();
+}
+
 void DollController::notify_input_checked(uint32_t p_input_id) {
 	// Remove inputs prior to the known one. We may still need the known one
 	// when the stream is paused.
@@ -1561,6 +1854,10 @@ void DollController::notify_input_checked(uint32_t p_input_id) {
 		snapshots.pop_front();
 	}
 
+	while (predicted_inputs.empty() == false && predicted_inputs.front().id <= p_input_id) {
+		predicted_inputs.pop_front();
+	}
+
 	last_checked_input = p_input_id;
 }
 
@@ -1571,7 +1868,7 @@ NoNetController::NoNetController(NetworkedControllerBase *p_node) :
 
 void NoNetController::process(double p_delta) {
 	node->get_inputs_buffer_mut().begin_write(0); // No need of meta in this case.
-	SceneSynchronizerDebugger::singleton()->debug_print(&node->get_network_interface(), "Nonet process index: " + itos(frame_id), true);
+	NS_DEBUG_PRINT(&node->get_network_interface(), "Nonet process index: " + itos(frame_id), true);
 	SceneSynchronizerDebugger::singleton()->databuffer_operation_begin_record(&node->get_network_interface(), SceneSynchronizerDebugger::WRITE);
 	node->networked_controller_manager->collect_inputs(p_delta, node->get_inputs_buffer_mut());
 	SceneSynchronizerDebugger::singleton()->databuffer_operation_end_record();
@@ -25,6 +25,20 @@ public:
 	virtual void controller_process(double p_delta, DataBuffer &p_buffer) = 0;
 	virtual bool are_inputs_different(DataBuffer &p_buffer_A, DataBuffer &p_buffer_B) = 0;
 	virtual uint32_t count_input_size(DataBuffer &p_buffer) = 0;
+
+	/// Used by the dolls with `DOLL_INPUT_PREDICTION_CUSTOM`, when the next
+	/// input didn't arrive yet. `p_last_input` is the last received input and
+	/// `p_frames` the amount of frames predicted so far, this one included.
+	/// Write the predicted input into `r_predicted_input` and return true, or
+	/// return false to not process the doll this frame.
+	virtual bool predict_doll_input(int p_frames, DataBuffer &p_last_input, DataBuffer &r_predicted_input) { return false; }
+
+	/// Used by the dolls with `DOLL_INPUT_PREDICTION_DECAY_TO_NEUTRAL`, when the
+	/// next input didn't arrive yet. Write into `r_decayed_input` the
+	/// `p_last_input` with its intensity scaled by `p_factor` (1 is the
+	/// received input, 0 is neutral) and return true, or return false to
+	/// repeat `p_last_input` as is.
+	virtual bool decay_doll_input(double p_factor, DataBuffer &p_last_input, DataBuffer &r_decayed_input) { return false; }
 };
 
 /// The `NetworkedController` is responsible to sync the `Player` inputs between
@@ -63,6 +77,17 @@ public:
 		CONTROLLER_TYPE_DOLL
 	};
 
+	/// How the doll predicts the inputs that didn't arrive yet.
+	enum DollInputPrediction {
+		/// Repeats the last received input.
+		DOLL_INPUT_PREDICTION_REPEAT_LAST,
+		/// Repeats the last received input, fading it toward neutral through
+		/// `NetworkedControllerManager::decay_doll_input` each frame.
+		DOLL_INPUT_PREDICTION_DECAY_TO_NEUTRAL,
+		/// Asks `NetworkedControllerManager::predict_doll_input`.
+		DOLL_INPUT_PREDICTION_CUSTOM
+	};
+
 public:
 	NetworkedControllerManager *networked_controller_manager = nullptr;
 
@@ -129,6 +154,20 @@ private:
 	/// Amount of additional frames produced per second.
 	double tick_acceleration = 5.0;
 
+	DollInputPrediction doll_input_prediction = DOLL_INPUT_PREDICTION_REPEAT_LAST;
+	/// The doll stops after predicting this amount of consecutive inputs, and
+	/// waits the real ones.
+	int doll_max_predicted_frames = 10;
+	/// Used by `DOLL_INPUT_PREDICTION_DECAY_TO_NEUTRAL`: the input intensity
+	/// is scaled by this factor for each predicted frame.
+	double doll_prediction_decay = 0.7;
+
+	/// When `true` each input sent through the network is prefixed with its
+	/// size, so the server and the dolls can split the packets without calling
+	/// `NetworkedControllerManager::count_input_size`.
+	/// It changes the packet format, so it must be the same on all the peers.
+	bool input_size_prefixed = false;
+
 	ControllerType controller_type = CONTROLLER_TYPE_NULL;
 	Controller *controller = nullptr;
 	// Created using `memnew` into the constructor:
@@ -208,6 +247,22 @@ public: // ---------------------------------------------------------------- APIs
 	void set_tick_acceleration(double p_acceleration);
 	double get_tick_acceleration() const;
 
+	void set_doll_input_prediction(DollInputPrediction p_prediction);
+	DollInputPrediction get_doll_input_prediction() const;
+
+	void set_doll_max_predicted_frames(int p_frames);
+	int get_doll_max_predicted_frames() const;
+
+	void set_doll_prediction_decay(double p_decay);
+	double get_doll_prediction_decay() const;
+
+	void set_input_size_prefixed(bool p_prefixed);
+	bool get_input_size_prefixed() const;
+
+	/// Returns the ratio of the predicted inputs that were wrong, once the
+	/// real input arrived. Always 0 when this is not a doll.
+	double get_doll_misprediction_rate() const;
+
 	uint32_t get_current_input_id() const;
 
 	const DataBuffer &get_inputs_buffer() const {
@@ -271,6 +326,12 @@ protected:
 	void notify_controller_reset();
 
 public:
+	/// Writes the input size prefix into `r_dst`, which must have room for 5
+	/// bytes, and returns the written bytes.
+	static int __input_size_encode(uint32_t p_size_in_bits, uint8_t *r_dst);
+	/// Returns the read bytes, or 0 when the prefix is malformed.
+	static int __input_size_decode(const uint8_t *p_src, int p_len, uint32_t &r_size_in_bits);
+
 	bool __input_data_parse(
 			const Vector<uint8_t> &p_data,
 			void *p_user_pointer,
@@ -343,6 +404,11 @@ public:
 	virtual void process(double p_delta) override;
 
 	virtual bool receive_inputs(const Vector<uint8_t> &p_data) override;
+
+protected:
+	/// Called by `receive_inputs` for each parsed input, including the ones
+	/// already processed, so the subclasses don't need to parse the packet again.
+	virtual void on_input_parsed(uint32_t p_input_id, int p_input_size_in_bits, const BitArray &p_bit_array) {}
 };
 
 struct ServerController : public RemotelyControlledController {
@@ -352,6 +418,17 @@ struct ServerController : public RemotelyControlledController {
 	NS::StatisticalRingBuffer<uint32_t> network_watcher;
 	NS::StatisticalRingBuffer<int> consecutive_input_watcher;
 
+	/// The last inputs received, sorted by id: the `SceneSynchronizer` relays
+	/// them to the peers that see this controller as a doll.
+	std::deque<FrameSnapshot> relay_inputs;
+	bool relay_has_new_inputs = false;
+	/// The packets lost between two received packets, used to adapt the
+	/// redundancy of the inputs relayed to this peer.
+	NS::StatisticalRingBuffer<double> packet_loss_watcher;
+	uint32_t last_received_input_id = UINT32_MAX;
+	/// The newest input id of the packet being parsed by `receive_inputs`.
+	uint32_t parsed_newest_input_id = UINT32_MAX;
+
 	ServerController(
 			NetworkedControllerBase *p_node,
 			int p_traced_frames);
@@ -366,8 +443,22 @@ struct ServerController : public RemotelyControlledController {
 
 	virtual bool receive_inputs(const Vector<uint8_t> &p_data) override;
 
+protected:
+	virtual void on_input_parsed(uint32_t p_input_id, int p_input_size_in_bits, const BitArray &p_bit_array) override;
+
+public:
 	uint32_t convert_input_id_to(int p_other_peer, uint32_t p_input_id) const;
 
+	/// Returns the estimated ratio, from 0 to 1, of the packets lost by this peer.
+	double get_packet_loss() const;
+	/// Returns how many times each input should be repeated in the packets
+	/// sent to this peer, so that at least one copy likely arrives.
+	int compute_relay_redundancy(int p_max_redundancy) const;
+	/// Writes the last `p_redundancy + 1` consecutive relay inputs using the
+	/// `receive_inputs` format, with the input ids converted to `p_peer`.
+	/// Returns false when nothing can be sent to this peer yet.
+	bool encode_relay_inputs(int p_peer, int p_redundancy, Vector<uint8_t> &r_data) const;
+
 	/// This function updates the `tick_additional_fps` so that the `frames_inputs`
 	/// size is enough to reduce the missing packets to 0.
 	///
@@ -442,11 +533,36 @@ struct DollController : public RemotelyControlledController {
 	uint32_t last_checked_input = 0;
 	int queued_instant_to_process = -1;
 
+	/// The last received input set, used to predict the missing ones.
+	FrameSnapshot last_received_input = { UINT32_MAX, BitArray(), 0, 0, 0 };
+	/// The inputs predicted and not yet received, sorted by id.
+	std::deque<FrameSnapshot> predicted_inputs;
+	int predicted_frames = 0;
+
+	/// The first input that was mispredicted: the `ClientSynchronizer`
+	/// replays the doll from here.
+	uint32_t replay_from_input_id = UINT32_MAX;
+
+	uint64_t verified_predictions_count = 0;
+	uint64_t mispredictions_count = 0;
+
 	virtual bool receive_inputs(const Vector<uint8_t> &p_data) override;
 	virtual void queue_instant_process(uint32_t p_input_id, int p_index, int p_count) override;
 	virtual bool fetch_next_input(real_t p_delta) override;
 	virtual void process(double p_delta) override;
 	virtual void notify_input_checked(uint32_t p_input_id) override;
+
+	/// Sets a predicted input as the current one, returns false when the
+	/// doll should not be processed.
+	bool predict_next_input(uint32_t p_input_id);
+	/// Processes again the input `p_input_id`: using the received one, or the
+	/// predicted one if it didn't arrive yet. Returns false if unknown.
+	bool replay_input(uint32_t p_input_id, double p_delta);
+	double get_misprediction_rate() const;
+
+private:
+	void process_current_input(double p_delta);
+	void verify_prediction(const FrameSnapshot &p_received);
 };
 
 /// This controller is used when the game instance is not a peer of any kind.
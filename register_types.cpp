@@ -36,7 +36,9 @@
 
 #include "core/config/engine.h"
 #include "core/config/project_settings.h"
+#include "core/os/os.h"
 #include "data_buffer.h"
+#include "godot4/gd_deferred_kinematics.h"
 #include "godot4/gd_networked_controller.h"
 #include "godot4/gd_scene_synchronizer.h"
 #include "input_network_encoder.h"
@@ -45,6 +47,7 @@
 #include "scene_synchronizer_debugger.h"
 
 #ifdef DEBUG_ENABLED
+#include "tests/benchmark_scene_synchronizer.h"
 #include "tests/tests.h"
 #endif
 
@@ -52,6 +55,7 @@ void initialize_network_synchronizer_module(ModuleInitializationLevel p_level) {
 	if (p_level == MODULE_INITIALIZATION_LEVEL_SERVERS) {
 		GDREGISTER_CLASS(DataBuffer);
 		GDREGISTER_CLASS(SceneDiff);
+		GDREGISTER_CLASS(GdDeferredKinematics);
 		GDREGISTER_CLASS(GdNetworkedController);
 		GDREGISTER_CLASS(GdSceneSynchronizer);
 		GDREGISTER_CLASS(InputNetworkEncoder);
@@ -70,6 +74,12 @@ void initialize_network_synchronizer_module(ModuleInitializationLevel p_level) {
 #ifdef DEBUG_ENABLED
 		NS_GD_Test::test_var_data_conversin();
 		NS_Test::test_all();
+
+		// The benchmarks are slow, so these run only when explicitly requested:
+		// `godot --headless --editor --quit -- --ns-benchmark`
+		if (OS::get_singleton()->get_cmdline_user_args().find("--ns-benchmark")) {
+			print_line(String(NS_Test::benchmark_all().c_str()));
+		}
 #endif
 	}
 }
@@ -0,0 +1,150 @@
+#include "rewind_profiler.h"
+
+#include "core/error/error_macros.h"
+#include "core/math/math_funcs.h"
+#include "modules/network_synchronizer/core/object_data.h"
+#include <algorithm>
+#include <cmath>
+
+NS_NAMESPACE_BEGIN
+
+void RewindHistogram::add(double p_value) {
+	int bucket = 0;
+	if (p_value >= unit) {
+		// `frexp` returns the exponent `e` so that `value / unit` is in `[2^(e-1), 2^e)`.
+		std::frexp(p_value / unit, &bucket);
+		bucket = MIN(bucket, BUCKETS_COUNT - 1);
+	}
+	buckets[bucket] += 1;
+	count += 1;
+	sum += p_value;
+	max = MAX(max, p_value);
+}
+
+void RewindHistogram::reset() {
+	for (int i = 0; i < BUCKETS_COUNT; i++) {
+		buckets[i] = 0;
+	}
+	count = 0;
+	sum = 0.0;
+	max = 0.0;
+}
+
+double RewindHistogram::get_average() const {
+	return count == 0 ? 0.0 : sum / double(count);
+}
+
+double RewindHistogram::get_bucket_upper_bound(int p_bucket) const {
+	ERR_FAIL_INDEX_V(p_bucket, BUCKETS_COUNT, 0.0);
+	return std::ldexp(unit, p_bucket);
+}
+
+double RewindHistogram::get_percentile(double p_percentile) const {
+	if (count == 0) {
+		return 0.0;
+	}
+
+	const uint64_t target = MAX(uint64_t(1), uint64_t(std::ceil(CLAMP(p_percentile, 0.0, 1.0) * double(count))));
+	uint64_t accumulated = 0;
+	for (int i = 0; i < BUCKETS_COUNT; i++) {
+		accumulated += buckets[i];
+		if (accumulated >= target) {
+			// The last bucket has no upper bound, so the max is more accurate.
+			return i == BUCKETS_COUNT - 1 ? max : MIN(max, get_bucket_upper_bound(i));
+		}
+	}
+	return max;
+}
+
+void RewindProfiler::set_enabled(bool p_enabled) {
+	enabled = p_enabled;
+	pending_triggers.clear();
+}
+
+void RewindProfiler::reset() {
+	rewinds_count = 0;
+	depth_frames.reset();
+	sync_usec.reset();
+	rewind_usec.reset();
+	divergence.reset();
+	triggers.clear();
+	pending_triggers.clear();
+}
+
+void RewindProfiler::notify_trigger(const ObjectData &p_object_data, VarId p_var_id, const Variant &p_server_value, const Variant &p_client_value) {
+	if (!enabled) {
+		return;
+	}
+	const uint64_t key = (uint64_t(p_object_data.get_net_id().id) << 32) | uint64_t(p_var_id.id);
+
+	RewindTriggerStats &stats = triggers[key];
+	if (stats.object_name != p_object_data.object_name) {
+		// This is a new trigger, or the `ObjectNetId` was reassigned.
+		stats = RewindTriggerStats();
+		stats.object_name = p_object_data.object_name;
+		if (p_var_id.id < p_object_data.vars.size()) {
+			stats.var_name = p_object_data.get_variable_name(p_var_id);
+		}
+	}
+
+	pending_triggers.push_back({ key, compute_divergence(p_server_value, p_client_value) });
+}
+
+void RewindProfiler::discard_pending_triggers() {
+	pending_triggers.clear();
+}
+
+void RewindProfiler::notify_rewind(int p_depth_frames, uint64_t p_sync_usec, uint64_t p_rewind_usec) {
+	if (!enabled) {
+		return;
+	}
+
+	rewinds_count += 1;
+	depth_frames.add(p_depth_frames);
+	sync_usec.add(p_sync_usec);
+	rewind_usec.add(p_rewind_usec);
+
+	for (const PendingTrigger &pending : pending_triggers) {
+		RewindTriggerStats &stats = triggers[pending.key];
+		stats.rewinds_count += 1;
+		stats.frames_count += p_depth_frames;
+		stats.rewinds_usec += p_sync_usec + p_rewind_usec;
+		stats.divergence.add(pending.divergence);
+		divergence.add(pending.divergence);
+	}
+	pending_triggers.clear();
+}
+
+std::vector<RewindTriggerStats> RewindProfiler::get_triggers() const {
+	std::vector<RewindTriggerStats> sorted;
+	sorted.reserve(triggers.size());
+	for (const auto &it : triggers) {
+		if (it.second.rewinds_count > 0) {
+			sorted.push_back(it.second);
+		}
+	}
+	std::sort(sorted.begin(), sorted.end(), [](const RewindTriggerStats &p_a, const RewindTriggerStats &p_b) -> bool {
+		return p_a.rewinds_usec > p_b.rewinds_usec;
+	});
+	return sorted;
+}
+
+double RewindProfiler::compute_divergence(const Variant &p_a, const Variant &p_b) {
+	if (p_a.get_type() != p_b.get_type()) {
+		return 1.0;
+	}
+
+	switch (p_a.get_type()) {
+		case Variant::INT:
+		case Variant::FLOAT:
+			return Math::abs(double(p_a) - double(p_b));
+		case Variant::VECTOR2:
+			return Vector2(p_a).distance_to(Vector2(p_b));
+		case Variant::VECTOR3:
+			return Vector3(p_a).distance_to(Vector3(p_b));
+		default:
+			return p_a == p_b ? 0.0 : 1.0;
+	}
+}
+
+NS_NAMESPACE_END
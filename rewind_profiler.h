@@ -0,0 +1,111 @@
+#pragma once
+
+#include "core/templates/local_vector.h"
+#include "core/variant/variant.h"
+#include "modules/network_synchronizer/core/core.h"
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+NS_NAMESPACE_BEGIN
+
+struct ObjectData;
+
+/// The smallest divergence the histograms distinguish.
+constexpr double REWIND_DIVERGENCE_UNIT = 0.0001;
+
+/// Histogram with power of two buckets: the bucket `0` counts the values
+/// smaller than `unit`, while the bucket `i` counts the values in
+/// `[unit * 2^(i-1), unit * 2^i)`. The last bucket counts everything above.
+struct RewindHistogram {
+	static constexpr int BUCKETS_COUNT = 24;
+
+	double unit = 1.0;
+	uint64_t buckets[BUCKETS_COUNT] = {};
+	uint64_t count = 0;
+	double sum = 0.0;
+	double max = 0.0;
+
+public:
+	RewindHistogram(double p_unit = 1.0) :
+			unit(p_unit) {}
+
+	void add(double p_value);
+	void reset();
+
+	double get_average() const;
+	/// Returns the upper bound of the bucket `p_bucket`.
+	double get_bucket_upper_bound(int p_bucket) const;
+	/// Returns the upper bound of the bucket containing the percentile
+	/// `p_percentile`, which goes from 0.0 to 1.0.
+	double get_percentile(double p_percentile) const;
+};
+
+/// The statistics of a variable that triggered at least one rewind.
+struct RewindTriggerStats {
+	std::string object_name;
+	std::string var_name;
+	/// How many rewinds this variable triggered.
+	uint64_t rewinds_count = 0;
+	/// The sum of the rewinding depth (in frames) of the triggered rewinds.
+	uint64_t frames_count = 0;
+	/// The time spent (in microseconds) by the triggered rewinds.
+	uint64_t rewinds_usec = 0;
+	RewindHistogram divergence = RewindHistogram(REWIND_DIVERGENCE_UNIT);
+};
+
+/// Collects, at a really low cost, the statistics about the client rewinds:
+/// which variables triggered them, how much the client diverged from the
+/// server, how deep the rewind was and how much time it took.
+/// It's disabled by default; unlike the `event_desync_detected` it works on
+/// release builds too, so it can be used to tune the tolerances.
+class RewindProfiler {
+	struct PendingTrigger {
+		uint64_t key;
+		double divergence;
+	};
+
+	bool enabled = false;
+
+	uint64_t rewinds_count = 0;
+	RewindHistogram depth_frames = RewindHistogram(1.0);
+	RewindHistogram sync_usec = RewindHistogram(1.0);
+	RewindHistogram rewind_usec = RewindHistogram(1.0);
+	RewindHistogram divergence = RewindHistogram(REWIND_DIVERGENCE_UNIT);
+
+	/// The key is composed by the `ObjectNetId` and the `VarId`.
+	std::map<uint64_t, RewindTriggerStats> triggers;
+	LocalVector<PendingTrigger> pending_triggers;
+
+public:
+	void set_enabled(bool p_enabled);
+	bool is_enabled() const { return enabled; }
+
+	/// Clears all the collected statistics.
+	void reset();
+
+	/// Called by the snapshot comparison for each variable that requires a
+	/// rewind: the triggers are kept pending until `notify_rewind` is called.
+	void notify_trigger(const ObjectData &p_object_data, VarId p_var_id, const Variant &p_server_value, const Variant &p_client_value);
+	/// Drops the triggers collected so far, when no rewind is performed.
+	void discard_pending_triggers();
+	/// Commits the pending triggers, and registers the rewind cost.
+	void notify_rewind(int p_depth_frames, uint64_t p_sync_usec, uint64_t p_rewind_usec);
+
+	uint64_t get_rewinds_count() const { return rewinds_count; }
+	const RewindHistogram &get_depth_frames() const { return depth_frames; }
+	const RewindHistogram &get_sync_usec() const { return sync_usec; }
+	const RewindHistogram &get_rewind_usec() const { return rewind_usec; }
+	const RewindHistogram &get_divergence() const { return divergence; }
+
+	/// Returns the triggers statistics, sorted by the time spent rewinding:
+	/// the most expensive first.
+	std::vector<RewindTriggerStats> get_triggers() const;
+
+	/// Returns how much the two values diverge: the distance for numbers and
+	/// vectors, `1.0` for any other different value.
+	static double compute_divergence(const Variant &p_a, const Variant &p_b);
+};
+
+NS_NAMESPACE_END
@@ -7,26 +7,33 @@ namespace NS {
 class SceneSynchronizerBase;
 }; //namespace NS
 
-struct VarDiff {
-	bool is_different = false;
-	Variant value;
-};
-
 /// This class is used to track the scene changes during a particular period of
 /// the frame. You can use it to generate partial FrameSnapshot that contains
 /// only portion of a change.
+///
+/// While the tracking is in progress, the `SceneDiff` records the variables
+/// changes detected by the `SceneSynchronizer` into a per object bitmask, so
+/// the tracking costs only what changed.
 class SceneDiff : public Object {
 	friend NS::SceneSynchronizerBase;
 
 	uint32_t start_tracking_count = 0;
-	LocalVector<LocalVector<Variant>> tracking;
-	LocalVector<LocalVector<VarDiff>> diff;
+	const NS::SceneSynchronizerBase *tracking_synchronizer = nullptr;
+
+	/// The changed variables: indexed by `ObjectNetId`, each object has a
+	/// bitmask where the bit `VarId` is set when the variable changed.
+	LocalVector<LocalVector<uint64_t>> changes;
 
 public:
 	SceneDiff() = default;
-
-	void start_tracking_scene_changes(const NS::SceneSynchronizerBase *p_synchronizer, const LocalVector<NS::ObjectData *> &p_nodes);
-	void stop_tracking_scene_changes(const NS::SceneSynchronizerBase *p_synchronizer);
+	~SceneDiff();
 
 	bool is_tracking_in_progress() const;
+
+	void notify_variable_changed(NS::ObjectNetId p_object_id, NS::VarId p_var_id);
+	bool is_variable_changed(NS::ObjectNetId p_object_id, NS::VarId p_var_id) const;
+	bool is_object_changed(NS::ObjectNetId p_object_id) const;
+	uint32_t get_objects_count() const { return changes.size(); }
+
+	void clear_changes();
 };
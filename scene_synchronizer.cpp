@@ -1,26 +1,25 @@
 
 #include "scene_synchronizer.h"
 
+#include "core/config/engine.h"
+#include "core/config/project_settings.h"
 #include "core/error/error_macros.h"
+#include "core/io/marshalls.h"
 #include "core/object/object.h"
 #include "core/os/os.h"
 #include "core/templates/oa_hash_map.h"
 #include "core/variant/variant.h"
-#include "input_network_encoder.h"
 #include "modules/network_synchronizer/core/core.h"
 #include "modules/network_synchronizer/core/network_interface.h"
 #include "modules/network_synchronizer/core/object_data.h"
 #include "modules/network_synchronizer/core/processor.h"
 #include "modules/network_synchronizer/data_buffer.h"
-#include "modules/network_synchronizer/godot4/gd_network_interface.h"
 #include "modules/network_synchronizer/net_utilities.h"
 #include "modules/network_synchronizer/networked_controller.h"
 #include "modules/network_synchronizer/snapshot.h"
-#include "modules/network_synchronizer/tests/local_scene.h"
 #include "scene_diff.h"
 #include "scene_synchronizer_debugger.h"
 #include <limits>
-#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -36,6 +35,11 @@ SceneSynchronizerBase::SceneSynchronizerBase(NetworkInterface *p_network_interfa
 }
 
 SceneSynchronizerBase::~SceneSynchronizerBase() {
+	for (SceneDiff *diff : tracking_scene_diffs) {
+		diff->start_tracking_count = 0;
+		diff->tracking_synchronizer = nullptr;
+	}
+	tracking_scene_diffs.clear();
 	clear();
 	uninit_synchronizer();
 	network_interface = nullptr;
@@ -59,6 +63,12 @@ void SceneSynchronizerBase::setup(SynchronizerManager &p_synchronizer_interface)
 					true,
 					false);
 
+	rpc_handler_notify_need_resync =
+			network_interface->rpc_config(
+					std::function<void(DataBuffer &)>(std::bind(&SceneSynchronizerBase::rpc__notify_need_resync, this, std::placeholders::_1)),
+					true,
+					false);
+
 	rpc_handler_set_network_enabled =
 			network_interface->rpc_config(
 					std::function<void(bool)>(std::bind(&SceneSynchronizerBase::rpc_set_network_enabled, this, std::placeholders::_1)),
@@ -71,12 +81,24 @@ void SceneSynchronizerBase::setup(SynchronizerManager &p_synchronizer_interface)
 					true,
 					false);
 
+	rpc_handler_notify_spectator_mode =
+			network_interface->rpc_config(
+					std::function<void(bool)>(std::bind(&SceneSynchronizerBase::rpc_notify_spectator_mode, this, std::placeholders::_1)),
+					true,
+					false);
+
 	rpc_handler_deferred_sync_data =
 			network_interface->rpc_config(
 					std::function<void(const Vector<uint8_t> &)>(std::bind(&SceneSynchronizerBase::rpc_deferred_sync_data, this, std::placeholders::_1)),
 					false,
 					false);
 
+	rpc_handler_doll_inputs =
+			network_interface->rpc_config(
+					std::function<void(const Vector<uint8_t> &)>(std::bind(&SceneSynchronizerBase::rpc_doll_inputs, this, std::placeholders::_1)),
+					false,
+					false);
+
 	clear();
 	reset_synchronizer_mode();
 
@@ -106,9 +128,11 @@ void SceneSynchronizerBase::conclude() {
 
 	rpc_handler_state.reset();
 	rpc_handler_notify_need_full_snapshot.reset();
+	rpc_handler_notify_need_resync.reset();
 	rpc_handler_set_network_enabled.reset();
 	rpc_handler_notify_peer_status.reset();
 	rpc_handler_deferred_sync_data.reset();
+	rpc_handler_doll_inputs.reset();
 }
 
 void SceneSynchronizerBase::process() {
@@ -135,6 +159,23 @@ int SceneSynchronizerBase::get_max_deferred_nodes_per_update() const {
 	return max_deferred_nodes_per_update;
 }
 
+void SceneSynchronizerBase::set_deferred_sync_delta_enabled(bool p_enabled) {
+	deferred_sync_delta_enabled = p_enabled;
+}
+
+bool SceneSynchronizerBase::is_deferred_sync_delta_enabled() const {
+	return deferred_sync_delta_enabled;
+}
+
+void SceneSynchronizerBase::set_deferred_sync_keyframe_interval(int p_interval) {
+	ERR_FAIL_COND_MSG(p_interval < 0, "The keyframe interval can't be negative.");
+	deferred_sync_keyframe_interval = p_interval;
+}
+
+int SceneSynchronizerBase::get_deferred_sync_keyframe_interval() const {
+	return deferred_sync_keyframe_interval;
+}
+
 void SceneSynchronizerBase::set_server_notify_state_interval(real_t p_interval) {
 	server_notify_state_interval = p_interval;
 }
@@ -143,6 +184,49 @@ real_t SceneSynchronizerBase::get_server_notify_state_interval() const {
 	return server_notify_state_interval;
 }
 
+void SceneSynchronizerBase::set_join_stream_budget(int p_objects) {
+	ERR_FAIL_COND_MSG(p_objects < 0, "The join stream budget can't be negative.");
+	join_stream_budget = p_objects;
+}
+
+int SceneSynchronizerBase::get_join_stream_budget() const {
+	return join_stream_budget;
+}
+
+void SceneSynchronizerBase::set_spectator_mode(bool p_enabled) {
+	if (spectator_mode == p_enabled) {
+		return;
+	}
+	spectator_mode = p_enabled;
+	if (is_client()) {
+		reset_synchronizer_mode();
+		if (!p_enabled) {
+			// The spectator mode is notified by `init_synchronizer`.
+			rpc_handler_notify_spectator_mode.rpc(*network_interface, network_interface->get_server_peer(), false);
+		}
+	}
+}
+
+bool SceneSynchronizerBase::is_spectator_mode() const {
+	return spectator_mode;
+}
+
+void SceneSynchronizerBase::set_spectator_interpolation_delay(real_t p_delay) {
+	ERR_FAIL_COND_MSG(p_delay < 0.0, "The spectator interpolation delay can't be negative.");
+	spectator_interpolation_delay = p_delay;
+}
+
+real_t SceneSynchronizerBase::get_spectator_interpolation_delay() const {
+	return spectator_interpolation_delay;
+}
+
+bool SceneSynchronizerBase::is_join_streaming() const {
+	if (is_client()) {
+		return static_cast<const ClientSynchronizer *>(synchronizer)->join_streaming;
+	}
+	return false;
+}
+
 void SceneSynchronizerBase::set_nodes_relevancy_update_time(real_t p_time) {
 	nodes_relevancy_update_time = p_time;
 }
@@ -151,6 +235,14 @@ real_t SceneSynchronizerBase::get_nodes_relevancy_update_time() const {
 	return nodes_relevancy_update_time;
 }
 
+void SceneSynchronizerBase::set_rewind_profiler_enabled(bool p_enabled) {
+	rewind_profiler.set_enabled(p_enabled);
+}
+
+bool SceneSynchronizerBase::is_rewind_profiler_enabled() const {
+	return rewind_profiler.is_enabled();
+}
+
 bool SceneSynchronizerBase::is_variable_registered(ObjectLocalId p_id, const StringName &p_variable) const {
 	const ObjectData *od = objects_data_storage.get_object_data(p_id);
 	if (od != nullptr) {
@@ -177,7 +269,7 @@ void SceneSynchronizerBase::register_app_object(ObjectHandle p_app_object_handle
 		od->set_net_id(ObjectNetId::NONE);
 		od->instance_id = synchronizer_manager->get_object_id(p_app_object_handle);
 		od->object_name = synchronizer_manager->get_object_name(p_app_object_handle);
-		od->app_object_handle = p_app_object_handle;
+		objects_data_storage.object_set_app_object_handle(*od, p_app_object_handle);
 
 		od->set_controller(synchronizer_manager->extract_network_controller(p_app_object_handle));
 		if (od->get_controller()) {
@@ -185,7 +277,9 @@ void SceneSynchronizerBase::register_app_object(ObjectHandle p_app_object_handle
 				ERR_PRINT("This controller already has a synchronizer. This is a bug!");
 			}
 
-			dirty_peers();
+			if (!bulk_registration_in_progress) {
+				dirty_peers();
+			}
 		}
 
 		if (generate_id) {
@@ -205,7 +299,10 @@ void SceneSynchronizerBase::register_app_object(ObjectHandle p_app_object_handle
 			process_functions__clear();
 		}
 
-		if (synchronizer) {
+		if (bulk_registration_in_progress) {
+			od->bulk_registration_pending = true;
+			bulk_registered_objects.push_back(od);
+		} else if (synchronizer) {
 			synchronizer->on_object_data_added(od);
 		}
 
@@ -213,7 +310,9 @@ void SceneSynchronizerBase::register_app_object(ObjectHandle p_app_object_handle
 
 		synchronizer_manager->setup_synchronizer_for(p_app_object_handle, id);
 
-		SceneSynchronizerDebugger::singleton()->debug_print(network_interface, "New node registered" + (generate_id ? String(" #ID: ") + itos(od->get_net_id().id) : "") + " : " + od->object_name.c_str());
+		if (!bulk_registration_in_progress) {
+			NS_DEBUG_PRINT(network_interface, "New node registered" + (generate_id ? String(" #ID: ") + itos(od->get_net_id().id) : "") + " : " + od->object_name.c_str(), false);
+		}
 
 		if (od->get_controller()) {
 			od->get_controller()->notify_registered_with_synchronizer(this, *od);
@@ -223,6 +322,50 @@ void SceneSynchronizerBase::register_app_object(ObjectHandle p_app_object_handle
 	CRASH_COND(id == ObjectLocalId::NONE);
 }
 
+void SceneSynchronizerBase::register_app_objects(const std::vector<ObjectHandle> &p_app_object_handles, std::vector<ObjectLocalId> *r_ids) {
+	ERR_FAIL_COND_MSG(bulk_registration_in_progress, "The objects can't be registered in bulk while `register_app_objects` is running.");
+
+	if (r_ids) {
+		r_ids->clear();
+		r_ids->reserve(p_app_object_handles.size());
+	}
+
+	objects_data_storage.reserve(p_app_object_handles.size());
+	bulk_registered_objects.clear();
+	bulk_registered_objects.reserve(p_app_object_handles.size());
+	bulk_registration_in_progress = true;
+
+	for (ObjectHandle handle : p_app_object_handles) {
+		ObjectLocalId id = ObjectLocalId::NONE;
+		register_app_object(handle, &id);
+		if (r_ids) {
+			r_ids->push_back(id);
+		}
+	}
+
+	bulk_registration_in_progress = false;
+
+	// Commit the registration: everything that depends on the registered
+	// objects is updated once.
+	bool has_controllers = false;
+	for (ObjectData *od : bulk_registered_objects) {
+		od->bulk_registration_pending = false;
+		has_controllers = has_controllers || od->get_controller() != nullptr;
+	}
+
+	if (synchronizer && !bulk_registered_objects.is_empty()) {
+		synchronizer->on_objects_data_added(bulk_registered_objects);
+	}
+
+	if (has_controllers) {
+		dirty_peers();
+	}
+	process_functions__clear();
+
+	NS_DEBUG_PRINT(network_interface, "Registered " + itos(bulk_registered_objects.size()) + " nodes in bulk.", false);
+	bulk_registered_objects.clear();
+}
+
 void SceneSynchronizerBase::unregister_app_object(ObjectLocalId p_id) {
 	if (p_id == ObjectLocalId::NONE) {
 		// Nothing to do.
@@ -245,27 +388,7 @@ void SceneSynchronizerBase::register_variable(ObjectLocalId p_id, const StringNa
 	NS::ObjectData *object_data = get_object_data(p_id);
 	ERR_FAIL_COND(object_data == nullptr);
 
-	VarId var_id = object_data->find_variable_id(std::string(String(p_variable).utf8()));
-	if (var_id == VarId::NONE) {
-		// The variable is not yet registered.
-		bool valid = false;
-		Variant old_val;
-		valid = synchronizer_manager->get_variable(object_data->app_object_handle, String(p_variable).utf8(), old_val);
-		if (valid == false) {
-			SceneSynchronizerDebugger::singleton()->debug_error(network_interface, "The variable `" + p_variable + "` on the node `" + String(object_data->object_name.c_str()) + "` was not found, make sure the variable exist.");
-		}
-		var_id = VarId{ uint32_t(object_data->vars.size()) };
-		object_data->vars.push_back(
-				NS::VarDescriptor(
-						var_id,
-						p_variable,
-						old_val,
-						false,
-						true));
-	} else {
-		// Make sure the var is active.
-		object_data->vars[var_id.id].enabled = true;
-	}
+	register_variable_data(*object_data, p_variable, std::string(String(p_variable).utf8()));
 
 #ifdef DEBUG_ENABLED
 	for (VarId v = { 0 }; v < VarId{ uint32_t(object_data->vars.size()) }; v += 1) {
@@ -274,11 +397,55 @@ void SceneSynchronizerBase::register_variable(ObjectLocalId p_id, const StringNa
 	}
 #endif
 
-	if (synchronizer) {
+	if (synchronizer && !object_data->bulk_registration_pending) {
 		synchronizer->on_variable_added(object_data, p_variable);
 	}
 }
 
+void SceneSynchronizerBase::register_variables(ObjectLocalId p_id, const std::vector<VarSpec> &p_variables) {
+	ERR_FAIL_COND(p_id == ObjectLocalId::NONE);
+
+	NS::ObjectData *object_data = get_object_data(p_id);
+	ERR_FAIL_COND(object_data == nullptr);
+
+	object_data->vars.reserve(object_data->vars.size() + p_variables.size());
+
+	for (const VarSpec &spec : p_variables) {
+		ERR_CONTINUE(spec.name == StringName());
+
+		const VarId var_id = register_variable_data(*object_data, spec.name, std::string(String(spec.name).utf8()));
+		object_data->vars[var_id.id].skip_rewinding = spec.skip_rewinding;
+
+		if (synchronizer && !object_data->bulk_registration_pending) {
+			synchronizer->on_variable_added(object_data, spec.name);
+		}
+	}
+
+#ifdef DEBUG_ENABLED
+	for (VarId v = { 0 }; v < VarId{ uint32_t(object_data->vars.size()) }; v += 1) {
+		// This can't happen, because the IDs are always consecutive, or NONE.
+		CRASH_COND(object_data->vars[v.id].id != v);
+	}
+#endif
+}
+
+VarId SceneSynchronizerBase::register_variable_data(NS::ObjectData &p_object_data, const StringName &p_variable, const std::string &p_variable_name) {
+	VarId var_id = p_object_data.find_variable_id(p_variable_name);
+	if (var_id == VarId::NONE) {
+		// The variable is not yet registered.
+		Variant old_val;
+		const bool valid = synchronizer_manager->get_variable(p_object_data.app_object_handle, p_variable_name.c_str(), old_val);
+		if (valid == false) {
+			NS_DEBUG_ERROR(network_interface, "The variable `" + p_variable + "` on the node `" + String(p_object_data.object_name.c_str()) + "` was not found, make sure the variable exist.", false);
+		}
+		var_id = p_object_data.add_variable(p_variable_name, old_val, false);
+	} else {
+		// Make sure the var is active.
+		p_object_data.vars[var_id.id].enabled = true;
+	}
+	return var_id;
+}
+
 void SceneSynchronizerBase::unregister_variable(ObjectLocalId p_id, const StringName &p_variable) {
 	ERR_FAIL_COND(p_id == ObjectLocalId::NONE);
 	ERR_FAIL_COND(p_variable == StringName());
@@ -376,20 +543,42 @@ ListenerHandle SceneSynchronizerBase::track_variables_changes(
 		const std::vector<StringName> &p_variables,
 		std::function<void(const std::vector<Variant> &p_old_values)> p_listener_func,
 		NetEventFlag p_flags) {
-	ERR_FAIL_COND_V_MSG(p_object_ids.size() != p_variables.size(), nulllistenerhandle, "object_ids and variables should have the exact same size.");
-	ERR_FAIL_COND_V_MSG(p_object_ids.size() == 0, nulllistenerhandle, "object_ids can't be of size 0");
-	ERR_FAIL_COND_V_MSG(p_variables.size() == 0, nulllistenerhandle, "object_ids can't be of size 0");
-
-	bool is_valid = true;
-
 	// TODO allocate into a buffer instead of using `new`?
 	ChangesListener *listener = new ChangesListener;
 	listener->listener_func = p_listener_func;
 	listener->flag = p_flags;
+	return track_changes(listener, p_object_ids, p_variables);
+}
+
+ListenerHandle SceneSynchronizerBase::track_variables_changes_batched(
+		const std::vector<ObjectLocalId> &p_object_ids,
+		const std::vector<StringName> &p_variables,
+		std::function<void(const std::vector<VarChange> &p_changes)> p_listener_func,
+		NetEventFlag p_flags) {
+	ChangesListener *listener = new ChangesListener;
+	listener->batched_listener_func = p_listener_func;
+	listener->flag = p_flags;
+	return track_changes(listener, p_object_ids, p_variables);
+}
+
+ListenerHandle SceneSynchronizerBase::track_changes(
+		ChangesListener *p_listener,
+		const std::vector<ObjectLocalId> &p_object_ids,
+		const std::vector<StringName> &p_variables) {
+	ChangesListener *listener = p_listener;
+	bool is_valid = true;
+
+	if (p_object_ids.size() != p_variables.size()) {
+		ERR_PRINT("object_ids and variables should have the exact same size.");
+		is_valid = false;
+	} else if (p_object_ids.size() == 0) {
+		ERR_PRINT("object_ids can't be of size 0");
+		is_valid = false;
+	}
 
 	listener->watching_vars.resize(p_object_ids.size());
 	listener->old_values.resize(p_object_ids.size());
-	for (int i = 0; i < int(p_object_ids.size()); i++) {
+	for (int i = 0; is_valid && i < int(p_object_ids.size()); i++) {
 		ObjectLocalId id = p_object_ids[i];
 		const StringName variable_name = p_variables[i];
 
@@ -489,7 +678,95 @@ void SceneSynchronizerBase::setup_deferred_sync(ObjectLocalId p_id, const Callab
 	ERR_FAIL_COND(!od);
 	od->collect_epoch_func = p_collect_epoch_func;
 	od->apply_epoch_func = p_apply_epoch_func;
-	SceneSynchronizerDebugger::singleton()->debug_print(network_interface, "Setup deferred sync functions for: `" + String(od->object_name.c_str()) + "`. Collect epoch, method name: `" + p_collect_epoch_func.get_method() + "`. Apply epoch, method name: `" + p_apply_epoch_func.get_method() + "`.");
+	NS_DEBUG_PRINT(network_interface, "Setup deferred sync functions for: `" + String(od->object_name.c_str()) + "`. Collect epoch, method name: `" + p_collect_epoch_func.get_method() + "`. Apply epoch, method name: `" + p_apply_epoch_func.get_method() + "`.", false);
+}
+
+void SceneSynchronizerBase::set_deferred_max_extrapolation(ObjectLocalId p_id, real_t p_max_intervals) {
+	ERR_FAIL_COND_MSG(p_max_intervals < 0.0, "The max extrapolation can't be negative.");
+	NS::ObjectData *od = get_object_data(p_id);
+	ERR_FAIL_COND(od == nullptr);
+	od->deferred_max_extrapolation = p_max_intervals;
+}
+
+real_t SceneSynchronizerBase::get_deferred_max_extrapolation(ObjectLocalId p_id) const {
+	const NS::ObjectData *od = get_object_data(p_id);
+	ERR_FAIL_COND_V(od == nullptr, 0.0);
+	return od->deferred_max_extrapolation;
+}
+
+void SceneSynchronizerBase::set_sleep_idle_ticks(ObjectLocalId p_id, uint32_t p_idle_ticks) {
+	NS::ObjectData *od = get_object_data(p_id);
+	ERR_FAIL_COND(od == nullptr);
+	od->sleep_idle_ticks = p_idle_ticks;
+	if (p_idle_ticks == 0 && od->sleeping) {
+		wake_object(*od);
+	}
+}
+
+uint32_t SceneSynchronizerBase::get_sleep_idle_ticks(ObjectLocalId p_id) const {
+	const NS::ObjectData *od = get_object_data(p_id);
+	ERR_FAIL_COND_V(od == nullptr, 0);
+	return od->sleep_idle_ticks;
+}
+
+bool SceneSynchronizerBase::is_sleeping(ObjectLocalId p_id) const {
+	const NS::ObjectData *od = get_object_data(p_id);
+	ERR_FAIL_COND_V(od == nullptr, false);
+	return od->sleeping;
+}
+
+void SceneSynchronizerBase::wake_up(ObjectLocalId p_id) {
+	NS::ObjectData *od = get_object_data(p_id);
+	ERR_FAIL_COND(od == nullptr);
+	if (od->sleeping) {
+		wake_object(*od);
+	} else {
+		// Postpone the sleep.
+		od->idle_ticks = 0;
+	}
+}
+
+void SceneSynchronizerBase::set_process_rate_divisor(ObjectLocalId p_id, uint32_t p_divisor) {
+	ERR_FAIL_COND_MSG(p_divisor == 0, "The process rate divisor can't be 0.");
+	NS::ObjectData *od = get_object_data(p_id);
+	ERR_FAIL_COND(od == nullptr);
+	ERR_FAIL_COND_MSG(p_divisor > 1 && od->get_controller(), "The controllers are always processed at full rate.");
+	if (od->process_rate_divisor == p_divisor) {
+		return;
+	}
+	od->process_rate_divisor = p_divisor;
+	od->process_last_tick = process_tick;
+	process_functions__clear();
+
+	if (is_server()) {
+		// Sends the divisor to the clients.
+		static_cast<ServerSynchronizer *>(synchronizer)->notify_object_unknown(od);
+	}
+}
+
+uint32_t SceneSynchronizerBase::get_process_rate_divisor(ObjectLocalId p_id) const {
+	const NS::ObjectData *od = get_object_data(p_id);
+	ERR_FAIL_COND_V(od == nullptr, 1);
+	return od->process_rate_divisor;
+}
+
+void SceneSynchronizerBase::add_wake_trigger(ObjectLocalId p_id, ObjectLocalId p_trigger_id) {
+	ERR_FAIL_COND(p_id == ObjectLocalId::NONE);
+	ERR_FAIL_COND(p_id == p_trigger_id);
+	NS::ObjectData *trigger_od = get_object_data(p_trigger_id);
+	ERR_FAIL_COND(trigger_od == nullptr);
+	if (ns_find(trigger_od->wake_dependents, p_id) == trigger_od->wake_dependents.end()) {
+		trigger_od->wake_dependents.push_back(p_id);
+	}
+}
+
+void SceneSynchronizerBase::remove_wake_trigger(ObjectLocalId p_id, ObjectLocalId p_trigger_id) {
+	NS::ObjectData *trigger_od = get_object_data(p_trigger_id);
+	ERR_FAIL_COND(trigger_od == nullptr);
+	auto it = ns_find(trigger_od->wake_dependents, p_id);
+	if (it != trigger_od->wake_dependents.end()) {
+		trigger_od->wake_dependents.erase(it);
+	}
 }
 
 SyncGroupId SceneSynchronizerBase::sync_group_create() {
@@ -529,6 +806,49 @@ void SceneSynchronizerBase::sync_group_replace_nodes(SyncGroupId p_group_id, Loc
 	static_cast<ServerSynchronizer *>(synchronizer)->sync_group_replace_nodes(p_group_id, std::move(p_new_realtime_nodes), std::move(p_new_deferred_nodes));
 }
 
+void SceneSynchronizerBase::sync_group_replace_nodes_by_id(SyncGroupId p_group_id, const LocalVector<ObjectNetId> &p_realtime_node_ids, const LocalVector<ObjectNetId> &p_deferred_node_ids, const LocalVector<real_t> &p_deferred_update_rates) {
+	ERR_FAIL_COND_MSG(!is_server(), "This function CAN be used only on the server.");
+	ERR_FAIL_COND_MSG(!p_deferred_update_rates.is_empty() && p_deferred_update_rates.size() != p_deferred_node_ids.size(), "The deferred update rates must be empty or as many as the deferred nodes.");
+
+	LocalVector<NS::SyncGroup::RealtimeNodeInfo> realtime_nodes;
+	realtime_nodes.reserve(p_realtime_node_ids.size());
+	for (ObjectNetId id : p_realtime_node_ids) {
+		NS::ObjectData *od = get_object_data(id);
+		if (od) {
+			realtime_nodes.push_back(od);
+		}
+	}
+
+	LocalVector<NS::SyncGroup::DeferredNodeInfo> deferred_nodes;
+	deferred_nodes.reserve(p_deferred_node_ids.size());
+	for (uint32_t i = 0; i < p_deferred_node_ids.size(); i++) {
+		NS::ObjectData *od = get_object_data(p_deferred_node_ids[i]);
+		if (od) {
+			deferred_nodes.push_back(od);
+			if (!p_deferred_update_rates.is_empty()) {
+				deferred_nodes[deferred_nodes.size() - 1].update_rate = p_deferred_update_rates[i];
+			}
+		}
+	}
+
+	static_cast<ServerSynchronizer *>(synchronizer)->sync_group_replace_nodes(p_group_id, std::move(realtime_nodes), std::move(deferred_nodes));
+}
+
+void SceneSynchronizerBase::sync_group_remove_nodes_by_id(SyncGroupId p_group_id, const LocalVector<ObjectNetId> &p_node_ids) {
+	ERR_FAIL_COND_MSG(!is_server(), "This function CAN be used only on the server.");
+
+	LocalVector<NS::ObjectData *> objects_data;
+	objects_data.reserve(p_node_ids.size());
+	for (ObjectNetId id : p_node_ids) {
+		NS::ObjectData *od = get_object_data(id);
+		if (od) {
+			objects_data.push_back(od);
+		}
+	}
+
+	static_cast<ServerSynchronizer *>(synchronizer)->sync_group_remove_nodes(objects_data, p_group_id);
+}
+
 void SceneSynchronizerBase::sync_group_remove_all_nodes(SyncGroupId p_group_id) {
 	ERR_FAIL_COND_MSG(!is_server(), "This function CAN be used only on the server.");
 	static_cast<ServerSynchronizer *>(synchronizer)->sync_group_remove_all_nodes(p_group_id);
@@ -537,7 +857,7 @@ void SceneSynchronizerBase::sync_group_remove_all_nodes(SyncGroupId p_group_id)
 void SceneSynchronizerBase::sync_group_move_peer_to(int p_peer_id, SyncGroupId p_group_id) {
 	ERR_FAIL_COND_MSG(!is_server(), "This function CAN be used only on the server.");
 
-	NS::PeerData *pd = MapFunc::at(peer_data, p_peer_id);
+	NS::PeerData *pd = peer_data.find(p_peer_id);
 	ERR_FAIL_COND_MSG(pd == nullptr, "The PeerData doesn't exist. This looks like a bug. Are you sure the peer_id `" + itos(p_peer_id) + "` exists?");
 
 	if (pd->sync_group_id == p_group_id) {
@@ -553,7 +873,7 @@ void SceneSynchronizerBase::sync_group_move_peer_to(int p_peer_id, SyncGroupId p
 SyncGroupId SceneSynchronizerBase::sync_group_get_peer_group(int p_peer_id) const {
 	ERR_FAIL_COND_V_MSG(!is_server(), UINT32_MAX, "This function CAN be used only on the server.");
 
-	const NS::PeerData *pd = MapFunc::at(peer_data, p_peer_id);
+	const NS::PeerData *pd = peer_data.find(p_peer_id);
 	ERR_FAIL_COND_V_MSG(pd == nullptr, UINT32_MAX, "The PeerData doesn't exist. This looks like a bug. Are you sure the peer_id `" + itos(p_peer_id) + "` exists?");
 
 	return pd->sync_group_id;
@@ -588,6 +908,45 @@ real_t SceneSynchronizerBase::sync_group_get_deferred_update_rate(ObjectNetId p_
 	return static_cast<ServerSynchronizer *>(synchronizer)->sync_group_get_deferred_update_rate(od, p_group_id);
 }
 
+void SceneSynchronizerBase::sync_group_set_lod_policy(SyncGroupId p_group_id, const NS::LodPolicy &p_policy) {
+	ERR_FAIL_COND_MSG(!is_server(), "This function CAN be used only on the server.");
+	static_cast<ServerSynchronizer *>(synchronizer)->sync_group_set_lod_policy(p_group_id, p_policy);
+}
+
+NS::LodPolicy SceneSynchronizerBase::sync_group_get_lod_policy(SyncGroupId p_group_id) const {
+	ERR_FAIL_COND_V_MSG(!is_server(), NS::LodPolicy(), "This function CAN be used only on the server.");
+	return static_cast<ServerSynchronizer *>(synchronizer)->sync_group_get_lod_policy(p_group_id);
+}
+
+void SceneSynchronizerBase::sync_group_set_lod_metric(ObjectLocalId p_node_id, SyncGroupId p_group_id, real_t p_metric) {
+	NS::ObjectData *od = get_object_data(p_node_id);
+	ERR_FAIL_COND_MSG(!is_server(), "This function CAN be used only on the server.");
+	static_cast<ServerSynchronizer *>(synchronizer)->sync_group_set_lod_metric(od, p_group_id, p_metric);
+}
+
+void SceneSynchronizerBase::sync_group_set_lod_metric(ObjectNetId p_node_id, SyncGroupId p_group_id, real_t p_metric) {
+	NS::ObjectData *od = get_object_data(p_node_id);
+	ERR_FAIL_COND_MSG(!is_server(), "This function CAN be used only on the server.");
+	static_cast<ServerSynchronizer *>(synchronizer)->sync_group_set_lod_metric(od, p_group_id, p_metric);
+}
+
+NS::LodTier SceneSynchronizerBase::sync_group_get_lod_tier(ObjectLocalId p_node_id, SyncGroupId p_group_id) const {
+	const NS::ObjectData *od = get_object_data(p_node_id);
+	ERR_FAIL_COND_V_MSG(!is_server(), NS::LOD_TIER_COUNT, "This function CAN be used only on the server.");
+	return static_cast<ServerSynchronizer *>(synchronizer)->sync_group_get_lod_tier(od, p_group_id);
+}
+
+NS::LodTier SceneSynchronizerBase::sync_group_get_lod_tier(ObjectNetId p_node_id, SyncGroupId p_group_id) const {
+	const NS::ObjectData *od = get_object_data(p_node_id);
+	ERR_FAIL_COND_V_MSG(!is_server(), NS::LOD_TIER_COUNT, "This function CAN be used only on the server.");
+	return static_cast<ServerSynchronizer *>(synchronizer)->sync_group_get_lod_tier(od, p_group_id);
+}
+
+void SceneSynchronizerBase::sync_group_update_lod(SyncGroupId p_group_id) {
+	ERR_FAIL_COND_MSG(!is_server(), "This function CAN be used only on the server.");
+	static_cast<ServerSynchronizer *>(synchronizer)->sync_group_update_lod(p_group_id);
+}
+
 void SceneSynchronizerBase::sync_group_set_user_data(SyncGroupId p_group_id, uint64_t p_user_data) {
 	ERR_FAIL_COND_MSG(!is_server(), "This function CAN be used only on the server.");
 	return static_cast<ServerSynchronizer *>(synchronizer)->sync_group_set_user_data(p_group_id, p_user_data);
@@ -602,67 +961,101 @@ void SceneSynchronizerBase::start_tracking_scene_changes(Object *p_diff_handle)
 	ERR_FAIL_COND_MSG(!is_server(), "This function is supposed to be called only on server.");
 	SceneDiff *diff = Object::cast_to<SceneDiff>(p_diff_handle);
 	ERR_FAIL_COND_MSG(diff == nullptr, "The object is not a SceneDiff class.");
+	ERR_FAIL_COND_MSG(diff->tracking_synchronizer != nullptr && diff->tracking_synchronizer != this, "This SceneDiff is already tracking the changes of another SceneSynchronizer.");
 
-	// TODO add this back?
-	//diff->start_tracking_scene_changes(this, objects_data_storage.get_sorted_objects_data());
+	diff->start_tracking_count += 1;
+	if (diff->start_tracking_count == 1) {
+		diff->tracking_synchronizer = this;
+		tracking_scene_diffs.push_back(diff);
+	}
 }
 
 void SceneSynchronizerBase::stop_tracking_scene_changes(Object *p_diff_handle) const {
 	ERR_FAIL_COND_MSG(!is_server(), "This function is supposed to be called only on server.");
 	SceneDiff *diff = Object::cast_to<SceneDiff>(p_diff_handle);
 	ERR_FAIL_COND_MSG(diff == nullptr, "The object is not a SceneDiff class.");
+	ERR_FAIL_COND_MSG(diff->start_tracking_count == 0 || diff->tracking_synchronizer != this, "The tracking is not yet started on this SceneDiff, so can't be end.");
 
-	diff->stop_tracking_scene_changes(this);
+	diff->start_tracking_count -= 1;
+	if (diff->start_tracking_count == 0) {
+		scene_diff_tracking_dropped(diff);
+	}
 }
 
-Variant SceneSynchronizerBase::pop_scene_changes(Object *p_diff_handle) const {
+void SceneSynchronizerBase::scene_diff_tracking_dropped(SceneDiff *p_diff) const {
+	const int64_t index = tracking_scene_diffs.find(p_diff);
+	if (index >= 0) {
+		tracking_scene_diffs.remove_at_unordered(index);
+	}
+	p_diff->start_tracking_count = 0;
+	p_diff->tracking_synchronizer = nullptr;
+}
+
+bool SceneSynchronizerBase::pop_scene_changes(Object *p_diff_handle, DataBuffer &r_sync_data) const {
 	ERR_FAIL_COND_V_MSG(
 			synchronizer_type != SYNCHRONIZER_TYPE_SERVER,
-			Variant(),
+			false,
 			"This function is supposed to be called only on server.");
 
 	SceneDiff *diff = Object::cast_to<SceneDiff>(p_diff_handle);
 	ERR_FAIL_COND_V_MSG(
 			diff == nullptr,
-			Variant(),
+			false,
 			"The object is not a SceneDiff class.");
 
 	ERR_FAIL_COND_V_MSG(
 			diff->is_tracking_in_progress(),
-			Variant(),
+			false,
 			"You can't pop the changes while the tracking is still in progress.");
 
-	// Generates a sync_data and returns it.
-	Vector<Variant> ret;
-	for (ObjectNetId node_id = { 0 }; node_id < ObjectNetId{ diff->diff.size() }; node_id += 1) {
-		if (diff->diff[node_id.id].size() == 0) {
-			// Nothing to do.
+	// Generates a sync_data using the same format of the snapshot, but
+	// containing only the changed variables.
+	// NOTE: Check `ServerSynchronizer::generate_snapshot` to see the format.
+	r_sync_data.begin_write(0);
+	// No `InputID`.
+	r_sync_data.add(std::numeric_limits<std::uint32_t>::max());
+	// No active object list.
+	r_sync_data.add(false);
+	// Not part of a join.
+	r_sync_data.add(false);
+	// No custom data.
+	r_sync_data.add(false);
+
+	bool has_changes = false;
+	for (ObjectNetId object_id = { 0 }; object_id < ObjectNetId{ diff->get_objects_count() }; object_id += 1) {
+		if (!diff->is_object_changed(object_id)) {
 			continue;
 		}
 
-		bool node_id_in_ret = false;
-		for (VarId var_id = { 0 }; var_id < VarId{ diff->diff[node_id.id].size() }; var_id += 1) {
-			if (diff->diff[node_id.id][var_id.id].is_different == false) {
-				continue;
-			}
-			if (node_id_in_ret == false) {
-				node_id_in_ret = true;
-				// Set the node id.
-				ret.push_back(node_id.id);
-			}
-			ret.push_back(var_id.id);
-			ret.push_back(diff->diff[node_id.id][var_id.id].value);
+		const ObjectData *od = get_object_data(object_id, false);
+		if (od == nullptr) {
+			// The object was removed in the meantime.
+			continue;
 		}
-		if (node_id_in_ret) {
-			// Close the Node data.
-			ret.push_back(Variant());
+
+		has_changes = true;
+		r_sync_data.add(object_id.id);
+		// The object is already known by the client.
+		r_sync_data.add(false);
+
+		const std::uint8_t vars_count = od->vars.size();
+		r_sync_data.add(vars_count);
+		for (VarId var_id = { 0 }; var_id < VarId{ uint32_t(od->vars.size()) }; var_id += 1) {
+			const bool var_has_value = od->vars[var_id.id].enabled && diff->is_variable_changed(object_id, var_id);
+			r_sync_data.add(var_has_value);
+			if (var_has_value) {
+				r_sync_data.add_variant(od->vars[var_id.id].value);
+			}
 		}
 	}
 
+	// Mark the end.
+	r_sync_data.add(ObjectNetId::NONE.id);
+
 	// Clear the diff data.
-	diff->diff.clear();
+	diff->clear_changes();
 
-	return ret.size() > 0 ? Variant(ret) : Variant();
+	return has_changes;
 }
 
 void SceneSynchronizerBase::apply_scene_changes(DataBuffer &p_sync_data) {
@@ -692,16 +1085,13 @@ void SceneSynchronizerBase::apply_scene_changes(DataBuffer &p_sync_data) {
 			[](void *p_user_pointer, NS::ObjectData *p_object_data, VarId p_var_id, const Variant &p_value) {
 				SceneSynchronizerBase *scene_sync = static_cast<SceneSynchronizerBase *>(p_user_pointer);
 
-				const Variant current_val = p_object_data->vars[p_var_id.id].var.value;
+				const Variant current_val = p_object_data->vars[p_var_id.id].value;
 
 				if (scene_sync->network_interface->compare(current_val, p_value) == false) {
 					// There is a difference.
 					// Set the new value.
-					p_object_data->vars[p_var_id.id].var.value = p_value;
-					scene_sync->synchronizer_manager->set_variable(
-							p_object_data->app_object_handle,
-							p_object_data->vars[p_var_id.id].var.name.c_str(),
-							p_value);
+					p_object_data->vars[p_var_id.id].value = p_value;
+					scene_sync->variables_write(*p_object_data, p_var_id, p_value);
 
 					// Add an event.
 					scene_sync->change_event_add(
@@ -714,8 +1104,10 @@ void SceneSynchronizerBase::apply_scene_changes(DataBuffer &p_sync_data) {
 			// Parse node activation:
 			[](void *p_user_pointer, NS::ObjectData *p_object_data, bool p_is_active) {});
 
+	variables_write_flush();
+
 	if (success == false) {
-		SceneSynchronizerDebugger::singleton()->debug_error(network_interface, "DataBuffer parsing failed.");
+		NS_DEBUG_ERROR(network_interface, "DataBuffer parsing failed.", false);
 	}
 
 	change_events_flush();
@@ -740,10 +1132,8 @@ bool SceneSynchronizerBase::is_end_sync() const {
 void SceneSynchronizerBase::force_state_notify(SyncGroupId p_sync_group_id) {
 	ERR_FAIL_COND(is_server() == false);
 	ServerSynchronizer *r = static_cast<ServerSynchronizer *>(synchronizer);
-	// + 1.0 is just a ridiculous high number to be sure to avoid float
-	// precision error.
 	ERR_FAIL_COND_MSG(p_sync_group_id >= r->sync_groups.size(), "The group id `" + itos(p_sync_group_id) + "` doesn't exist.");
-	r->sync_groups[p_sync_group_id].state_notifier_timer = get_server_notify_state_interval() + 1.0;
+	r->sync_group_force_state_notify(r->sync_groups[p_sync_group_id]);
 }
 
 void SceneSynchronizerBase::force_state_notify_all() {
@@ -751,9 +1141,7 @@ void SceneSynchronizerBase::force_state_notify_all() {
 	ServerSynchronizer *r = static_cast<ServerSynchronizer *>(synchronizer);
 
 	for (uint32_t i = 0; i < r->sync_groups.size(); ++i) {
-		// + 1.0 is just a ridiculous high number to be sure to avoid float
-		// precision error.
-		r->sync_groups[i].state_notifier_timer = get_server_notify_state_interval() + 1.0;
+		r->sync_group_force_state_notify(r->sync_groups[i]);
 	}
 }
 
@@ -763,7 +1151,7 @@ void SceneSynchronizerBase::dirty_peers() {
 
 void SceneSynchronizerBase::set_enabled(bool p_enable) {
 	ERR_FAIL_COND_MSG(synchronizer_type == SYNCHRONIZER_TYPE_SERVER, "The server is always enabled.");
-	if (synchronizer_type == SYNCHRONIZER_TYPE_CLIENT) {
+	if (is_client()) {
 		rpc_handler_set_network_enabled.rpc(*network_interface, network_interface->get_server_peer(), p_enable);
 		if (p_enable == false) {
 			// If the peer want to disable, we can disable it locally
@@ -779,7 +1167,7 @@ void SceneSynchronizerBase::set_enabled(bool p_enable) {
 
 bool SceneSynchronizerBase::is_enabled() const {
 	ERR_FAIL_COND_V_MSG(synchronizer_type == SYNCHRONIZER_TYPE_SERVER, false, "The server is always enabled.");
-	if (likely(synchronizer_type == SYNCHRONIZER_TYPE_CLIENT)) {
+	if (likely(is_client())) {
 		return static_cast<ClientSynchronizer *>(synchronizer)->enabled;
 	} else if (synchronizer_type == SYNCHRONIZER_TYPE_NONETWORK) {
 		return static_cast<NoNetSynchronizer *>(synchronizer)->enabled;
@@ -792,7 +1180,7 @@ void SceneSynchronizerBase::set_peer_networking_enable(int p_peer, bool p_enable
 	if (synchronizer_type == SYNCHRONIZER_TYPE_SERVER) {
 		ERR_FAIL_COND_MSG(p_peer == 1, "Disable the server is not possible.");
 
-		NS::PeerData *pd = MapFunc::at(peer_data, p_peer);
+		NS::PeerData *pd = peer_data.find(p_peer);
 		ERR_FAIL_COND_MSG(pd == nullptr, "The peer: " + itos(p_peer) + " is not know. [bug]");
 
 		if (pd->enabled == p_enable) {
@@ -828,7 +1216,7 @@ bool SceneSynchronizerBase::is_peer_networking_enable(int p_peer) const {
 			return true;
 		}
 
-		const NS::PeerData *pd = MapFunc::at(peer_data, p_peer);
+		const NS::PeerData *pd = peer_data.find(p_peer);
 		ERR_FAIL_COND_V_MSG(pd == nullptr, false, "The peer: " + itos(p_peer) + " is not know. [bug]");
 		return pd->enabled;
 	} else {
@@ -837,8 +1225,15 @@ bool SceneSynchronizerBase::is_peer_networking_enable(int p_peer) const {
 	}
 }
 
+bool SceneSynchronizerBase::is_peer_spectator(int p_peer) const {
+	ERR_FAIL_COND_V_MSG(synchronizer_type != SYNCHRONIZER_TYPE_SERVER, false, "Only the server knows the spectators.");
+	const NS::PeerData *pd = peer_data.find(p_peer);
+	ERR_FAIL_COND_V_MSG(pd == nullptr, false, "The peer: " + itos(p_peer) + " is not know. [bug]");
+	return pd->spectator;
+}
+
 void SceneSynchronizerBase::on_peer_connected(int p_peer) {
-	peer_data.insert(std::pair(p_peer, NS::PeerData()));
+	peer_data.insert(p_peer);
 
 	event_peer_status_updated.broadcast(nullptr, p_peer, true, false);
 
@@ -850,7 +1245,7 @@ void SceneSynchronizerBase::on_peer_connected(int p_peer) {
 
 void SceneSynchronizerBase::on_peer_disconnected(int p_peer) {
 	// Emit a signal notifying this peer is gone.
-	NS::PeerData *pd = MapFunc::at(peer_data, p_peer);
+	NS::PeerData *pd = peer_data.find(p_peer);
 	ObjectNetId id = ObjectNetId::NONE;
 	NS::ObjectData *node_data = nullptr;
 	if (pd) {
@@ -860,10 +1255,10 @@ void SceneSynchronizerBase::on_peer_disconnected(int p_peer) {
 
 	event_peer_status_updated.broadcast(node_data, p_peer, false, false);
 
-	peer_data.erase(p_peer);
+	peer_data.remove(p_peer);
 
 #ifdef DEBUG_ENABLED
-	CRASH_COND_MSG(peer_data.count(p_peer) > 0, "The peer was just removed. This can't be triggered.");
+	CRASH_COND_MSG(peer_data.has(p_peer), "The peer was just removed. This can't be triggered.");
 #endif
 
 	if (synchronizer) {
@@ -881,6 +1276,9 @@ void SceneSynchronizerBase::init_synchronizer(bool p_was_generating_ids) {
 		synchronizer_type = SYNCHRONIZER_TYPE_SERVER;
 		synchronizer = memnew(ServerSynchronizer(this));
 		generate_id = true;
+	} else if (spectator_mode) {
+		synchronizer_type = SYNCHRONIZER_TYPE_SPECTATOR;
+		synchronizer = memnew(SpectatorSynchronizer(this));
 	} else {
 		synchronizer_type = SYNCHRONIZER_TYPE_CLIENT;
 		synchronizer = memnew(ClientSynchronizer(this));
@@ -920,13 +1318,13 @@ void SceneSynchronizerBase::init_synchronizer(bool p_was_generating_ids) {
 
 		synchronizer->on_object_data_added(od);
 		for (uint32_t y = 0; y < od->vars.size(); y += 1) {
-			synchronizer->on_variable_added(od, StringName(od->vars[y].var.name.c_str()));
+			synchronizer->on_variable_added(od, StringName(od->get_var_layout().names[y].c_str()));
 		}
 	}
 
 	// Notify the presence all available peers
-	for (auto &peer_it : peer_data) {
-		synchronizer->on_peer_connected(peer_it.first);
+	for (const NS::PeerTable::Entry &peer_it : peer_data) {
+		synchronizer->on_peer_connected(peer_it.peer);
 	}
 
 	// Reset the controllers.
@@ -934,6 +1332,11 @@ void SceneSynchronizerBase::init_synchronizer(bool p_was_generating_ids) {
 
 	process_functions__clear();
 	synchronizer_manager->on_init_synchronizer(p_was_generating_ids);
+
+	if (synchronizer_type == SYNCHRONIZER_TYPE_SPECTATOR) {
+		// So the server doesn't relay the doll inputs to this peer.
+		rpc_handler_notify_spectator_mode.rpc(*network_interface, network_interface->get_server_peer(), true);
+	}
 }
 
 void SceneSynchronizerBase::uninit_synchronizer() {
@@ -951,7 +1354,10 @@ void SceneSynchronizerBase::uninit_synchronizer() {
 }
 
 void SceneSynchronizerBase::reset_synchronizer_mode() {
-	debug_rewindings_enabled = ProjectSettings::get_singleton()->get_setting("NetworkSynchronizer/log_debug_rewindings");
+	SceneSynchronizerDebugger::singleton()->load_log_settings();
+	// Not filtered by the log level: the rewind reasons are collected for the
+	// debugger dump even when the messages are not printed.
+	debug_rewindings_enabled = GLOBAL_GET("NetworkSynchronizer/log_debug_rewindings");
 	const bool was_generating_ids = generate_id;
 	uninit_synchronizer();
 	init_synchronizer(was_generating_ids);
@@ -1000,11 +1406,32 @@ void SceneSynchronizerBase::rpc__notify_need_full_snapshot() {
 	ERR_FAIL_COND_MSG(is_server() == false, "Only the server can receive the request to send a full snapshot.");
 
 	const int sender_peer = network_interface->rpc_get_sender();
-	NS::PeerData *pd = MapFunc::at(peer_data, sender_peer);
+	NS::PeerData *pd = peer_data.find(sender_peer);
 	ERR_FAIL_COND(pd == nullptr);
 	pd->need_full_snapshot = true;
 }
 
+void SceneSynchronizerBase::rpc__notify_need_resync(DataBuffer &p_request) {
+	ERR_FAIL_COND_MSG(is_server() == false, "Only the server can receive the request to resync some objects.");
+
+	const int sender_peer = network_interface->rpc_get_sender();
+	NS::PeerData *pd = peer_data.find(sender_peer);
+	ERR_FAIL_COND(pd == nullptr);
+
+	p_request.begin_read();
+	LocalVector<NS::ObjectResync> resync;
+	if (!NS::read_object_resync(p_request, resync)) {
+		// Malformed: fallback to the full snapshot.
+		ERR_PRINT("The resync request sent by the peer `" + itos(sender_peer) + "` is malformed.");
+		pd->need_full_snapshot = true;
+		return;
+	}
+
+	for (uint32_t i = 0; i < resync.size(); i++) {
+		NS::merge_object_resync(pd->pending_resync, resync[i]);
+	}
+}
+
 void SceneSynchronizerBase::rpc_set_network_enabled(bool p_enabled) {
 	ERR_FAIL_COND_MSG(is_server() == false, "The peer status is supposed to be received by the server.");
 	set_peer_networking_enable(
@@ -1017,6 +1444,15 @@ void SceneSynchronizerBase::rpc_notify_peer_status(bool p_enabled) {
 	static_cast<ClientSynchronizer *>(synchronizer)->set_enabled(p_enabled);
 }
 
+void SceneSynchronizerBase::rpc_notify_spectator_mode(bool p_enabled) {
+	ERR_FAIL_COND_MSG(is_server() == false, "The spectator mode is supposed to be received by the server.");
+
+	const int sender_peer = network_interface->rpc_get_sender();
+	NS::PeerData *pd = peer_data.find(sender_peer);
+	ERR_FAIL_COND(pd == nullptr);
+	pd->spectator = p_enabled;
+}
+
 void SceneSynchronizerBase::rpc_deferred_sync_data(const Vector<uint8_t> &p_data) {
 	ERR_FAIL_COND_MSG(is_client() == false, "Only clients are supposed to receive this function call.");
 	ERR_FAIL_COND_MSG(p_data.size() <= 0, "It's not supposed to receive a 0 size data.");
@@ -1024,6 +1460,18 @@ void SceneSynchronizerBase::rpc_deferred_sync_data(const Vector<uint8_t> &p_data
 	static_cast<ClientSynchronizer *>(synchronizer)->receive_deferred_sync_data(p_data);
 }
 
+void SceneSynchronizerBase::rpc_doll_inputs(const Vector<uint8_t> &p_data) {
+	ERR_FAIL_COND_MSG(is_client() == false, "Only clients are supposed to receive this function call.");
+	ERR_FAIL_COND_MSG(p_data.size() <= 0, "It's not supposed to receive a 0 size data.");
+
+	if (is_spectator()) {
+		// The spectator doesn't predict the dolls.
+		return;
+	}
+
+	static_cast<ClientSynchronizer *>(synchronizer)->receive_doll_inputs(p_data);
+}
+
 void SceneSynchronizerBase::update_peers() {
 #ifdef DEBUG_ENABLED
 	// This function is only called on server.
@@ -1036,44 +1484,48 @@ void SceneSynchronizerBase::update_peers() {
 
 	peer_dirty = false;
 
-	for (auto &it : peer_data) {
+	for (NS::PeerTable::Entry &it : peer_data) {
 		// Validate the peer.
-		if (it.second.controller_id != ObjectNetId::NONE) {
-			NS::ObjectData *nd = get_object_data(it.second.controller_id);
+		if (it.data.controller_id != ObjectNetId::NONE) {
+			NS::ObjectData *nd = get_object_data(it.data.controller_id);
 			if (nd == nullptr ||
 					nd->get_controller() == nullptr ||
-					nd->get_controller()->network_interface->get_unit_authority() != it.first) {
+					nd->get_controller()->network_interface->get_unit_authority() != it.peer) {
 				// Invalidate the controller id
-				it.second.controller_id = ObjectNetId::NONE;
+				it.data.controller_id = ObjectNetId::NONE;
 			}
 		} else {
 			// The controller_id is not assigned, search it.
 			for (uint32_t i = 0; i < objects_data_storage.get_controllers_objects_data().size(); i += 1) {
 				const NetworkedControllerBase *nc = objects_data_storage.get_controllers_objects_data()[i]->get_controller();
-				if (nc && nc->network_interface->get_unit_authority() == it.first) {
+				if (nc && nc->network_interface->get_unit_authority() == it.peer) {
 					// Controller found.
-					it.second.controller_id = objects_data_storage.get_controllers_objects_data()[i]->get_net_id();
+					it.data.controller_id = objects_data_storage.get_controllers_objects_data()[i]->get_net_id();
 					break;
 				}
 			}
 		}
 
-		NS::ObjectData *nd = get_object_data(it.second.controller_id, false);
+		NS::ObjectData *nd = get_object_data(it.data.controller_id, false);
 		if (nd) {
-			nd->realtime_sync_enabled_on_client = it.second.enabled;
-			event_peer_status_updated.broadcast(nd, it.first, true, it.second.enabled);
+			nd->realtime_sync_enabled_on_client = it.data.enabled;
+			event_peer_status_updated.broadcast(nd, it.peer, true, it.data.enabled);
 		}
 	}
 }
 
 void SceneSynchronizerBase::clear_peers() {
-	// Copy, so we can safely remove the peers from `peer_data`.
-	std::map<int, NS::PeerData> peer_data_tmp = peer_data;
-	for (auto &it : peer_data_tmp) {
-		on_peer_disconnected(it.first);
+	// Copy the ids, so we can safely remove the peers from `peer_data`.
+	LocalVector<int> peers;
+	peers.reserve(peer_data.size());
+	for (const NS::PeerTable::Entry &it : peer_data) {
+		peers.push_back(it.peer);
+	}
+	for (int peer : peers) {
+		on_peer_disconnected(peer);
 	}
 
-	CRASH_COND_MSG(!peer_data.empty(), "The above loop should have cleared this peer_data by calling `_on_peer_disconnected` for all the peers.");
+	CRASH_COND_MSG(!peer_data.is_empty(), "The above loop should have cleared this peer_data by calling `_on_peer_disconnected` for all the peers.");
 }
 
 void SceneSynchronizerBase::detect_and_signal_changed_variables(int p_flags) {
@@ -1083,9 +1535,25 @@ void SceneSynchronizerBase::detect_and_signal_changed_variables(int p_flags) {
 		change_events_begin(p_flags);
 	}
 
+	// The idle ticks are counted only on the main process, never while rewinding.
+	const bool count_idle_ticks = p_flags == NetEventFlag::CHANGE;
+
 	for (auto od : objects_data_storage.get_objects_data()) {
-		if (od) {
-			pull_node_changes(od);
+		if (od == nullptr || od->sleeping) {
+			continue;
+		}
+
+		const bool changed = pull_node_changes(od);
+
+		if (count_idle_ticks && od->sleep_idle_ticks > 0 && od->get_controller() == nullptr) {
+			if (changed) {
+				od->idle_ticks = 0;
+			} else {
+				od->idle_ticks += 1;
+				if (od->idle_ticks >= od->sleep_idle_ticks) {
+					sleep_object(*od);
+				}
+			}
 		}
 	}
 	change_events_flush();
@@ -1107,6 +1575,18 @@ void SceneSynchronizerBase::change_events_begin(int p_flag) {
 }
 
 void SceneSynchronizerBase::change_event_add(NS::ObjectData *p_object_data, VarId p_var_id, const Variant &p_old) {
+	if (unlikely(p_object_data->sleeping)) {
+		// The synchronizer changed this object (e.g. applying a snapshot).
+		wake_object(*p_object_data);
+	}
+
+	for (ObjectLocalId dependent_id : p_object_data->wake_dependents) {
+		NS::ObjectData *dependent = get_object_data(dependent_id, false);
+		if (dependent && dependent->sleeping) {
+			wake_object(*dependent);
+		}
+	}
+
 	for (int i = 0; i < int(p_object_data->vars[p_var_id.id].changes_listeners.size()); i += 1) {
 		ChangesListener *listener = p_object_data->vars[p_var_id.id].changes_listeners[i];
 		// This can't be `nullptr` because when the changes listener is dropped
@@ -1121,8 +1601,9 @@ void SceneSynchronizerBase::change_event_add(NS::ObjectData *p_object_data, VarI
 		listener->emitted = false;
 
 		int v = 0;
-		for (auto wv : listener->watching_vars) {
-			if (wv.var_id == p_var_id) {
+		for (auto &wv : listener->watching_vars) {
+			if (wv.node_data == p_object_data && wv.var_id == p_var_id && !wv.old_set) {
+				// Keep the value it had before the first change of this phase.
 				wv.old_set = true;
 				listener->old_values[v] = p_old;
 			}
@@ -1130,6 +1611,12 @@ void SceneSynchronizerBase::change_event_add(NS::ObjectData *p_object_data, VarI
 		}
 	}
 
+	if (!tracking_scene_diffs.is_empty() && p_object_data->get_net_id() != ObjectNetId::NONE) {
+		for (SceneDiff *diff : tracking_scene_diffs) {
+			diff->notify_variable_changed(p_object_data->get_net_id(), p_var_id);
+		}
+	}
+
 	// Notify the synchronizer.
 	if (synchronizer) {
 		synchronizer->on_variable_changed(
@@ -1149,11 +1636,39 @@ void SceneSynchronizerBase::change_events_flush() {
 		}
 		listener.emitted = true;
 
+		if (listener.batched_listener_func) {
+			listener.changes.clear();
+			for (uint32_t v = 0; v < listener.watching_vars.size(); v += 1) {
+				ListeningVariable &wv = listener.watching_vars[v];
+				if (!wv.old_set) {
+					continue;
+				}
+				wv.old_set = false;
+				if (wv.node_data == nullptr) {
+					// Dropped in the meantime.
+					continue;
+				}
+				VarChange change;
+				change.object_id = wv.node_data->get_local_id();
+				change.var_id = wv.var_id;
+				change.old_value = listener.old_values[v];
+				change.new_value = wv.node_data->vars[wv.var_id.id].value;
+				listener.changes.push_back(change);
+			}
+			listener.batched_listener_func(listener.changes);
+			continue;
+		}
+
 		for (uint32_t v = 0; v < listener.watching_vars.size(); v += 1) {
+			if (listener.watching_vars[v].node_data == nullptr) {
+				// Dropped, keep the last known value.
+				listener.watching_vars[v].old_set = false;
+				continue;
+			}
 			if (!listener.watching_vars[v].old_set) {
 				// Old is not set, so set the current valud.
 				listener.old_values[v] =
-						listener.watching_vars[v].node_data->vars[listener.watching_vars[v].var_id.id].var.value;
+						listener.watching_vars[v].node_data->vars[listener.watching_vars[v].var_id.id].value;
 			}
 			// Reset this to false.
 			listener.watching_vars[v].old_set = false;
@@ -1171,6 +1686,11 @@ void SceneSynchronizerBase::change_events_flush() {
 void SceneSynchronizerBase::drop_object_data(NS::ObjectData &p_object_data) {
 	synchronizer_manager->on_drop_object_data(p_object_data);
 
+	if (p_object_data.bulk_registration_pending) {
+		// Dropped while registered in bulk: the synchronizer is not aware of it yet.
+		bulk_registered_objects.erase(&p_object_data);
+	}
+
 	if (synchronizer) {
 		synchronizer->on_object_data_removed(p_object_data);
 	}
@@ -1183,7 +1703,7 @@ void SceneSynchronizerBase::drop_object_data(NS::ObjectData &p_object_data) {
 
 	// Remove this `NodeData` from any event listener.
 	for (auto cl : changes_listeners) {
-		for (auto wv : cl->watching_vars) {
+		for (auto &wv : cl->watching_vars) {
 			if (wv.node_data == &p_object_data) {
 				// We can't remove this entirely, otherwise we change that the user expects.
 				wv.node_data = nullptr;
@@ -1192,6 +1712,17 @@ void SceneSynchronizerBase::drop_object_data(NS::ObjectData &p_object_data) {
 		}
 	}
 
+	// The local id can be reused, so make sure no trigger wakes the next
+	// object that gets it.
+	for (ObjectData *od : objects_data_storage.get_objects_data()) {
+		if (od) {
+			auto it = ns_find(od->wake_dependents, p_object_data.get_local_id());
+			if (it != od->wake_dependents.end()) {
+				od->wake_dependents.erase(it);
+			}
+		}
+	}
+
 	if (p_object_data.has_registered_process_functions()) {
 		process_functions__clear();
 	}
@@ -1203,11 +1734,14 @@ void SceneSynchronizerBase::notify_object_data_net_id_changed(ObjectData &p_obje
 	if (p_object_data.has_registered_process_functions()) {
 		process_functions__clear();
 	}
-	SceneSynchronizerDebugger::singleton()->debug_print(network_interface, "ObjectNetId: " + itos(p_object_data.get_net_id().id) + " just assigned to: " + String(p_object_data.object_name.c_str()));
+	if (bulk_registration_in_progress) {
+		return;
+	}
+	NS_DEBUG_PRINT(network_interface, "ObjectNetId: " + itos(p_object_data.get_net_id().id) + " just assigned to: " + String(p_object_data.object_name.c_str()), false);
 }
 
 NetworkedControllerBase *SceneSynchronizerBase::fetch_controller_by_peer(int peer) {
-	const NS::PeerData *data = MapFunc::at(peer_data, peer);
+	const NS::PeerData *data = peer_data.find(peer);
 	if (data && data->controller_id != ObjectNetId::NONE) {
 		NS::ObjectData *nd = get_object_data(data->controller_id);
 		if (nd) {
@@ -1222,7 +1756,11 @@ bool SceneSynchronizerBase::is_server() const {
 }
 
 bool SceneSynchronizerBase::is_client() const {
-	return synchronizer_type == SYNCHRONIZER_TYPE_CLIENT;
+	return synchronizer_type == SYNCHRONIZER_TYPE_CLIENT || synchronizer_type == SYNCHRONIZER_TYPE_SPECTATOR;
+}
+
+bool SceneSynchronizerBase::is_spectator() const {
+	return synchronizer_type == SYNCHRONIZER_TYPE_SPECTATOR;
 }
 
 bool SceneSynchronizerBase::is_no_network() const {
@@ -1235,9 +1773,9 @@ bool SceneSynchronizerBase::is_networked() const {
 
 void SceneSynchronizerBase::update_nodes_relevancy() {
 	synchronizer_manager->update_nodes_relevancy();
+	static_cast<ServerSynchronizer *>(synchronizer)->sync_groups_update_lod();
 
-	const bool log_debug_nodes_relevancy_update = ProjectSettings::get_singleton()->get_setting("NetworkSynchronizer/log_debug_nodes_relevancy_update");
-	if (log_debug_nodes_relevancy_update) {
+	if (SceneSynchronizerDebugger::singleton()->is_log_enabled(SceneSynchronizerDebugger::LOG_LEVEL_INFO, SceneSynchronizerDebugger::LOG_CATEGORY_RELEVANCY)) {
 		static_cast<ServerSynchronizer *>(synchronizer)->sync_group_debug_print();
 	}
 }
@@ -1248,32 +1786,61 @@ void SceneSynchronizerBase::process_functions__clear() {
 
 void SceneSynchronizerBase::process_functions__execute(const double p_delta) {
 	if (cached_process_functions_valid == false) {
-		// Clear the process_functions.
-		for (int process_phase = PROCESSPHASE_EARLY; process_phase < PROCESSPHASE_COUNT; ++process_phase) {
-			cached_process_functions[process_phase].clear();
-		}
+		cached_process_steps.clear();
 
-		// Build the cached_process_functions, making sure the node data order is kept.
+		// Build the cached_process_steps, making sure the node data order is kept.
 		for (auto od : objects_data_storage.get_sorted_objects_data()) {
-			if (od == nullptr || (is_client() && od->realtime_sync_enabled_on_client == false)) {
+			if (od == nullptr || od->sleeping || (is_client() && od->realtime_sync_enabled_on_client == false)) {
 				// Nothing to process
 				continue;
 			}
 
+			if (od->process_rate_divisor > 1) {
+				// The client doesn't predict the objects processed at a
+				// reduced rate: it just applies the server state.
+				if (!is_client() && od->has_registered_process_functions()) {
+					cached_process_steps.emplace_back();
+					cached_process_steps.back().divided_od = od;
+				}
+				continue;
+			}
+
+			// The consecutive full rate objects share the same step.
+			if (cached_process_steps.empty() || cached_process_steps.back().divided_od != nullptr) {
+				cached_process_steps.emplace_back();
+			}
+
 			// For each valid NodeData.
 			for (int process_phase = PROCESSPHASE_EARLY; process_phase < PROCESSPHASE_COUNT; ++process_phase) {
 				// Append the contained functions.
-				cached_process_functions[process_phase].append(od->functions[process_phase]);
+				cached_process_steps.back().functions[process_phase].append(od->functions[process_phase]);
 			}
 		}
 
 		cached_process_functions_valid = true;
 	}
 
-	SceneSynchronizerDebugger::singleton()->debug_print(network_interface, "Process functions START", true);
+	NS_DEBUG_PRINT(network_interface, "Process functions START", true);
 
+	// The local id is used as offset, so the objects with the same
+	// divisor are spread across the ticks.
 	for (int process_phase = PROCESSPHASE_EARLY; process_phase < PROCESSPHASE_COUNT; ++process_phase) {
-		cached_process_functions[process_phase].broadcast(p_delta);
+		for (CachedProcessStep &step : cached_process_steps) {
+			if (step.divided_od == nullptr) {
+				step.functions[process_phase].broadcast(p_delta);
+			} else if (((process_tick + step.divided_od->get_local_id().id) % step.divided_od->process_rate_divisor) == 0) {
+				step.divided_od->functions[process_phase].broadcast(float(double(process_tick + 1 - step.divided_od->process_last_tick) * p_delta));
+			}
+		}
+	}
+	for (CachedProcessStep &step : cached_process_steps) {
+		if (step.divided_od != nullptr && ((process_tick + step.divided_od->get_local_id().id) % step.divided_od->process_rate_divisor) == 0) {
+			step.divided_od->process_last_tick = process_tick + 1;
+		}
+	}
+
+	if (!is_client()) {
+		process_tick += 1;
 	}
 }
 
@@ -1302,7 +1869,7 @@ const ObjectData *SceneSynchronizerBase::get_object_data(ObjectNetId p_id, bool
 }
 
 NetworkedControllerBase *SceneSynchronizerBase::get_controller_for_peer(int p_peer, bool p_expected) {
-	const NS::PeerData *pd = MapFunc::at(peer_data, p_peer);
+	const NS::PeerData *pd = peer_data.find(p_peer);
 	if (p_expected) {
 		ERR_FAIL_COND_V_MSG(pd == nullptr, nullptr, "The peer is unknown `" + itos(p_peer) + "`.");
 	}
@@ -1314,7 +1881,7 @@ NetworkedControllerBase *SceneSynchronizerBase::get_controller_for_peer(int p_pe
 }
 
 const NetworkedControllerBase *SceneSynchronizerBase::get_controller_for_peer(int p_peer, bool p_expected) const {
-	const NS::PeerData *pd = MapFunc::at(peer_data, p_peer);
+	const NS::PeerData *pd = peer_data.find(p_peer);
 	if (p_expected) {
 		ERR_FAIL_COND_V_MSG(pd == nullptr, nullptr, "The peer is unknown `" + itos(p_peer) + "`.");
 	}
@@ -1326,10 +1893,9 @@ const NetworkedControllerBase *SceneSynchronizerBase::get_controller_for_peer(in
 }
 
 NS::PeerData *SceneSynchronizerBase::get_peer_for_controller(const NetworkedControllerBase &p_controller, bool p_expected) {
-	for (auto &it : peer_data) {
-		if (it.first == p_controller.network_interface->get_unit_authority()) {
-			return &(it.second);
-		}
+	NS::PeerData *pd = peer_data.find(p_controller.network_interface->get_unit_authority());
+	if (pd) {
+		return pd;
 	}
 	if (p_expected) {
 		ERR_PRINT("The controller was not associated to a peer.");
@@ -1338,10 +1904,9 @@ NS::PeerData *SceneSynchronizerBase::get_peer_for_controller(const NetworkedCont
 }
 
 const NS::PeerData *SceneSynchronizerBase::get_peer_for_controller(const NetworkedControllerBase &p_controller, bool p_expected) const {
-	for (auto &it : peer_data) {
-		if (it.first == p_controller.network_interface->get_unit_authority()) {
-			return &(it.second);
-		}
+	const NS::PeerData *pd = peer_data.find(p_controller.network_interface->get_unit_authority());
+	if (pd) {
+		return pd;
 	}
 	if (p_expected) {
 		ERR_PRINT("The controller was not associated to a peer.");
@@ -1412,33 +1977,112 @@ void SceneSynchronizerBase::reset_controller(NS::ObjectData *p_controller_nd) {
 	}
 }
 
-void SceneSynchronizerBase::pull_node_changes(NS::ObjectData *p_object_data) {
+bool SceneSynchronizerBase::pull_node_changes(NS::ObjectData *p_object_data) {
+	const bool read_all = synchronizer_manager->get_variables(
+			p_object_data->app_object_handle,
+			p_object_data->get_var_layout(),
+			variables_read_buffer);
+	ERR_FAIL_COND_V_MSG(read_all && variables_read_buffer.size() < p_object_data->vars.size(), false, "`get_variables` must read all the variables of the layout.");
+
+	bool changed = false;
 	for (VarId var_id = { 0 }; var_id < VarId{ uint32_t(p_object_data->vars.size()) }; var_id += 1) {
 		if (p_object_data->vars[var_id.id].enabled == false) {
 			continue;
 		}
 
-		const Variant old_val = p_object_data->vars[var_id.id].var.value;
+		const Variant old_val = p_object_data->vars[var_id.id].value;
 		Variant new_val;
-		synchronizer_manager->get_variable(
-				p_object_data->app_object_handle,
-				p_object_data->vars[var_id.id].var.name.c_str(),
-				new_val);
+		if (read_all) {
+			new_val = variables_read_buffer[var_id.id];
+		} else {
+			synchronizer_manager->get_variable(
+					p_object_data->app_object_handle,
+					p_object_data->get_variable_name(var_id).c_str(),
+					new_val);
+		}
 
 		if (!network_interface->compare(old_val, new_val)) {
-			p_object_data->vars[var_id.id].var.value = new_val.duplicate(true);
+			p_object_data->vars[var_id.id].value = new_val.duplicate(true);
 			change_event_add(
 					p_object_data,
 					var_id,
 					old_val);
+			changed = true;
 		}
 	}
+	return changed;
+}
+
+void SceneSynchronizerBase::variables_write(NS::ObjectData &p_object_data, VarId p_var_id, const Variant &p_value) {
+	if (variables_write_object != &p_object_data) {
+		variables_write_flush();
+		variables_write_object = &p_object_data;
+		variables_write_mask.assign(p_object_data.vars.size(), false);
+		variables_write_values.resize(p_object_data.vars.size());
+	}
+
+	variables_write_mask[p_var_id.id] = true;
+	variables_write_values[p_var_id.id] = p_value;
+}
+
+void SceneSynchronizerBase::variables_write_flush() {
+	NS::ObjectData *od = variables_write_object;
+	if (od == nullptr) {
+		return;
+	}
+	variables_write_object = nullptr;
+
+	const bool written = synchronizer_manager->set_variables(
+			od->app_object_handle,
+			od->get_var_layout(),
+			variables_write_mask,
+			variables_write_values);
+
+	if (!written) {
+		for (uint32_t v = 0; v < variables_write_mask.size(); v += 1) {
+			if (variables_write_mask[v]) {
+				synchronizer_manager->set_variable(
+						od->app_object_handle,
+						od->get_var_layout().names[v].c_str(),
+						variables_write_values[v]);
+			}
+		}
+	}
+
+	// Release the values.
+	variables_write_values.clear();
+}
+
+void SceneSynchronizerBase::sleep_object(NS::ObjectData &p_object_data) {
+	p_object_data.sleeping = true;
+	if (p_object_data.has_registered_process_functions()) {
+		process_functions__clear();
+	}
+}
+
+void SceneSynchronizerBase::wake_object(NS::ObjectData &p_object_data) {
+	p_object_data.sleeping = false;
+	p_object_data.idle_ticks = 0;
+	// The time spent sleeping is not accumulated.
+	p_object_data.process_last_tick = process_tick;
+	if (p_object_data.has_registered_process_functions()) {
+		process_functions__clear();
+	}
 }
 
 Synchronizer::Synchronizer(SceneSynchronizerBase *p_node) :
 		scene_synchronizer(p_node) {
 }
 
+void Synchronizer::on_objects_data_added(const LocalVector<NS::ObjectData *> &p_objects_data) {
+	for (NS::ObjectData *od : p_objects_data) {
+		on_object_data_added(od);
+		for (uint32_t v = 0; v < od->vars.size(); v += 1) {
+			on_variable_added(od, StringName(od->get_var_layout().names[v].c_str()));
+		}
+	}
+}
+
 NoNetSynchronizer::NoNetSynchronizer(SceneSynchronizerBase *p_node) :
 		Synchronizer(p_node) {
 }
@@ -1453,7 +2097,7 @@ void NoNetSynchronizer::process() {
 		return;
 	}
 
-	SceneSynchronizerDebugger::singleton()->debug_print(&scene_synchronizer->get_network_interface(), "NoNetSynchronizer::process", true);
+	NS_DEBUG_PRINT(&scene_synchronizer->get_network_interface(), "NoNetSynchronizer::process", true);
 
 	const uint32_t frame_index = frame_count;
 	frame_count += 1;
@@ -1504,7 +2148,7 @@ void ServerSynchronizer::clear() {
 }
 
 void ServerSynchronizer::process() {
-	SceneSynchronizerDebugger::singleton()->debug_print(&scene_synchronizer->get_network_interface(), "ServerSynchronizer::process", true);
+	NS_DEBUG_PRINT(&scene_synchronizer->get_network_interface(), "ServerSynchronizer::process", true);
 
 	scene_synchronizer->update_peers();
 
@@ -1528,19 +2172,20 @@ void ServerSynchronizer::process() {
 
 	process_snapshot_notificator(delta);
 	process_deferred_sync(delta);
+	process_doll_inputs_relay();
 
 	SceneSynchronizerDebugger::singleton()->scene_sync_process_end(scene_synchronizer);
 
 #if DEBUG_ENABLED
 	// Write the debug dump for each peer.
-	for (auto &peer_it : scene_synchronizer->peer_data) {
-		if (unlikely(peer_it.second.controller_id == ObjectNetId::NONE)) {
+	for (const NS::PeerTable::Entry &peer_it : scene_synchronizer->peer_data) {
+		if (unlikely(peer_it.data.controller_id == ObjectNetId::NONE)) {
 			continue;
 		}
 
-		const NS::ObjectData *nd = scene_synchronizer->get_object_data(peer_it.second.controller_id);
+		const NS::ObjectData *nd = scene_synchronizer->get_object_data(peer_it.data.controller_id);
 		const uint32_t current_input_id = nd->get_controller()->get_server_controller()->get_current_input_id();
-		SceneSynchronizerDebugger::singleton()->write_dump(peer_it.first, current_input_id);
+		SceneSynchronizerDebugger::singleton()->write_dump(peer_it.peer, current_input_id);
 	}
 	SceneSynchronizerDebugger::singleton()->start_new_frame();
 #endif
@@ -1577,6 +2222,36 @@ void ServerSynchronizer::on_object_data_added(NS::ObjectData *p_object_data) {
 	}
 }
 
+void ServerSynchronizer::on_objects_data_added(const LocalVector<NS::ObjectData *> &p_objects_data) {
+#ifdef DEBUG_ENABLED
+	// Can't happen on server
+	CRASH_COND(scene_synchronizer->is_recovered());
+#endif
+
+	// The objects may have been added to other groups while registered.
+	for (uint32_t g = 0; g < sync_groups.size(); ++g) {
+		if (g == SceneSynchronizerBase::GLOBAL_SYNC_GROUP_ID) {
+			sync_groups[g].add_new_realtime_nodes(p_objects_data);
+		} else {
+			sync_groups[g].notify_new_variables(p_objects_data);
+		}
+	}
+
+	for (NS::ObjectData *od : p_objects_data) {
+#ifdef DEBUG_ENABLED
+		// On server the ID is always known.
+		CRASH_COND(od->get_net_id() == ObjectNetId::NONE);
+#endif
+		if (od->get_controller()) {
+			NS::PeerData *pd = scene_synchronizer->get_peer_for_controller(*od->get_controller());
+			if (pd) {
+				pd->force_notify_snapshot = true;
+				pd->need_full_snapshot = true;
+			}
+		}
+	}
+}
+
 void ServerSynchronizer::on_object_data_removed(NS::ObjectData &p_object_data) {
 	// Make sure to remove this `NodeData` from any sync group.
 	for (uint32_t i = 0; i < sync_groups.size(); ++i) {
@@ -1597,6 +2272,14 @@ void ServerSynchronizer::on_variable_added(NS::ObjectData *p_object_data, const
 	}
 }
 
+void ServerSynchronizer::notify_object_unknown(NS::ObjectData *p_object_data) {
+	for (uint32_t g = 0; g < sync_groups.size(); ++g) {
+		if (sync_groups[g].notify_node_unknown(p_object_data)) {
+			sync_group_force_state_notify(sync_groups[g]);
+		}
+	}
+}
+
 void ServerSynchronizer::on_variable_changed(NS::ObjectData *p_object_data, VarId p_var_id, const Variant &p_old_value, int p_flag) {
 #ifdef DEBUG_ENABLED
 	// Can't happen on server
@@ -1606,16 +2289,27 @@ void ServerSynchronizer::on_variable_changed(NS::ObjectData *p_object_data, VarI
 #endif
 
 	for (uint32_t g = 0; g < sync_groups.size(); ++g) {
-		sync_groups[g].notify_variable_changed(p_object_data, p_object_data->vars[p_var_id.id].var.name);
+		sync_groups[g].notify_variable_changed(p_object_data, p_object_data->get_variable_name(p_var_id));
 	}
 }
 
 SyncGroupId ServerSynchronizer::sync_group_create() {
 	const SyncGroupId id = sync_groups.size();
 	sync_groups.resize(id + 1);
+	// Each group notifies the state at a different moment of the interval, so
+	// the snapshots generation is spread across the ticks.
+	sync_groups[id].state_notifier_timer = scene_synchronizer->get_server_notify_state_interval() * NS::stagger_phase(id);
 	return id;
 }
 
+void ServerSynchronizer::sync_group_force_state_notify(NS::SyncGroup &p_group) {
+	// Notifies on the next tick, without changing the phase of this group.
+	const real_t interval = scene_synchronizer->get_server_notify_state_interval();
+	if (p_group.state_notifier_timer < interval) {
+		p_group.state_notifier_timer += interval;
+	}
+}
+
 const NS::SyncGroup *ServerSynchronizer::sync_group_get(SyncGroupId p_group_id) const {
 	ERR_FAIL_COND_V_MSG(p_group_id >= sync_groups.size(), nullptr, "The group id `" + itos(p_group_id) + "` doesn't exist.");
 	return &sync_groups[p_group_id];
@@ -1635,6 +2329,12 @@ void ServerSynchronizer::sync_group_remove_node(NS::ObjectData *p_object_data, S
 	sync_groups[p_group_id].remove_node(p_object_data);
 }
 
+void ServerSynchronizer::sync_group_remove_nodes(const LocalVector<NS::ObjectData *> &p_objects_data, SyncGroupId p_group_id) {
+	ERR_FAIL_COND_MSG(p_group_id >= sync_groups.size(), "The group id `" + itos(p_group_id) + "` doesn't exist.");
+	ERR_FAIL_COND_MSG(p_group_id == SceneSynchronizerBase::GLOBAL_SYNC_GROUP_ID, "You can't change this SyncGroup in any way. Create a new one.");
+	sync_groups[p_group_id].remove_nodes(p_objects_data);
+}
+
 void ServerSynchronizer::sync_group_replace_nodes(SyncGroupId p_group_id, LocalVector<NS::SyncGroup::RealtimeNodeInfo> &&p_new_realtime_nodes, LocalVector<NS::SyncGroup::DeferredNodeInfo> &&p_new_deferred_nodes) {
 	ERR_FAIL_COND_MSG(p_group_id >= sync_groups.size(), "The group id `" + itos(p_group_id) + "` doesn't exist.");
 	ERR_FAIL_COND_MSG(p_group_id == SceneSynchronizerBase::GLOBAL_SYNC_GROUP_ID, "You can't change this SyncGroup in any way. Create a new one.");
@@ -1661,8 +2361,13 @@ void ServerSynchronizer::sync_group_move_peer_to(int p_peer_id, SyncGroupId p_gr
 	ERR_FAIL_COND_MSG(p_group_id >= sync_groups.size(), "The group id `" + itos(p_group_id) + "` doesn't exist.");
 	sync_groups[p_group_id].peers.push_back(p_peer_id);
 
+	// The new peer doesn't have the epochs sent so far: send them in full.
+	for (NS::SyncGroup::DeferredNodeInfo &info : sync_groups[p_group_id].get_deferred_sync_nodes()) {
+		info.reset_epoch_reference();
+	}
+
 	// Also mark the peer as need full snapshot, as it's into a new group now.
-	NS::PeerData *pd = MapFunc::at(scene_synchronizer->peer_data, p_peer_id);
+	NS::PeerData *pd = scene_synchronizer->peer_data.find(p_peer_id);
 	ERR_FAIL_COND(pd == nullptr);
 	pd->force_notify_snapshot = true;
 	pd->need_full_snapshot = true;
@@ -1693,6 +2398,41 @@ real_t ServerSynchronizer::sync_group_get_deferred_update_rate(const NS::ObjectD
 	return sync_groups[p_group_id].get_deferred_update_rate(p_object_data);
 }
 
+void ServerSynchronizer::sync_group_set_lod_policy(SyncGroupId p_group_id, const NS::LodPolicy &p_policy) {
+	ERR_FAIL_COND_MSG(p_group_id >= sync_groups.size(), "The group id `" + itos(p_group_id) + "` doesn't exist.");
+	ERR_FAIL_COND_MSG(p_group_id == SceneSynchronizerBase::GLOBAL_SYNC_GROUP_ID, "You can't change this SyncGroup in any way. Create a new one.");
+	sync_groups[p_group_id].lod_policy = p_policy;
+}
+
+NS::LodPolicy ServerSynchronizer::sync_group_get_lod_policy(SyncGroupId p_group_id) const {
+	ERR_FAIL_COND_V_MSG(p_group_id >= sync_groups.size(), NS::LodPolicy(), "The group id `" + itos(p_group_id) + "` doesn't exist.");
+	return sync_groups[p_group_id].lod_policy;
+}
+
+void ServerSynchronizer::sync_group_set_lod_metric(NS::ObjectData *p_object_data, SyncGroupId p_group_id, real_t p_metric) {
+	ERR_FAIL_COND(p_object_data == nullptr);
+	ERR_FAIL_COND_MSG(p_group_id >= sync_groups.size(), "The group id `" + itos(p_group_id) + "` doesn't exist.");
+	ERR_FAIL_COND_MSG(p_group_id == SceneSynchronizerBase::GLOBAL_SYNC_GROUP_ID, "You can't change this SyncGroup in any way. Create a new one.");
+	sync_groups[p_group_id].set_lod_metric(p_object_data, p_metric);
+}
+
+NS::LodTier ServerSynchronizer::sync_group_get_lod_tier(const NS::ObjectData *p_object_data, SyncGroupId p_group_id) const {
+	ERR_FAIL_COND_V(p_object_data == nullptr, NS::LOD_TIER_COUNT);
+	ERR_FAIL_COND_V_MSG(p_group_id >= sync_groups.size(), NS::LOD_TIER_COUNT, "The group id `" + itos(p_group_id) + "` doesn't exist.");
+	return sync_groups[p_group_id].get_lod_tier(p_object_data);
+}
+
+void ServerSynchronizer::sync_group_update_lod(SyncGroupId p_group_id) {
+	ERR_FAIL_COND_MSG(p_group_id >= sync_groups.size(), "The group id `" + itos(p_group_id) + "` doesn't exist.");
+	sync_groups[p_group_id].update_lod();
+}
+
+void ServerSynchronizer::sync_groups_update_lod() {
+	for (uint32_t g = 0; g < sync_groups.size(); ++g) {
+		sync_groups[g].update_lod();
+	}
+}
+
 void ServerSynchronizer::sync_group_set_user_data(SyncGroupId p_group_id, uint64_t p_user_data) {
 	ERR_FAIL_COND_MSG(p_group_id >= sync_groups.size(), "The group id `" + itos(p_group_id) + "` doesn't exist.");
 	sync_groups[p_group_id].user_data = p_user_data;
@@ -1704,41 +2444,41 @@ uint64_t ServerSynchronizer::sync_group_get_user_data(SyncGroupId p_group_id) co
 }
 
 void ServerSynchronizer::sync_group_debug_print() {
-	SceneSynchronizerDebugger::singleton()->debug_print(&scene_synchronizer->get_network_interface(), "");
-	SceneSynchronizerDebugger::singleton()->debug_print(&scene_synchronizer->get_network_interface(), "|-----------------------");
-	SceneSynchronizerDebugger::singleton()->debug_print(&scene_synchronizer->get_network_interface(), "| Sync groups");
-	SceneSynchronizerDebugger::singleton()->debug_print(&scene_synchronizer->get_network_interface(), "|-----------------------");
+	NS_DEBUG_PRINT(&scene_synchronizer->get_network_interface(), "", false);
+	NS_DEBUG_PRINT(&scene_synchronizer->get_network_interface(), "|-----------------------", false);
+	NS_DEBUG_PRINT(&scene_synchronizer->get_network_interface(), "| Sync groups", false);
+	NS_DEBUG_PRINT(&scene_synchronizer->get_network_interface(), "|-----------------------", false);
 
 	for (int g = 0; g < int(sync_groups.size()); ++g) {
 		NS::SyncGroup &group = sync_groups[g];
 
-		SceneSynchronizerDebugger::singleton()->debug_print(&scene_synchronizer->get_network_interface(), "| [Group " + itos(g) + "#]");
-		SceneSynchronizerDebugger::singleton()->debug_print(&scene_synchronizer->get_network_interface(), "|    Listening peers");
+		NS_DEBUG_PRINT(&scene_synchronizer->get_network_interface(), "| [Group " + itos(g) + "#]", false);
+		NS_DEBUG_PRINT(&scene_synchronizer->get_network_interface(), "|    Listening peers", false);
 		for (int peer : group.peers) {
-			SceneSynchronizerDebugger::singleton()->debug_print(&scene_synchronizer->get_network_interface(), "|      |- " + itos(peer));
+			NS_DEBUG_PRINT(&scene_synchronizer->get_network_interface(), "|      |- " + itos(peer), false);
 		}
 
 		const LocalVector<NS::SyncGroup::RealtimeNodeInfo> &realtime_node_info = group.get_realtime_sync_nodes();
-		SceneSynchronizerDebugger::singleton()->debug_print(&scene_synchronizer->get_network_interface(), "|");
-		SceneSynchronizerDebugger::singleton()->debug_print(&scene_synchronizer->get_network_interface(), "|    [Realtime nodes]");
+		NS_DEBUG_PRINT(&scene_synchronizer->get_network_interface(), "|", false);
+		NS_DEBUG_PRINT(&scene_synchronizer->get_network_interface(), "|    [Realtime nodes]", false);
 		for (auto info : realtime_node_info) {
-			SceneSynchronizerDebugger::singleton()->debug_print(&scene_synchronizer->get_network_interface(), "|      |- " + String(info.od->object_name.c_str()));
+			NS_DEBUG_PRINT(&scene_synchronizer->get_network_interface(), "|      |- " + String(info.od->object_name.c_str()), false);
 		}
 
-		SceneSynchronizerDebugger::singleton()->debug_print(&scene_synchronizer->get_network_interface(), "|");
+		NS_DEBUG_PRINT(&scene_synchronizer->get_network_interface(), "|", false);
 
 		const LocalVector<NS::SyncGroup::DeferredNodeInfo> &deferred_node_info = group.get_deferred_sync_nodes();
-		SceneSynchronizerDebugger::singleton()->debug_print(&scene_synchronizer->get_network_interface(), "|    [Deferred nodes (UR: Update Rate)]");
+		NS_DEBUG_PRINT(&scene_synchronizer->get_network_interface(), "|    [Deferred nodes (UR: Update Rate)]", false);
 		for (auto info : deferred_node_info) {
-			SceneSynchronizerDebugger::singleton()->debug_print(&scene_synchronizer->get_network_interface(), "|      |- [UR: " + rtos(info.update_rate) + "] " + info.od->object_name.c_str());
+			NS_DEBUG_PRINT(&scene_synchronizer->get_network_interface(), "|      |- [UR: " + rtos(info.update_rate) + "] " + info.od->object_name.c_str(), false);
 		}
 	}
-	SceneSynchronizerDebugger::singleton()->debug_print(&scene_synchronizer->get_network_interface(), "|-----------------------");
-	SceneSynchronizerDebugger::singleton()->debug_print(&scene_synchronizer->get_network_interface(), "");
+	NS_DEBUG_PRINT(&scene_synchronizer->get_network_interface(), "|-----------------------", false);
+	NS_DEBUG_PRINT(&scene_synchronizer->get_network_interface(), "", false);
 }
 
 void ServerSynchronizer::process_snapshot_notificator(real_t p_delta) {
-	if (scene_synchronizer->peer_data.empty()) {
+	if (scene_synchronizer->peer_data.is_empty()) {
 		// No one is listening.
 		return;
 	}
@@ -1752,11 +2492,13 @@ void ServerSynchronizer::process_snapshot_notificator(real_t p_delta) {
 		}
 
 		// Notify the state if needed
+		const real_t notify_interval = scene_synchronizer->get_server_notify_state_interval();
 		group.state_notifier_timer += p_delta;
-		const bool notify_state = group.state_notifier_timer >= scene_synchronizer->get_server_notify_state_interval();
+		const bool notify_state = group.state_notifier_timer >= notify_interval;
 
 		if (notify_state) {
-			group.state_notifier_timer = 0.0;
+			// Keep the phase of this group.
+			group.state_notifier_timer = notify_interval > 0.0 ? Math::fmod(group.state_notifier_timer, notify_interval) : 0.0;
 		}
 
 		const int MD_SIZE = DataBuffer::get_bit_taken(DataBuffer::DATA_TYPE_UINT, DataBuffer::COMPRESSION_LEVEL_1);
@@ -1769,15 +2511,17 @@ void ServerSynchronizer::process_snapshot_notificator(real_t p_delta) {
 		DataBuffer delta_snapshot;
 		delta_snapshot.begin_write(MD_SIZE);
 
+		DataBuffer resync_snapshot;
+
 		for (int pi = 0; pi < int(group.peers.size()); ++pi) {
 			const int peer_id = group.peers[pi];
-			NS::PeerData *peer = MapFunc::at(scene_synchronizer->peer_data, peer_id);
+			NS::PeerData *peer = scene_synchronizer->peer_data.find(peer_id);
 			if (peer == nullptr) {
 				ERR_PRINT("The `process_snapshot_notificator` failed to lookup the peer_id `" + itos(peer_id) + "`. Was it removed but never cleared from sync_groups. Report this error, as this is a bug.");
 				continue;
 			}
 
-			if (peer->force_notify_snapshot == false && notify_state == false) {
+			if (peer->force_notify_snapshot == false && notify_state == false && peer->join_backlog.is_empty()) {
 				// Nothing to sync.
 				continue;
 			}
@@ -1794,9 +2538,50 @@ void ServerSynchronizer::process_snapshot_notificator(real_t p_delta) {
 				input_id = controller->get_current_input_id();
 			}
 
+			const int join_stream_budget = scene_synchronizer->get_join_stream_budget();
+			if (peer->need_full_snapshot && join_stream_budget > 0) {
+				// Rather than a full snapshot, stream the world to this peer
+				// over the next snapshots, starting from the most relevant.
+				group.collect_join_backlog(peer->controller_id, peer->join_backlog);
+				peer->join_backlog_cursor = 0;
+				if (!peer->join_backlog.is_empty()) {
+					peer->need_full_snapshot = false;
+					peer->pending_resync.clear();
+				}
+			}
+
 			DataBuffer *snap;
-			if (peer->need_full_snapshot) {
+			if (!peer->join_backlog.is_empty()) {
+				// This peer is joining: send it the next chunk of the world,
+				// along with the changes of the objects it already has.
+				LocalVector<NS::ObjectResync> chunk = peer->pending_resync;
+				peer->pending_resync.clear();
+				const uint32_t chunk_end = MIN(peer->join_backlog.size(), peer->join_backlog_cursor + uint32_t(join_stream_budget));
+				for (uint32_t i = peer->join_backlog_cursor; i < chunk_end; i++) {
+					NS::ObjectResync resync;
+					resync.net_id = peer->join_backlog[i];
+					NS::merge_object_resync(chunk, resync);
+				}
+				peer->join_backlog_cursor = chunk_end;
+				if (peer->join_backlog_cursor >= peer->join_backlog.size()) {
+					peer->join_backlog.clear();
+					peer->join_backlog_cursor = 0;
+				}
+
+				resync_snapshot.begin_write(MD_SIZE);
+				resync_snapshot.seek(MD_SIZE);
+				generate_snapshot(
+						false,
+						group,
+						resync_snapshot,
+						&chunk,
+						peer->join_backlog.is_empty() ? JOIN_STREAM_DONE : JOIN_STREAM_PENDING);
+
+				snap = &resync_snapshot;
+
+			} else if (peer->need_full_snapshot) {
 				peer->need_full_snapshot = false;
+				peer->pending_resync.clear();
 				if (full_snapshot_need_init) {
 					full_snapshot_need_init = false;
 					full_snapshot.seek(MD_SIZE);
@@ -1805,6 +2590,15 @@ void ServerSynchronizer::process_snapshot_notificator(real_t p_delta) {
 
 				snap = &full_snapshot;
 
+			} else if (!peer->pending_resync.is_empty()) {
+				// This peer is missing some objects: it gets its own delta.
+				resync_snapshot.begin_write(MD_SIZE);
+				resync_snapshot.seek(MD_SIZE);
+				generate_snapshot(false, group, resync_snapshot, &peer->pending_resync);
+				peer->pending_resync.clear();
+
+				snap = &resync_snapshot;
+
 			} else {
 				if (delta_snapshot_need_init) {
 					delta_snapshot_need_init = false;
@@ -1840,11 +2634,15 @@ void ServerSynchronizer::process_snapshot_notificator(real_t p_delta) {
 void ServerSynchronizer::generate_snapshot(
 		bool p_force_full_snapshot,
 		const NS::SyncGroup &p_group,
-		DataBuffer &r_snapshot_db) const {
+		DataBuffer &r_snapshot_db,
+		const LocalVector<NS::ObjectResync> *p_resync,
+		JoinStreamStatus p_join) const {
 	const LocalVector<NS::SyncGroup::RealtimeNodeInfo> &relevant_node_data = p_group.get_realtime_sync_nodes();
 
-	// First insert the list of ALL simulated ObjectData, if changed.
-	if (p_group.is_realtime_node_list_changed() || p_force_full_snapshot) {
+	// First insert the list of ALL simulated ObjectData, if changed. The
+	// resync carries it too, as the peer may have lost the one that
+	// activated the missing objects.
+	if (p_group.is_realtime_node_list_changed() || p_force_full_snapshot || p_join != JOIN_STREAM_NONE || (p_resync && !p_resync->is_empty())) {
 		r_snapshot_db.add(true);
 
 		for (uint32_t i = 0; i < relevant_node_data.size(); i += 1) {
@@ -1860,6 +2658,9 @@ void ServerSynchronizer::generate_snapshot(
 		r_snapshot_db.add(false);
 	}
 
+	// Tells the client whether more objects follow.
+	r_snapshot_db.add(p_join == JOIN_STREAM_PENDING);
+
 	// Calling this function to allow customize the snapshot per group.
 	NS::VarData vd;
 	if (scene_synchronizer->synchronizer_manager->snapshot_get_custom_data(&p_group, vd)) {
@@ -1887,12 +2688,50 @@ void ServerSynchronizer::generate_snapshot(
 	for (uint32_t i = 0; i < relevant_node_data.size(); i += 1) {
 		const NS::ObjectData *node_data = relevant_node_data[i].od;
 
-		if (node_data != nullptr) {
-			generate_snapshot_object_data(
-					node_data,
-					mode,
-					relevant_node_data[i].change,
-					r_snapshot_db);
+		if (node_data != nullptr) {
+			generate_snapshot_object_data(
+					node_data,
+					mode,
+					relevant_node_data[i].change,
+					r_snapshot_db);
+		}
+	}
+
+	// Then add what the peer is missing: the client parses the object twice
+	// when it's also in the delta above, with the same values.
+	if (p_resync) {
+		for (uint32_t r = 0; r < p_resync->size(); r++) {
+			const NS::ObjectResync &resync = (*p_resync)[r];
+			const NS::ObjectData *od = scene_synchronizer->get_object_data(resync.net_id, false);
+			if (od == nullptr) {
+				continue;
+			}
+
+			bool is_realtime = false;
+			for (uint32_t i = 0; i < relevant_node_data.size(); i += 1) {
+				if (relevant_node_data[i].od == od) {
+					is_realtime = true;
+					break;
+				}
+			}
+
+			if (is_realtime) {
+				NS::SyncGroup::Change change;
+				change.unknown = true;
+				for (uint32_t v = 0; v < od->vars.size(); v += 1) {
+					if (resync.vars.is_empty() || resync.vars.find(od->vars[v].id) != -1) {
+						change.vars.insert(od->get_var_layout().names[v]);
+					}
+				}
+				generate_snapshot_object_data(od, SNAPSHOT_GENERATION_MODE_NORMAL, change, r_snapshot_db);
+			} else {
+				for (uint32_t i = 0; i < p_group.get_deferred_sync_nodes().size(); ++i) {
+					if (p_group.get_deferred_sync_nodes()[i].od == od) {
+						generate_snapshot_object_data(od, SNAPSHOT_GENERATION_MODE_FORCE_NODE_PATH_ONLY, NS::SyncGroup::Change(), r_snapshot_db);
+						break;
+					}
+				}
+			}
 		}
 	}
 
@@ -1923,6 +2762,13 @@ void ServerSynchronizer::generate_snapshot_object_data(
 		// This object is unknown.
 		r_snapshot_db.add(true); // Has the object name?
 		r_snapshot_db.add(p_object_data->object_name);
+		// The client doesn't predict the objects processed at a reduced rate,
+		// so it needs the divisor too: it's sent only when not 1.
+		const bool has_process_rate_divisor = p_object_data->process_rate_divisor > 1;
+		r_snapshot_db.add(has_process_rate_divisor);
+		if (has_process_rate_divisor) {
+			r_snapshot_db.add(std::uint32_t(p_object_data->process_rate_divisor));
+		}
 	} else {
 		// This node is already known on clients, just set the node ID.
 		r_snapshot_db.add(false); // Has the object name?
@@ -1949,7 +2795,7 @@ void ServerSynchronizer::generate_snapshot_object_data(
 			var_has_value = false;
 		}
 
-		if (!force_snapshot_variables && !p_change.vars.has(var.var.name)) {
+		if (!force_snapshot_variables && !p_change.vars.has(p_object_data->get_var_layout().names[i])) {
 			// This is a delta snapshot and this variable is the same as before.
 			// Skip this value
 			var_has_value = false;
@@ -1957,13 +2803,82 @@ void ServerSynchronizer::generate_snapshot_object_data(
 
 		r_snapshot_db.add(var_has_value);
 		if (var_has_value) {
-			r_snapshot_db.add_variant(var.var.value);
+			r_snapshot_db.add_variant(var.value);
+		}
+	}
+}
+
+void ServerSynchronizer::process_doll_inputs_relay() {
+	const std::vector<NS::ObjectData *> &controllers = scene_synchronizer->objects_data_storage.get_controllers_objects_data();
+
+	if (scene_synchronizer->peer_data.size() > 1) {
+		// The packet is composed as follow, for each doll:
+		// - Four bytes for the doll `ObjectNetId`.
+		// - Two bytes for the size of the inputs.
+		// - The inputs, using the `receive_inputs` format.
+		Vector<uint8_t> packet;
+		Vector<uint8_t> inputs;
+		for (const NS::PeerTable::Entry &peer_it : scene_synchronizer->peer_data) {
+			if (!peer_it.data.enabled || peer_it.data.spectator || peer_it.data.sync_group_id >= sync_groups.size()) {
+				continue;
+			}
+
+			// The redundancy is adapted to the loss of this peer, which is
+			// measured on the inputs it sends.
+			const ServerController *peer_controller = nullptr;
+			if (peer_it.data.controller_id != ObjectNetId::NONE) {
+				const NS::ObjectData *peer_od = scene_synchronizer->get_object_data(peer_it.data.controller_id, false);
+				if (peer_od && peer_od->get_controller() && peer_od->get_controller()->is_server_controller()) {
+					peer_controller = peer_od->get_controller()->get_server_controller();
+				}
+			}
+
+			int packet_size = 0;
+			const LocalVector<NS::SyncGroup::RealtimeNodeInfo> &nodes = sync_groups[peer_it.data.sync_group_id].get_realtime_sync_nodes();
+			for (uint32_t i = 0; i < nodes.size(); ++i) {
+				const NS::ObjectData *od = nodes[i].od;
+				if (od->get_controller() == nullptr || !od->get_controller()->is_server_controller() || od->get_net_id() == peer_it.data.controller_id) {
+					continue;
+				}
+				const ServerController *doll = od->get_controller()->get_server_controller();
+				if (!doll->relay_has_new_inputs) {
+					continue;
+				}
+
+				const int max_redundancy = od->get_controller()->get_max_redundant_inputs();
+				const int redundancy = peer_controller ? peer_controller->compute_relay_redundancy(max_redundancy) : max_redundancy;
+				if (!doll->encode_relay_inputs(peer_it.peer, redundancy, inputs)) {
+					continue;
+				}
+				ERR_CONTINUE(inputs.size() > UINT16_MAX);
+
+				packet.resize(packet_size + 6 + inputs.size());
+				packet_size += encode_uint32(od->get_net_id().id, packet.ptrw() + packet_size);
+				packet_size += encode_uint16(inputs.size(), packet.ptrw() + packet_size);
+				memcpy(packet.ptrw() + packet_size, inputs.ptr(), inputs.size());
+				packet_size += inputs.size();
+			}
+
+			if (packet_size > 0) {
+				packet.resize(packet_size);
+				scene_synchronizer->rpc_handler_doll_inputs.rpc(
+						scene_synchronizer->get_network_interface(),
+						peer_it.peer,
+						packet);
+			}
+		}
+	}
+
+	for (NS::ObjectData *od : controllers) {
+		if (od->get_controller() && od->get_controller()->is_server_controller()) {
+			od->get_controller()->get_server_controller()->relay_has_new_inputs = false;
 		}
 	}
 }
 
 void ServerSynchronizer::process_deferred_sync(real_t p_delta) {
 	DataBuffer *tmp_buffer = memnew(DataBuffer);
+	DataBuffer delta_buffer;
 	const Variant var_data_buffer = tmp_buffer;
 	const Variant *fake_array_vars = &var_data_buffer;
 
@@ -1998,12 +2913,12 @@ void ServerSynchronizer::process_deferred_sync(real_t p_delta) {
 			}
 
 			if (node_info[i].od->get_net_id().id > UINT16_MAX) {
-				SceneSynchronizerDebugger::singleton()->debug_error(&scene_synchronizer->get_network_interface(), "[FATAL] The `process_deferred_sync` found a node with ID `" + itos(node_info[i].od->get_net_id().id) + "::" + node_info[i].od->object_name.c_str() + "` that exceedes the max ID this function can network at the moment. Please report this, we will consider improving this function.");
+				NS_DEBUG_ERROR(&scene_synchronizer->get_network_interface(), "[FATAL] The `process_deferred_sync` found a node with ID `" + itos(node_info[i].od->get_net_id().id) + "::" + node_info[i].od->object_name.c_str() + "` that exceedes the max ID this function can network at the moment. Please report this, we will consider improving this function.", false);
 				send = false;
 			}
 
 			if (node_info[i].od->collect_epoch_func.is_null()) {
-				SceneSynchronizerDebugger::singleton()->debug_error(&scene_synchronizer->get_network_interface(), "The `process_deferred_sync` found a node `" + itos(node_info[i].od->get_net_id().id) + "::" + node_info[i].od->object_name.c_str() + "` with an invalid function `collect_epoch_func`. Please use `setup_deferred_sync` to correctly initialize this node for deferred sync.");
+				NS_DEBUG_ERROR(&scene_synchronizer->get_network_interface(), "The `process_deferred_sync` found a node `" + itos(node_info[i].od->get_net_id().id) + "::" + node_info[i].od->object_name.c_str() + "` with an invalid function `collect_epoch_func`. Please use `setup_deferred_sync` to correctly initialize this node for deferred sync.", false);
 				send = false;
 			}
 
@@ -2017,28 +2932,89 @@ void ServerSynchronizer::process_deferred_sync(real_t p_delta) {
 				node_info[i].od->collect_epoch_func.callp(&fake_array_vars, 1, r, e);
 
 				if (e.error != Callable::CallError::CALL_OK) {
-					SceneSynchronizerDebugger::singleton()->debug_error(&scene_synchronizer->get_network_interface(), "The `process_deferred_sync` was not able to execute the function `" + node_info[i].od->collect_epoch_func.get_method() + "` for the node `" + itos(node_info[i].od->get_net_id().id) + "::" + node_info[i].od->object_name.c_str() + "`.");
+					NS_DEBUG_ERROR(&scene_synchronizer->get_network_interface(), "The `process_deferred_sync` was not able to execute the function `" + node_info[i].od->collect_epoch_func.get_method() + "` for the node `" + itos(node_info[i].od->get_net_id().id) + "::" + node_info[i].od->object_name.c_str() + "`.", false);
 					continue;
 				}
 
 				if (tmp_buffer->total_size() > UINT16_MAX) {
-					SceneSynchronizerDebugger::singleton()->debug_error(&scene_synchronizer->get_network_interface(), "The `process_deferred_sync` failed because the method `" + node_info[i].od->collect_epoch_func.get_method() + "` for the node `" + itos(node_info[i].od->get_net_id().id) + "::" + node_info[i].od->object_name.c_str() + "` collected more than " + itos(UINT16_MAX) + " bits. Please optimize your netcode to send less data.");
+					NS_DEBUG_ERROR(&scene_synchronizer->get_network_interface(), "The `process_deferred_sync` failed because the method `" + node_info[i].od->collect_epoch_func.get_method() + "` for the node `" + itos(node_info[i].od->get_net_id().id) + "::" + node_info[i].od->object_name.c_str() + "` collected more than " + itos(UINT16_MAX) + " bits. Please optimize your netcode to send less data.", false);
 					continue;
 				}
 
+				NS::SyncGroup::DeferredNodeInfo &info = node_info[i];
+				const uint8_t *epoch_data = tmp_buffer->get_buffer().get_bytes().ptr();
+				const int epoch_bit_count = tmp_buffer->total_size();
+				const uint64_t epoch_hash = NS::hash_bits(epoch_data, epoch_bit_count);
+				const uint32_t epochs_since_check = epoch - info._last_checked_epoch;
+				info._last_checked_epoch = epoch;
+
+				const bool keyframe_needed =
+						info._last_epoch_bit_count < 0 ||
+						info._epochs_since_keyframe >= uint32_t(scene_synchronizer->deferred_sync_keyframe_interval);
+
+				if (!keyframe_needed && info._last_epoch_bit_count == epoch_bit_count && info._last_epoch_hash == epoch_hash) {
+					// The state didn't change since the last sent epoch, skip it.
+					info._epochs_since_keyframe += 1;
+					info._skipped_since_sent = true;
+					continue;
+				}
+
+				bool use_delta = false;
+				if (!keyframe_needed &&
+						scene_synchronizer->deferred_sync_delta_enabled &&
+						info._last_epoch_bit_count == epoch_bit_count &&
+						!info._last_epoch_data.is_empty() &&
+						(epoch - info._last_epoch) <= UINT16_MAX) {
+					// The delta also sends the reference epoch and the epoch size,
+					// which the full epoch doesn't need.
+					const int delta_header_bit_count = global_buffer.get_uint_size(DataBuffer::COMPRESSION_LEVEL_2) * 2;
+					use_delta = (NS::delta_encoded_bits_size(info._last_epoch_data.ptr(), epoch_data, epoch_bit_count) + delta_header_bit_count) < epoch_bit_count;
+				}
+
 				++update_node_count;
 
-				if (node_info[i].od->get_net_id().id > UINT8_MAX) {
+				if (info.od->get_net_id().id > UINT8_MAX) {
 					global_buffer.add_bool(true);
-					global_buffer.add_uint(node_info[i].od->get_net_id().id, DataBuffer::COMPRESSION_LEVEL_2);
+					global_buffer.add_uint(info.od->get_net_id().id, DataBuffer::COMPRESSION_LEVEL_2);
 				} else {
 					global_buffer.add_bool(false);
-					global_buffer.add_uint(node_info[i].od->get_net_id().id, DataBuffer::COMPRESSION_LEVEL_3);
+					global_buffer.add_uint(info.od->get_net_id().id, DataBuffer::COMPRESSION_LEVEL_3);
+				}
+
+				// When the previous epochs were skipped, the client needs to
+				// know when the state was last checked, to interpolate from there.
+				global_buffer.add_bool(info._skipped_since_sent);
+				if (info._skipped_since_sent) {
+					global_buffer.add_uint(MIN(epochs_since_check, uint32_t(UINT16_MAX)), DataBuffer::COMPRESSION_LEVEL_2);
+				}
+
+				global_buffer.add_bool(use_delta);
+				if (use_delta) {
+					delta_buffer.begin_write(0);
+					NS::delta_encode_bits(info._last_epoch_data.ptr(), epoch_data, epoch_bit_count, delta_buffer);
+
+					global_buffer.add_uint(epoch - info._last_epoch, DataBuffer::COMPRESSION_LEVEL_2);
+					global_buffer.add_uint(uint32_t(epoch_bit_count), DataBuffer::COMPRESSION_LEVEL_2);
+					global_buffer.add_uint(uint32_t(delta_buffer.total_size()), DataBuffer::COMPRESSION_LEVEL_2);
+					global_buffer.add_bits(delta_buffer.get_buffer().get_bytes().ptr(), delta_buffer.total_size());
+					info._epochs_since_keyframe += 1;
+				} else {
+					// Collapse the two DataBuffer.
+					global_buffer.add_uint(uint32_t(epoch_bit_count), DataBuffer::COMPRESSION_LEVEL_2);
+					global_buffer.add_bits(epoch_data, epoch_bit_count);
+					info._epochs_since_keyframe = 0;
 				}
 
-				// Collapse the two DataBuffer.
-				global_buffer.add_uint(uint32_t(tmp_buffer->total_size()), DataBuffer::COMPRESSION_LEVEL_2);
-				global_buffer.add_bits(tmp_buffer->get_buffer().get_bytes().ptr(), tmp_buffer->total_size());
+				info._last_epoch_hash = epoch_hash;
+				info._last_epoch_bit_count = epoch_bit_count;
+				info._last_epoch = epoch;
+				info._skipped_since_sent = false;
+				if (scene_synchronizer->deferred_sync_delta_enabled) {
+					info._last_epoch_data.resize((epoch_bit_count + 7) / 8);
+					memcpy(info._last_epoch_data.ptrw(), epoch_data, info._last_epoch_data.size());
+				} else if (!info._last_epoch_data.is_empty()) {
+					info._last_epoch_data.clear();
+				}
 
 			} else {
 				node_info[i]._update_priority += node_info[i].update_rate;
@@ -2076,21 +3052,28 @@ void ClientSynchronizer::clear() {
 	last_checked_input = 0;
 	enabled = true;
 	need_full_snapshot_notified = false;
+	pending_resync.clear();
+	requested_resync.clear();
+	resync_clock = 0.0;
+	join_streaming = false;
 }
 
 void ClientSynchronizer::process() {
-	SceneSynchronizerDebugger::singleton()->debug_print(&scene_synchronizer->get_network_interface(), "ClientSynchronizer::process", true);
+	NS_DEBUG_PRINT(&scene_synchronizer->get_network_interface(), "ClientSynchronizer::process", true);
 
 	const double physics_ticks_per_second = Engine::get_singleton()->get_physics_ticks_per_second();
 	const double delta = 1.0 / physics_ticks_per_second;
 
 #ifdef DEBUG_ENABLED
 	if (unlikely(Engine::get_singleton()->get_frames_per_second() < physics_ticks_per_second)) {
-		const bool silent = !ProjectSettings::get_singleton()->get_setting("NetworkSynchronizer/debugger/log_debug_fps_warnings");
-		SceneSynchronizerDebugger::singleton()->debug_warning(&scene_synchronizer->get_network_interface(), "Current FPS is " + itos(Engine::get_singleton()->get_frames_per_second()) + ", but the minimum required FPS is " + itos(physics_ticks_per_second) + ", the client is unable to generate enough inputs for the server.", silent);
+		NS_DEBUG_WARNING_CATEGORY(LOG_CATEGORY_FPS, &scene_synchronizer->get_network_interface(), "Current FPS is " + itos(Engine::get_singleton()->get_frames_per_second()) + ", but the minimum required FPS is " + itos(physics_ticks_per_second) + ", the client is unable to generate enough inputs for the server.");
 	}
 #endif
 
+	resync_clock += delta;
+
+	process_dolls_replay(delta);
+
 	process_simulation(delta, physics_ticks_per_second);
 
 	process_received_server_state(delta);
@@ -2120,7 +3103,7 @@ void ClientSynchronizer::receive_snapshot(DataBuffer &p_snapshot) {
 	// incremental update so the last received data is always needed to fully
 	// reconstruct it.
 
-	SceneSynchronizerDebugger::singleton()->debug_print(&scene_synchronizer->get_network_interface(), "The Client received the server snapshot.", true);
+	NS_DEBUG_PRINT(&scene_synchronizer->get_network_interface(), "The Client received the server snapshot.", true);
 
 	// Parse server snapshot.
 	const bool success = parse_snapshot(p_snapshot);
@@ -2171,7 +3154,7 @@ void ClientSynchronizer::signal_end_sync_changed_variables_events() {
 		// Check if the values between the variables before the sync and the
 		// current one are different.
 		if (scene_synchronizer->network_interface->compare(
-					e->get().node_data->vars[e->get().var_id.id].var.value,
+					e->get().node_data->vars[e->get().var_id.id].value,
 					e->get().old_value) == false) {
 			// Are different so we need to emit the `END_SYNC`.
 			scene_synchronizer->change_event_add(
@@ -2199,7 +3182,7 @@ void ClientSynchronizer::on_controller_reset(NS::ObjectData *p_object_data) {
 
 	if (p_object_data->get_controller()->is_player_controller()) {
 		if (player_controller_node_data != nullptr) {
-			SceneSynchronizerDebugger::singleton()->debug_error(&scene_synchronizer->get_network_interface(), "Only one player controller is supported, at the moment. Make sure this is the case.");
+			NS_DEBUG_ERROR(&scene_synchronizer->get_network_interface(), "Only one player controller is supported, at the moment. Make sure this is the case.", false);
 		} else {
 			// Set this player controller as active.
 			player_controller_node_data = p_object_data;
@@ -2237,13 +3220,13 @@ void ClientSynchronizer::store_controllers_snapshot(
 	}
 
 	if (p_snapshot.input_id == UINT32_MAX) {
-		SceneSynchronizerDebugger::singleton()->debug_print(&scene_synchronizer->get_network_interface(), "The Client received the server snapshot WITHOUT `input_id`.", true);
+		NS_DEBUG_PRINT(&scene_synchronizer->get_network_interface(), "The Client received the server snapshot WITHOUT `input_id`.", true);
 		// The controller node is not registered so just assume this snapshot is the most up-to-date.
 		r_snapshot_storage.clear();
 		r_snapshot_storage.push_back(Snapshot::make_copy(p_snapshot));
 
 	} else {
-		SceneSynchronizerDebugger::singleton()->debug_print(&scene_synchronizer->get_network_interface(), "The Client received the server snapshot: " + itos(p_snapshot.input_id), true);
+		NS_DEBUG_PRINT(&scene_synchronizer->get_network_interface(), "The Client received the server snapshot: " + itos(p_snapshot.input_id), true);
 
 		// Store the snapshot sorted by controller input ID.
 		if (r_snapshot_storage.empty() == false) {
@@ -2291,11 +3274,11 @@ void ClientSynchronizer::process_simulation(real_t p_delta, real_t p_physics_tic
 	int sub_ticks = player_controller->calculates_sub_ticks(p_delta, p_physics_ticks_per_second);
 
 	if (sub_ticks == 0) {
-		SceneSynchronizerDebugger::singleton()->debug_print(&scene_synchronizer->get_network_interface(), "No sub ticks: this is not bu a bug; it's the lag compensation algorithm.", true);
+		NS_DEBUG_PRINT(&scene_synchronizer->get_network_interface(), "No sub ticks: this is not bu a bug; it's the lag compensation algorithm.", true);
 	}
 
 	while (sub_ticks > 0) {
-		SceneSynchronizerDebugger::singleton()->debug_print(&scene_synchronizer->get_network_interface(), "ClientSynchronizer::process::sub_process " + itos(sub_ticks), true);
+		NS_DEBUG_PRINT(&scene_synchronizer->get_network_interface(), "ClientSynchronizer::process::sub_process " + itos(sub_ticks), true);
 		SceneSynchronizerDebugger::singleton()->scene_sync_process_start(scene_synchronizer);
 
 		// Process the scene.
@@ -2322,6 +3305,51 @@ void ClientSynchronizer::process_simulation(real_t p_delta, real_t p_physics_tic
 	}
 }
 
+void ClientSynchronizer::process_dolls_replay(real_t p_delta) {
+	for (NS::ObjectData *od : scene_synchronizer->objects_data_storage.get_controllers_objects_data()) {
+		DollController *doll = od->get_controller() && od->get_controller()->is_doll_controller() ? od->get_controller()->get_doll_controller() : nullptr;
+		if (doll == nullptr || doll->replay_from_input_id == UINT32_MAX) {
+			continue;
+		}
+
+		const uint32_t replay_from = doll->replay_from_input_id;
+		const uint32_t current_input_id = doll->current_input_buffer_id;
+		doll->replay_from_input_id = UINT32_MAX;
+
+		if (replay_from == 0 || current_input_id == UINT32_MAX || replay_from > current_input_id || od->realtime_sync_enabled_on_client == false) {
+			continue;
+		}
+
+		// Find the state the doll had before processing the mispredicted input.
+		size_t snapshot_index = client_snapshots.size();
+		for (size_t i = 0; i < client_snapshots.size(); i++) {
+			if (client_snapshots[i].input_id == replay_from - 1) {
+				snapshot_index = i;
+				break;
+			}
+		}
+		if (snapshot_index >= client_snapshots.size() || od->get_net_id().id >= client_snapshots[snapshot_index].object_vars.size()) {
+			// Too old: the server snapshot corrects it.
+			continue;
+		}
+
+		scene_synchronizer->change_events_begin(NetEventFlag::SYNC_RECOVER | NetEventFlag::SYNC_REWIND);
+		apply_object_vars(*od, client_snapshots[snapshot_index].object_vars[od->get_net_id().id], nullptr);
+
+		for (size_t i = snapshot_index + 1; i < client_snapshots.size() && client_snapshots[i].input_id <= current_input_id; i++) {
+			if (doll->replay_input(client_snapshots[i].input_id, p_delta)) {
+				scene_synchronizer->pull_node_changes(od);
+			}
+			if (od->get_net_id().id < client_snapshots[i].object_vars.size()) {
+				update_client_snapshot_object(client_snapshots[i], *od);
+			}
+		}
+
+		scene_synchronizer->change_events_flush();
+		doll->current_input_buffer_id = current_input_id;
+	}
+}
+
 void ClientSynchronizer::process_received_server_state(real_t p_delta) {
 	// The client is responsible to recover only its local controller, while all
 	// the other controllers_node_data (dolls) have their state interpolated. There is
@@ -2339,7 +3367,7 @@ void ClientSynchronizer::process_received_server_state(real_t p_delta) {
 
 	if (server_snapshots.back().input_id == UINT32_MAX) {
 		// The server last received snapshot is a no input snapshot. Just assume it's the most up-to-date.
-		SceneSynchronizerDebugger::singleton()->debug_print(&scene_synchronizer->get_network_interface(), "The client received a \"no input\" snapshot, so the client is setting it right away assuming is the most updated one.", true);
+		NS_DEBUG_PRINT(&scene_synchronizer->get_network_interface(), "The client received a \"no input\" snapshot, so the client is setting it right away assuming is the most updated one.", true);
 
 		apply_snapshot(server_snapshots.back(), NetEventFlag::SYNC_RECOVER, nullptr);
 
@@ -2439,9 +3467,14 @@ void ClientSynchronizer::process_received_server_state(real_t p_delta) {
 				scene_synchronizer->get_network_interface().get_name(),
 				"Recover input: " + itos(checkable_input_id) + " - Last input: " + itos(player_controller->get_stored_input_id(-1)));
 
+		NS::RewindProfiler &profiler = scene_synchronizer->rewind_profiler;
+		const uint64_t sync_begin_usec = profiler.is_enabled() ? OS::get_singleton()->get_ticks_usec() : 0;
+
 		// Sync.
 		__pcr__sync__rewind();
 
+		const uint64_t rewind_begin_usec = profiler.is_enabled() ? OS::get_singleton()->get_ticks_usec() : 0;
+
 		// Rewind.
 		__pcr__rewind(
 				p_delta,
@@ -2449,7 +3482,15 @@ void ClientSynchronizer::process_received_server_state(real_t p_delta) {
 				player_controller_node_data,
 				controller,
 				player_controller);
+
+		if (profiler.is_enabled()) {
+			const uint64_t rewind_end_usec = OS::get_singleton()->get_ticks_usec();
+			// At this point, the client snapshots are the rewound frames.
+			profiler.notify_rewind(int(client_snapshots.size()), rewind_begin_usec - sync_begin_usec, rewind_end_usec - rewind_begin_usec);
+		}
 	} else {
+		scene_synchronizer->rewind_profiler.discard_pending_triggers();
+
 		if (no_rewind_recover.input_id == 0) {
 			SceneSynchronizerDebugger::singleton()->notify_event(SceneSynchronizerDebugger::FrameEvent::CLIENT_DESYNC_DETECTED_SOFT);
 
@@ -2480,6 +3521,7 @@ bool ClientSynchronizer::__pcr__fetch_recovery_info(
 			client_snapshots.front(),
 			&r_no_rewind_recover,
 			scene_synchronizer->debug_rewindings_enabled ? &differences_info : nullptr,
+			scene_synchronizer->rewind_profiler.is_enabled() ? &scene_synchronizer->rewind_profiler : nullptr,
 			&different_node_data);
 
 	if (!is_equal) {
@@ -2529,14 +3571,15 @@ bool ClientSynchronizer::__pcr__fetch_recovery_info(
 			server_snapshots.front(),
 			client_snapshots.front(),
 			&r_no_rewind_recover,
-			scene_synchronizer->debug_rewindings_enabled ? &differences_info : nullptr);
+			scene_synchronizer->debug_rewindings_enabled ? &differences_info : nullptr,
+			scene_synchronizer->rewind_profiler.is_enabled() ? &scene_synchronizer->rewind_profiler : nullptr);
 #endif
 
 	// Prints the comparison info.
 	if (differences_info.size() > 0 && scene_synchronizer->debug_rewindings_enabled) {
-		SceneSynchronizerDebugger::singleton()->debug_print(&scene_synchronizer->get_network_interface(), "Rewind on frame " + itos(p_input_id) + " is needed because:");
+		NS_DEBUG_PRINT(&scene_synchronizer->get_network_interface(), "Rewind on frame " + itos(p_input_id) + " is needed because:", false);
 		for (int i = 0; i < int(differences_info.size()); i++) {
-			SceneSynchronizerDebugger::singleton()->debug_print(&scene_synchronizer->get_network_interface(), "|- " + differences_info[i]);
+			NS_DEBUG_PRINT(&scene_synchronizer->get_network_interface(), "|- " + differences_info[i], false);
 		}
 	}
 
@@ -2556,9 +3599,9 @@ void ClientSynchronizer::__pcr__sync__rewind() {
 			scene_synchronizer->debug_rewindings_enabled ? &applied_data_info : nullptr);
 
 	if (applied_data_info.size() > 0) {
-		SceneSynchronizerDebugger::singleton()->debug_print(&scene_synchronizer->get_network_interface(), "Full reset:");
+		NS_DEBUG_PRINT(&scene_synchronizer->get_network_interface(), "Full reset:", false);
 		for (int i = 0; i < int(applied_data_info.size()); i++) {
-			SceneSynchronizerDebugger::singleton()->debug_print(&scene_synchronizer->get_network_interface(), "|- " + applied_data_info[i]);
+			NS_DEBUG_PRINT(&scene_synchronizer->get_network_interface(), "|- " + applied_data_info[i], false);
 		}
 	}
 }
@@ -2590,7 +3633,7 @@ void ClientSynchronizer::__pcr__rewind(
 		scene_synchronizer->event_rewind_frame_begin.broadcast(p_local_player_controller->get_stored_input_id(i), i, remaining_inputs);
 #ifdef DEBUG_ENABLED
 		has_next = p_local_controller->has_another_instant_to_process_after(i);
-		SceneSynchronizerDebugger::singleton()->debug_print(&scene_synchronizer->get_network_interface(), "Rewind, processed controller: " + String(p_local_controller_node->object_name.c_str()), !scene_synchronizer->debug_rewindings_enabled);
+		NS_DEBUG_PRINT_CATEGORY(LOG_CATEGORY_REWIND, &scene_synchronizer->get_network_interface(), "Rewind, processed controller: " + String(p_local_controller_node->object_name.c_str()));
 #endif
 
 		// Step 2 -- Process the scene.
@@ -2624,9 +3667,9 @@ void ClientSynchronizer::__pcr__sync__no_rewind(const NS::Snapshot &p_no_rewind_
 			true);
 
 	if (applied_data_info.size() > 0) {
-		SceneSynchronizerDebugger::singleton()->debug_print(&scene_synchronizer->get_network_interface(), "Partial reset:");
+		NS_DEBUG_PRINT(&scene_synchronizer->get_network_interface(), "Partial reset:", false);
 		for (int i = 0; i < int(applied_data_info.size()); i++) {
-			SceneSynchronizerDebugger::singleton()->debug_print(&scene_synchronizer->get_network_interface(), "|- " + applied_data_info[i]);
+			NS_DEBUG_PRINT(&scene_synchronizer->get_network_interface(), "|- " + applied_data_info[i], false);
 		}
 	}
 
@@ -2666,9 +3709,9 @@ void ClientSynchronizer::process_paused_controller_recovery(real_t p_delta) {
 	server_snapshots.pop_front();
 
 	if (applied_data_info.size() > 0) {
-		SceneSynchronizerDebugger::singleton()->debug_print(&scene_synchronizer->get_network_interface(), "Paused controller recover:");
+		NS_DEBUG_PRINT(&scene_synchronizer->get_network_interface(), "Paused controller recover:", false);
 		for (int i = 0; i < int(applied_data_info.size()); i++) {
-			SceneSynchronizerDebugger::singleton()->debug_print(&scene_synchronizer->get_network_interface(), "|- " + applied_data_info[i]);
+			NS_DEBUG_PRINT(&scene_synchronizer->get_network_interface(), "|- " + applied_data_info[i], false);
 		}
 	}
 }
@@ -2718,6 +3761,16 @@ bool ClientSynchronizer::parse_sync_data(
 		}
 	}
 
+	// While the server streams the world, the objects not received yet are
+	// expected: they are not requested.
+	bool join_pending = false;
+	p_snapshot.read(join_pending);
+	ERR_FAIL_COND_V_MSG(p_snapshot.is_buffer_failed(), false, "This snapshot is corrupted as the `join_pending` boolean expected is not set.");
+	if (has_active_list_array) {
+		// The join snapshots always have the list.
+		join_streaming = join_pending;
+	}
+
 	{
 		bool has_custom_data = false;
 		p_snapshot.read(has_custom_data);
@@ -2731,6 +3784,11 @@ bool ClientSynchronizer::parse_sync_data(
 	while (true) {
 		// First extract the object data
 		NS::ObjectData *synchronizer_object_data = nullptr;
+		// Set when the object is registered by this snapshot: its variables
+		// that are not in the snapshot are requested to the server.
+		bool registered_now = false;
+		// Sent along with the object name, 0 otherwise.
+		std::uint32_t process_rate_divisor = 0;
 		{
 			ObjectNetId net_id = ObjectNetId::NONE;
 			p_snapshot.read(net_id.id);
@@ -2751,8 +3809,19 @@ bool ClientSynchronizer::parse_sync_data(
 				p_snapshot.read(object_name);
 				ERR_FAIL_COND_V_MSG(p_snapshot.is_buffer_failed(), false, "This snapshot is corrupted. The `object_name` was expected at this point.");
 
+				bool has_process_rate_divisor = false;
+				p_snapshot.read(has_process_rate_divisor);
+				ERR_FAIL_COND_V_MSG(p_snapshot.is_buffer_failed(), false, "This snapshot is corrupted. The `has_process_rate_divisor` was expected at this point.");
+
+				process_rate_divisor = 1;
+				if (has_process_rate_divisor) {
+					p_snapshot.read(process_rate_divisor);
+					ERR_FAIL_COND_V_MSG(p_snapshot.is_buffer_failed() || process_rate_divisor == 0, false, "This snapshot is corrupted. The `process_rate_divisor` was expected at this point.");
+				}
+
 				// Associate the ID with the path.
 				objects_names.insert(std::pair(net_id, object_name));
+				requested_resync.notify_received(net_id);
 			}
 
 			// Fetch the ObjectData.
@@ -2766,8 +3835,8 @@ bool ClientSynchronizer::parse_sync_data(
 
 					if (object_name_ptr == nullptr) {
 						// The name for this `NodeId` doesn't exists yet.
-						SceneSynchronizerDebugger::singleton()->debug_warning(&scene_synchronizer->get_network_interface(), "The object with ID `" + itos(net_id.id) + "` is not know by this peer yet.");
-						notify_server_full_snapshot_is_needed();
+						NS_DEBUG_WARNING(&scene_synchronizer->get_network_interface(), "The object with ID `" + itos(net_id.id) + "` is not know by this peer yet.", false);
+						request_object_resync(net_id);
 					} else {
 						object_name = *object_name_ptr;
 					}
@@ -2779,7 +3848,7 @@ bool ClientSynchronizer::parse_sync_data(
 
 				if (app_object_handle == ObjectHandle::NONE) {
 					// The node doesn't exists.
-					SceneSynchronizerDebugger::singleton()->debug_warning(&scene_synchronizer->get_network_interface(), "The object " + String(object_name.c_str()) + " still doesn't exist.");
+					NS_DEBUG_WARNING(&scene_synchronizer->get_network_interface(), "The object " + String(object_name.c_str()) + " still doesn't exist.", false);
 				} else {
 					// Register this object, so to make sure the client is tracking it.
 					ObjectLocalId reg_obj_id;
@@ -2788,8 +3857,9 @@ bool ClientSynchronizer::parse_sync_data(
 						synchronizer_object_data = scene_synchronizer->get_object_data(reg_obj_id);
 						// Set the NetId.
 						synchronizer_object_data->set_net_id(net_id);
+						registered_now = true;
 					} else {
-						SceneSynchronizerDebugger::singleton()->debug_error(&scene_synchronizer->get_network_interface(), "[BUG] This object " + String(object_name.c_str()) + " was known on this client. Though, was not possible to register it as sync object.");
+						NS_DEBUG_ERROR(&scene_synchronizer->get_network_interface(), "[BUG] This object " + String(object_name.c_str()) + " was known on this client. Though, was not possible to register it as sync object.", false);
 					}
 				}
 			}
@@ -2804,6 +3874,11 @@ bool ClientSynchronizer::parse_sync_data(
 			CRASH_COND(synchronizer_object_data->get_net_id() == ObjectNetId::NONE);
 #endif
 
+			if (process_rate_divisor != 0 && synchronizer_object_data->process_rate_divisor != process_rate_divisor) {
+				synchronizer_object_data->process_rate_divisor = process_rate_divisor;
+				scene_synchronizer->process_functions__clear();
+			}
+
 			p_node_parse(p_user_pointer, synchronizer_object_data);
 
 			if (synchronizer_object_data->get_controller()) {
@@ -2826,14 +3901,19 @@ bool ClientSynchronizer::parse_sync_data(
 				}
 			}
 		} else {
+			LocalVector<VarId> missing_vars;
 			for (auto &var_desc : synchronizer_object_data->vars) {
 				bool var_has_value = false;
 				p_snapshot.read(var_has_value);
-				ERR_FAIL_COND_V_MSG(p_snapshot.is_buffer_failed(), false, String() + "This snapshot is corrupted. The `var_has_value` was expected at this point. Object: `" + synchronizer_object_data->object_name.c_str() + "` Var: `" + var_desc.var.name.c_str() + "`");
+				ERR_FAIL_COND_V_MSG(p_snapshot.is_buffer_failed(), false, String() + "This snapshot is corrupted. The `var_has_value` was expected at this point. Object: `" + synchronizer_object_data->object_name.c_str() + "` Var: `" + synchronizer_object_data->get_variable_name(var_desc.id).c_str() + "`");
+
+				if (registered_now && !var_has_value && var_desc.enabled) {
+					missing_vars.push_back(var_desc.id);
+				}
 
 				if (var_has_value) {
 					Variant value = p_snapshot.read_variant();
-					ERR_FAIL_COND_V_MSG(p_snapshot.is_buffer_failed(), false, String() + "This snapshot is corrupted. The `variable value` was expected at this point. Object: `" + synchronizer_object_data->object_name.c_str() + "` Var: `" + var_desc.var.name.c_str() + "`");
+					ERR_FAIL_COND_V_MSG(p_snapshot.is_buffer_failed(), false, String() + "This snapshot is corrupted. The `variable value` was expected at this point. Object: `" + synchronizer_object_data->object_name.c_str() + "` Var: `" + synchronizer_object_data->get_variable_name(var_desc.id).c_str() + "`");
 
 					// Variable fetched, now parse this variable.
 					p_variable_parse(
@@ -2843,6 +3923,10 @@ bool ClientSynchronizer::parse_sync_data(
 							value);
 				}
 			}
+
+			if (!missing_vars.is_empty()) {
+				request_object_resync(synchronizer_object_data->get_net_id(), missing_vars);
+			}
 		}
 	}
 
@@ -2867,10 +3951,17 @@ bool ClientSynchronizer::parse_sync_data(
 	if (!active_objects.empty()) {
 		// There are some objects lefts into the active objects list, which means this
 		// peer doesn't have all the objects registered by the server.
-		SceneSynchronizerDebugger::singleton()->debug_error(&scene_synchronizer->get_network_interface(), "This client received an active object data that is not registered. Requested full snapshot.");
-		notify_server_full_snapshot_is_needed();
+		NS_DEBUG_ERROR(&scene_synchronizer->get_network_interface(), "This client received an active object data that is not registered. Requested the resync of these objects.", false);
+		for (ObjectNetId net_id : active_objects) {
+			request_object_resync(net_id);
+		}
 	}
 
+	if (join_streaming) {
+		pending_resync.clear();
+	}
+	notify_server_resync_is_needed();
+
 	return true;
 }
 
@@ -2897,7 +3988,7 @@ void ClientSynchronizer::receive_deferred_sync_data(const Vector<uint8_t> &p_dat
 
 	int remaining_size = future_epoch_buffer.size() - future_epoch_buffer.get_bit_offset();
 	if (remaining_size < DataBuffer::get_bit_taken(DataBuffer::DATA_TYPE_UINT, DataBuffer::COMPRESSION_LEVEL_1)) {
-		SceneSynchronizerDebugger::singleton()->debug_error(&scene_synchronizer->get_network_interface(), "[FATAL] The function `receive_deferred_sync_data` received malformed data.");
+		NS_DEBUG_ERROR(&scene_synchronizer->get_network_interface(), "[FATAL] The function `receive_deferred_sync_data` received malformed data.", false);
 		// Nothing to fetch.
 		return;
 	}
@@ -2936,16 +4027,50 @@ void ClientSynchronizer::receive_deferred_sync_data(const Vector<uint8_t> &p_dat
 			node_id.id = future_epoch_buffer.read_uint(DataBuffer::COMPRESSION_LEVEL_3);
 		}
 
+		// Fetch the epochs skipped by the server, as this node didn't change.
+		uint32_t epochs_since_check = 0;
+		remaining_size = future_epoch_buffer.size() - future_epoch_buffer.get_bit_offset();
+		if (remaining_size < future_epoch_buffer.get_bool_size()) {
+			break;
+		}
+		if (future_epoch_buffer.read_bool()) {
+			remaining_size = future_epoch_buffer.size() - future_epoch_buffer.get_bit_offset();
+			if (remaining_size < future_epoch_buffer.get_uint_size(DataBuffer::COMPRESSION_LEVEL_2)) {
+				break;
+			}
+			epochs_since_check = future_epoch_buffer.read_uint(DataBuffer::COMPRESSION_LEVEL_2);
+		}
+
+		// Fetch the delta encoding info.
+		remaining_size = future_epoch_buffer.size() - future_epoch_buffer.get_bit_offset();
+		if (remaining_size < future_epoch_buffer.get_bool_size()) {
+			break;
+		}
+		const bool is_delta = future_epoch_buffer.read_bool();
+		uint32_t delta_reference_epoch = UINT32_MAX;
+		int epoch_bit_count = 0;
+		if (is_delta) {
+			remaining_size = future_epoch_buffer.size() - future_epoch_buffer.get_bit_offset();
+			if (remaining_size < (future_epoch_buffer.get_uint_size(DataBuffer::COMPRESSION_LEVEL_2) * 2)) {
+				break;
+			}
+			delta_reference_epoch = epoch - future_epoch_buffer.read_uint(DataBuffer::COMPRESSION_LEVEL_2);
+			epoch_bit_count = future_epoch_buffer.read_uint(DataBuffer::COMPRESSION_LEVEL_2);
+		}
+
 		remaining_size = future_epoch_buffer.size() - future_epoch_buffer.get_bit_offset();
 		if (remaining_size < future_epoch_buffer.get_uint_size(DataBuffer::COMPRESSION_LEVEL_2)) {
 			// buffer entirely consumed, nothing else to do.
 			break;
 		}
 		const int buffer_bit_count = future_epoch_buffer.read_uint(DataBuffer::COMPRESSION_LEVEL_2);
+		if (!is_delta) {
+			epoch_bit_count = buffer_bit_count;
+		}
 
 		remaining_size = future_epoch_buffer.size() - future_epoch_buffer.get_bit_offset();
 		if (remaining_size < buffer_bit_count) {
-			SceneSynchronizerDebugger::singleton()->debug_error(&scene_synchronizer->get_network_interface(), "[FATAL] The function `receive_deferred_sync_data` failed applying the epoch because the received buffer is malformed. The node with ID `" + itos(node_id.id) + "` reported that the sub buffer size is `" + itos(buffer_bit_count) + "` but the main-buffer doesn't have so many bits.");
+			NS_DEBUG_ERROR(&scene_synchronizer->get_network_interface(), "[FATAL] The function `receive_deferred_sync_data` failed applying the epoch because the received buffer is malformed. The node with ID `" + itos(node_id.id) + "` reported that the sub buffer size is `" + itos(buffer_bit_count) + "` but the main-buffer doesn't have so many bits.", false);
 			break;
 		}
 
@@ -2954,16 +4079,11 @@ void ClientSynchronizer::receive_deferred_sync_data(const Vector<uint8_t> &p_dat
 
 		NS::ObjectData *nd = scene_synchronizer->get_object_data(node_id, false);
 		if (nd == nullptr) {
-			SceneSynchronizerDebugger::singleton()->debug_print(&scene_synchronizer->get_network_interface(), "The function `receive_deferred_sync_data` is skipping the node with ID `" + itos(node_id.id) + "` as it was not found locally.");
+			NS_DEBUG_PRINT(&scene_synchronizer->get_network_interface(), "The function `receive_deferred_sync_data` is skipping the node with ID `" + itos(node_id.id) + "` as it was not found locally.", false);
 			future_epoch_buffer.seek(expected_bit_offset_after_apply);
 			continue;
 		}
 
-		Vector<uint8_t> future_buffer_data;
-		future_buffer_data.resize(Math::ceil(float(buffer_bit_count) / 8.0));
-		future_epoch_buffer.read_bits(future_buffer_data.ptrw(), buffer_bit_count);
-		CRASH_COND_MSG(future_epoch_buffer.get_bit_offset() != expected_bit_offset_after_apply, "At this point the buffer is expected to be exactly at this bit.");
-
 		int64_t index = deferred_sync_array.find(nd);
 		if (index == -1) {
 			index = deferred_sync_array.size();
@@ -2973,6 +4093,30 @@ void ClientSynchronizer::receive_deferred_sync_data(const Vector<uint8_t> &p_dat
 #ifdef DEBUG_ENABLED
 		CRASH_COND(stream.nd != nd);
 #endif
+
+		Vector<uint8_t> future_buffer_data;
+		future_buffer_data.resize(Math::ceil(float(epoch_bit_count) / 8.0));
+		if (is_delta) {
+			if (stream.last_epoch != delta_reference_epoch || stream.last_epoch_bit_count != epoch_bit_count) {
+				// The reference epoch was lost: wait for the next full epoch.
+				NS_DEBUG_PRINT(&scene_synchronizer->get_network_interface(), "The function `receive_deferred_sync_data` is skipping the delta epoch for the node `" + String(nd->object_name.c_str()) + "` as the reference epoch `" + itos(delta_reference_epoch) + "` is missing.", false);
+				future_epoch_buffer.seek(expected_bit_offset_after_apply);
+				continue;
+			}
+			if (!NS::delta_decode_bits(stream.last_epoch_data.ptr(), epoch_bit_count, future_epoch_buffer, future_buffer_data.ptrw())) {
+				NS_DEBUG_ERROR(&scene_synchronizer->get_network_interface(), "[FATAL] The function `receive_deferred_sync_data` failed decoding the delta epoch for the node `" + String(nd->object_name.c_str()) + "`.", false);
+				break;
+			}
+		} else {
+			future_epoch_buffer.read_bits(future_buffer_data.ptrw(), buffer_bit_count);
+		}
+		CRASH_COND_MSG(future_epoch_buffer.get_bit_offset() != expected_bit_offset_after_apply, "At this point the buffer is expected to be exactly at this bit.");
+
+		// Store this epoch, as the reference for the next delta.
+		stream.last_epoch_data = future_buffer_data;
+		stream.last_epoch_bit_count = epoch_bit_count;
+		stream.last_epoch = epoch;
+
 		stream.future_epoch_buffer.copy(future_buffer_data);
 
 		stream.past_epoch_buffer.begin_write(0);
@@ -2986,13 +4130,18 @@ void ClientSynchronizer::receive_deferred_sync_data(const Vector<uint8_t> &p_dat
 		stream.past_epoch_buffer.copy(*db);
 
 		if (e.error != Callable::CallError::CALL_OK) {
-			SceneSynchronizerDebugger::singleton()->debug_print(&scene_synchronizer->get_network_interface(), "The function `receive_deferred_sync_data` is skipping the node `" + String(stream.nd->object_name.c_str()) + "` as the function `" + stream.nd->collect_epoch_func.get_method() + "` failed executing.");
+			NS_DEBUG_PRINT(&scene_synchronizer->get_network_interface(), "The function `receive_deferred_sync_data` is skipping the node `" + String(stream.nd->object_name.c_str()) + "` as the function `" + stream.nd->collect_epoch_func.get_method() + "` failed executing.", false);
 			future_epoch_buffer.seek(expected_bit_offset_after_apply);
 			continue;
 		}
 
 		// 3. Initialize the past_epoch and the future_epoch.
 		stream.past_epoch = stream.future_epoch;
+		if (epochs_since_check > 0 && stream.past_epoch != UINT32_MAX) {
+			// The server skipped the epochs in between, as the state didn't
+			// change: so interpolate from the last check.
+			stream.past_epoch = MAX(stream.past_epoch, epoch - MIN(epoch, epochs_since_check));
+		}
 		stream.future_epoch = epoch;
 
 		if (stream.past_epoch < stream.future_epoch) {
@@ -3009,6 +4158,31 @@ void ClientSynchronizer::receive_deferred_sync_data(const Vector<uint8_t> &p_dat
 	memdelete(db);
 }
 
+void ClientSynchronizer::receive_doll_inputs(const Vector<uint8_t> &p_data) {
+	int ofs = 0;
+	Vector<uint8_t> inputs;
+	while (ofs < p_data.size()) {
+		ERR_FAIL_COND_MSG(ofs + 6 > p_data.size(), "The doll inputs packet is malformed.");
+		const ObjectNetId net_id = { decode_uint32(p_data.ptr() + ofs) };
+		const int inputs_size = decode_uint16(p_data.ptr() + ofs + 4);
+		ofs += 6;
+		ERR_FAIL_COND_MSG(ofs + inputs_size > p_data.size(), "The doll inputs packet is malformed.");
+
+		NS::ObjectData *od = scene_synchronizer->get_object_data(net_id, false);
+		if (od == nullptr || od->get_controller() == nullptr || !od->get_controller()->is_doll_controller()) {
+			// Not yet known, or not a doll on this peer: the server keeps
+			// sending the inputs, so just skip it.
+			ofs += inputs_size;
+			continue;
+		}
+
+		inputs.resize(inputs_size);
+		memcpy(inputs.ptrw(), p_data.ptr() + ofs, inputs_size);
+		od->get_controller()->get_doll_controller()->receive_inputs(inputs);
+		ofs += inputs_size;
+	}
+}
+
 void ClientSynchronizer::process_received_deferred_sync_data(real_t p_delta) {
 	DataBuffer *db1 = memnew(DataBuffer);
 	DataBuffer *db2 = memnew(DataBuffer);
@@ -3023,22 +4197,22 @@ void ClientSynchronizer::process_received_deferred_sync_data(real_t p_delta) {
 
 	for (int i = 0; i < int(deferred_sync_array.size()); ++i) {
 		DeferredSyncInterpolationData &stream = deferred_sync_array[i];
-		if (stream.alpha > 1.2) {
-			// The stream is not yet started.
-			// OR
-			// The stream for this node is stopped as the data received is old.
+		NS::ObjectData *nd = stream.nd;
+		if (nd == nullptr) {
+			NS_DEBUG_ERROR(&scene_synchronizer->get_network_interface(), "The function `process_received_deferred_sync_data` found a null NodeData into the `deferred_sync_array`; this is not supposed to happen.", false);
 			continue;
 		}
 
-		NS::ObjectData *nd = stream.nd;
-		if (nd == nullptr) {
-			SceneSynchronizerDebugger::singleton()->debug_error(&scene_synchronizer->get_network_interface(), "The function `process_received_deferred_sync_data` found a null NodeData into the `deferred_sync_array`; this is not supposed to happen.");
+		if (stream.alpha > MAX(1.2, 1.0 + nd->deferred_max_extrapolation)) {
+			// The stream is not yet started.
+			// OR
+			// The stream for this node is stopped as the data received is old.
 			continue;
 		}
 
 #ifdef DEBUG_ENABLED
 		if (nd->apply_epoch_func.is_null()) {
-			SceneSynchronizerDebugger::singleton()->debug_error(&scene_synchronizer->get_network_interface(), "The function `process_received_deferred_sync_data` skip the node `" + String(nd->object_name.c_str()) + "` has an invalid apply epoch function named `" + nd->apply_epoch_func.get_method() + "`. Remotely you used the function `setup_deferred_sync` properly, while locally you didn't. Fix it.");
+			NS_DEBUG_ERROR(&scene_synchronizer->get_network_interface(), "The function `process_received_deferred_sync_data` skip the node `" + String(nd->object_name.c_str()) + "` has an invalid apply epoch function named `" + nd->apply_epoch_func.get_method() + "`. Remotely you used the function `setup_deferred_sync` properly, while locally you didn't. Fix it.", false);
 			continue;
 		}
 #endif
@@ -3058,7 +4232,7 @@ void ClientSynchronizer::process_received_deferred_sync_data(real_t p_delta) {
 		nd->apply_epoch_func.callp(array_vars_ptr, 4, r, e);
 
 		if (e.error != Callable::CallError::CALL_OK) {
-			SceneSynchronizerDebugger::singleton()->debug_error(&scene_synchronizer->get_network_interface(), "The `process_received_deferred_sync_data` failed executing the function`" + nd->collect_epoch_func.get_method() + "` for the node `" + nd->object_name.c_str() + "`.");
+			NS_DEBUG_ERROR(&scene_synchronizer->get_network_interface(), "The `process_received_deferred_sync_data` failed executing the function`" + nd->collect_epoch_func.get_method() + "` for the node `" + nd->object_name.c_str() + "`.", false);
 			continue;
 		}
 	}
@@ -3077,7 +4251,7 @@ void ClientSynchronizer::remove_node_from_deferred_sync(NS::ObjectData *p_object
 bool ClientSynchronizer::parse_snapshot(DataBuffer &p_snapshot) {
 	if (want_to_enable) {
 		if (enabled) {
-			SceneSynchronizerDebugger::singleton()->debug_error(&scene_synchronizer->get_network_interface(), "At this point the client is supposed to be disabled. This is a bug that must be solved.");
+			NS_DEBUG_ERROR(&scene_synchronizer->get_network_interface(), "At this point the client is supposed to be disabled. This is a bug that must be solved.", false);
 		}
 		// The netwroking is disabled and we can re-enable it.
 		enabled = true;
@@ -3152,8 +4326,17 @@ bool ClientSynchronizer::parse_snapshot(DataBuffer &p_snapshot) {
 					pd->snapshot.object_vars[p_object_data->get_net_id().id].resize(p_object_data->vars.size());
 				}
 
-				pd->snapshot.object_vars[p_object_data->get_net_id().id][p_var_id.id].name = p_object_data->vars[p_var_id.id].var.name;
+				pd->snapshot.object_vars[p_object_data->get_net_id().id][p_var_id.id].name = p_object_data->get_variable_name(p_var_id);
 				pd->snapshot.object_vars[p_object_data->get_net_id().id][p_var_id.id].value = p_value.duplicate(true);
+
+				if (unlikely(p_object_data->sleeping) && !pd->scene_synchronizer->get_network_interface().compare(p_object_data->vars[p_var_id.id].value, p_value)) {
+					// The server changed this object: its values didn't change
+					// while sleeping, so they are put into the client snapshots
+					// that skipped it. The compare of this same snapshot
+					// detects the difference and rewinds.
+					pd->client_synchronizer->capture_sleeping_object(*p_object_data);
+					pd->scene_synchronizer->wake_object(*p_object_data);
+				}
 			},
 
 			// Parse node activation:
@@ -3173,14 +4356,14 @@ bool ClientSynchronizer::parse_snapshot(DataBuffer &p_snapshot) {
 			});
 
 	if (success == false) {
-		SceneSynchronizerDebugger::singleton()->debug_error(&scene_synchronizer->get_network_interface(), "Snapshot parsing failed.");
+		NS_DEBUG_ERROR(&scene_synchronizer->get_network_interface(), "Snapshot parsing failed.", false);
 		return false;
 	}
 
 	if (unlikely(received_snapshot.input_id == UINT32_MAX && player_controller_node_data != nullptr)) {
 		// We espect that the player_controller is updated by this new snapshot,
 		// so make sure it's done so.
-		SceneSynchronizerDebugger::singleton()->debug_print(&scene_synchronizer->get_network_interface(), "[INFO] the player controller (" + String(player_controller_node_data->object_name.c_str()) + ") was not part of the received snapshot, this happens when the server destroys the peer controller.");
+		NS_DEBUG_PRINT(&scene_synchronizer->get_network_interface(), "[INFO] the player controller (" + String(player_controller_node_data->object_name.c_str()) + ") was not part of the received snapshot, this happens when the server destroys the peer controller.", false);
 	}
 
 	last_received_snapshot = std::move(received_snapshot);
@@ -3201,6 +4384,44 @@ void ClientSynchronizer::notify_server_full_snapshot_is_needed() {
 			scene_synchronizer->network_interface->get_server_peer());
 }
 
+void ClientSynchronizer::request_object_resync(ObjectNetId p_net_id, const LocalVector<VarId> &p_vars) {
+	NS::ObjectResync resync;
+	resync.net_id = p_net_id;
+	resync.vars = p_vars;
+	NS::merge_object_resync(pending_resync, resync);
+}
+
+void ClientSynchronizer::notify_server_resync_is_needed() {
+	if (pending_resync.is_empty()) {
+		return;
+	}
+
+	if (need_full_snapshot_notified || pending_resync.size() > MAX_RESYNC_OBJECTS) {
+		// The full snapshot is cheaper, or is already coming.
+		pending_resync.clear();
+		notify_server_full_snapshot_is_needed();
+		return;
+	}
+
+	// The objects stay unknown until the response arrives: don't ask them
+	// again with each snapshot.
+	requested_resync.filter(pending_resync, resync_clock, RESYNC_REQUEST_TIMEOUT);
+	if (pending_resync.is_empty()) {
+		return;
+	}
+
+	DataBuffer request;
+	request.begin_write(0);
+	NS::write_object_resync(pending_resync, request);
+	request.dry();
+	pending_resync.clear();
+
+	scene_synchronizer->rpc_handler_notify_need_resync.rpc(
+			scene_synchronizer->get_network_interface(),
+			scene_synchronizer->network_interface->get_server_peer(),
+			request);
+}
+
 void ClientSynchronizer::update_client_snapshot(NS::Snapshot &p_snapshot) {
 	scene_synchronizer->synchronizer_manager->snapshot_get_custom_data(nullptr, p_snapshot.custom_data);
 
@@ -3214,23 +4435,42 @@ void ClientSynchronizer::update_client_snapshot(NS::Snapshot &p_snapshot) {
 			continue;
 		}
 
+		if (nd->sleeping) {
+			// The sleeping objects are not captured, so the compare skips them.
+			// The server changes are detected by `parse_snapshot`, that wakes them
+			// and fills these snapshots.
+			p_snapshot.object_vars[net_node_id.id].clear();
+			continue;
+		}
+
 		// Make sure this ID is valid.
 		ERR_FAIL_COND_MSG(nd->get_net_id() == ObjectNetId::NONE, "[BUG] It's not expected that the client has an uninitialized NetNodeId into the `organized_node_data` ");
 
-#ifdef DEBUG_ENABLED
-		CRASH_COND_MSG(nd->get_net_id().id >= uint32_t(p_snapshot.object_vars.size()), "This array was resized above, this can't be triggered.");
-#endif
+		update_client_snapshot_object(p_snapshot, *nd);
+	}
+}
+
+void ClientSynchronizer::capture_sleeping_object(const NS::ObjectData &p_object_data) {
+	for (NS::Snapshot &snapshot : client_snapshots) {
+		if (p_object_data.get_net_id().id < uint32_t(snapshot.object_vars.size()) && snapshot.object_vars[p_object_data.get_net_id().id].empty()) {
+			update_client_snapshot_object(snapshot, p_object_data);
+		}
+	}
+}
 
-		std::vector<NS::NameAndVar> *snap_node_vars = p_snapshot.object_vars.data() + nd->get_net_id().id;
-		snap_node_vars->resize(nd->vars.size());
+void ClientSynchronizer::update_client_snapshot_object(NS::Snapshot &p_snapshot, const NS::ObjectData &p_object_data) {
+	ERR_FAIL_COND(p_object_data.get_net_id().id >= uint32_t(p_snapshot.object_vars.size()));
 
-		NS::NameAndVar *snap_node_vars_ptr = snap_node_vars->data();
-		for (uint32_t v = 0; v < nd->vars.size(); v += 1) {
-			if (nd->vars[v].enabled) {
-				snap_node_vars_ptr[v] = nd->vars[v].var;
-			} else {
-				snap_node_vars_ptr[v].name = std::string();
-			}
+	std::vector<NS::NameAndVar> *snap_node_vars = p_snapshot.object_vars.data() + p_object_data.get_net_id().id;
+	snap_node_vars->resize(p_object_data.vars.size());
+
+	NS::NameAndVar *snap_node_vars_ptr = snap_node_vars->data();
+	for (uint32_t v = 0; v < p_object_data.vars.size(); v += 1) {
+		if (p_object_data.vars[v].enabled) {
+			snap_node_vars_ptr[v].name = p_object_data.get_var_layout().names[v];
+			snap_node_vars_ptr[v].value = p_object_data.vars[v].value;
+		} else {
+			snap_node_vars_ptr[v].name = std::string();
 		}
 	}
 }
@@ -3259,45 +4499,199 @@ void ClientSynchronizer::apply_snapshot(
 			continue;
 		}
 
-		const std::vector<NS::NameAndVar> &vars = objects_vars[net_node_id.id];
-		const NS::NameAndVar *vars_ptr = vars.data();
+		apply_object_vars(*nd, objects_vars[net_node_id.id], r_applied_data_info);
+	}
+
+	if (p_snapshot.has_custom_data && !p_skip_custom_data) {
+		scene_synchronizer->synchronizer_manager->snapshot_set_custom_data(p_snapshot.custom_data);
+	}
+
+	scene_synchronizer->change_events_flush();
+}
+
+void ClientSynchronizer::apply_object_vars(
+		NS::ObjectData &p_object_data,
+		const std::vector<NS::NameAndVar> &p_vars,
+		LocalVector<String> *r_applied_data_info) {
+	const NS::NameAndVar *vars_ptr = p_vars.data();
 
-		if (r_applied_data_info) {
-			r_applied_data_info->push_back("Applied snapshot data on the node: " + String(nd->object_name.c_str()));
+	if (r_applied_data_info) {
+		r_applied_data_info->push_back("Applied snapshot data on the node: " + String(p_object_data.object_name.c_str()));
+	}
+
+	// NOTE: The vars may not contain ALL the variables: it depends on how
+	//       the snapshot was captured.
+	for (VarId v = { 0 }; v < VarId{ uint32_t(p_vars.size()) }; v += 1) {
+		if (vars_ptr[v.id].name.empty()) {
+			// This variable was not set, skip it.
+			continue;
 		}
 
-		// NOTE: The vars may not contain ALL the variables: it depends on how
-		//       the snapshot was captured.
-		for (VarId v = { 0 }; v < VarId{ uint32_t(vars.size()) }; v += 1) {
-			if (vars_ptr[v.id].name.empty()) {
-				// This variable was not set, skip it.
-				continue;
+		const Variant current_val = p_object_data.vars[v.id].value;
+		p_object_data.vars[v.id].value = vars_ptr[v.id].value.duplicate(true);
+
+		if (!scene_synchronizer->network_interface->compare(current_val, vars_ptr[v.id].value)) {
+			scene_synchronizer->variables_write(p_object_data, v, vars_ptr[v.id].value);
+			scene_synchronizer->change_event_add(
+					&p_object_data,
+					v,
+					current_val);
+
+			if (r_applied_data_info) {
+				r_applied_data_info->push_back(String() + " |- Variable: " + vars_ptr[v.id].name.c_str() + " New value: " + NS::stringify_fast(vars_ptr[v.id].value));
 			}
+		}
+	}
+
+	scene_synchronizer->variables_write_flush();
+}
 
-			const Variant current_val = nd->vars[v.id].var.value;
-			nd->vars[v.id].var.value = vars_ptr[v.id].value.duplicate(true);
+SpectatorSynchronizer::SpectatorSynchronizer(SceneSynchronizerBase *p_node) :
+		ClientSynchronizer(p_node) {
+}
+
+void SpectatorSynchronizer::clear() {
+	ClientSynchronizer::clear();
+	interpolation_buffer.clear();
+	time = 0.0;
+	past_applied = false;
+	settled = false;
+}
 
-			if (!scene_synchronizer->network_interface->compare(current_val, vars_ptr[v.id].value)) {
-				scene_synchronizer->synchronizer_manager->set_variable(
-						nd->app_object_handle,
-						vars_ptr[v.id].name.c_str(),
-						vars_ptr[v.id].value);
-				scene_synchronizer->change_event_add(
-						nd,
-						v,
-						current_val);
+void SpectatorSynchronizer::process() {
+	NS_DEBUG_PRINT(&scene_synchronizer->get_network_interface(), "SpectatorSynchronizer::process", true);
 
-				if (r_applied_data_info) {
-					r_applied_data_info->push_back(String() + " |- Variable: " + vars_ptr[v.id].name.c_str() + " New value: " + NS::stringify_fast(vars_ptr[v.id].value));
-				}
+	const double delta = 1.0 / Engine::get_singleton()->get_physics_ticks_per_second();
+	time += delta;
+	resync_clock += delta;
+
+	const double playback_time = time - scene_synchronizer->get_spectator_interpolation_delay();
+
+	// Drop the snapshots already played.
+	while (interpolation_buffer.size() >= 2 && interpolation_buffer[1].time <= playback_time) {
+		interpolation_buffer.pop_front();
+		past_applied = false;
+	}
+
+	if (!interpolation_buffer.empty() && !settled) {
+		const BufferedSnapshot &past = interpolation_buffer[0];
+
+		if (!past_applied) {
+			past_applied = true;
+			if (past.snapshot.has_custom_data) {
+				scene_synchronizer->synchronizer_manager->snapshot_set_custom_data(past.snapshot.custom_data);
 			}
 		}
+
+		if (interpolation_buffer.size() == 1) {
+			// Nothing to interpolate to: hold the last received state.
+			apply_interpolated(past.snapshot, past.snapshot, 1.0);
+			settled = true;
+		} else {
+			const BufferedSnapshot &future = interpolation_buffer[1];
+			const double interval = future.time - past.time;
+			const real_t alpha = interval > 0.0 ? CLAMP((playback_time - past.time) / interval, 0.0, 1.0) : 1.0;
+			apply_interpolated(past.snapshot, future.snapshot, alpha);
+		}
 	}
 
-	if (p_snapshot.has_custom_data && !p_skip_custom_data) {
-		scene_synchronizer->synchronizer_manager->snapshot_set_custom_data(p_snapshot.custom_data);
+	process_received_deferred_sync_data(delta);
+}
+
+void SpectatorSynchronizer::on_object_data_removed(NS::ObjectData &p_object_data) {
+	ClientSynchronizer::on_object_data_removed(p_object_data);
+
+	for (BufferedSnapshot &buffered : interpolation_buffer) {
+		if (p_object_data.get_net_id().id < uint32_t(buffered.snapshot.object_vars.size())) {
+			buffered.snapshot.object_vars[p_object_data.get_net_id().id].clear();
+		}
+	}
+}
+
+void SpectatorSynchronizer::receive_snapshot(DataBuffer &p_snapshot) {
+	NS_DEBUG_PRINT(&scene_synchronizer->get_network_interface(), "The Spectator received the server snapshot.", true);
+
+	if (!parse_snapshot(p_snapshot)) {
+		return;
+	}
+
+	const double playback_time = time - scene_synchronizer->get_spectator_interpolation_delay();
+	if (interpolation_buffer.size() == 1 && interpolation_buffer[0].time < playback_time) {
+		// The buffer ran dry: interpolate from the current state, rather
+		// than jumping ahead.
+		interpolation_buffer[0].time = playback_time;
+	}
+
+	BufferedSnapshot buffered;
+	buffered.snapshot = NS::Snapshot::make_copy(last_received_snapshot);
+	buffered.time = time;
+	interpolation_buffer.push_back(std::move(buffered));
+	settled = false;
+
+	while (interpolation_buffer.size() > MAX_BUFFERED_SNAPSHOTS) {
+		interpolation_buffer.pop_front();
+		past_applied = false;
+	}
+}
+
+static bool is_variant_interpolable(Variant::Type p_type) {
+	switch (p_type) {
+		case Variant::FLOAT:
+		case Variant::VECTOR2:
+		case Variant::VECTOR3:
+		case Variant::VECTOR4:
+		case Variant::QUATERNION:
+		case Variant::BASIS:
+		case Variant::TRANSFORM2D:
+		case Variant::TRANSFORM3D:
+		case Variant::COLOR:
+			return true;
+		default:
+			return false;
+	}
+}
+
+void SpectatorSynchronizer::apply_interpolated(const NS::Snapshot &p_past, const NS::Snapshot &p_future, real_t p_alpha) {
+	scene_synchronizer->change_events_begin(NetEventFlag::CHANGE);
+
+	Variant value;
+	for (ObjectNetId net_id = { 0 }; net_id < ObjectNetId{ uint32_t(p_future.object_vars.size()) }; net_id += 1) {
+		NS::ObjectData *od = scene_synchronizer->get_object_data(net_id, false);
+		if (od == nullptr || od->realtime_sync_enabled_on_client == false) {
+			continue;
+		}
+
+		const std::vector<NS::NameAndVar> &future_vars = p_future.object_vars[net_id.id];
+		const std::vector<NS::NameAndVar> *past_vars = net_id.id < p_past.object_vars.size() ? &p_past.object_vars[net_id.id] : nullptr;
+
+		for (VarId v = { 0 }; v < VarId{ uint32_t(MIN(future_vars.size(), od->vars.size())) }; v += 1) {
+			if (future_vars[v.id].name.empty()) {
+				// This variable was not set, skip it.
+				continue;
+			}
+
+			if (p_alpha < 1.0 && past_vars && v.id < past_vars->size() && !(*past_vars)[v.id].name.empty()) {
+				const Variant &past_value = (*past_vars)[v.id].value;
+				if (past_value.get_type() == future_vars[v.id].value.get_type() && is_variant_interpolable(past_value.get_type())) {
+					Variant::interpolate(past_value, future_vars[v.id].value, p_alpha, value);
+				} else {
+					// Not interpolable: switch once the future snapshot is reached.
+					value = past_value;
+				}
+			} else {
+				value = future_vars[v.id].value;
+			}
+
+			if (!scene_synchronizer->network_interface->compare(od->vars[v.id].value, value)) {
+				const Variant old_value = od->vars[v.id].value;
+				od->vars[v.id].value = value.duplicate(true);
+				scene_synchronizer->variables_write(*od, v, value);
+				scene_synchronizer->change_event_add(od, v, old_value);
+			}
+		}
 	}
 
+	scene_synchronizer->variables_write_flush();
 	scene_synchronizer->change_events_flush();
 }
 
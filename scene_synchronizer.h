@@ -12,6 +12,7 @@
 #include "modules/network_synchronizer/core/processor.h"
 #include "modules/network_synchronizer/core/var_data.h"
 #include "net_utilities.h"
+#include "rewind_profiler.h"
 #include "snapshot.h"
 #include <cstdint>
 #include <deque>
@@ -59,6 +60,15 @@ public:
 	virtual void set_variable(ObjectHandle p_app_object_handle, const char *p_var_name, const Variant &p_val) = 0;
 	virtual bool get_variable(ObjectHandle p_app_object_handle, const char *p_var_name, Variant &p_val) const = 0;
 
+	/// Optional: reads all the `p_layout` variables of the object with a
+	/// single call, into `r_values` indexed by `VarId`.
+	/// Returns false when not implemented: `get_variable` is used instead.
+	virtual bool get_variables(ObjectHandle p_app_object_handle, const VarLayout &p_layout, std::vector<Variant> &r_values) const { return false; }
+	/// Optional: writes, with a single call, the `p_layout` variables that are
+	/// set in `p_var_mask`. Both vectors are indexed by `VarId`.
+	/// Returns false when not implemented: `set_variable` is used instead.
+	virtual bool set_variables(ObjectHandle p_app_object_handle, const VarLayout &p_layout, const std::vector<bool> &p_var_mask, const std::vector<Variant> &p_values) { return false; }
+
 	virtual NetworkedControllerBase *extract_network_controller(ObjectHandle p_app_object_handle) = 0;
 	virtual const NetworkedControllerBase *extract_network_controller(ObjectHandle p_app_object_handle) const = 0;
 };
@@ -133,6 +143,7 @@ class SceneSynchronizerBase {
 	friend class ServerSynchronizer;
 	friend class ClientSynchronizer;
 	friend class NoNetSynchronizer;
+	friend class SpectatorSynchronizer;
 	friend SceneDiff;
 
 public:
@@ -140,24 +151,48 @@ public:
 		SYNCHRONIZER_TYPE_NULL,
 		SYNCHRONIZER_TYPE_NONETWORK,
 		SYNCHRONIZER_TYPE_CLIENT,
-		SYNCHRONIZER_TYPE_SERVER
+		SYNCHRONIZER_TYPE_SERVER,
+		/// A client that only receives and interpolates the server state.
+		SYNCHRONIZER_TYPE_SPECTATOR
 	};
 
 	/// This SyncGroup contains ALL the registered NodeData.
 	static const SyncGroupId GLOBAL_SYNC_GROUP_ID;
 
+	/// A variable to register with `register_variables`.
+	struct VarSpec {
+		StringName name;
+		bool skip_rewinding = false;
+	};
+
 private:
 	class NetworkInterface *network_interface = nullptr;
 	SynchronizerManager *synchronizer_manager = nullptr;
 
 	RpcHandle<DataBuffer &> rpc_handler_state;
 	RpcHandle<> rpc_handler_notify_need_full_snapshot;
+	RpcHandle<DataBuffer &> rpc_handler_notify_need_resync;
 	RpcHandle<bool> rpc_handler_set_network_enabled;
 	RpcHandle<bool> rpc_handler_notify_peer_status;
+	RpcHandle<bool> rpc_handler_notify_spectator_mode;
 	RpcHandle<const Vector<uint8_t> &> rpc_handler_deferred_sync_data;
+	RpcHandle<const Vector<uint8_t> &> rpc_handler_doll_inputs;
 
 	int max_deferred_nodes_per_update = 30;
+	/// When true, the deferred sync epochs are XOR encoded against the
+	/// previous one, when that's smaller.
+	bool deferred_sync_delta_enabled = false;
+	/// A node sends a full epoch at least once every this amount of epochs,
+	/// even if its state didn't change: so the lost packets are recovered.
+	int deferred_sync_keyframe_interval = 10;
 	real_t server_notify_state_interval = 1.0;
+	/// The objects sent per snapshot to a joining peer, by priority, until
+	/// it has the whole world. 0 sends the world in a single full snapshot.
+	int join_stream_budget = 0;
+	/// When true, the client is initialized as spectator.
+	bool spectator_mode = false;
+	/// How late, in seconds, the spectator applies the received snapshots.
+	real_t spectator_interpolation_delay = 0.1;
 	/// Can be 0.0 to update the relevancy each frame.
 	real_t nodes_relevancy_update_time = 0.5;
 
@@ -169,21 +204,47 @@ private:
 	bool end_sync = false;
 
 	bool peer_dirty = false;
-	std::map<int, NS::PeerData> peer_data;
+	NS::PeerTable peer_data;
 
 	bool generate_id = false;
 
 	ObjectDataStorage objects_data_storage;
 
+	/// The buffers used to read and write all the variables of an object at
+	/// once, through the `SynchronizerManager`.
+	std::vector<Variant> variables_read_buffer;
+	NS::ObjectData *variables_write_object = nullptr;
+	std::vector<bool> variables_write_mask;
+	std::vector<Variant> variables_write_values;
+
+	/// True while `register_app_objects` runs: the synchronizer is notified
+	/// about the registered objects once, when all of them are registered.
+	bool bulk_registration_in_progress = false;
+	LocalVector<ObjectData *> bulk_registered_objects;
+
 	int event_flag = 0;
 	std::vector<ChangesListener *> changes_listeners;
 
+	/// The `SceneDiff`s that are tracking the scene changes.
+	mutable LocalVector<SceneDiff *> tracking_scene_diffs;
+
 	bool cached_process_functions_valid = false;
-	Processor<float> cached_process_functions[PROCESSPHASE_COUNT];
+	struct CachedProcessStep {
+		/// The object processed at a reduced rate. When `nullptr`, this step
+		/// broadcasts the `functions` of consecutive full rate objects at once.
+		ObjectData *divided_od = nullptr;
+		Processor<float> functions[PROCESSPHASE_COUNT];
+	};
+	/// Sorted as the `NetId`, so the execution order is kept.
+	std::vector<CachedProcessStep> cached_process_steps;
+	/// Counts the `process_functions__execute` on the server and no network.
+	uint64_t process_tick = 0;
 
 	// Set at runtime by the constructor by reading the project settings.
 	bool debug_rewindings_enabled = false;
 
+	RewindProfiler rewind_profiler;
+
 public: // -------------------------------------------------------------- Events
 	Processor<> event_sync_started;
 	Processor<> event_sync_paused;
@@ -232,26 +293,71 @@ public:
 	void set_max_deferred_nodes_per_update(int p_rate);
 	int get_max_deferred_nodes_per_update() const;
 
+	void set_deferred_sync_delta_enabled(bool p_enabled);
+	bool is_deferred_sync_delta_enabled() const;
+
+	void set_deferred_sync_keyframe_interval(int p_interval);
+	int get_deferred_sync_keyframe_interval() const;
+
 	void set_server_notify_state_interval(real_t p_interval);
 	real_t get_server_notify_state_interval() const;
 
+	void set_join_stream_budget(int p_objects);
+	int get_join_stream_budget() const;
+
+	/// The spectator receives and interpolates the server state, without
+	/// predicting it: use it for the peers that have no player controller
+	/// (observers, replay viewers). It resets the client synchronizer.
+	void set_spectator_mode(bool p_enabled);
+	bool is_spectator_mode() const;
+
+	/// Should be bigger than the server notify state interval, so there is
+	/// always a snapshot to interpolate to.
+	void set_spectator_interpolation_delay(real_t p_delay);
+	real_t get_spectator_interpolation_delay() const;
+
+	/// Returns true, on client, while the server is still streaming the world
+	/// to this peer: the objects not yet received are inactive.
+	bool is_join_streaming() const;
+
 	void set_nodes_relevancy_update_time(real_t p_time);
 	real_t get_nodes_relevancy_update_time() const;
 
 	bool is_variable_registered(ObjectLocalId p_id, const StringName &p_variable) const;
 
+	/// Collects the rewinds statistics, used to find out which variables
+	/// trigger the most expensive rewinds. Works only on client.
+	void set_rewind_profiler_enabled(bool p_enabled);
+	bool is_rewind_profiler_enabled() const;
+	RewindProfiler &get_rewind_profiler() { return rewind_profiler; }
+	const RewindProfiler &get_rewind_profiler() const { return rewind_profiler; }
+
+	/// Returns true when the rewind reasons are collected, read from the
+	/// `NetworkSynchronizer/log_debug_rewindings` setting.
+	bool is_debug_rewindings_enabled() const { return debug_rewindings_enabled; }
+
 public: // ---------------------------------------------------------------- RPCs
 	void rpc_receive_state(DataBuffer &p_snapshot);
 	void rpc__notify_need_full_snapshot();
+	void rpc__notify_need_resync(DataBuffer &p_request);
 	void rpc_set_network_enabled(bool p_enabled);
 	void rpc_notify_peer_status(bool p_enabled);
+	void rpc_notify_spectator_mode(bool p_enabled);
 	void rpc_deferred_sync_data(const Vector<uint8_t> &p_data);
+	void rpc_doll_inputs(const Vector<uint8_t> &p_data);
 
 public: // ---------------------------------------------------------------- APIs
 	/// Register a new node and returns its `NodeData`.
 	void register_app_object(ObjectHandle p_app_object_handle, ObjectLocalId *out_id = nullptr);
+	/// Registers all the objects at once: the storage is sized once, and the
+	/// process cache, the peers and the sync groups are updated once at the
+	/// end. Use this to load big levels.
+	/// `r_ids`, when set, receives the ids in the same order of the handles.
+	void register_app_objects(const std::vector<ObjectHandle> &p_app_object_handles, std::vector<ObjectLocalId> *r_ids = nullptr);
 	void unregister_app_object(ObjectLocalId p_id);
 	void register_variable(ObjectLocalId p_id, const StringName &p_variable);
+	/// Registers all the variables at once, and sets their `skip_rewinding`.
+	void register_variables(ObjectLocalId p_id, const std::vector<VarSpec> &p_variables);
 	void unregister_variable(ObjectLocalId p_id, const StringName &p_variable);
 
 	ObjectNetId get_app_object_net_id(ObjectHandle p_app_object_handle) const;
@@ -282,6 +388,14 @@ public: // ---------------------------------------------------------------- APIs
 			std::function<void(const std::vector<Variant> &p_old_values)> p_listener_func,
 			NetEventFlag p_flags = NetEventFlag::DEFAULT);
 
+	/// Like `track_variables_changes`, but the listener is called once per
+	/// flush with the changed variables only: their old and new values.
+	ListenerHandle track_variables_changes_batched(
+			const std::vector<ObjectLocalId> &p_object_ids,
+			const std::vector<StringName> &p_variables,
+			std::function<void(const std::vector<VarChange> &p_changes)> p_listener_func,
+			NetEventFlag p_flags = NetEventFlag::DEFAULT);
+
 	void untrack_variable_changes(ListenerHandle p_handle);
 
 	/// You can use the macro `callable_mp()` to register custom C++ function.
@@ -293,6 +407,43 @@ public: // ---------------------------------------------------------------- APIs
 	/// is streamed and not simulated.
 	void setup_deferred_sync(ObjectLocalId p_id, const Callable &p_collect_epoch_func, const Callable &p_apply_epoch_func);
 
+	/// By default the client stops applying the deferred sync data shortly
+	/// after the last received epoch, so the object stalls till the next one
+	/// arrives. With this set, the apply epoch function keeps receiving an
+	/// alpha greater than 1 for up to `p_max_intervals` intervals between two
+	/// epochs, so it can extrapolate: `DeferredKinematics` implements that for
+	/// the position, blending the error away when the next epoch arrives.
+	/// This is a client side setting.
+	void set_deferred_max_extrapolation(ObjectLocalId p_id, real_t p_max_intervals);
+	real_t get_deferred_max_extrapolation(ObjectLocalId p_id) const;
+
+	/// The object falls asleep after `p_idle_ticks` ticks without changes: a
+	/// sleeping object is skipped by the change detection, the process
+	/// functions and the client snapshots, till it's woken up.
+	/// Set 0 (the default) to never sleep. The controllers never sleep.
+	/// NOTE: The changes done from outside the synchronizer, while the object
+	///       sleeps, are not detected: call `wake_up` before changing it.
+	void set_sleep_idle_ticks(ObjectLocalId p_id, uint32_t p_idle_ticks);
+	uint32_t get_sleep_idle_ticks(ObjectLocalId p_id) const;
+	bool is_sleeping(ObjectLocalId p_id) const;
+	void wake_up(ObjectLocalId p_id);
+
+	/// The process functions of this object are executed once every
+	/// `p_divisor` ticks, receiving the delta accumulated since the last
+	/// execution. The objects are spread across the ticks, so the cost is
+	/// evenly distributed. Set 1 (the default) to process at full rate.
+	/// This is meant for the objects that don't need an accurate simulation
+	/// (e.g. far away or ambient AI): the clients don't predict them and their
+	/// differences never trigger a rewind, they are just applied.
+	/// Set it on the server: the clients receive it with the snapshots, and
+	/// the value set on a client is overwritten.
+	void set_process_rate_divisor(ObjectLocalId p_id, uint32_t p_divisor);
+	uint32_t get_process_rate_divisor(ObjectLocalId p_id) const;
+
+	/// Wakes up the object `p_id` each time a variable of `p_trigger_id` changes.
+	void add_wake_trigger(ObjectLocalId p_id, ObjectLocalId p_trigger_id);
+	void remove_wake_trigger(ObjectLocalId p_id, ObjectLocalId p_trigger_id);
+
 	/// Creates a realtime sync group containing a list of nodes.
 	/// The Peers listening to this group will receive the updates only
 	/// from the nodes within this group.
@@ -306,6 +457,11 @@ public: // ---------------------------------------------------------------- APIs
 
 	/// Use `std::move()` to transfer `p_new_realtime_nodes` and `p_new_deferred_nodes`.
 	void sync_group_replace_nodes(SyncGroupId p_group_id, LocalVector<NS::SyncGroup::RealtimeNodeInfo> &&p_new_realtime_nodes, LocalVector<NS::SyncGroup::DeferredNodeInfo> &&p_new_deferred_nodes);
+	/// Sets the nodes of the group by their net IDs, with a single pass.
+	/// `p_deferred_update_rates` is empty, to use the default update rate, or
+	/// has the update rate of each deferred node.
+	void sync_group_replace_nodes_by_id(SyncGroupId p_group_id, const LocalVector<ObjectNetId> &p_realtime_node_ids, const LocalVector<ObjectNetId> &p_deferred_node_ids, const LocalVector<real_t> &p_deferred_update_rates);
+	void sync_group_remove_nodes_by_id(SyncGroupId p_group_id, const LocalVector<ObjectNetId> &p_node_ids);
 
 	void sync_group_remove_all_nodes(SyncGroupId p_group_id);
 	void sync_group_move_peer_to(int p_peer_id, SyncGroupId p_group_id);
@@ -317,12 +473,33 @@ public: // ---------------------------------------------------------------- APIs
 	real_t sync_group_get_deferred_update_rate(ObjectLocalId p_node_id, SyncGroupId p_group_id) const;
 	real_t sync_group_get_deferred_update_rate(ObjectNetId p_node_id, SyncGroupId p_group_id) const;
 
+	/// The LOD policy assigns each node, which has a LOD metric set, to the
+	/// realtime, deferred high, deferred low or culled tier. The tiers are
+	/// updated together with the nodes relevancy, so set the metrics from
+	/// `update_nodes_relevancy`.
+	void sync_group_set_lod_policy(SyncGroupId p_group_id, const NS::LodPolicy &p_policy);
+	NS::LodPolicy sync_group_get_lod_policy(SyncGroupId p_group_id) const;
+	/// From now on, the tier of this node is managed by the LOD policy: don't
+	/// add it to the group manually. Use `sync_group_remove_node` to drop it.
+	void sync_group_set_lod_metric(ObjectLocalId p_node_id, SyncGroupId p_group_id, real_t p_metric);
+	void sync_group_set_lod_metric(ObjectNetId p_node_id, SyncGroupId p_group_id, real_t p_metric);
+	/// Returns `LOD_TIER_COUNT` when the node is not managed by the LOD policy.
+	NS::LodTier sync_group_get_lod_tier(ObjectLocalId p_node_id, SyncGroupId p_group_id) const;
+	NS::LodTier sync_group_get_lod_tier(ObjectNetId p_node_id, SyncGroupId p_group_id) const;
+	/// Updates the tiers right away, rather than waiting the relevancy update.
+	void sync_group_update_lod(SyncGroupId p_group_id);
+
 	void sync_group_set_user_data(SyncGroupId p_group_id, uint64_t p_user_ptr);
 	uint64_t sync_group_get_user_data(SyncGroupId p_group_id) const;
 
+	/// The `SceneDiff` records the variables changes detected by this
+	/// synchronizer till the tracking is stopped.
 	void start_tracking_scene_changes(Object *p_diff_handle) const;
 	void stop_tracking_scene_changes(Object *p_diff_handle) const;
-	Variant pop_scene_changes(Object *p_diff_handle) const;
+	/// Writes the changes recorded by the `SceneDiff` into `r_sync_data`, which
+	/// can be applied on the client using `apply_scene_changes`.
+	/// Returns false when there are no changes.
+	bool pop_scene_changes(Object *p_diff_handle, DataBuffer &r_sync_data) const;
 	void apply_scene_changes(DataBuffer &p_sync_data);
 
 	bool is_recovered() const;
@@ -341,6 +518,8 @@ public: // ---------------------------------------------------------------- APIs
 
 	void set_peer_networking_enable(int p_peer, bool p_enable);
 	bool is_peer_networking_enable(int p_peer) const;
+	/// Returns true when the peer told the server it's a spectator.
+	bool is_peer_spectator(int p_peer) const;
 
 	void on_peer_connected(int p_peer);
 	void on_peer_disconnected(int p_peer);
@@ -364,9 +543,25 @@ public: // ---------------------------------------------------------------- APIs
 public: // ------------------------------------------------------------ INTERNAL
 	void update_nodes_relevancy();
 
+	void scene_diff_tracking_dropped(SceneDiff *p_diff) const;
+
 	void process_functions__clear();
 	void process_functions__execute(const double p_delta);
 
+private:
+	/// Queues the value to set on the application object: the values queued
+	/// for the same object are set together by `variables_write_flush`.
+	void variables_write(NS::ObjectData &p_object_data, VarId p_var_id, const Variant &p_value);
+	void variables_write_flush();
+
+	/// Connects the listener to the variables, or deletes it if any is invalid.
+	ListenerHandle track_changes(ChangesListener *p_listener, const std::vector<ObjectLocalId> &p_object_ids, const std::vector<StringName> &p_variables);
+
+	/// Adds the variable to the object, if not yet there, and enables it.
+	VarId register_variable_data(NS::ObjectData &p_object_data, const StringName &p_variable, const std::string &p_variable_name);
+
+public:
+
 	ObjectLocalId find_object_local_id(ObjectHandle p_app_object) const;
 	ObjectLocalId find_object_local_id(const NetworkedControllerBase &p_controller) const;
 
@@ -392,7 +587,11 @@ public: // ------------------------------------------------------------ INTERNAL
 
 	/// Read the node variables and store the value if is different from the
 	/// previous one and emits a signal.
-	void pull_node_changes(NS::ObjectData *p_object_data);
+	/// Returns true if at least one variable changed.
+	bool pull_node_changes(NS::ObjectData *p_object_data);
+
+	void sleep_object(NS::ObjectData &p_object_data);
+	void wake_object(NS::ObjectData &p_object_data);
 
 	void drop_object_data(NS::ObjectData &p_object_data);
 
@@ -403,8 +602,10 @@ public: // ------------------------------------------------------------ INTERNAL
 public:
 	/// Returns true if this peer is server.
 	bool is_server() const;
-	/// Returns true if this peer is client.
+	/// Returns true if this peer is client, also when spectator.
 	bool is_client() const;
+	/// Returns true if this peer is a spectator client.
+	bool is_spectator() const;
 	/// Returns true if there is no network.
 	bool is_no_network() const;
 	/// Returns true if network is enabled.
@@ -425,6 +626,9 @@ public:
 	virtual void on_peer_connected(int p_peer_id) {}
 	virtual void on_peer_disconnected(int p_peer_id) {}
 	virtual void on_object_data_added(NS::ObjectData *p_object_data) {}
+	/// Called once by `register_app_objects`, when the objects and their
+	/// variables are registered.
+	virtual void on_objects_data_added(const LocalVector<NS::ObjectData *> &p_objects_data);
 	virtual void on_object_data_removed(NS::ObjectData &p_object_data) {}
 	virtual void on_variable_added(NS::ObjectData *p_object_data, const StringName &p_var_name) {}
 	virtual void on_variable_changed(NS::ObjectData *p_object_data, VarId p_var_id, const Variant &p_old_value, int p_flag) {}
@@ -464,6 +668,15 @@ class ServerSynchronizer : public Synchronizer {
 		SNAPSHOT_GENERATION_MODE_FORCE_FULL,
 	};
 
+	enum JoinStreamStatus {
+		/// The snapshot is not part of a join.
+		JOIN_STREAM_NONE,
+		/// The snapshot is part of a join, and more objects follow.
+		JOIN_STREAM_PENDING,
+		/// The snapshot carries the last objects of the join.
+		JOIN_STREAM_DONE,
+	};
+
 public:
 	ServerSynchronizer(SceneSynchronizerBase *p_node);
 
@@ -472,14 +685,21 @@ public:
 	virtual void on_peer_connected(int p_peer_id) override;
 	virtual void on_peer_disconnected(int p_peer_id) override;
 	virtual void on_object_data_added(NS::ObjectData *p_object_data) override;
+	virtual void on_objects_data_added(const LocalVector<NS::ObjectData *> &p_objects_data) override;
 	virtual void on_object_data_removed(NS::ObjectData &p_object_data) override;
 	virtual void on_variable_added(NS::ObjectData *p_object_data, const StringName &p_var_name) override;
 	virtual void on_variable_changed(NS::ObjectData *p_object_data, VarId p_var_id, const Variant &p_old_value, int p_flag) override;
 
+	/// The next snapshot, sent on the next tick, sends the object name and
+	/// divisor again.
+	void notify_object_unknown(NS::ObjectData *p_object_data);
+
 	SyncGroupId sync_group_create();
 	const NS::SyncGroup *sync_group_get(SyncGroupId p_group_id) const;
+	void sync_group_force_state_notify(NS::SyncGroup &p_group);
 	void sync_group_add_node(NS::ObjectData *p_object_data, SyncGroupId p_group_id, bool p_realtime);
 	void sync_group_remove_node(NS::ObjectData *p_object_data, SyncGroupId p_group_id);
+	void sync_group_remove_nodes(const LocalVector<NS::ObjectData *> &p_objects_data, SyncGroupId p_group_id);
 	void sync_group_replace_nodes(SyncGroupId p_group_id, LocalVector<NS::SyncGroup::RealtimeNodeInfo> &&p_new_realtime_nodes, LocalVector<NS::SyncGroup::DeferredNodeInfo> &&p_new_deferred_nodes);
 	void sync_group_remove_all_nodes(SyncGroupId p_group_id);
 	void sync_group_move_peer_to(int p_peer_id, SyncGroupId p_group_id);
@@ -488,6 +708,13 @@ public:
 	void sync_group_set_deferred_update_rate(NS::ObjectData *p_object_data, SyncGroupId p_group_id, real_t p_update_rate);
 	real_t sync_group_get_deferred_update_rate(const NS::ObjectData *p_object_data, SyncGroupId p_group_id) const;
 
+	void sync_group_set_lod_policy(SyncGroupId p_group_id, const NS::LodPolicy &p_policy);
+	NS::LodPolicy sync_group_get_lod_policy(SyncGroupId p_group_id) const;
+	void sync_group_set_lod_metric(NS::ObjectData *p_object_data, SyncGroupId p_group_id, real_t p_metric);
+	NS::LodTier sync_group_get_lod_tier(const NS::ObjectData *p_object_data, SyncGroupId p_group_id) const;
+	void sync_group_update_lod(SyncGroupId p_group_id);
+	void sync_groups_update_lod();
+
 	void sync_group_set_user_data(SyncGroupId p_group_id, uint64_t p_user_ptr);
 	uint64_t sync_group_get_user_data(SyncGroupId p_group_id) const;
 
@@ -495,10 +722,15 @@ public:
 
 	void process_snapshot_notificator(real_t p_delta);
 
+	/// `p_resync`, when set, contains the objects the peer is missing: their
+	/// name and requested variables are added to the snapshot.
+	/// The join snapshots always carry the realtime objects list.
 	void generate_snapshot(
 			bool p_force_full_snapshot,
 			const NS::SyncGroup &p_group,
-			DataBuffer &r_snapshot_db) const;
+			DataBuffer &r_snapshot_db,
+			const LocalVector<NS::ObjectResync> *p_resync = nullptr,
+			JoinStreamStatus p_join = JOIN_STREAM_NONE) const;
 
 	void generate_snapshot_object_data(
 			const NS::ObjectData *p_object_data,
@@ -507,10 +739,15 @@ public:
 			DataBuffer &r_snapshot_db) const;
 
 	void process_deferred_sync(real_t p_delta);
+	/// Relays the inputs received this tick to the peers that see the
+	/// controllers as dolls: one packet per peer, covering all the dolls of
+	/// its sync group.
+	void process_doll_inputs_relay();
 };
 
 class ClientSynchronizer : public Synchronizer {
 	friend class SceneSynchronizerBase;
+	friend class SpectatorSynchronizer;
 
 	NS::ObjectData *player_controller_node_data = nullptr;
 	std::map<ObjectNetId, std::string> objects_names;
@@ -523,6 +760,19 @@ class ClientSynchronizer : public Synchronizer {
 	bool want_to_enable = false;
 
 	bool need_full_snapshot_notified = false;
+	/// The objects this client is missing, requested to the server at the end
+	/// of the snapshot parsing.
+	LocalVector<NS::ObjectResync> pending_resync;
+	/// Above this amount of missing objects, a full snapshot is requested.
+	static const uint32_t MAX_RESYNC_OBJECTS = 64;
+	/// The objects already requested, asked again only after
+	/// `RESYNC_REQUEST_TIMEOUT` seconds without a response.
+	NS::ObjectResyncTracker requested_resync;
+	static constexpr double RESYNC_REQUEST_TIMEOUT = 1.0;
+	/// The seconds processed by this client, used to time the requests.
+	double resync_clock = 0.0;
+	/// True while the server streams the world to this peer.
+	bool join_streaming = false;
 
 	struct EndSyncEvent {
 		NS::ObjectData *node_data;
@@ -550,13 +800,21 @@ class ClientSynchronizer : public Synchronizer {
 		real_t alpha_advacing_per_epoch = 1.0;
 		real_t alpha = 0.0;
 
+		/// The last received epoch, used as reference by the delta epochs.
+		Vector<uint8_t> last_epoch_data;
+		int last_epoch_bit_count = -1;
+		uint32_t last_epoch = UINT32_MAX;
+
 		DeferredSyncInterpolationData() = default;
 		DeferredSyncInterpolationData(const DeferredSyncInterpolationData &p_dss) :
 				nd(p_dss.nd),
 				past_epoch(p_dss.past_epoch),
 				future_epoch(p_dss.future_epoch),
 				alpha_advacing_per_epoch(p_dss.alpha_advacing_per_epoch),
-				alpha(p_dss.alpha) {
+				alpha(p_dss.alpha),
+				last_epoch_data(p_dss.last_epoch_data),
+				last_epoch_bit_count(p_dss.last_epoch_bit_count),
+				last_epoch(p_dss.last_epoch) {
 			past_epoch_buffer.copy(p_dss.past_epoch_buffer);
 			future_epoch_buffer.copy(p_dss.future_epoch_buffer);
 		}
@@ -568,6 +826,9 @@ class ClientSynchronizer : public Synchronizer {
 			future_epoch = p_dss.future_epoch;
 			alpha_advacing_per_epoch = p_dss.alpha_advacing_per_epoch;
 			alpha = p_dss.alpha;
+			last_epoch_data = p_dss.last_epoch_data;
+			last_epoch_bit_count = p_dss.last_epoch_bit_count;
+			last_epoch = p_dss.last_epoch;
 			return *this;
 		}
 
@@ -597,7 +858,7 @@ public:
 	void signal_end_sync_changed_variables_events();
 	virtual void on_controller_reset(NS::ObjectData *p_object_data) override;
 
-	void receive_snapshot(DataBuffer &p_snapshot);
+	virtual void receive_snapshot(DataBuffer &p_snapshot);
 	bool parse_sync_data(
 			DataBuffer &p_snapshot,
 			void *p_user_pointer,
@@ -613,6 +874,8 @@ public:
 	void receive_deferred_sync_data(const Vector<uint8_t> &p_data);
 	void process_received_deferred_sync_data(real_t p_delta);
 
+	void receive_doll_inputs(const Vector<uint8_t> &p_data);
+
 	void remove_node_from_deferred_sync(NS::ObjectData *p_object_data);
 
 private:
@@ -627,6 +890,11 @@ private:
 
 	void process_received_server_state(real_t p_delta);
 
+	/// Replays the dolls which predicted inputs were wrong, from the client
+	/// snapshot that precedes the first mispredicted input. Only the doll is
+	/// processed, so the rest of the scene is not rewound.
+	void process_dolls_replay(real_t p_delta);
+
 	bool __pcr__fetch_recovery_info(
 			const uint32_t p_input_id,
 			NS::Snapshot &r_no_rewind_recover);
@@ -651,8 +919,20 @@ private:
 	bool parse_snapshot(DataBuffer &p_snapshot);
 
 	void notify_server_full_snapshot_is_needed();
+	/// Asks the server the object name and the variables `p_vars`, all of
+	/// them when empty.
+	void request_object_resync(ObjectNetId p_net_id, const LocalVector<VarId> &p_vars = LocalVector<VarId>());
+	void notify_server_resync_is_needed();
 
 	void update_client_snapshot(NS::Snapshot &p_snapshot);
+	void update_client_snapshot_object(NS::Snapshot &p_snapshot, const NS::ObjectData &p_object_data);
+	/// Adds the sleeping object to the client snapshots taken while it slept,
+	/// so the compare detects the server changes that wake it.
+	void capture_sleeping_object(const NS::ObjectData &p_object_data);
+	void apply_object_vars(
+			NS::ObjectData &p_object_data,
+			const std::vector<NS::NameAndVar> &p_vars,
+			LocalVector<String> *r_applied_data_info);
 	void apply_snapshot(
 			const NS::Snapshot &p_snapshot,
 			int p_flag,
@@ -660,6 +940,47 @@ private:
 			bool p_skip_custom_data = false);
 };
 
+/// A client without player controller, that doesn't predict: no client
+/// snapshots, compare or rewind. The received snapshots are buffered, and
+/// applied interpolated `spectator_interpolation_delay` seconds late.
+/// Only the float and vector variables are interpolated: the others (like
+/// the ids and the enums) switch once the new snapshot is reached.
+class SpectatorSynchronizer : public ClientSynchronizer {
+	friend class SceneSynchronizerBase;
+
+	struct BufferedSnapshot {
+		NS::Snapshot snapshot;
+		/// The local time this snapshot was received.
+		double time = 0.0;
+	};
+
+	/// The first is the past snapshot, the second the future one.
+	std::deque<BufferedSnapshot> interpolation_buffer;
+	/// Above this amount of buffered snapshots, the oldest are dropped.
+	static const uint32_t MAX_BUFFERED_SNAPSHOTS = 32;
+	double time = 0.0;
+	/// True when the past snapshot custom data is applied.
+	bool past_applied = false;
+	/// True when the last buffered snapshot is applied: nothing to do until
+	/// a new one is received.
+	bool settled = false;
+
+public:
+	SpectatorSynchronizer(SceneSynchronizerBase *p_node);
+
+	virtual void clear() override;
+
+	virtual void process() override;
+	virtual void on_object_data_removed(NS::ObjectData &p_object_data) override;
+	virtual void on_variable_changed(NS::ObjectData *p_object_data, VarId p_var_id, const Variant &p_old_value, int p_flag) override {}
+	virtual void on_controller_reset(NS::ObjectData *p_object_data) override {}
+
+	virtual void receive_snapshot(DataBuffer &p_snapshot) override;
+
+private:
+	void apply_interpolated(const NS::Snapshot &p_past, const NS::Snapshot &p_future, real_t p_alpha);
+};
+
 /// This is used to make sure we can safely convert any `BaseType` defined by
 // the user to `void*`.
 template <class BaseType, class NetInterfaceClass>
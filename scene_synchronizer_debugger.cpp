@@ -47,9 +47,14 @@
 #endif
 
 SceneSynchronizerDebugger *SceneSynchronizerDebugger::the_singleton = nullptr;
+static thread_local SceneSynchronizerDebugger *thread_singleton = nullptr;
 
 SceneSynchronizerDebugger *SceneSynchronizerDebugger::singleton() {
-	return the_singleton;
+	return thread_singleton ? thread_singleton : the_singleton;
+}
+
+void SceneSynchronizerDebugger::set_thread_singleton(SceneSynchronizerDebugger *p_debugger) {
+	thread_singleton = p_debugger;
 }
 
 void SceneSynchronizerDebugger::_bind_methods() {
@@ -77,6 +82,9 @@ SceneSynchronizerDebugger::~SceneSynchronizerDebugger() {
 	if (the_singleton == this) {
 		the_singleton = nullptr;
 	}
+	if (thread_singleton == this) {
+		thread_singleton = nullptr;
+	}
 
 #ifdef DEBUG_ENABLED
 	tracked_nodes.reset();
@@ -160,6 +168,55 @@ void SceneSynchronizerDebugger::setup_debugger(const String &p_dump_name, int p_
 #endif
 }
 
+void SceneSynchronizerDebugger::load_log_settings() {
+#ifdef DEBUG_ENABLED
+	const bool log_messages = GLOBAL_GET("NetworkSynchronizer/log_debug_warnings_and_messages");
+	log_level = log_messages ? LOG_LEVEL_INFO : LOG_LEVEL_ERROR;
+
+	log_categories = LOG_CATEGORY_GENERAL;
+	if (bool(GLOBAL_GET("NetworkSynchronizer/log_debug_rewindings"))) {
+		log_categories |= LOG_CATEGORY_REWIND;
+	}
+	if (bool(GLOBAL_GET("NetworkSynchronizer/log_debug_nodes_relevancy_update"))) {
+		log_categories |= LOG_CATEGORY_RELEVANCY;
+	}
+	if (bool(GLOBAL_GET("NetworkSynchronizer/debug_server_speedup"))) {
+		log_categories |= LOG_CATEGORY_SPEEDUP;
+	}
+	if (bool(GLOBAL_GET("NetworkSynchronizer/debugger/log_debug_fps_warnings"))) {
+		log_categories |= LOG_CATEGORY_FPS;
+	}
+#endif
+}
+
+void SceneSynchronizerDebugger::set_log_level(LogLevel p_level) {
+#ifdef DEBUG_ENABLED
+	log_level = p_level;
+#endif
+}
+
+SceneSynchronizerDebugger::LogLevel SceneSynchronizerDebugger::get_log_level() const {
+#ifdef DEBUG_ENABLED
+	return log_level;
+#else
+	return LOG_LEVEL_ERROR;
+#endif
+}
+
+void SceneSynchronizerDebugger::set_log_categories(uint32_t p_categories) {
+#ifdef DEBUG_ENABLED
+	log_categories = p_categories;
+#endif
+}
+
+uint32_t SceneSynchronizerDebugger::get_log_categories() const {
+#ifdef DEBUG_ENABLED
+	return log_categories;
+#else
+	return 0;
+#endif
+}
+
 void SceneSynchronizerDebugger::prepare_dumping(int p_peer, SceneTree *p_scene_tree) {
 #ifdef DEBUG_ENABLED
 	if (!dump_enabled) {
@@ -591,6 +648,9 @@ void SceneSynchronizerDebugger::databuffer_read(uint32_t p_data_type, uint32_t p
 
 void SceneSynchronizerDebugger::notify_input_sent_to_server(NS::NetworkInterface *p_network_interface, uint32_t p_frame_index, uint32_t p_input_index) {
 #ifdef DEBUG_ENABLED
+	if (!dump_enabled) {
+		return;
+	}
 	debug_print(p_network_interface, "The client sent to server the input `" + itos(p_input_index) + "` for frame:`" + itos(p_frame_index) + "`.", true);
 #endif
 }
@@ -600,6 +660,9 @@ void SceneSynchronizerDebugger::notify_are_inputs_different_result(
 		uint32_t p_other_frame_index,
 		bool p_is_similar) {
 #ifdef DEBUG_ENABLED
+	if (!dump_enabled) {
+		return;
+	}
 	if (p_is_similar) {
 		debug_print(p_network_interface, "This frame input is SIMILAR to `" + itos(p_other_frame_index) + "`", true);
 	} else {
@@ -630,28 +693,28 @@ void SceneSynchronizerDebugger::add_node_message(const String &p_node_path, cons
 #endif
 }
 
-void SceneSynchronizerDebugger::debug_print(NS::NetworkInterface *p_network_interface, const String &p_message, bool p_silent) {
+void SceneSynchronizerDebugger::debug_print(NS::NetworkInterface *p_network_interface, const String &p_message, bool p_silent, uint32_t p_category) {
 #ifdef DEBUG_ENABLED
-	if (!p_silent) {
-		NET_DEBUG_PRINT(p_message);
+	if (!p_silent && is_log_enabled(LOG_LEVEL_INFO, p_category)) {
+		print_line(String("[Net] ") + p_message);
 	}
 	add_node_message(p_network_interface ? p_network_interface->get_name() : "GLOBAL", "[INFO]    " + p_message);
 #endif
 }
 
-void SceneSynchronizerDebugger::debug_warning(NS::NetworkInterface *p_network_interface, const String &p_message, bool p_silent) {
+void SceneSynchronizerDebugger::debug_warning(NS::NetworkInterface *p_network_interface, const String &p_message, bool p_silent, uint32_t p_category) {
 #ifdef DEBUG_ENABLED
-	if (!p_silent) {
-		NET_DEBUG_WARN(p_message);
+	if (!p_silent && is_log_enabled(LOG_LEVEL_WARNING, p_category)) {
+		WARN_PRINT(String("[Net] ") + p_message);
 	}
 	add_node_message(p_network_interface ? p_network_interface->get_name() : "GLOBAL", "[WARNING] " + p_message);
 	frame_dump__has_warnings = true;
 #endif
 }
 
-void SceneSynchronizerDebugger::debug_error(NS::NetworkInterface *p_network_interface, const String &p_message, bool p_silent) {
+void SceneSynchronizerDebugger::debug_error(NS::NetworkInterface *p_network_interface, const String &p_message, bool p_silent, uint32_t p_category) {
 #ifdef DEBUG_ENABLED
-	if (!p_silent) {
+	if (!p_silent && is_log_enabled(LOG_LEVEL_ERROR, p_category)) {
 		NET_DEBUG_ERR(p_message);
 	}
 	add_node_message(p_network_interface ? p_network_interface->get_name() : "GLOBAL", "[ERROR]   " + p_message);
@@ -661,8 +724,8 @@ void SceneSynchronizerDebugger::debug_error(NS::NetworkInterface *p_network_inte
 
 void SceneSynchronizerDebugger::gd_debug_print(Node *p_node, const String &p_message, bool p_silent) {
 #ifdef DEBUG_ENABLED
-	if (!p_silent) {
-		NET_DEBUG_PRINT(p_message);
+	if (!p_silent && is_log_enabled(LOG_LEVEL_INFO, LOG_CATEGORY_GENERAL)) {
+		print_line(String("[Net] ") + p_message);
 	}
 	add_node_message(p_node ? String(p_node->get_path()) : "GLOBAL", "[INFO]    " + p_message);
 #endif
@@ -670,8 +733,8 @@ void SceneSynchronizerDebugger::gd_debug_print(Node *p_node, const String &p_mes
 
 void SceneSynchronizerDebugger::gd_debug_warning(Node *p_node, const String &p_message, bool p_silent) {
 #ifdef DEBUG_ENABLED
-	if (!p_silent) {
-		NET_DEBUG_WARN(p_message);
+	if (!p_silent && is_log_enabled(LOG_LEVEL_WARNING, LOG_CATEGORY_GENERAL)) {
+		WARN_PRINT(String("[Net] ") + p_message);
 	}
 	add_node_message(p_node ? String(p_node->get_path()) : "GLOBAL", "[WARNING] " + p_message);
 	frame_dump__has_warnings = true;
@@ -680,7 +743,7 @@ void SceneSynchronizerDebugger::gd_debug_warning(Node *p_node, const String &p_m
 
 void SceneSynchronizerDebugger::gd_debug_error(Node *p_node, const String &p_message, bool p_silent) {
 #ifdef DEBUG_ENABLED
-	if (!p_silent) {
+	if (!p_silent && is_log_enabled(LOG_LEVEL_ERROR, LOG_CATEGORY_GENERAL)) {
 		NET_DEBUG_ERR(p_message);
 	}
 	add_node_message(p_node ? String(p_node->get_path()) : "GLOBAL", "[ERROR]   " + p_message);
@@ -76,8 +76,28 @@ public:
 		CLIENT_DESYNC_DETECTED_SOFT = 1 << 0,
 	};
 
+	enum LogLevel : uint8_t {
+		LOG_LEVEL_ERROR,
+		LOG_LEVEL_WARNING,
+		LOG_LEVEL_INFO,
+	};
+
+	enum LogCategory : uint32_t {
+		LOG_CATEGORY_GENERAL = 1 << 0,
+		LOG_CATEGORY_REWIND = 1 << 1,
+		LOG_CATEGORY_RELEVANCY = 1 << 2,
+		LOG_CATEGORY_SPEEDUP = 1 << 3,
+		LOG_CATEGORY_FPS = 1 << 4,
+		LOG_CATEGORY_ALL = UINT32_MAX,
+	};
+
 public:
+	/// Returns the debugger set for the current thread, or the global one.
 	static SceneSynchronizerDebugger *singleton();
+	/// Sets the debugger used by the current thread, so each synchronizer
+	/// instance hosted by the same process can have its own debugger and logs.
+	/// Pass `nullptr` to use the global debugger again.
+	static void set_thread_singleton(SceneSynchronizerDebugger *p_debugger);
 	static void _bind_methods();
 
 private:
@@ -126,6 +146,11 @@ private:
 
 	bool frame_dump__has_warnings = false;
 	bool frame_dump__has_errors = false;
+
+	// The log filter, cached by `load_log_settings` so the logging functions
+	// never query the `ProjectSettings`.
+	LogLevel log_level = LOG_LEVEL_INFO;
+	uint32_t log_categories = LOG_CATEGORY_GENERAL | LOG_CATEGORY_FPS;
 #endif
 
 public:
@@ -141,6 +166,31 @@ public:
 
 	void setup_debugger(const String &p_dump_name, int p_peer, SceneTree *p_scene_tree);
 
+	/// Reads the log level and the log categories from the `ProjectSettings`.
+	void load_log_settings();
+	void set_log_level(LogLevel p_level);
+	LogLevel get_log_level() const;
+	void set_log_categories(uint32_t p_categories);
+	uint32_t get_log_categories() const;
+
+	/// Returns true when a message of this level and category must be printed.
+	bool is_log_enabled(LogLevel p_level, uint32_t p_category) const {
+#ifdef DEBUG_ENABLED
+		return p_level <= log_level && (log_categories & p_category) != 0;
+#else
+		return false;
+#endif
+	}
+
+	/// Returns true when a message must be either printed or dumped.
+	bool is_log_needed(LogLevel p_level, uint32_t p_category, bool p_silent) const {
+#ifdef DEBUG_ENABLED
+		return dump_enabled || (!p_silent && is_log_enabled(p_level, p_category));
+#else
+		return false;
+#endif
+	}
+
 private:
 	void prepare_dumping(int p_peer, SceneTree *p_scene_tree);
 	void setup_debugger_python_ui();
@@ -165,9 +215,9 @@ public:
 
 	void add_node_message(const String &p_name, const String &p_message);
 
-	void debug_print(NS::NetworkInterface *p_network_interface, const String &p_message, bool p_silent = false);
-	void debug_warning(NS::NetworkInterface *p_network_interface, const String &p_message, bool p_silent = false);
-	void debug_error(NS::NetworkInterface *p_network_interface, const String &p_message, bool p_silent = false);
+	void debug_print(NS::NetworkInterface *p_network_interface, const String &p_message, bool p_silent = false, uint32_t p_category = LOG_CATEGORY_GENERAL);
+	void debug_warning(NS::NetworkInterface *p_network_interface, const String &p_message, bool p_silent = false, uint32_t p_category = LOG_CATEGORY_GENERAL);
+	void debug_error(NS::NetworkInterface *p_network_interface, const String &p_message, bool p_silent = false, uint32_t p_category = LOG_CATEGORY_GENERAL);
 	void gd_debug_print(Node *p_node, const String &p_message, bool p_silent = false);
 	void gd_debug_warning(Node *p_node, const String &p_message, bool p_silent = false);
 	void gd_debug_error(Node *p_node, const String &p_message, bool p_silent = false);
@@ -177,3 +227,26 @@ public:
 private:
 	void dump_tracked_objects(const NS::SceneSynchronizerBase *p_scene_sync, Dictionary &p_dump);
 };
+
+// The following macros build the message only when it's going to be printed
+// or dumped; prefer them to calling `debug_print` & co directly.
+// On release builds the message is never built.
+#ifdef DEBUG_ENABLED
+#define NS_DEBUG_LOG(m_func, m_level, m_category, m_network_interface, m_message, m_silent)                                 \
+	if (!SceneSynchronizerDebugger::singleton()->is_log_needed(SceneSynchronizerDebugger::m_level, m_category, m_silent)) { \
+	} else                                                                                                                  \
+		SceneSynchronizerDebugger::singleton()->m_func(m_network_interface, m_message, m_silent, m_category)
+#else
+#define NS_DEBUG_LOG(m_func, m_level, m_category, m_network_interface, m_message, m_silent) \
+	if (true) {                                                                             \
+	} else                                                                                  \
+		SceneSynchronizerDebugger::singleton()->m_func(m_network_interface, m_message, m_silent, m_category)
+#endif
+
+#define NS_DEBUG_PRINT(m_network_interface, m_message, m_silent) NS_DEBUG_LOG(debug_print, LOG_LEVEL_INFO, SceneSynchronizerDebugger::LOG_CATEGORY_GENERAL, m_network_interface, m_message, m_silent)
+#define NS_DEBUG_WARNING(m_network_interface, m_message, m_silent) NS_DEBUG_LOG(debug_warning, LOG_LEVEL_WARNING, SceneSynchronizerDebugger::LOG_CATEGORY_GENERAL, m_network_interface, m_message, m_silent)
+#define NS_DEBUG_ERROR(m_network_interface, m_message, m_silent) NS_DEBUG_LOG(debug_error, LOG_LEVEL_ERROR, SceneSynchronizerDebugger::LOG_CATEGORY_GENERAL, m_network_interface, m_message, m_silent)
+
+// Prints the message only if its category is enabled.
+#define NS_DEBUG_PRINT_CATEGORY(m_category, m_network_interface, m_message) NS_DEBUG_LOG(debug_print, LOG_LEVEL_INFO, SceneSynchronizerDebugger::m_category, m_network_interface, m_message, false)
+#define NS_DEBUG_WARNING_CATEGORY(m_category, m_network_interface, m_message) NS_DEBUG_LOG(debug_warning, LOG_LEVEL_WARNING, SceneSynchronizerDebugger::m_category, m_network_interface, m_message, false)
@@ -0,0 +1,139 @@
+#include "scene_synchronizer_host.h"
+
+#include "core/error/error_macros.h"
+#include "scene_synchronizer_debugger.h"
+
+NS_NAMESPACE_BEGIN
+
+SceneSynchronizerHost::SceneSynchronizerHost(int p_workers_count) {
+	if (p_workers_count <= 0) {
+		p_workers_count = MAX(1, int(std::thread::hardware_concurrency()));
+	}
+
+	for (int w = 0; w < p_workers_count; w++) {
+		workers.push_back(std::make_unique<Worker>());
+	}
+
+	for (int w = 0; w < p_workers_count; w++) {
+		workers[w]->thread = std::thread(&SceneSynchronizerHost::worker_loop, this, w);
+	}
+}
+
+SceneSynchronizerHost::~SceneSynchronizerHost() {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		quit = true;
+	}
+	process_cond.notify_all();
+
+	for (std::unique_ptr<Worker> &worker : workers) {
+		worker->thread.join();
+	}
+}
+
+int SceneSynchronizerHost::get_workers_count() const {
+	return int(workers.size());
+}
+
+HostInstanceId SceneSynchronizerHost::add_instance(ProcessFunc p_process_func, SceneSynchronizerDebugger *p_debugger, int p_worker) {
+	ERR_FAIL_COND_V(!p_process_func, NONE);
+	ERR_FAIL_COND_V_MSG(p_debugger == nullptr, NONE, "Each instance needs its own debugger: the global one is not thread safe.");
+	ERR_FAIL_COND_V(p_worker >= int(workers.size()), NONE);
+
+	if (p_worker < 0) {
+		// Pin it to the least loaded worker.
+		p_worker = 0;
+		for (int w = 1; w < int(workers.size()); w++) {
+			if (workers[w]->instances.size() < workers[p_worker]->instances.size()) {
+				p_worker = w;
+			}
+		}
+	}
+
+	// The synchronizer loads the log settings into the global debugger only.
+	p_debugger->load_log_settings();
+
+	Instance instance;
+	instance.id = id_counter;
+	instance.process_func = p_process_func;
+	instance.debugger = p_debugger;
+	id_counter += 1;
+
+	workers[p_worker]->instances.push_back(instance);
+	return instance.id;
+}
+
+void SceneSynchronizerHost::remove_instance(HostInstanceId p_id) {
+	for (std::unique_ptr<Worker> &worker : workers) {
+		for (auto it = worker->instances.begin(); it != worker->instances.end(); it++) {
+			if (it->id == p_id) {
+				worker->instances.erase(it);
+				return;
+			}
+		}
+	}
+}
+
+int SceneSynchronizerHost::get_instances_count() const {
+	int count = 0;
+	for (const std::unique_ptr<Worker> &worker : workers) {
+		count += int(worker->instances.size());
+	}
+	return count;
+}
+
+int SceneSynchronizerHost::get_instance_worker(HostInstanceId p_id) const {
+	for (int w = 0; w < int(workers.size()); w++) {
+		for (const Instance &instance : workers[w]->instances) {
+			if (instance.id == p_id) {
+				return w;
+			}
+		}
+	}
+	return -1;
+}
+
+void SceneSynchronizerHost::process(double p_delta) {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		process_delta = p_delta;
+		process_generation += 1;
+		workers_processing = int(workers.size());
+	}
+	process_cond.notify_all();
+
+	std::unique_lock<std::mutex> lock(mutex);
+	done_cond.wait(lock, [this]() { return workers_processing == 0; });
+}
+
+void SceneSynchronizerHost::worker_loop(int p_worker) {
+	uint64_t processed_generation = 0;
+	while (true) {
+		double delta;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			process_cond.wait(lock, [this, processed_generation]() { return quit || process_generation != processed_generation; });
+			if (quit) {
+				return;
+			}
+			processed_generation = process_generation;
+			delta = process_delta;
+		}
+
+		// The instances can't change while processing, so it's safe to read
+		// them without lock.
+		for (Instance &instance : workers[p_worker]->instances) {
+			SceneSynchronizerDebugger::set_thread_singleton(instance.debugger);
+			instance.process_func(delta);
+		}
+		SceneSynchronizerDebugger::set_thread_singleton(nullptr);
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			workers_processing -= 1;
+		}
+		done_cond.notify_one();
+	}
+}
+
+NS_NAMESPACE_END
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "modules/network_synchronizer/core/core.h"
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class SceneSynchronizerDebugger;
+
+NS_NAMESPACE_BEGIN
+
+typedef uint32_t HostInstanceId;
+
+/// Hosts many independent synchronizer instances (for example many small
+/// matches) in the same process.
+/// Each instance is pinned to a worker of the pool, so it's always processed
+/// by the same thread, while the instances pinned to different workers are
+/// processed concurrently.
+///
+/// The instances must not share any mutable state: each one has its own
+/// `SceneSynchronizer`, `NetworkInterface` and its own
+/// `SceneSynchronizerDebugger`, which is set as the thread debugger while the
+/// instance is processed.
+///
+/// NOTE: This class is not thread safe: add, remove and process the instances
+/// always from the same thread.
+class SceneSynchronizerHost {
+public:
+	typedef std::function<void(double p_delta)> ProcessFunc;
+	static constexpr HostInstanceId NONE = std::numeric_limits<HostInstanceId>::max();
+
+private:
+	struct Instance {
+		HostInstanceId id = NONE;
+		ProcessFunc process_func;
+		SceneSynchronizerDebugger *debugger = nullptr;
+	};
+
+	struct Worker {
+		std::thread thread;
+		std::vector<Instance> instances;
+	};
+
+	std::vector<std::unique_ptr<Worker>> workers;
+	HostInstanceId id_counter = 0;
+
+	std::mutex mutex;
+	std::condition_variable process_cond;
+	std::condition_variable done_cond;
+	uint64_t process_generation = 0;
+	int workers_processing = 0;
+	double process_delta = 0.0;
+	bool quit = false;
+
+public:
+	/// When `p_workers_count` is 0 a worker per hardware thread is created.
+	SceneSynchronizerHost(int p_workers_count = 0);
+	~SceneSynchronizerHost();
+
+	int get_workers_count() const;
+
+	/// Adds an instance, pinned to `p_worker` or to the least loaded worker
+	/// when `p_worker` is -1.
+	/// The `p_process_func` processes the whole instance: the synchronizer
+	/// and the network. The `p_debugger` is mandatory, so the workers never
+	/// share the global one, and it gets the project log settings.
+	HostInstanceId add_instance(ProcessFunc p_process_func, SceneSynchronizerDebugger *p_debugger, int p_worker = -1);
+	void remove_instance(HostInstanceId p_id);
+	int get_instances_count() const;
+
+	/// Returns the worker this instance is pinned to, or -1.
+	int get_instance_worker(HostInstanceId p_id) const;
+
+	/// Processes all the instances concurrently and returns once all are done.
+	void process(double p_delta);
+
+private:
+	void worker_loop(int p_worker);
+};
+
+NS_NAMESPACE_END
@@ -1,5 +1,6 @@
 #include "snapshot.h"
 
+#include "rewind_profiler.h"
 #include "scene/main/node.h"
 #include "scene_synchronizer.h"
 
@@ -27,7 +28,8 @@ bool compare_vars(
 		const std::vector<NS::NameAndVar> &p_server_vars,
 		const std::vector<NS::NameAndVar> &p_client_vars,
 		NS::Snapshot *r_no_rewind_recover,
-		LocalVector<String> *r_differences_info) {
+		LocalVector<String> *r_differences_info,
+		NS::RewindProfiler *r_rewind_profiler) {
 	const NS::NameAndVar *s_vars = p_server_vars.data();
 	const NS::NameAndVar *c_vars = p_client_vars.data();
 
@@ -56,8 +58,9 @@ bool compare_vars(
 						c_vars[var_index].value);
 
 		if (different) {
-			if (p_synchronizer_node_data->vars[var_index].skip_rewinding) {
-				// The vars are different, but we don't need to trigger a rewind.
+			if (p_synchronizer_node_data->vars[var_index].skip_rewinding || p_synchronizer_node_data->process_rate_divisor > 1) {
+				// The vars are different, but we don't need to trigger a rewind:
+				// the objects processed at a reduced rate are not predicted.
 				if (r_no_rewind_recover) {
 					if (uint32_t(r_no_rewind_recover->object_vars.data()[p_synchronizer_node_data->get_net_id().id].size()) <= var_index) {
 						r_no_rewind_recover->object_vars.data()[p_synchronizer_node_data->get_net_id().id].resize(var_index + 1);
@@ -70,7 +73,7 @@ bool compare_vars(
 
 				if (r_differences_info) {
 					r_differences_info->push_back(
-							"[NO REWIND] Difference found on var #" + itos(var_index) + " " + p_synchronizer_node_data->vars[var_index].var.name.c_str() + " " +
+							"[NO REWIND] Difference found on var #" + itos(var_index) + " " + p_synchronizer_node_data->get_var_layout().names[var_index].c_str() + " " +
 							"Server value: `" + NS::stringify_fast(s_vars[var_index].value) + "` " +
 							"Client value: `" + NS::stringify_fast(c_vars[var_index].value) + "`.    " +
 							"[Server name: `" + s_vars[var_index].name.c_str() + "` " +
@@ -80,12 +83,15 @@ bool compare_vars(
 				// The vars are different.
 				if (r_differences_info) {
 					r_differences_info->push_back(
-							"Difference found on var #" + itos(var_index) + " " + p_synchronizer_node_data->vars[var_index].var.name.c_str() + " " +
+							"Difference found on var #" + itos(var_index) + " " + p_synchronizer_node_data->get_var_layout().names[var_index].c_str() + " " +
 							"Server value: `" + NS::stringify_fast(s_vars[var_index].value) + "` " +
 							"Client value: `" + NS::stringify_fast(c_vars[var_index].value) + "`.    " +
 							"[Server name: `" + s_vars[var_index].name.c_str() + "` " +
 							"Client name: `" + c_vars[var_index].name.c_str() + "`].");
 				}
+				if (r_rewind_profiler) {
+					r_rewind_profiler->notify_trigger(*p_synchronizer_node_data, NS::VarId{ var_index }, s_vars[var_index].value, c_vars[var_index].value);
+				}
 #ifdef DEBUG_ENABLED
 				is_equal = false;
 #else
@@ -120,7 +126,8 @@ bool NS::Snapshot::compare(
 		const Snapshot &p_snap_A,
 		const Snapshot &p_snap_B,
 		Snapshot *r_no_rewind_recover,
-		LocalVector<String> *r_differences_info
+		LocalVector<String> *r_differences_info,
+		RewindProfiler *r_rewind_profiler
 #ifdef DEBUG_ENABLED
 		,
 		LocalVector<ObjectNetId> *r_different_node_data
@@ -180,7 +187,8 @@ bool NS::Snapshot::compare(
 					p_snap_A.object_vars[net_node_id.id],
 					p_snap_B.object_vars[net_node_id.id],
 					r_no_rewind_recover,
-					r_differences_info);
+					r_differences_info,
+					r_rewind_profiler);
 
 			if (are_nodes_different) {
 				if (r_differences_info) {
@@ -6,6 +6,7 @@
 
 namespace NS {
 class SceneSynchronizerBase;
+class RewindProfiler;
 
 struct Snapshot {
 	uint32_t input_id = UINT32_MAX;
@@ -32,7 +33,8 @@ public:
 			const Snapshot &p_snap_A,
 			const Snapshot &p_snap_B,
 			Snapshot *r_no_rewind_recover,
-			LocalVector<String> *r_differences_info
+			LocalVector<String> *r_differences_info,
+			RewindProfiler *r_rewind_profiler
 #ifdef DEBUG_ENABLED
 			,
 			LocalVector<ObjectNetId> *r_different_node_data);
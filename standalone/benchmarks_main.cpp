@@ -0,0 +1,15 @@
+// Runs the network synchronizer benchmarks, without the Godot engine, and
+// prints the JSON result to the stdout.
+
+#include "core/string/print_string.h"
+#include "modules/network_synchronizer/scene_synchronizer_debugger.h"
+#include "modules/network_synchronizer/tests/benchmark_scene_synchronizer.h"
+
+int main(int argc, char **argv) {
+	memnew(SceneSynchronizerDebugger);
+
+	print_line(String(NS_Test::benchmark_all().c_str()));
+
+	memdelete(SceneSynchronizerDebugger::singleton());
+	return 0;
+}
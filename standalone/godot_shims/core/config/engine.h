@@ -0,0 +1,16 @@
+#pragma once
+
+// Thin shim of the Godot `Engine`, used by the standalone build.
+
+#include "core/typedefs.h"
+
+class Engine {
+	int physics_ticks_per_second = 60;
+
+public:
+	static Engine *get_singleton();
+
+	void set_physics_ticks_per_second(int p_ips) { physics_ticks_per_second = p_ips; }
+	int get_physics_ticks_per_second() const { return physics_ticks_per_second; }
+	bool is_editor_hint() const { return false; }
+};
@@ -0,0 +1,25 @@
+#pragma once
+
+// Thin shim of the Godot `ProjectSettings`, used by the standalone build.
+// It's a plain key value store: the unset settings return the given default.
+
+#include "core/string/ustring.h"
+#include "core/variant/variant.h"
+#include <map>
+#include <string>
+
+class ProjectSettings {
+	std::map<std::string, Variant> settings;
+
+public:
+	static ProjectSettings *get_singleton();
+
+	bool has_setting(const String &p_name) const;
+	void set_setting(const String &p_name, const Variant &p_value);
+	Variant get_setting(const String &p_name, const Variant &p_default_value = Variant()) const;
+};
+
+Variant _GLOBAL_DEF(const String &p_var, const Variant &p_default);
+
+#define GLOBAL_DEF(m_var, m_value) _GLOBAL_DEF(m_var, m_value)
+#define GLOBAL_GET(m_var) ProjectSettings::get_singleton()->get_setting(m_var)
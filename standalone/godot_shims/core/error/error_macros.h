@@ -0,0 +1,120 @@
+#pragma once
+
+// Thin shim of the Godot error macros, used by the standalone build.
+
+#include "core/string/ustring.h"
+#include "core/typedefs.h"
+#include <cstdio>
+#include <cstdlib>
+
+namespace ns_shim {
+extern bool error_print_enabled;
+
+inline void print_error(const char *p_function, const char *p_file, int p_line, const char *p_kind, const String &p_message) {
+	if (error_print_enabled) {
+		fprintf(stderr, "%s: %s\n   at: %s (%s:%i)\n", p_kind, p_message.utf8().get_data(), p_function, p_file, p_line);
+	}
+}
+} //namespace ns_shim
+
+#define ERR_PRINT_ON ns_shim::error_print_enabled = true;
+#define ERR_PRINT_OFF ns_shim::error_print_enabled = false;
+
+#define _NS_SHIM_ERR(m_kind, m_msg) ns_shim::print_error(__FUNCTION__, __FILE__, __LINE__, m_kind, String(m_msg))
+
+#define ERR_PRINT(m_msg) _NS_SHIM_ERR("ERROR", m_msg)
+#define WARN_PRINT(m_msg) _NS_SHIM_ERR("WARNING", m_msg)
+
+#define CRASH_NOW_MSG(m_msg)                      \
+	if (true) {                                   \
+		_NS_SHIM_ERR("FATAL", m_msg);             \
+		fflush(stderr);                           \
+		abort();                                  \
+	} else                                        \
+		((void)0)
+
+#define CRASH_NOW() CRASH_NOW_MSG("")
+
+#define CRASH_COND(m_cond)                                            \
+	if (unlikely(m_cond)) {                                           \
+		_NS_SHIM_ERR("FATAL", "Condition \"" #m_cond "\" is true."); \
+		fflush(stderr);                                               \
+		abort();                                                      \
+	} else                                                            \
+		((void)0)
+
+#define CRASH_COND_MSG(m_cond, m_msg)                                                                   \
+	if (unlikely(m_cond)) {                                                                             \
+		_NS_SHIM_ERR("FATAL", String("Condition \"" #m_cond "\" is true. ") + String(m_msg)); \
+		fflush(stderr);                                                                                 \
+		abort();                                                                                        \
+	} else                                                                                              \
+		((void)0)
+
+#define ERR_FAIL_COND(m_cond)                                         \
+	if (unlikely(m_cond)) {                                           \
+		_NS_SHIM_ERR("ERROR", "Condition \"" #m_cond "\" is true."); \
+		return;                                                       \
+	} else                                                            \
+		((void)0)
+
+#define ERR_FAIL_COND_MSG(m_cond, m_msg)                                                       \
+	if (unlikely(m_cond)) {                                                                    \
+		_NS_SHIM_ERR("ERROR", String("Condition \"" #m_cond "\" is true. ") + String(m_msg)); \
+		return;                                                                                \
+	} else                                                                                     \
+		((void)0)
+
+#define ERR_FAIL_COND_V(m_cond, m_retval)                             \
+	if (unlikely(m_cond)) {                                           \
+		_NS_SHIM_ERR("ERROR", "Condition \"" #m_cond "\" is true."); \
+		return m_retval;                                              \
+	} else                                                            \
+		((void)0)
+
+#define ERR_FAIL_COND_V_MSG(m_cond, m_retval, m_msg)                                           \
+	if (unlikely(m_cond)) {                                                                    \
+		_NS_SHIM_ERR("ERROR", String("Condition \"" #m_cond "\" is true. ") + String(m_msg)); \
+		return m_retval;                                                                       \
+	} else                                                                                     \
+		((void)0)
+
+#define ERR_FAIL_MSG(m_msg)           \
+	if (true) {                       \
+		_NS_SHIM_ERR("ERROR", m_msg); \
+		return;                       \
+	} else                            \
+		((void)0)
+
+#define ERR_FAIL_V_MSG(m_retval, m_msg) \
+	if (true) {                         \
+		_NS_SHIM_ERR("ERROR", m_msg);   \
+		return m_retval;                \
+	} else                              \
+		((void)0)
+
+#define ERR_FAIL_V(m_retval) ERR_FAIL_V_MSG(m_retval, "Method failed.")
+
+#define ERR_FAIL_NULL(m_param) ERR_FAIL_COND((m_param) == nullptr)
+#define ERR_FAIL_NULL_V(m_param, m_retval) ERR_FAIL_COND_V((m_param) == nullptr, m_retval)
+#define ERR_FAIL_NULL_MSG(m_param, m_msg) ERR_FAIL_COND_MSG((m_param) == nullptr, m_msg)
+#define ERR_FAIL_NULL_V_MSG(m_param, m_retval, m_msg) ERR_FAIL_COND_V_MSG((m_param) == nullptr, m_retval, m_msg)
+
+#define ERR_FAIL_INDEX(m_index, m_size) ERR_FAIL_COND((m_index) < 0 || (m_index) >= (m_size))
+#define ERR_FAIL_INDEX_V(m_index, m_size, m_retval) ERR_FAIL_COND_V((m_index) < 0 || (m_index) >= (m_size), m_retval)
+#define ERR_FAIL_INDEX_MSG(m_index, m_size, m_msg) ERR_FAIL_COND_MSG((m_index) < 0 || (m_index) >= (m_size), m_msg)
+#define ERR_FAIL_INDEX_V_MSG(m_index, m_size, m_retval, m_msg) ERR_FAIL_COND_V_MSG((m_index) < 0 || (m_index) >= (m_size), m_retval, m_msg)
+#define ERR_FAIL_UNSIGNED_INDEX(m_index, m_size) ERR_FAIL_COND((m_index) >= (m_size))
+#define ERR_FAIL_UNSIGNED_INDEX_V(m_index, m_size, m_retval) ERR_FAIL_COND_V((m_index) >= (m_size), m_retval)
+
+#define ERR_CONTINUE(m_cond) \
+	if (unlikely(m_cond)) {  \
+		continue;            \
+	} else                   \
+		((void)0)
+
+#define ERR_BREAK(m_cond)   \
+	if (unlikely(m_cond)) { \
+		break;              \
+	} else                  \
+		((void)0)
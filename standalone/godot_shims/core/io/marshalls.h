@@ -0,0 +1,68 @@
+#pragma once
+
+// Thin shim of the Godot marshalls, used by the standalone build.
+// The variant encoding is a simplified version of the Godot one: a 4 bytes
+// type header followed by the payload, always padded to 4 bytes.
+
+#include "core/error/error_list.h"
+#include "core/typedefs.h"
+#include "core/variant/variant.h"
+#include <cstring>
+
+static inline unsigned int encode_uint16(uint16_t p_uint, uint8_t *p_arr) {
+	for (int i = 0; i < 2; i++) {
+		*p_arr = p_uint & 0xFF;
+		p_arr++;
+		p_uint >>= 8;
+	}
+	return sizeof(uint16_t);
+}
+
+static inline unsigned int encode_uint32(uint32_t p_uint, uint8_t *p_arr) {
+	for (int i = 0; i < 4; i++) {
+		*p_arr = p_uint & 0xFF;
+		p_arr++;
+		p_uint >>= 8;
+	}
+	return sizeof(uint32_t);
+}
+
+static inline unsigned int encode_uint64(uint64_t p_uint, uint8_t *p_arr) {
+	for (int i = 0; i < 8; i++) {
+		*p_arr = p_uint & 0xFF;
+		p_arr++;
+		p_uint >>= 8;
+	}
+	return sizeof(uint64_t);
+}
+
+static inline uint16_t decode_uint16(const uint8_t *p_arr) {
+	uint16_t u = 0;
+	for (int i = 1; i >= 0; i--) {
+		u <<= 8;
+		u |= p_arr[i];
+	}
+	return u;
+}
+
+static inline uint32_t decode_uint32(const uint8_t *p_arr) {
+	uint32_t u = 0;
+	for (int i = 3; i >= 0; i--) {
+		u <<= 8;
+		u |= p_arr[i];
+	}
+	return u;
+}
+
+static inline uint64_t decode_uint64(const uint8_t *p_arr) {
+	uint64_t u = 0;
+	for (int i = 7; i >= 0; i--) {
+		u <<= 8;
+		u |= p_arr[i];
+	}
+	return u;
+}
+
+/// When `r_buffer` is nullptr only `r_len` is computed.
+Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bool p_full_objects = false, int p_depth = 0);
+Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int *r_len = nullptr, bool p_allow_objects = false, int p_depth = 0);
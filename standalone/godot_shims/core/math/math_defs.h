@@ -0,0 +1,9 @@
+#pragma once
+
+// Thin shim of the Godot `math_defs.h`, used by the standalone build.
+
+#define CMP_EPSILON 0.00001
+#define CMP_EPSILON2 (CMP_EPSILON * CMP_EPSILON)
+
+#define Math_PI 3.1415926535897932384626433833
+#define Math_TAU 6.2831853071795864769252867666
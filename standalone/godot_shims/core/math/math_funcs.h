@@ -0,0 +1,47 @@
+#pragma once
+
+// Thin shim of the Godot `math_funcs.h`, used by the standalone build.
+
+#include "core/math/math_defs.h"
+#include "core/error/error_macros.h"
+#include "core/typedefs.h"
+#include <cmath>
+
+namespace Math {
+inline double pow(double p_x, double p_y) { return std::pow(p_x, p_y); }
+inline double sqrt(double p_x) { return std::sqrt(p_x); }
+inline double log(double p_x) { return std::log(p_x); }
+inline double sin(double p_x) { return std::sin(p_x); }
+inline double cos(double p_x) { return std::cos(p_x); }
+inline double atan2(double p_y, double p_x) { return std::atan2(p_y, p_x); }
+inline double round(double p_x) { return std::round(p_x); }
+inline double floor(double p_x) { return std::floor(p_x); }
+inline double ceil(double p_x) { return std::ceil(p_x); }
+inline double fmod(double p_x, double p_y) { return std::fmod(p_x, p_y); }
+inline double abs(double p_x) { return std::fabs(p_x); }
+inline float abs(float p_x) { return std::fabs(p_x); }
+inline int abs(int p_x) { return p_x > 0 ? p_x : -p_x; }
+inline int64_t abs(int64_t p_x) { return p_x > 0 ? p_x : -p_x; }
+inline bool is_nan(double p_x) { return std::isnan(p_x); }
+inline bool is_inf(double p_x) { return std::isinf(p_x); }
+inline double lerp(double p_from, double p_to, double p_weight) { return p_from + (p_to - p_from) * p_weight; }
+inline bool is_zero_approx(double p_x) { return std::fabs(p_x) < CMP_EPSILON; }
+
+inline bool is_equal_approx(double p_a, double p_b, double p_tolerance) {
+	if (p_a == p_b) {
+		return true;
+	}
+	return std::fabs(p_a - p_b) < p_tolerance;
+}
+
+inline bool is_equal_approx(double p_a, double p_b) {
+	if (p_a == p_b) {
+		return true;
+	}
+	double tolerance = CMP_EPSILON * std::fabs(p_a);
+	if (tolerance < CMP_EPSILON) {
+		tolerance = CMP_EPSILON;
+	}
+	return std::fabs(p_a - p_b) < tolerance;
+}
+} //namespace Math
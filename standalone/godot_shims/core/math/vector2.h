@@ -0,0 +1,35 @@
+#pragma once
+
+// Thin shim of the Godot `Vector2`, used by the standalone build.
+
+#include "core/math/math_funcs.h"
+
+struct Vector2 {
+	real_t x = 0.0;
+	real_t y = 0.0;
+
+	Vector2() = default;
+	Vector2(real_t p_x, real_t p_y) :
+			x(p_x), y(p_y) {}
+
+	const real_t &operator[](int p_axis) const { return (&x)[p_axis]; }
+	real_t &operator[](int p_axis) { return (&x)[p_axis]; }
+
+	real_t length() const { return Math::sqrt(x * x + y * y); }
+	real_t distance_to(const Vector2 &p_to) const { return (p_to - *this).length(); }
+	real_t length_squared() const { return x * x + y * y; }
+	real_t angle() const { return Math::atan2(y, x); }
+	Vector2 normalized() const {
+		const real_t l = length();
+		return l == 0.0 ? Vector2() : Vector2(x / l, y / l);
+	}
+	bool is_normalized() const { return Math::is_equal_approx(length_squared(), 1.0, 0.001); }
+	real_t dot(const Vector2 &p_other) const { return x * p_other.x + y * p_other.y; }
+
+	Vector2 operator+(const Vector2 &p_v) const { return Vector2(x + p_v.x, y + p_v.y); }
+	Vector2 operator-(const Vector2 &p_v) const { return Vector2(x - p_v.x, y - p_v.y); }
+	Vector2 operator*(real_t p_s) const { return Vector2(x * p_s, y * p_s); }
+	Vector2 operator/(real_t p_s) const { return Vector2(x / p_s, y / p_s); }
+	bool operator==(const Vector2 &p_v) const { return x == p_v.x && y == p_v.y; }
+	bool operator!=(const Vector2 &p_v) const { return !(*this == p_v); }
+};
@@ -0,0 +1,35 @@
+#pragma once
+
+// Thin shim of the Godot `Vector3`, used by the standalone build.
+
+#include "core/math/math_funcs.h"
+
+struct Vector3 {
+	real_t x = 0.0;
+	real_t y = 0.0;
+	real_t z = 0.0;
+
+	Vector3() = default;
+	Vector3(real_t p_x, real_t p_y, real_t p_z) :
+			x(p_x), y(p_y), z(p_z) {}
+
+	const real_t &operator[](int p_axis) const { return (&x)[p_axis]; }
+	real_t &operator[](int p_axis) { return (&x)[p_axis]; }
+
+	real_t length() const { return Math::sqrt(x * x + y * y + z * z); }
+	real_t distance_to(const Vector3 &p_to) const { return (p_to - *this).length(); }
+	real_t length_squared() const { return x * x + y * y + z * z; }
+	Vector3 normalized() const {
+		const real_t l = length();
+		return l == 0.0 ? Vector3() : Vector3(x / l, y / l, z / l);
+	}
+	bool is_normalized() const { return Math::is_equal_approx(length_squared(), 1.0, 0.001); }
+	real_t dot(const Vector3 &p_other) const { return x * p_other.x + y * p_other.y + z * p_other.z; }
+
+	Vector3 operator+(const Vector3 &p_v) const { return Vector3(x + p_v.x, y + p_v.y, z + p_v.z); }
+	Vector3 operator-(const Vector3 &p_v) const { return Vector3(x - p_v.x, y - p_v.y, z - p_v.z); }
+	Vector3 operator*(real_t p_s) const { return Vector3(x * p_s, y * p_s, z * p_s); }
+	Vector3 operator/(real_t p_s) const { return Vector3(x / p_s, y / p_s, z / p_s); }
+	bool operator==(const Vector3 &p_v) const { return x == p_v.x && y == p_v.y && z == p_v.z; }
+	bool operator!=(const Vector3 &p_v) const { return !(*this == p_v); }
+};
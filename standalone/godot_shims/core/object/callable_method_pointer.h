@@ -0,0 +1,34 @@
+#pragma once
+
+// Thin shim of the Godot `callable_mp`, used by the standalone build.
+
+#include "core/object/object.h"
+#include "core/variant/callable.h"
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace ns_shim {
+template <class T, class R, class... P, size_t... Is>
+void call_with_variant_args(T *p_instance, R (T::*p_method)(P...), const Variant **p_args, Variant &r_ret, std::index_sequence<Is...>) {
+	if constexpr (std::is_void_v<R>) {
+		(p_instance->*p_method)(VariantCaster<std::decay_t<P>>::cast(*p_args[Is])...);
+	} else {
+		r_ret = (p_instance->*p_method)(VariantCaster<std::decay_t<P>>::cast(*p_args[Is])...);
+	}
+}
+} //namespace ns_shim
+
+template <class T, class R, class... P>
+Callable callable_mp(T *p_instance, R (T::*p_method)(P...)) {
+	return Callable(
+			StringName("callable_mp"),
+			[p_instance, p_method](const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_error) {
+				if (p_argcount != int(sizeof...(P))) {
+					r_error.error = p_argcount < int(sizeof...(P)) ? Callable::CallError::CALL_ERROR_TOO_FEW_ARGUMENTS : Callable::CallError::CALL_ERROR_TOO_MANY_ARGUMENTS;
+					r_error.expected = int(sizeof...(P));
+					return;
+				}
+				ns_shim::call_with_variant_args(p_instance, p_method, p_args, r_ret, std::index_sequence_for<P...>{});
+			});
+}
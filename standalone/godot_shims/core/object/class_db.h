@@ -0,0 +1,28 @@
+#pragma once
+
+// Thin shim of the Godot `ClassDB`, used by the standalone build.
+// The standalone build has no scripting, so nothing is really bound.
+
+#include "core/object/object.h"
+
+#define D_METHOD(m_c, ...) m_c
+#define DEFVAL(m_defval) (m_defval)
+
+#define BIND_ENUM_CONSTANT(m_constant) ((void)0)
+#define BIND_CONSTANT(m_constant) ((void)0)
+#define ADD_SIGNAL(m_signal) ((void)0)
+#define ADD_PROPERTY(m_property, m_setter, m_getter) ((void)0)
+#define GDVIRTUAL_BIND(...) ((void)0)
+
+#define VARIANT_ENUM_CAST(m_enum)
+
+class ClassDB {
+public:
+	template <class M, class... VarArgs>
+	static void bind_method(const char *p_name, M p_method, VarArgs... p_defaults) {}
+
+	template <class T>
+	static void register_class() {}
+};
+
+#define GDREGISTER_CLASS(m_class) ClassDB::register_class<m_class>()
@@ -0,0 +1,45 @@
+#pragma once
+
+// Thin shim of the Godot `Object`, used by the standalone build.
+
+#include "core/error/error_macros.h"
+#include "core/os/memory.h"
+#include "core/string/string_name.h"
+#include "core/string/ustring.h"
+#include "core/templates/list.h"
+#include "core/variant/callable.h"
+#include "core/variant/variant.h"
+
+struct PropertyInfo {
+	Variant::Type type = Variant::NIL;
+	String name;
+};
+
+#define GDCLASS(m_class, m_inherits)                                      \
+private:                                                                  \
+	typedef m_inherits inherited;                                         \
+                                                                          \
+public:                                                                   \
+	static String get_class_static() { return String(#m_class); }         \
+	virtual String get_class() const override { return String(#m_class); } \
+                                                                          \
+private:
+
+class Object {
+public:
+	virtual ~Object() {}
+
+	static String get_class_static() { return String("Object"); }
+	virtual String get_class() const { return String("Object"); }
+	StringName get_class_name() const { return StringName(get_class()); }
+
+	template <class T>
+	static T *cast_to(Object *p_object) {
+		return dynamic_cast<T *>(p_object);
+	}
+
+	template <class T>
+	static const T *cast_to(const Object *p_object) {
+		return dynamic_cast<const T *>(p_object);
+	}
+};
@@ -0,0 +1,38 @@
+#pragma once
+
+// Thin shim of the Godot `memory.h`, used by the standalone build.
+
+#include "core/error/error_macros.h"
+#include "core/typedefs.h"
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+class Memory {
+public:
+	// The standalone build doesn't track the memory usage.
+	static uint64_t get_mem_usage() { return 0; }
+	static uint64_t get_mem_max_usage() { return 0; }
+
+	static void *alloc_static(size_t p_bytes) { return malloc(p_bytes); }
+	static void *realloc_static(void *p_memory, size_t p_bytes) { return realloc(p_memory, p_bytes); }
+	static void free_static(void *p_ptr) { free(p_ptr); }
+};
+
+#define memalloc(m_size) Memory::alloc_static(m_size)
+#define memrealloc(m_mem, m_size) Memory::realloc_static(m_mem, m_size)
+#define memfree(m_mem) Memory::free_static(m_mem)
+
+#define memnew(m_class) (new m_class)
+
+template <class T>
+void memdelete(T *p_class) {
+	delete p_class;
+}
+
+#define memnew_arr(m_class, m_count) (new m_class[m_count])
+
+template <class T>
+void memdelete_arr(T *p_class) {
+	delete[] p_class;
+}
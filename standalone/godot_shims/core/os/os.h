@@ -0,0 +1,15 @@
+#pragma once
+
+// Thin shim of the Godot `OS`, used by the standalone build.
+
+#include "core/string/ustring.h"
+#include "core/typedefs.h"
+#include <vector>
+
+class OS {
+public:
+	static OS *get_singleton();
+
+	uint64_t get_ticks_usec() const;
+	uint64_t get_ticks_msec() const { return get_ticks_usec() / 1000; }
+};
@@ -0,0 +1,7 @@
+#pragma once
+
+// Thin shim of the Godot `print_string.h`, used by the standalone build.
+
+#include "core/string/ustring.h"
+
+void print_line(const String &p_string);
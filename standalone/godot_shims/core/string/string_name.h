@@ -0,0 +1,39 @@
+#pragma once
+
+// Thin shim of the Godot `StringName`, used by the standalone build.
+// Unlike Godot, the name is not interned.
+
+#include "core/string/ustring.h"
+#include <functional>
+
+class StringName {
+	String name;
+
+public:
+	StringName() = default;
+	StringName(const char *p_name) :
+			name(p_name) {}
+	StringName(const String &p_name) :
+			name(p_name) {}
+
+	operator String() const { return name; }
+	bool is_empty() const { return name.is_empty(); }
+
+	bool operator==(const StringName &p_other) const { return name == p_other.name; }
+	bool operator!=(const StringName &p_other) const { return name != p_other.name; }
+	bool operator==(const String &p_other) const { return name == p_other; }
+	bool operator==(const char *p_other) const { return name == p_other; }
+	bool operator<(const StringName &p_other) const { return name < p_other.name; }
+
+	uint32_t hash() const { return uint32_t(std::hash<std::string>()(name.std_str())); }
+};
+
+inline String operator+(const String &p_a, const StringName &p_b) {
+	return p_a + String(p_b);
+}
+
+inline String operator+(const char *p_a, const StringName &p_b) {
+	return String(p_a) + String(p_b);
+}
+
+#define SNAME(m_arg) StringName(m_arg)
@@ -0,0 +1,77 @@
+#pragma once
+
+// Thin shim of the Godot `String`, used by the standalone build.
+// It's a simple UTF-8 string backed by `std::string`.
+
+#include "core/typedefs.h"
+#include <cstdint>
+#include <string>
+
+class CharString {
+	std::string data;
+
+public:
+	CharString() = default;
+	CharString(const std::string &p_data) :
+			data(p_data) {}
+
+	const char *get_data() const { return data.c_str(); }
+	const char *ptr() const { return data.c_str(); }
+	char *ptrw() { return data.data(); }
+	void resize(int p_size) { data.resize(p_size > 0 ? p_size : 0); }
+	int length() const { return int(data.size()); }
+	int size() const { return int(data.size()) + 1; }
+	operator const char *() const { return data.c_str(); }
+};
+
+class String {
+	std::string data;
+
+public:
+	String() = default;
+	String(const char *p_str) :
+			data(p_str ? p_str : "") {}
+	String(const std::string &p_str) :
+			data(p_str) {}
+
+	CharString utf8() const { return CharString(data); }
+	CharString ascii() const { return CharString(data); }
+	const std::string &std_str() const { return data; }
+
+	int length() const { return int(data.size()); }
+	int size() const { return int(data.size()) + 1; }
+	bool is_empty() const { return data.empty(); }
+
+	String operator+(const String &p_other) const { return String(data + p_other.data); }
+	String operator+(const char *p_other) const { return String(data + p_other); }
+	String operator+(char32_t p_char) const { return String(data + char(p_char)); }
+	String &operator+=(const String &p_other) {
+		data += p_other.data;
+		return *this;
+	}
+	String &operator+=(const char *p_other) {
+		data += p_other;
+		return *this;
+	}
+
+	bool operator==(const String &p_other) const { return data == p_other.data; }
+	bool operator!=(const String &p_other) const { return data != p_other.data; }
+	bool operator==(const char *p_other) const { return data == p_other; }
+	bool operator!=(const char *p_other) const { return data != p_other; }
+	bool operator<(const String &p_other) const { return data < p_other.data; }
+
+	static String num(double p_num, int p_decimals = -1);
+	static String num_int64(int64_t p_num) { return String(std::to_string(p_num)); }
+	static String num_uint64(uint64_t p_num) { return String(std::to_string(p_num)); }
+};
+
+inline String operator+(const char *p_a, const String &p_b) {
+	return String(p_a) + p_b;
+}
+
+inline bool operator==(const char *p_a, const String &p_b) {
+	return p_b == p_a;
+}
+
+String itos(int64_t p_val);
+String rtos(double p_val);
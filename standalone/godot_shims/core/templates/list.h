@@ -0,0 +1,32 @@
+#pragma once
+
+// Thin shim of the Godot `List`, used by the standalone build.
+
+#include "core/error/error_macros.h"
+#include "core/typedefs.h"
+#include <list>
+
+template <class T>
+class List {
+	std::list<T> data;
+
+public:
+	class Element {
+		friend class List;
+		typename std::list<T>::iterator it;
+		List *owner = nullptr;
+
+	public:
+		T &get() { return *it; }
+		const T &get() const { return *it; }
+	};
+
+	void push_back(const T &p_value) { data.push_back(p_value); }
+	void clear() { data.clear(); }
+	int size() const { return int(data.size()); }
+
+	typename std::list<T>::iterator begin() { return data.begin(); }
+	typename std::list<T>::iterator end() { return data.end(); }
+	typename std::list<T>::const_iterator begin() const { return data.begin(); }
+	typename std::list<T>::const_iterator end() const { return data.end(); }
+};
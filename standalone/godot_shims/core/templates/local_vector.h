@@ -0,0 +1,79 @@
+#pragma once
+
+// Thin shim of the Godot `LocalVector`, used by the standalone build.
+
+#include "core/error/error_macros.h"
+#include "core/typedefs.h"
+#include <algorithm>
+#include <initializer_list>
+#include <vector>
+
+template <class T, class U = uint32_t>
+class LocalVector {
+	std::vector<T> data;
+
+public:
+	LocalVector() = default;
+	LocalVector(std::initializer_list<T> p_init) :
+			data(p_init) {}
+
+	U size() const { return U(data.size()); }
+	bool is_empty() const { return data.empty(); }
+	void clear() { data.clear(); }
+	void reset() {
+		data.clear();
+		data.shrink_to_fit();
+	}
+	void resize(U p_size) { data.resize(p_size); }
+	void reserve(U p_size) { data.reserve(p_size); }
+
+	T *ptr() { return data.data(); }
+	const T *ptr() const { return data.data(); }
+
+	void push_back(const T &p_elem) { data.push_back(p_elem); }
+	void push_back(T &&p_elem) { data.push_back(std::move(p_elem)); }
+
+	void remove_at(U p_index) { data.erase(data.begin() + p_index); }
+	void remove_at_unordered(U p_index) {
+		data[p_index] = std::move(data.back());
+		data.pop_back();
+	}
+
+	bool erase(const T &p_val) {
+		const int64_t idx = find(p_val);
+		if (idx >= 0) {
+			remove_at(U(idx));
+			return true;
+		}
+		return false;
+	}
+
+	void insert(U p_pos, const T &p_val) { data.insert(data.begin() + p_pos, p_val); }
+	void ordered_insert(const T &p_val) {
+		data.insert(std::upper_bound(data.begin(), data.end(), p_val), p_val);
+	}
+
+	int64_t find(const T &p_val, U p_from = 0) const {
+		for (U i = p_from; i < size(); i++) {
+			// Like Godot, the element constness is not propagated.
+			if (const_cast<T &>(data[i]) == p_val) {
+				return int64_t(i);
+			}
+		}
+		return -1;
+	}
+	bool has(const T &p_val) const { return find(p_val) != -1; }
+
+	void invert() { std::reverse(data.begin(), data.end()); }
+	void sort() { std::sort(data.begin(), data.end()); }
+	template <class C>
+	void sort_custom() { std::sort(data.begin(), data.end(), C()); }
+
+	T &operator[](U p_index) { return data[p_index]; }
+	const T &operator[](U p_index) const { return data[p_index]; }
+
+	typename std::vector<T>::iterator begin() { return data.begin(); }
+	typename std::vector<T>::iterator end() { return data.end(); }
+	typename std::vector<T>::const_iterator begin() const { return data.begin(); }
+	typename std::vector<T>::const_iterator end() const { return data.end(); }
+};
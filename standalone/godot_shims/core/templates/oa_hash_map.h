@@ -0,0 +1,45 @@
+#pragma once
+
+// Thin shim of the Godot `OAHashMap`, used by the standalone build.
+
+#include "core/error/error_macros.h"
+#include "core/typedefs.h"
+#include <unordered_map>
+
+template <class K>
+struct OAHashMapShimHasher {
+	size_t operator()(const K &p_key) const { return std::hash<K>()(p_key); }
+};
+
+template <class K, class V, class H = OAHashMapShimHasher<K>>
+class OAHashMap {
+	std::unordered_map<K, V, H> data;
+
+public:
+	void insert(const K &p_key, const V &p_value) { data[p_key] = p_value; }
+	void set(const K &p_key, const V &p_value) { data[p_key] = p_value; }
+	bool has(const K &p_key) const { return data.find(p_key) != data.end(); }
+	void remove(const K &p_key) { data.erase(p_key); }
+	void clear() { data.clear(); }
+	uint32_t get_num_elements() const { return uint32_t(data.size()); }
+	bool is_empty() const { return data.empty(); }
+
+	bool lookup(const K &p_key, V &r_data) const {
+		auto it = data.find(p_key);
+		if (it == data.end()) {
+			return false;
+		}
+		r_data = it->second;
+		return true;
+	}
+
+	V *lookup_ptr(const K &p_key) {
+		auto it = data.find(p_key);
+		return it == data.end() ? nullptr : &it->second;
+	}
+
+	const V *lookup_ptr(const K &p_key) const {
+		auto it = data.find(p_key);
+		return it == data.end() ? nullptr : &it->second;
+	}
+};
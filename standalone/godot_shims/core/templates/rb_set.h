@@ -0,0 +1,78 @@
+#pragma once
+
+// Thin shim of the Godot `RBSet`, used by the standalone build.
+
+#include "core/error/error_macros.h"
+#include "core/typedefs.h"
+#include <set>
+
+template <class T>
+class RBSet {
+public:
+	class Element;
+
+private:
+	struct ElementLess {
+		bool operator()(const Element &p_a, const Element &p_b) const { return p_a.value < p_b.value; }
+	};
+	typedef std::set<Element, ElementLess> Storage;
+	Storage data;
+
+public:
+	class Element {
+		friend class RBSet;
+		T value;
+		const Storage *owner = nullptr;
+
+	public:
+		Element(const T &p_value, const Storage *p_owner) :
+				value(p_value), owner(p_owner) {}
+
+		const T &get() const { return value; }
+		const Element *next() const {
+			typename Storage::const_iterator it = owner->upper_bound(*this);
+			return it == owner->end() ? nullptr : &(*it);
+		}
+	};
+
+	class ConstIterator {
+		typename Storage::const_iterator it;
+
+	public:
+		ConstIterator(typename Storage::const_iterator p_it) :
+				it(p_it) {}
+		const T &operator*() const { return it->get(); }
+		ConstIterator &operator++() {
+			++it;
+			return *this;
+		}
+		bool operator!=(const ConstIterator &p_other) const { return it != p_other.it; }
+		bool operator==(const ConstIterator &p_other) const { return it == p_other.it; }
+	};
+
+	RBSet() = default;
+	RBSet(const RBSet &p_other) { *this = p_other; }
+	RBSet &operator=(const RBSet &p_other) {
+		data.clear();
+		for (const Element &e : p_other.data) {
+			data.insert(Element(e.value, &data));
+		}
+		return *this;
+	}
+
+	const Element *insert(const T &p_value) { return &(*data.insert(Element(p_value, &data)).first); }
+	bool has(const T &p_value) const { return data.find(Element(p_value, &data)) != data.end(); }
+	const Element *find(const T &p_value) const {
+		typename Storage::const_iterator it = data.find(Element(p_value, &data));
+		return it == data.end() ? nullptr : &(*it);
+	}
+	bool erase(const T &p_value) { return data.erase(Element(p_value, &data)) > 0; }
+	void clear() { data.clear(); }
+	int size() const { return int(data.size()); }
+	bool is_empty() const { return data.empty(); }
+
+	const Element *front() const { return data.empty() ? nullptr : &(*data.begin()); }
+
+	ConstIterator begin() const { return ConstIterator(data.begin()); }
+	ConstIterator end() const { return ConstIterator(data.end()); }
+};
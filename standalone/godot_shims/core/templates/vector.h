@@ -0,0 +1,87 @@
+#pragma once
+
+// Thin shim of the Godot `Vector`, used by the standalone build.
+// Unlike Godot, this is not copy on write.
+
+#include "core/error/error_macros.h"
+#include "core/typedefs.h"
+#include <algorithm>
+#include <initializer_list>
+#include <vector>
+
+template <class T>
+class Vector {
+	std::vector<T> data;
+
+public:
+	class Write {
+		friend class Vector;
+		Vector *owner = nullptr;
+
+	public:
+		T &operator[](int p_index) { return owner->data[p_index]; }
+	};
+	friend class Write;
+
+	Write write;
+
+	Vector() { write.owner = this; }
+	Vector(std::initializer_list<T> p_init) :
+			data(p_init) { write.owner = this; }
+	Vector(const Vector &p_from) :
+			data(p_from.data) { write.owner = this; }
+	Vector(Vector &&p_from) :
+			data(std::move(p_from.data)) { write.owner = this; }
+
+	Vector &operator=(const Vector &p_from) {
+		data = p_from.data;
+		return *this;
+	}
+	Vector &operator=(Vector &&p_from) {
+		data = std::move(p_from.data);
+		return *this;
+	}
+
+	int size() const { return int(data.size()); }
+	bool is_empty() const { return data.empty(); }
+	void clear() { data.clear(); }
+	int resize(int p_size) {
+		data.resize(p_size);
+		return 0;
+	}
+
+	const T *ptr() const { return data.data(); }
+	T *ptrw() { return data.data(); }
+
+	bool push_back(const T &p_elem) {
+		data.push_back(p_elem);
+		return false;
+	}
+	void append_array(const Vector &p_other) { data.insert(data.end(), p_other.data.begin(), p_other.data.end()); }
+	void remove_at(int p_index) { data.erase(data.begin() + p_index); }
+	int insert(int p_pos, const T &p_val) {
+		data.insert(data.begin() + p_pos, p_val);
+		return 0;
+	}
+
+	void set(int p_index, const T &p_elem) { data[p_index] = p_elem; }
+	const T &get(int p_index) const { return data[p_index]; }
+	const T &operator[](int p_index) const { return data[p_index]; }
+
+	int find(const T &p_val, int p_from = 0) const {
+		for (int i = p_from; i < size(); i++) {
+			if (data[i] == p_val) {
+				return i;
+			}
+		}
+		return -1;
+	}
+	bool has(const T &p_val) const { return find(p_val) != -1; }
+	void sort() { std::sort(data.begin(), data.end()); }
+
+	bool operator==(const Vector &p_other) const { return data == p_other.data; }
+	bool operator!=(const Vector &p_other) const { return data != p_other.data; }
+
+	typename std::vector<T>::const_iterator begin() const { return data.begin(); }
+	typename std::vector<T>::const_iterator end() const { return data.end(); }
+};
@@ -0,0 +1,49 @@
+#pragma once
+
+// Thin shim of the Godot `Callable`, used by the standalone build.
+
+#include "core/string/string_name.h"
+#include "core/variant/variant.h"
+#include <functional>
+
+class Callable {
+public:
+	struct CallError {
+		enum Error {
+			CALL_OK,
+			CALL_ERROR_INVALID_METHOD,
+			CALL_ERROR_INVALID_ARGUMENT,
+			CALL_ERROR_TOO_MANY_ARGUMENTS,
+			CALL_ERROR_TOO_FEW_ARGUMENTS,
+			CALL_ERROR_INSTANCE_IS_NULL,
+			CALL_ERROR_METHOD_NOT_CONST,
+		};
+		Error error = Error::CALL_OK;
+		int argument = 0;
+		int expected = 0;
+	};
+
+	typedef std::function<void(const Variant **p_arguments, int p_argcount, Variant &r_return_value, CallError &r_call_error)> Function;
+
+private:
+	StringName method;
+	Function function;
+
+public:
+	Callable() = default;
+	Callable(const StringName &p_method, Function p_function) :
+			method(p_method), function(p_function) {}
+
+	bool is_valid() const { return bool(function); }
+	bool is_null() const { return !function; }
+	StringName get_method() const { return method; }
+
+	void callp(const Variant **p_arguments, int p_argcount, Variant &r_return_value, CallError &r_call_error) const {
+		if (!function) {
+			r_call_error.error = CallError::CALL_ERROR_INSTANCE_IS_NULL;
+			return;
+		}
+		r_call_error.error = CallError::CALL_OK;
+		function(p_arguments, p_argcount, r_return_value, r_call_error);
+	}
+};
@@ -0,0 +1,50 @@
+#pragma once
+
+// Thin shim of the Godot `Dictionary`, used by the standalone build.
+// It's a simple ordered list of key value pairs.
+
+#include "core/templates/vector.h"
+#include "core/variant/variant.h"
+
+class Dictionary {
+	Vector<Variant> keys;
+	Vector<Variant> values;
+
+public:
+	int size() const { return keys.size(); }
+	bool is_empty() const { return keys.size() == 0; }
+	void clear() {
+		keys.clear();
+		values.clear();
+	}
+
+	bool has(const Variant &p_key) const { return keys.find(p_key) != -1; }
+
+	Variant &operator[](const Variant &p_key) {
+		int index = keys.find(p_key);
+		if (index == -1) {
+			index = keys.size();
+			keys.push_back(p_key);
+			values.push_back(Variant());
+		}
+		return values.write[index];
+	}
+
+	Variant get(const Variant &p_key, const Variant &p_default) const {
+		const int index = keys.find(p_key);
+		return index == -1 ? p_default : values[index];
+	}
+
+	bool erase(const Variant &p_key) {
+		const int index = keys.find(p_key);
+		if (index == -1) {
+			return false;
+		}
+		keys.remove_at(index);
+		values.remove_at(index);
+		return true;
+	}
+
+	Vector<Variant> get_keys() const { return keys; }
+	Vector<Variant> get_values() const { return values; }
+};
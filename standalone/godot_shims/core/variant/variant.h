@@ -0,0 +1,166 @@
+#pragma once
+
+// Thin shim of the Godot `Variant`, used by the standalone build.
+// It supports only the types used by the synchronization core and its tests.
+
+#include "core/error/error_list.h"
+#include "core/error/error_macros.h"
+#include "core/math/vector2.h"
+#include "core/math/vector3.h"
+#include "core/string/print_string.h"
+#include "core/string/string_name.h"
+#include "core/string/ustring.h"
+#include "core/templates/vector.h"
+#include "core/typedefs.h"
+#include <memory>
+#include <vector>
+
+class Object;
+
+class Variant {
+public:
+	// Same order of the Godot `Variant::Type`, so the values are compatible.
+	enum Type {
+		NIL,
+		BOOL,
+		INT,
+		FLOAT,
+		STRING,
+		VECTOR2,
+		VECTOR2I,
+		RECT2,
+		RECT2I,
+		VECTOR3,
+		VECTOR3I,
+		TRANSFORM2D,
+		VECTOR4,
+		VECTOR4I,
+		PLANE,
+		QUATERNION,
+		AABB,
+		BASIS,
+		TRANSFORM3D,
+		PROJECTION,
+		COLOR,
+		STRING_NAME,
+		NODE_PATH,
+		RID,
+		OBJECT,
+		CALLABLE,
+		SIGNAL,
+		DICTIONARY,
+		ARRAY,
+		PACKED_BYTE_ARRAY,
+		PACKED_INT32_ARRAY,
+		PACKED_INT64_ARRAY,
+		PACKED_FLOAT32_ARRAY,
+		PACKED_FLOAT64_ARRAY,
+		PACKED_STRING_ARRAY,
+		PACKED_VECTOR2_ARRAY,
+		PACKED_VECTOR3_ARRAY,
+		PACKED_COLOR_ARRAY,
+		VARIANT_MAX
+	};
+
+private:
+	Type type = NIL;
+	union {
+		bool _bool;
+		int64_t _int;
+		double _float;
+		real_t _vector[3];
+		Object *_object;
+	} _data = {};
+	String _string;
+	std::shared_ptr<Vector<Variant>> _array;
+	std::shared_ptr<Vector<uint8_t>> _bytes;
+
+public:
+	Variant() = default;
+	Variant(bool p_bool) :
+			type(BOOL) { _data._bool = p_bool; }
+	Variant(int p_int) :
+			type(INT) { _data._int = p_int; }
+	Variant(unsigned int p_int) :
+			type(INT) { _data._int = p_int; }
+	Variant(long p_int) :
+			type(INT) { _data._int = p_int; }
+	Variant(unsigned long p_int) :
+			type(INT) { _data._int = int64_t(p_int); }
+	Variant(long long p_int) :
+			type(INT) { _data._int = p_int; }
+	Variant(unsigned long long p_int) :
+			type(INT) { _data._int = int64_t(p_int); }
+	Variant(float p_float) :
+			type(FLOAT) { _data._float = p_float; }
+	Variant(double p_float) :
+			type(FLOAT) { _data._float = p_float; }
+	Variant(const char *p_string) :
+			type(STRING), _string(p_string) {}
+	Variant(const String &p_string) :
+			type(STRING), _string(p_string) {}
+	Variant(const StringName &p_string) :
+			type(STRING_NAME), _string(p_string) {}
+	Variant(const Vector2 &p_vector);
+	Variant(const Vector3 &p_vector);
+	Variant(const Object *p_object) :
+			type(OBJECT) { _data._object = const_cast<Object *>(p_object); }
+	Variant(const Vector<Variant> &p_array) :
+			type(ARRAY), _array(std::make_shared<Vector<Variant>>(p_array)) {}
+	Variant(const Vector<uint8_t> &p_bytes) :
+			type(PACKED_BYTE_ARRAY), _bytes(std::make_shared<Vector<uint8_t>>(p_bytes)) {}
+
+	Type get_type() const { return type; }
+	static String get_type_name(Type p_type);
+	bool is_null() const { return type == NIL; }
+
+	operator bool() const;
+	operator int() const { return int(to_int()); }
+	operator unsigned int() const { return (unsigned int)(to_int()); }
+	operator long() const { return long(to_int()); }
+	operator unsigned long() const { return (unsigned long)(to_int()); }
+	operator long long() const { return (long long)(to_int()); }
+	operator unsigned long long() const { return (unsigned long long)(to_int()); }
+	operator float() const { return float(to_float()); }
+	operator double() const { return to_float(); }
+	operator String() const;
+	operator StringName() const { return StringName(operator String()); }
+	operator Vector2() const;
+	operator Vector3() const;
+	operator Object *() const { return type == OBJECT ? _data._object : nullptr; }
+	operator Vector<Variant>() const { return type == ARRAY ? *_array : Vector<Variant>(); }
+	operator Vector<uint8_t>() const { return type == PACKED_BYTE_ARRAY ? *_bytes : Vector<uint8_t>(); }
+
+	int64_t to_int() const;
+	double to_float() const;
+
+	bool operator==(const Variant &p_other) const;
+	bool operator!=(const Variant &p_other) const { return !(*this == p_other); }
+
+	Variant duplicate(bool p_deep = false) const;
+
+	/// As in Godot: the numeric types are interpolated, the others switch
+	/// from `a` to `b` at half way.
+	static void interpolate(const Variant &a, const Variant &b, float c, Variant &r_dst);
+
+	String stringify() const;
+};
+
+namespace ns_shim {
+template <class T>
+struct VariantCaster {
+	static T cast(const Variant &p_variant) { return p_variant; }
+};
+
+template <class T>
+struct VariantCaster<T *> {
+	static T *cast(const Variant &p_variant) { return dynamic_cast<T *>(p_variant.operator Object *()); }
+};
+} //namespace ns_shim
+
+// As in Godot, these are always available to the `Variant` users.
+#include "core/templates/list.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/rb_set.h"
+#include "core/variant/callable.h"
+#include "core/variant/dictionary.h"
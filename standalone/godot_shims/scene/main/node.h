@@ -0,0 +1,18 @@
+#pragma once
+
+// Thin shim of the Godot `Node`, used by the standalone build.
+
+#include "core/object/class_db.h"
+#include "core/object/object.h"
+
+class SceneTree;
+
+class Node : public Object {
+	GDCLASS(Node, Object);
+
+public:
+	String name;
+
+	String get_name() const { return name; }
+	void set_name(const String &p_name) { name = p_name; }
+};
@@ -0,0 +1,512 @@
+// Implementation of the Godot shims, used by the standalone build.
+
+#include "core/config/engine.h"
+#include "core/config/project_settings.h"
+#include "core/io/marshalls.h"
+#include "core/math/math_funcs.h"
+#include "core/object/object.h"
+#include "core/os/os.h"
+#include "core/string/print_string.h"
+#include "core/variant/variant.h"
+#include <chrono>
+#include <cstdio>
+#include <sstream>
+
+bool ns_shim::error_print_enabled = true;
+
+String itos(int64_t p_val) {
+	return String(std::to_string(p_val));
+}
+
+String rtos(double p_val) {
+	return String::num(p_val);
+}
+
+String String::num(double p_num, int p_decimals) {
+	std::ostringstream stream;
+	if (p_decimals >= 0) {
+		stream.setf(std::ios::fixed);
+		stream.precision(p_decimals);
+	} else {
+		stream.precision(14);
+	}
+	stream << p_num;
+	return String(stream.str());
+}
+
+void print_line(const String &p_string) {
+	printf("%s\n", p_string.utf8().get_data());
+	fflush(stdout);
+}
+
+/* ProjectSettings */
+
+ProjectSettings *ProjectSettings::get_singleton() {
+	static ProjectSettings singleton;
+	return &singleton;
+}
+
+bool ProjectSettings::has_setting(const String &p_name) const {
+	return settings.find(p_name.std_str()) != settings.end();
+}
+
+void ProjectSettings::set_setting(const String &p_name, const Variant &p_value) {
+	settings[p_name.std_str()] = p_value;
+}
+
+Variant ProjectSettings::get_setting(const String &p_name, const Variant &p_default_value) const {
+	auto it = settings.find(p_name.std_str());
+	return it == settings.end() ? p_default_value : it->second;
+}
+
+Variant _GLOBAL_DEF(const String &p_var, const Variant &p_default) {
+	if (!ProjectSettings::get_singleton()->has_setting(p_var)) {
+		ProjectSettings::get_singleton()->set_setting(p_var, p_default);
+	}
+	return ProjectSettings::get_singleton()->get_setting(p_var);
+}
+
+/* Engine */
+
+Engine *Engine::get_singleton() {
+	static Engine singleton;
+	return &singleton;
+}
+
+/* OS */
+
+OS *OS::get_singleton() {
+	static OS singleton;
+	return &singleton;
+}
+
+uint64_t OS::get_ticks_usec() const {
+	static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	return uint64_t(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+}
+
+/* Variant */
+
+Variant::Variant(const Vector2 &p_vector) :
+		type(VECTOR2) {
+	_data._vector[0] = p_vector.x;
+	_data._vector[1] = p_vector.y;
+}
+
+Variant::Variant(const Vector3 &p_vector) :
+		type(VECTOR3) {
+	_data._vector[0] = p_vector.x;
+	_data._vector[1] = p_vector.y;
+	_data._vector[2] = p_vector.z;
+}
+
+String Variant::get_type_name(Type p_type) {
+	switch (p_type) {
+		case NIL:
+			return "Nil";
+		case BOOL:
+			return "bool";
+		case INT:
+			return "int";
+		case FLOAT:
+			return "float";
+		case STRING:
+			return "String";
+		case VECTOR2:
+			return "Vector2";
+		case VECTOR3:
+			return "Vector3";
+		case STRING_NAME:
+			return "StringName";
+		case OBJECT:
+			return "Object";
+		case ARRAY:
+			return "Array";
+		case PACKED_BYTE_ARRAY:
+			return "PackedByteArray";
+		default:
+			return "Unsupported";
+	}
+}
+
+Variant::operator bool() const {
+	switch (type) {
+		case BOOL:
+			return _data._bool;
+		case INT:
+			return _data._int != 0;
+		case FLOAT:
+			return _data._float != 0.0;
+		case OBJECT:
+			return _data._object != nullptr;
+		default:
+			return false;
+	}
+}
+
+int64_t Variant::to_int() const {
+	switch (type) {
+		case BOOL:
+			return _data._bool ? 1 : 0;
+		case INT:
+			return _data._int;
+		case FLOAT:
+			return int64_t(_data._float);
+		default:
+			return 0;
+	}
+}
+
+double Variant::to_float() const {
+	switch (type) {
+		case BOOL:
+			return _data._bool ? 1.0 : 0.0;
+		case INT:
+			return double(_data._int);
+		case FLOAT:
+			return _data._float;
+		default:
+			return 0.0;
+	}
+}
+
+void Variant::interpolate(const Variant &a, const Variant &b, float c, Variant &r_dst) {
+	if (a.type != b.type) {
+		r_dst = c < 0.5 ? a : b;
+		return;
+	}
+
+	switch (a.type) {
+		case INT:
+			r_dst = int64_t(Math::lerp(double(a._data._int), double(b._data._int), c));
+			return;
+		case FLOAT:
+			r_dst = Math::lerp(a._data._float, b._data._float, c);
+			return;
+		case VECTOR2:
+			r_dst = Vector2(
+					Math::lerp(a._data._vector[0], b._data._vector[0], c),
+					Math::lerp(a._data._vector[1], b._data._vector[1], c));
+			return;
+		case VECTOR3:
+			r_dst = Vector3(
+					Math::lerp(a._data._vector[0], b._data._vector[0], c),
+					Math::lerp(a._data._vector[1], b._data._vector[1], c),
+					Math::lerp(a._data._vector[2], b._data._vector[2], c));
+			return;
+		default:
+			r_dst = c < 0.5 ? a : b;
+	}
+}
+
+Variant::operator String() const {
+	return stringify();
+}
+
+Variant::operator Vector2() const {
+	if (type == VECTOR2 || type == VECTOR3) {
+		return Vector2(_data._vector[0], _data._vector[1]);
+	}
+	return Vector2();
+}
+
+Variant::operator Vector3() const {
+	if (type == VECTOR3) {
+		return Vector3(_data._vector[0], _data._vector[1], _data._vector[2]);
+	} else if (type == VECTOR2) {
+		return Vector3(_data._vector[0], _data._vector[1], 0.0);
+	}
+	return Vector3();
+}
+
+bool Variant::operator==(const Variant &p_other) const {
+	if (type != p_other.type) {
+		if ((type == INT || type == FLOAT) && (p_other.type == INT || p_other.type == FLOAT)) {
+			return to_float() == p_other.to_float();
+		}
+		if ((type == STRING || type == STRING_NAME) && (p_other.type == STRING || p_other.type == STRING_NAME)) {
+			return _string == p_other._string;
+		}
+		return false;
+	}
+
+	switch (type) {
+		case NIL:
+			return true;
+		case BOOL:
+			return _data._bool == p_other._data._bool;
+		case INT:
+			return _data._int == p_other._data._int;
+		case FLOAT:
+			return _data._float == p_other._data._float;
+		case STRING:
+		case STRING_NAME:
+			return _string == p_other._string;
+		case VECTOR2:
+			return _data._vector[0] == p_other._data._vector[0] && _data._vector[1] == p_other._data._vector[1];
+		case VECTOR3:
+			return _data._vector[0] == p_other._data._vector[0] && _data._vector[1] == p_other._data._vector[1] && _data._vector[2] == p_other._data._vector[2];
+		case OBJECT:
+			return _data._object == p_other._data._object;
+		case ARRAY: {
+			if (_array->size() != p_other._array->size()) {
+				return false;
+			}
+			for (int i = 0; i < _array->size(); i++) {
+				if ((*_array)[i] != (*p_other._array)[i]) {
+					return false;
+				}
+			}
+			return true;
+		}
+		case PACKED_BYTE_ARRAY:
+			return _bytes->size() == p_other._bytes->size() && memcmp(_bytes->ptr(), p_other._bytes->ptr(), _bytes->size()) == 0;
+		default:
+			return false;
+	}
+}
+
+Variant Variant::duplicate(bool p_deep) const {
+	Variant v = *this;
+	if (type == ARRAY) {
+		v._array = std::make_shared<Vector<Variant>>();
+		for (int i = 0; i < _array->size(); i++) {
+			v._array->push_back(p_deep ? (*_array)[i].duplicate(true) : (*_array)[i]);
+		}
+	} else if (type == PACKED_BYTE_ARRAY) {
+		v._bytes = std::make_shared<Vector<uint8_t>>(*_bytes);
+	}
+	return v;
+}
+
+String Variant::stringify() const {
+	switch (type) {
+		case NIL:
+			return "<null>";
+		case BOOL:
+			return _data._bool ? "true" : "false";
+		case INT:
+			return itos(_data._int);
+		case FLOAT:
+			return rtos(_data._float);
+		case STRING:
+		case STRING_NAME:
+			return _string;
+		case VECTOR2:
+			return "(" + rtos(_data._vector[0]) + ", " + rtos(_data._vector[1]) + ")";
+		case VECTOR3:
+			return "(" + rtos(_data._vector[0]) + ", " + rtos(_data._vector[1]) + ", " + rtos(_data._vector[2]) + ")";
+		case OBJECT:
+			return _data._object ? String("<") + _data._object->get_class() + ">" : String("<null>");
+		case ARRAY: {
+			String s = "[";
+			for (int i = 0; i < _array->size(); i++) {
+				if (i > 0) {
+					s += ", ";
+				}
+				s += (*_array)[i].stringify();
+			}
+			return s + "]";
+		}
+		case PACKED_BYTE_ARRAY:
+			return "PackedByteArray(" + itos(_bytes->size()) + ")";
+		default:
+			return "<" + get_type_name(type) + ">";
+	}
+}
+
+/* Marshalls */
+
+#define ENCODE_PAD(m_len) (((m_len) + 3) & ~3)
+
+Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bool p_full_objects, int p_depth) {
+	ERR_FAIL_COND_V_MSG(p_depth > 256, ERR_OUT_OF_MEMORY, "Potential infinite recursion detected.");
+
+	r_len = 0;
+	if (r_buffer) {
+		encode_uint32(p_variant.get_type(), r_buffer);
+		r_buffer += 4;
+	}
+	r_len += 4;
+
+	switch (p_variant.get_type()) {
+		case Variant::NIL:
+			break;
+		case Variant::BOOL:
+			if (r_buffer) {
+				encode_uint32(bool(p_variant) ? 1 : 0, r_buffer);
+			}
+			r_len += 4;
+			break;
+		case Variant::INT:
+			if (r_buffer) {
+				encode_uint64(uint64_t(p_variant.to_int()), r_buffer);
+			}
+			r_len += 8;
+			break;
+		case Variant::FLOAT: {
+			if (r_buffer) {
+				const double d = p_variant.to_float();
+				uint64_t u;
+				memcpy(&u, &d, sizeof(double));
+				encode_uint64(u, r_buffer);
+			}
+			r_len += 8;
+		} break;
+		case Variant::STRING:
+		case Variant::STRING_NAME: {
+			const CharString utf8 = p_variant.stringify().utf8();
+			if (r_buffer) {
+				encode_uint32(utf8.length(), r_buffer);
+				memcpy(r_buffer + 4, utf8.get_data(), utf8.length());
+			}
+			r_len += 4 + ENCODE_PAD(utf8.length());
+		} break;
+		case Variant::VECTOR2:
+		case Variant::VECTOR3: {
+			const int count = p_variant.get_type() == Variant::VECTOR2 ? 2 : 3;
+			if (r_buffer) {
+				const Vector3 v = p_variant;
+				const float values[3] = { float(v.x), float(v.y), float(v.z) };
+				for (int i = 0; i < count; i++) {
+					uint32_t u;
+					memcpy(&u, &values[i], sizeof(float));
+					encode_uint32(u, r_buffer + (i * 4));
+				}
+			}
+			r_len += count * 4;
+		} break;
+		case Variant::ARRAY: {
+			const Vector<Variant> array = p_variant;
+			if (r_buffer) {
+				encode_uint32(array.size(), r_buffer);
+				r_buffer += 4;
+			}
+			r_len += 4;
+			for (int i = 0; i < array.size(); i++) {
+				int len;
+				const Error err = encode_variant(array[i], r_buffer, len, p_full_objects, p_depth + 1);
+				ERR_FAIL_COND_V(err != OK, err);
+				if (r_buffer) {
+					r_buffer += len;
+				}
+				r_len += len;
+			}
+		} break;
+		case Variant::PACKED_BYTE_ARRAY: {
+			const Vector<uint8_t> bytes = p_variant;
+			if (r_buffer) {
+				encode_uint32(bytes.size(), r_buffer);
+				if (bytes.size() > 0) {
+					memcpy(r_buffer + 4, bytes.ptr(), bytes.size());
+				}
+			}
+			r_len += 4 + ENCODE_PAD(bytes.size());
+		} break;
+		default:
+			ERR_FAIL_V_MSG(ERR_UNAVAILABLE, "The standalone build can't encode the Variant type: " + Variant::get_type_name(p_variant.get_type()));
+	}
+
+	return OK;
+}
+
+Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int *r_len, bool p_allow_objects, int p_depth) {
+	ERR_FAIL_COND_V_MSG(p_depth > 256, ERR_OUT_OF_MEMORY, "Potential infinite recursion detected.");
+	ERR_FAIL_COND_V(p_len < 4, ERR_INVALID_DATA);
+
+	const uint32_t type = decode_uint32(p_buffer);
+	p_buffer += 4;
+	p_len -= 4;
+	int len = 4;
+
+	switch (type) {
+		case Variant::NIL:
+			r_variant = Variant();
+			break;
+		case Variant::BOOL:
+			ERR_FAIL_COND_V(p_len < 4, ERR_INVALID_DATA);
+			r_variant = decode_uint32(p_buffer) != 0;
+			len += 4;
+			break;
+		case Variant::INT:
+			ERR_FAIL_COND_V(p_len < 8, ERR_INVALID_DATA);
+			r_variant = int64_t(decode_uint64(p_buffer));
+			len += 8;
+			break;
+		case Variant::FLOAT: {
+			ERR_FAIL_COND_V(p_len < 8, ERR_INVALID_DATA);
+			const uint64_t u = decode_uint64(p_buffer);
+			double d;
+			memcpy(&d, &u, sizeof(double));
+			r_variant = d;
+			len += 8;
+		} break;
+		case Variant::STRING:
+		case Variant::STRING_NAME: {
+			ERR_FAIL_COND_V(p_len < 4, ERR_INVALID_DATA);
+			const int str_len = int(decode_uint32(p_buffer));
+			ERR_FAIL_COND_V(str_len < 0 || ENCODE_PAD(str_len) > p_len - 4, ERR_INVALID_DATA);
+			const String s(std::string(reinterpret_cast<const char *>(p_buffer + 4), str_len));
+			if (type == Variant::STRING) {
+				r_variant = s;
+			} else {
+				r_variant = StringName(s);
+			}
+			len += 4 + ENCODE_PAD(str_len);
+		} break;
+		case Variant::VECTOR2:
+		case Variant::VECTOR3: {
+			const int count = type == Variant::VECTOR2 ? 2 : 3;
+			ERR_FAIL_COND_V(p_len < count * 4, ERR_INVALID_DATA);
+			float values[3] = { 0.0, 0.0, 0.0 };
+			for (int i = 0; i < count; i++) {
+				const uint32_t u = decode_uint32(p_buffer + (i * 4));
+				memcpy(&values[i], &u, sizeof(float));
+			}
+			if (type == Variant::VECTOR2) {
+				r_variant = Vector2(values[0], values[1]);
+			} else {
+				r_variant = Vector3(values[0], values[1], values[2]);
+			}
+			len += count * 4;
+		} break;
+		case Variant::ARRAY: {
+			ERR_FAIL_COND_V(p_len < 4, ERR_INVALID_DATA);
+			const int count = int(decode_uint32(p_buffer));
+			p_buffer += 4;
+			p_len -= 4;
+			len += 4;
+			Vector<Variant> array;
+			for (int i = 0; i < count; i++) {
+				Variant v;
+				int used = 0;
+				const Error err = decode_variant(v, p_buffer, p_len, &used, p_allow_objects, p_depth + 1);
+				ERR_FAIL_COND_V(err != OK, err);
+				array.push_back(v);
+				p_buffer += used;
+				p_len -= used;
+				len += used;
+			}
+			r_variant = array;
+		} break;
+		case Variant::PACKED_BYTE_ARRAY: {
+			ERR_FAIL_COND_V(p_len < 4, ERR_INVALID_DATA);
+			const int count = int(decode_uint32(p_buffer));
+			ERR_FAIL_COND_V(count < 0 || ENCODE_PAD(count) > p_len - 4, ERR_INVALID_DATA);
+			Vector<uint8_t> bytes;
+			bytes.resize(count);
+			if (count > 0) {
+				memcpy(bytes.ptrw(), p_buffer + 4, count);
+			}
+			r_variant = bytes;
+			len += 4 + ENCODE_PAD(count);
+		} break;
+		default:
+			ERR_FAIL_V_MSG(ERR_INVALID_DATA, "The standalone build can't decode the Variant type: " + itos(type));
+	}
+
+	if (r_len) {
+		*r_len = len;
+	}
+	return OK;
+}
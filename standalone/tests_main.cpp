@@ -0,0 +1,13 @@
+// Runs the network synchronizer tests, without the Godot engine.
+
+#include "modules/network_synchronizer/scene_synchronizer_debugger.h"
+#include "modules/network_synchronizer/tests/tests.h"
+
+int main(int argc, char **argv) {
+	memnew(SceneSynchronizerDebugger);
+
+	NS_Test::test_all();
+
+	memdelete(SceneSynchronizerDebugger::singleton());
+	return 0;
+}
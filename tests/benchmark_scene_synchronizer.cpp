@@ -0,0 +1,666 @@
+#include "benchmark_scene_synchronizer.h"
+
+#include "core/error/error_macros.h"
+#include "core/math/math_funcs.h"
+#include "core/object/callable_method_pointer.h"
+#include "core/os/memory.h"
+#include "core/os/os.h"
+#include "core/variant/variant.h"
+#include "local_scene.h"
+#include "modules/network_synchronizer/core/core.h"
+#include "modules/network_synchronizer/data_buffer.h"
+#include "modules/network_synchronizer/scene_synchronizer.h"
+#include "modules/network_synchronizer/scene_synchronizer_debugger.h"
+#include "modules/network_synchronizer/scene_synchronizer_host.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace NS_Test {
+
+const float bench_delta = 1.0 / 60.0;
+
+// The amount of frames processed before starting the measurements, so the
+// initial full snapshots are not accounted.
+const int bench_warmup_frames = 10;
+
+std::string bench_var_name(int p_index) {
+	return "var_" + std::to_string(p_index);
+}
+
+class BenchObject;
+
+/// The deferred sync functions are called through `Callable`, so this has to
+/// be an `Object`.
+class BenchEpochHandler : public Object {
+public:
+	BenchObject *owner = nullptr;
+
+	void collect_epoch(DataBuffer *p_buffer);
+	void apply_epoch(double p_delta, double p_alpha, DataBuffer *p_past_buffer, DataBuffer *p_future_buffer);
+};
+
+class BenchObject : public NS::LocalSceneObject {
+public:
+	int vars_count = 0;
+	bool deferred = false;
+	bool bulk = false;
+	BenchEpochHandler epoch_handler;
+
+	// The registration is done by `register_object`, once the object is configured.
+	virtual void on_scene_entry() override {}
+
+	void configure(int p_vars_count, bool p_deferred, bool p_bulk) {
+		vars_count = p_vars_count;
+		deferred = p_deferred;
+		bulk = p_bulk;
+		epoch_handler.owner = this;
+		for (int i = 0; i < vars_count; i++) {
+			variables.insert(std::make_pair(bench_var_name(i), Variant(0.0)));
+		}
+	}
+
+	void register_object(int p_vars_count, bool p_deferred) {
+		configure(p_vars_count, p_deferred, false);
+		get_scene()->scene_sync->register_app_object(get_scene()->scene_sync->to_handle(this));
+	}
+
+	virtual void setup_synchronizer(NS::LocalSceneSynchronizer &p_scene_sync, NS::ObjectLocalId p_id) override {
+		if (bulk) {
+			std::vector<NS::SceneSynchronizerBase::VarSpec> vars;
+			vars.reserve(vars_count);
+			for (int i = 0; i < vars_count; i++) {
+				vars.push_back({ StringName(bench_var_name(i).c_str()), false });
+			}
+			p_scene_sync.register_variables(p_id, vars);
+		} else {
+			for (int i = 0; i < vars_count; i++) {
+				p_scene_sync.register_variable(p_id, StringName(bench_var_name(i).c_str()));
+			}
+		}
+		if (deferred) {
+			p_scene_sync.setup_deferred_sync(
+					p_id,
+					callable_mp(&epoch_handler, &BenchEpochHandler::collect_epoch),
+					callable_mp(&epoch_handler, &BenchEpochHandler::apply_epoch));
+		}
+	}
+
+	virtual void on_scene_exit() override {
+		get_scene()->scene_sync->on_app_object_removed(get_scene()->scene_sync->to_handle(this));
+	}
+};
+
+void BenchEpochHandler::collect_epoch(DataBuffer *p_buffer) {
+	for (int i = 0; i < owner->vars_count; i++) {
+		p_buffer->add_real(owner->variables[bench_var_name(i)], DataBuffer::COMPRESSION_LEVEL_1);
+	}
+}
+
+void BenchEpochHandler::apply_epoch(double p_delta, double p_alpha, DataBuffer *p_past_buffer, DataBuffer *p_future_buffer) {
+	for (int i = 0; i < owner->vars_count; i++) {
+		const double past = p_past_buffer->read_real(DataBuffer::COMPRESSION_LEVEL_1);
+		const double future = p_future_buffer->read_real(DataBuffer::COMPRESSION_LEVEL_1);
+		owner->variables[bench_var_name(i)] = Math::lerp(past, future, p_alpha);
+	}
+}
+
+class BenchController : public NS::NetworkedController<NS::LocalNetworkInterface>, public NS::NetworkedControllerManager, public NS::LocalSceneObject {
+public:
+	virtual void on_scene_entry() override {
+		get_network_interface().init(get_scene()->get_network(), name, authoritative_peer_id);
+		setup(*this);
+
+		variables.insert(std::make_pair("position", Variant(0.0)));
+
+		get_scene()->scene_sync->register_app_object(get_scene()->scene_sync->to_handle(this));
+	}
+
+	virtual void on_scene_exit() override {
+		get_scene()->scene_sync->on_app_object_removed(get_scene()->scene_sync->to_handle(this));
+	}
+
+	virtual void setup_synchronizer(NS::LocalSceneSynchronizer &p_scene_sync, NS::ObjectLocalId p_id) override {
+		p_scene_sync.register_variable(p_id, "position");
+	}
+
+	virtual void collect_inputs(double p_delta, DataBuffer &r_buffer) override {
+		r_buffer.add_bool(true);
+	}
+
+	virtual void controller_process(double p_delta, DataBuffer &p_buffer) override {
+		if (p_buffer.read_bool()) {
+			double position = variables["position"];
+			position += p_delta;
+			variables["position"] = position;
+		}
+	}
+
+	virtual bool are_inputs_different(DataBuffer &p_buffer_A, DataBuffer &p_buffer_B) override {
+		return p_buffer_A.read_bool() != p_buffer_B.read_bool();
+	}
+
+	virtual uint32_t count_input_size(DataBuffer &p_buffer) override {
+		return p_buffer.get_bool_size();
+	}
+};
+
+/// A full match: the server and its peers, which must be processed by the
+/// same thread.
+class BenchMatch {
+public:
+	BenchmarkParams params;
+	NS::LocalNetworkProps network_properties;
+
+	NS::LocalScene server_scene;
+	std::vector<std::unique_ptr<NS::LocalScene>> peer_scenes;
+	std::vector<BenchObject *> server_objects;
+	std::vector<bool> rewinded;
+
+	int frame = 0;
+	int changed_object_cursor = 0;
+	int changed_objects_per_frame = 0;
+
+	BenchmarkResult result;
+	double server_tick_ms_total = 0.0;
+	double client_tick_ms_total = 0.0;
+	double rewind_tick_ms_total = 0.0;
+	uint64_t allocated_bytes_total = 0;
+
+	BenchMatch(const BenchmarkParams &p_params);
+
+	/// Processes the server and all the peers once.
+	void process_frame();
+
+	/// Computes the result, using the measured frames.
+	const BenchmarkResult &finalize();
+};
+
+BenchMatch::BenchMatch(const BenchmarkParams &p_params) :
+		params(p_params),
+		network_properties(p_params.network_properties) {
+	CRASH_COND(p_params.peers_count < 1 || p_params.peers_count > 256);
+	CRASH_COND(p_params.sync_groups_count < 1);
+	CRASH_COND(p_params.deferred_objects_count > p_params.objects_count);
+	CRASH_COND(p_params.peers_are_spectators && p_params.peers_have_controller);
+
+	result.params = p_params;
+
+	server_scene.get_network().network_properties = &network_properties;
+	server_scene.start_as_server();
+
+	for (int p = 0; p < p_params.peers_count; p++) {
+		peer_scenes.push_back(std::make_unique<NS::LocalScene>());
+		peer_scenes.back()->get_network().network_properties = &network_properties;
+		peer_scenes.back()->start_as_client(server_scene);
+	}
+
+	std::vector<NS::LocalScene *> scenes;
+	scenes.push_back(&server_scene);
+	for (const std::unique_ptr<NS::LocalScene> &peer_scene : peer_scenes) {
+		scenes.push_back(peer_scene.get());
+	}
+
+	// Add the scene sync.
+	for (NS::LocalScene *scene : scenes) {
+		scene->scene_sync = scene->add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+		scene->scene_sync->bulk_variables_enabled = p_params.bulk_variables;
+	}
+	if (p_params.peers_are_spectators) {
+		for (const std::unique_ptr<NS::LocalScene> &peer_scene : peer_scenes) {
+			peer_scene->scene_sync->set_spectator_mode(true);
+			peer_scene->scene_sync->set_spectator_interpolation_delay(p_params.server_notify_state_interval * 2.0);
+		}
+	}
+	server_scene.scene_sync->set_server_notify_state_interval(p_params.server_notify_state_interval);
+
+	// Add the controllers.
+	if (p_params.peers_have_controller) {
+		for (const std::unique_ptr<NS::LocalScene> &peer_scene : peer_scenes) {
+			const std::string controller_name = "controller_" + std::to_string(peer_scene->get_peer());
+			for (NS::LocalScene *scene : scenes) {
+				scene->add_object<BenchController>(controller_name, peer_scene->get_peer());
+			}
+		}
+	}
+
+	// Add the objects.
+	for (int o = 0; o < p_params.objects_count; o++) {
+		const std::string object_name = "obj_" + std::to_string(o);
+		const bool deferred = o < p_params.deferred_objects_count;
+		for (NS::LocalScene *scene : scenes) {
+			BenchObject *object = scene->add_object<BenchObject>(object_name, server_scene.get_peer());
+			object->register_object(p_params.vars_per_object, deferred);
+			if (scene == &server_scene) {
+				server_objects.push_back(object);
+			}
+		}
+	}
+
+	// Distribute the objects and the peers across the sync groups.
+	std::vector<SyncGroupId> groups;
+	for (int g = 0; g < p_params.sync_groups_count; g++) {
+		groups.push_back(server_scene.scene_sync->sync_group_create());
+	}
+
+	for (int o = 0; o < p_params.objects_count; o++) {
+		NS::ObjectData *od = server_scene.scene_sync->get_object_data(server_objects[o]->find_local_id());
+		const bool realtime = o >= p_params.deferred_objects_count;
+		server_scene.scene_sync->sync_group_add_node(od, groups[o % groups.size()], realtime);
+	}
+
+	for (int p = 0; p < p_params.peers_count; p++) {
+		const int peer = peer_scenes[p]->get_peer();
+		const SyncGroupId group = groups[p % groups.size()];
+		server_scene.scene_sync->sync_group_move_peer_to(peer, group);
+		if (p_params.peers_have_controller) {
+			const std::string controller_name = "controller_" + std::to_string(peer);
+			BenchController *controller = server_scene.fetch_object<BenchController>(controller_name.c_str());
+			NS::ObjectData *od = server_scene.scene_sync->get_object_data(controller->find_local_id());
+			server_scene.scene_sync->sync_group_add_node(od, group, true);
+		}
+	}
+
+	// Track the rewinds.
+	rewinded.resize(p_params.peers_count, false);
+	for (int p = 0; p < p_params.peers_count; p++) {
+		peer_scenes[p]->scene_sync->event_rewind_frame_begin.bind([this, p](uint32_t p_input_id, int p_index, int p_count) {
+			rewinded[p] = true;
+		});
+	}
+
+	changed_objects_per_frame = int(Math::round(double(p_params.objects_count) * double(p_params.change_rate)));
+}
+
+void BenchMatch::process_frame() {
+	const bool measure = frame >= bench_warmup_frames;
+	if (frame == bench_warmup_frames) {
+		server_scene.get_network().sent_bytes_per_peer.clear();
+	}
+
+	// Change the objects on the server.
+	for (int i = 0; i < changed_objects_per_frame; i++) {
+		BenchObject *object = server_objects[changed_object_cursor];
+		changed_object_cursor = (changed_object_cursor + 1) % params.objects_count;
+		for (int v = 0; v < object->vars_count; v++) {
+			object->variables[bench_var_name(v)] = double(frame);
+		}
+	}
+
+	// Process the server.
+	{
+		const uint64_t mem_before = Memory::get_mem_usage();
+		const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		server_scene.scene_sync->process();
+		const double tick_ms = double(OS::get_singleton()->get_ticks_usec() - begin) / 1000.0;
+		const uint64_t mem_after = Memory::get_mem_usage();
+
+		if (measure) {
+			server_tick_ms_total += tick_ms;
+			result.server_tick_ms_max = MAX(result.server_tick_ms_max, tick_ms);
+			if (mem_after > mem_before) {
+				allocated_bytes_total += mem_after - mem_before;
+			}
+		}
+
+		server_scene.get_network().process(bench_delta);
+	}
+
+	// Process the clients.
+	for (int p = 0; p < params.peers_count; p++) {
+		rewinded[p] = false;
+
+		const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		peer_scenes[p]->scene_sync->process();
+		const double tick_ms = double(OS::get_singleton()->get_ticks_usec() - begin) / 1000.0;
+
+		if (measure) {
+			client_tick_ms_total += tick_ms;
+			result.client_tick_ms_max = MAX(result.client_tick_ms_max, tick_ms);
+			if (rewinded[p]) {
+				rewind_tick_ms_total += tick_ms;
+				result.rewinds_count += 1;
+			}
+		}
+
+		peer_scenes[p]->get_network().process(bench_delta);
+	}
+
+	frame += 1;
+}
+
+const BenchmarkResult &BenchMatch::finalize() {
+	const int measured_frames = MAX(1, frame - bench_warmup_frames);
+
+	result.server_tick_ms_avg = server_tick_ms_total / double(measured_frames);
+	result.client_tick_ms_avg = client_tick_ms_total / double(measured_frames * params.peers_count);
+	result.rewind_tick_ms_avg = result.rewinds_count > 0 ? rewind_tick_ms_total / double(result.rewinds_count) : 0.0;
+	result.allocated_bytes_per_tick = double(allocated_bytes_total) / double(measured_frames);
+
+	uint64_t sent_bytes = 0;
+	for (const auto &[peer, bytes] : server_scene.get_network().sent_bytes_per_peer) {
+		sent_bytes += bytes;
+	}
+	const double measured_seconds = double(measured_frames) * bench_delta;
+	result.bytes_per_peer_per_second = double(sent_bytes) / double(params.peers_count) / measured_seconds;
+
+	return result;
+}
+
+BenchmarkResult benchmark_run(const BenchmarkParams &p_params) {
+	BenchMatch match(p_params);
+	for (int f = 0; f < (bench_warmup_frames + p_params.frames); f++) {
+		match.process_frame();
+	}
+	return match.finalize();
+}
+
+MatchesPerCoreResult benchmark_matches_per_core(const BenchmarkParams &p_match_params, int p_matches_count, int p_workers_count) {
+	MatchesPerCoreResult result;
+	result.match_params = p_match_params;
+	result.matches_count = p_matches_count;
+
+	std::vector<std::unique_ptr<BenchMatch>> matches;
+	for (int m = 0; m < p_matches_count; m++) {
+		matches.push_back(std::make_unique<BenchMatch>(p_match_params));
+	}
+
+	NS::SceneSynchronizerHost host(p_workers_count);
+	result.workers_count = host.get_workers_count();
+
+	// Each match has its own debugger.
+	std::vector<SceneSynchronizerDebugger *> debuggers;
+	for (std::unique_ptr<BenchMatch> &match : matches) {
+		debuggers.push_back(memnew(SceneSynchronizerDebugger));
+		BenchMatch *m = match.get();
+		host.add_instance([m](double p_delta) { m->process_frame(); }, debuggers.back());
+	}
+
+	double frame_ms_total = 0.0;
+	for (int f = 0; f < (bench_warmup_frames + p_match_params.frames); f++) {
+		const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		host.process(bench_delta);
+		if (f >= bench_warmup_frames) {
+			frame_ms_total += double(OS::get_singleton()->get_ticks_usec() - begin) / 1000.0;
+		}
+	}
+
+	double server_tick_ms_total = 0.0;
+	double clients_tick_ms_total = 0.0;
+	for (std::unique_ptr<BenchMatch> &match : matches) {
+		const BenchmarkResult match_result = match->finalize();
+		server_tick_ms_total += match_result.server_tick_ms_avg;
+		clients_tick_ms_total += match_result.client_tick_ms_avg * double(p_match_params.peers_count);
+	}
+
+	for (SceneSynchronizerDebugger *debugger : debuggers) {
+		memdelete(debugger);
+	}
+
+	result.frame_ms_avg = frame_ms_total / double(p_match_params.frames);
+	result.server_tick_ms_avg = server_tick_ms_total / double(p_matches_count);
+	result.clients_tick_ms_avg = clients_tick_ms_total / double(p_matches_count);
+	const double match_tick_ms = result.server_tick_ms_avg + result.clients_tick_ms_avg;
+	result.matches_per_core = match_tick_ms > 0.0 ? (bench_delta * 1000.0) / match_tick_ms : 0.0;
+	return result;
+}
+
+std::string benchmark_result_to_json(const BenchmarkResult &p_result) {
+	const BenchmarkParams &p = p_result.params;
+	std::string json = "{";
+	json += "\"name\": \"" + p.name + "\", ";
+	json += "\"params\": {";
+	json += "\"objects\": " + std::to_string(p.objects_count) + ", ";
+	json += "\"vars_per_object\": " + std::to_string(p.vars_per_object) + ", ";
+	json += "\"peers\": " + std::to_string(p.peers_count) + ", ";
+	json += "\"sync_groups\": " + std::to_string(p.sync_groups_count) + ", ";
+	json += "\"change_rate\": " + std::to_string(p.change_rate) + ", ";
+	json += "\"deferred_objects\": " + std::to_string(p.deferred_objects_count) + ", ";
+	json += "\"peers_have_controller\": " + std::string(p.peers_have_controller ? "true" : "false") + ", ";
+	json += "\"server_notify_state_interval\": " + std::to_string(p.server_notify_state_interval) + ", ";
+	json += "\"frames\": " + std::to_string(p.frames) + ", ";
+	json += "\"bulk_variables\": " + std::string(p.bulk_variables ? "true" : "false") + ", ";
+	json += "\"peers_are_spectators\": " + std::string(p.peers_are_spectators ? "true" : "false") + ", ";
+	json += "\"rtt_seconds\": " + std::to_string(p.network_properties.rtt_seconds) + ", ";
+	json += "\"reorder\": " + std::to_string(p.network_properties.reorder) + ", ";
+	json += "\"packet_loss\": " + std::to_string(p.network_properties.packet_loss);
+	json += "}, ";
+	json += "\"server_tick_ms_avg\": " + std::to_string(p_result.server_tick_ms_avg) + ", ";
+	json += "\"server_tick_ms_max\": " + std::to_string(p_result.server_tick_ms_max) + ", ";
+	json += "\"client_tick_ms_avg\": " + std::to_string(p_result.client_tick_ms_avg) + ", ";
+	json += "\"client_tick_ms_max\": " + std::to_string(p_result.client_tick_ms_max) + ", ";
+	json += "\"rewind_tick_ms_avg\": " + std::to_string(p_result.rewind_tick_ms_avg) + ", ";
+	json += "\"rewinds_count\": " + std::to_string(p_result.rewinds_count) + ", ";
+	json += "\"bytes_per_peer_per_second\": " + std::to_string(p_result.bytes_per_peer_per_second) + ", ";
+	json += "\"allocated_bytes_per_tick\": " + std::to_string(p_result.allocated_bytes_per_tick);
+	json += "}";
+	return json;
+}
+
+BenchmarkParams benchmark_scenario_arena_shooter() {
+	// Few players, moving fast, with all the objects relevant to everyone.
+	BenchmarkParams params;
+	params.name = "arena_shooter";
+	params.objects_count = 200;
+	params.vars_per_object = 4;
+	params.peers_count = 16;
+	params.sync_groups_count = 1;
+	params.change_rate = 0.5;
+	params.deferred_objects_count = 0;
+	params.peers_have_controller = true;
+	params.server_notify_state_interval = 0.05;
+	params.frames = 600;
+	params.network_properties.rtt_seconds = 0.06;
+	params.network_properties.packet_loss = 0.01;
+	return params;
+}
+
+BenchmarkParams benchmark_scenario_mmo_zone() {
+	// Many players split across many groups, with lots of deferred objects.
+	BenchmarkParams params;
+	params.name = "mmo_zone";
+	params.objects_count = 5000;
+	params.vars_per_object = 3;
+	params.peers_count = 64;
+	params.sync_groups_count = 8;
+	params.change_rate = 0.05;
+	params.deferred_objects_count = 2000;
+	params.peers_have_controller = true;
+	params.server_notify_state_interval = 0.1;
+	params.frames = 300;
+	params.network_properties.rtt_seconds = 0.12;
+	params.network_properties.reorder = 0.01;
+	params.network_properties.packet_loss = 0.02;
+	return params;
+}
+
+BenchmarkParams benchmark_scenario_rts() {
+	// Few players, no controllers, many units changing at the same time.
+	BenchmarkParams params;
+	params.name = "rts";
+	params.objects_count = 5000;
+	params.vars_per_object = 2;
+	params.peers_count = 8;
+	params.sync_groups_count = 1;
+	params.change_rate = 0.3;
+	params.deferred_objects_count = 0;
+	params.peers_have_controller = false;
+	params.server_notify_state_interval = 0.1;
+	params.frames = 300;
+	params.network_properties.rtt_seconds = 0.15;
+	return params;
+}
+
+BenchmarkParams benchmark_scenario_observers() {
+	// Many peers watching a match, without controllers: e.g. a relay that
+	// broadcasts the match.
+	BenchmarkParams params;
+	params.name = "observers";
+	params.objects_count = 1000;
+	params.vars_per_object = 3;
+	params.peers_count = 32;
+	params.sync_groups_count = 1;
+	params.change_rate = 0.3;
+	params.deferred_objects_count = 0;
+	params.peers_have_controller = false;
+	params.server_notify_state_interval = 0.05;
+	params.frames = 300;
+	params.network_properties.rtt_seconds = 0.1;
+	return params;
+}
+
+BenchmarkParams benchmark_scenario_rewind_heavy() {
+	// Hundreds of physics bodies, with a lossy network: the clients rewind
+	// often, reading and writing all the bodies at each rewound frame.
+	BenchmarkParams params;
+	params.name = "rewind_heavy";
+	params.objects_count = 400;
+	params.vars_per_object = 3;
+	params.peers_count = 4;
+	params.sync_groups_count = 1;
+	params.change_rate = 0.5;
+	params.deferred_objects_count = 0;
+	params.peers_have_controller = true;
+	params.server_notify_state_interval = 0.05;
+	params.frames = 300;
+	params.network_properties.rtt_seconds = 0.1;
+	params.network_properties.packet_loss = 0.05;
+	return params;
+}
+
+BenchmarkParams benchmark_scenario_crowded_server() {
+	// The maximum amount of peers, to measure the per peer cost of the server tick.
+	BenchmarkParams params;
+	params.name = "crowded_server";
+	params.objects_count = 300;
+	params.vars_per_object = 1;
+	params.peers_count = 256;
+	params.sync_groups_count = 4;
+	params.change_rate = 0.2;
+	params.deferred_objects_count = 0;
+	params.peers_have_controller = true;
+	params.server_notify_state_interval = 0.05;
+	params.frames = 120;
+	params.network_properties.rtt_seconds = 0.06;
+	return params;
+}
+
+std::string matches_per_core_result_to_json(const MatchesPerCoreResult &p_result) {
+	std::string json = "{";
+	json += "\"name\": \"matches_per_core_" + p_result.match_params.name + "\", ";
+	json += "\"matches\": " + std::to_string(p_result.matches_count) + ", ";
+	json += "\"workers\": " + std::to_string(p_result.workers_count) + ", ";
+	json += "\"frame_ms_avg\": " + std::to_string(p_result.frame_ms_avg) + ", ";
+	json += "\"server_tick_ms_avg\": " + std::to_string(p_result.server_tick_ms_avg) + ", ";
+	json += "\"clients_tick_ms_avg\": " + std::to_string(p_result.clients_tick_ms_avg) + ", ";
+	json += "\"matches_per_core\": " + std::to_string(p_result.matches_per_core);
+	json += "}";
+	return json;
+}
+
+LevelLoadResult benchmark_level_load(int p_objects_count, int p_vars_per_object, bool p_bulk) {
+	LevelLoadResult result;
+	result.objects_count = p_objects_count;
+	result.vars_per_object = p_vars_per_object;
+	result.bulk = p_bulk;
+
+	NS::LocalScene server_scene;
+	server_scene.start_as_server();
+	server_scene.scene_sync = server_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+
+	// Only the registration is measured, not the objects creation.
+	std::vector<BenchObject *> objects;
+	std::vector<NS::ObjectHandle> handles;
+	objects.reserve(p_objects_count);
+	handles.reserve(p_objects_count);
+	for (int o = 0; o < p_objects_count; o++) {
+		BenchObject *object = server_scene.add_object<BenchObject>("obj_" + std::to_string(o), server_scene.get_peer());
+		object->configure(p_vars_per_object, false, p_bulk);
+		objects.push_back(object);
+		handles.push_back(server_scene.scene_sync->to_handle(object));
+	}
+
+	const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	if (p_bulk) {
+		server_scene.scene_sync->register_app_objects(handles);
+	} else {
+		for (NS::ObjectHandle handle : handles) {
+			server_scene.scene_sync->register_app_object(handle);
+		}
+	}
+	result.load_ms = double(OS::get_singleton()->get_ticks_usec() - begin) / 1000.0;
+
+	return result;
+}
+
+std::string level_load_result_to_json(const LevelLoadResult &p_result) {
+	std::string json = "{";
+	json += "\"name\": \"level_load_" + std::to_string(p_result.objects_count) + (p_result.bulk ? "_bulk" : "") + "\", ";
+	json += "\"objects\": " + std::to_string(p_result.objects_count) + ", ";
+	json += "\"vars_per_object\": " + std::to_string(p_result.vars_per_object) + ", ";
+	json += "\"bulk\": " + std::string(p_result.bulk ? "true" : "false") + ", ";
+	json += "\"load_ms\": " + std::to_string(p_result.load_ms);
+	json += "}";
+	return json;
+}
+
+BenchmarkParams benchmark_scenario_small_match() {
+	// A small match, many of which are hosted by the same process.
+	BenchmarkParams params;
+	params.name = "small_match";
+	params.objects_count = 50;
+	params.vars_per_object = 2;
+	params.peers_count = 4;
+	params.sync_groups_count = 1;
+	params.change_rate = 0.5;
+	params.deferred_objects_count = 0;
+	params.peers_have_controller = true;
+	params.server_notify_state_interval = 0.05;
+	params.frames = 300;
+	params.network_properties.rtt_seconds = 0.06;
+	params.network_properties.packet_loss = 0.01;
+	return params;
+}
+
+std::string benchmark_all() {
+	const std::vector<BenchmarkParams> scenarios = {
+		benchmark_scenario_arena_shooter(),
+		benchmark_scenario_mmo_zone(),
+		benchmark_scenario_rts(),
+		benchmark_scenario_rewind_heavy(),
+		benchmark_scenario_observers(),
+		benchmark_scenario_crowded_server()
+	};
+
+	std::string json = "[\n";
+	for (size_t i = 0; i < scenarios.size(); i++) {
+		json += "\t" + benchmark_result_to_json(benchmark_run(scenarios[i])) + ",\n";
+	}
+
+	// The rewind heavy scenario, reading and writing the variables in bulk.
+	BenchmarkParams rewind_heavy_bulk = benchmark_scenario_rewind_heavy();
+	rewind_heavy_bulk.name = "rewind_heavy_bulk";
+	rewind_heavy_bulk.bulk_variables = true;
+	json += "\t" + benchmark_result_to_json(benchmark_run(rewind_heavy_bulk)) + ",\n";
+
+	// The observers as regular clients, and as spectators.
+	BenchmarkParams observers_spectators = benchmark_scenario_observers();
+	observers_spectators.name = "observers_spectators";
+	observers_spectators.peers_are_spectators = true;
+	json += "\t" + benchmark_result_to_json(benchmark_run(observers_spectators)) + ",\n";
+
+	// The same amount of matches processed by one worker and by all the cores.
+	json += "\t" + matches_per_core_result_to_json(benchmark_matches_per_core(benchmark_scenario_small_match(), 16, 1)) + ",\n";
+	json += "\t" + matches_per_core_result_to_json(benchmark_matches_per_core(benchmark_scenario_small_match(), 16, 0)) + ",\n";
+
+	// The level load time, registering the objects one by one and in bulk.
+	// The biggest level is only loaded in bulk: one by one takes too long.
+	json += "\t" + level_load_result_to_json(benchmark_level_load(10000, 3, false)) + ",\n";
+	json += "\t" + level_load_result_to_json(benchmark_level_load(10000, 3, true)) + ",\n";
+	json += "\t" + level_load_result_to_json(benchmark_level_load(30000, 3, false)) + ",\n";
+	json += "\t" + level_load_result_to_json(benchmark_level_load(30000, 3, true)) + ",\n";
+	json += "\t" + level_load_result_to_json(benchmark_level_load(100000, 3, true)) + "\n";
+	json += "]";
+	return json;
+}
+}; //namespace NS_Test
@@ -0,0 +1,120 @@
+#pragma once
+
+#include "local_network.h"
+#include <string>
+#include <vector>
+
+namespace NS_Test {
+
+struct BenchmarkParams {
+	std::string name;
+
+	// Number of synchronized objects, present on the server and on each peer.
+	int objects_count = 100;
+	int vars_per_object = 1;
+
+	// Number of connected peers, from 1 to 256.
+	int peers_count = 1;
+
+	// The objects and the peers are distributed across these groups.
+	int sync_groups_count = 1;
+
+	// From 0.0 to 1.0: the fraction of objects changed by the server each frame.
+	float change_rate = 0.1;
+
+	// The first `deferred_objects_count` objects are deferred synced.
+	int deferred_objects_count = 0;
+
+	// When true, each peer has its own controller, so the clients rewind.
+	bool peers_have_controller = true;
+
+	float server_notify_state_interval = 0.1;
+	int frames = 300;
+
+	// When true, the variables of each object are read and written with a
+	// single `get_variables` and `set_variables` call.
+	bool bulk_variables = false;
+
+	// When true, the peers are spectators: they only receive and interpolate
+	// the server state. Requires `peers_have_controller` false.
+	bool peers_are_spectators = false;
+
+	NS::LocalNetworkProps network_properties;
+};
+
+struct BenchmarkResult {
+	BenchmarkParams params;
+
+	double server_tick_ms_avg = 0.0;
+	double server_tick_ms_max = 0.0;
+
+	// Averaged across all the peers.
+	double client_tick_ms_avg = 0.0;
+	double client_tick_ms_max = 0.0;
+
+	// The client tick time, measured only on the ticks that performed a rewind.
+	double rewind_tick_ms_avg = 0.0;
+	int rewinds_count = 0;
+
+	// Bytes sent by the server to each peer.
+	double bytes_per_peer_per_second = 0.0;
+
+	// The memory allocated (and not yet released) by the server within a tick.
+	// This is 0 on non debug builds.
+	double allocated_bytes_per_tick = 0.0;
+};
+
+struct MatchesPerCoreResult {
+	BenchmarkParams match_params;
+	int matches_count = 0;
+	int workers_count = 0;
+
+	// The wall time to process all the matches once.
+	double frame_ms_avg = 0.0;
+
+	// The server tick time of a single match.
+	double server_tick_ms_avg = 0.0;
+
+	// The tick time of all the clients of a single match.
+	double clients_tick_ms_avg = 0.0;
+
+	// How many matches, server and clients, a single core can process within
+	// a tick: the clients run on the same cores in this benchmark.
+	double matches_per_core = 0.0;
+};
+
+struct LevelLoadResult {
+	int objects_count = 0;
+	int vars_per_object = 0;
+
+	// When true, the objects are registered using `register_app_objects` and
+	// `register_variables`, otherwise one by one.
+	bool bulk = false;
+
+	// The time spent by the server to register all the objects.
+	double load_ms = 0.0;
+};
+
+BenchmarkResult benchmark_run(const BenchmarkParams &p_params);
+std::string benchmark_result_to_json(const BenchmarkResult &p_result);
+
+/// Processes `p_matches_count` independent matches concurrently, using a
+/// `SceneSynchronizerHost` with `p_workers_count` workers (0 means one per core).
+MatchesPerCoreResult benchmark_matches_per_core(const BenchmarkParams &p_match_params, int p_matches_count, int p_workers_count);
+std::string matches_per_core_result_to_json(const MatchesPerCoreResult &p_result);
+
+/// Registers a level of `p_objects_count` objects on a server.
+LevelLoadResult benchmark_level_load(int p_objects_count, int p_vars_per_object, bool p_bulk);
+std::string level_load_result_to_json(const LevelLoadResult &p_result);
+
+// Canonical scenarios, used to measure the performance changes.
+BenchmarkParams benchmark_scenario_arena_shooter();
+BenchmarkParams benchmark_scenario_mmo_zone();
+BenchmarkParams benchmark_scenario_rts();
+BenchmarkParams benchmark_scenario_rewind_heavy();
+BenchmarkParams benchmark_scenario_observers();
+BenchmarkParams benchmark_scenario_small_match();
+
+/// Runs all the canonical scenarios and returns the JSON array with the results.
+std::string benchmark_all();
+}; //namespace NS_Test
@@ -2,6 +2,8 @@
 #include "local_network.h"
 
 #include "core/error/error_macros.h"
+#include "core/math/math_funcs.h"
+#include "core/math/vector2.h"
 #include "core/math/vector3.h"
 #include "modules/network_synchronizer/core/network_interface.h"
 #include "modules/network_synchronizer/core/processor.h"
@@ -11,11 +13,12 @@
 #include <functional>
 #include <map>
 #include <memory>
+#include <random>
 #include <vector>
 
 NS_NAMESPACE_BEGIN
-float frand() {
-	return static_cast<float>(rand()) / static_cast<float>(RAND_MAX);
+float LocalNetwork::frand() {
+	return std::uniform_real_distribution<float>(0.0, 1.0)(random_engine);
 }
 
 int LocalNetwork::get_peer() const {
@@ -58,11 +61,17 @@ void LocalNetwork::rpc_send(String p_object_name, int p_peer_recipient, bool p_r
 	LocalNetworkInterface *object_net_interface = object_map_it->second;
 	CRASH_COND(object_net_interface == nullptr);
 
+	sent_bytes_per_peer[p_peer_recipient] += (p_data_buffer.total_size() + 7) / 8;
+
 	if (!p_reliable && network_properties && network_properties->packet_loss > frand()) {
 		// Simulating packet loss by dropping this packet right away.
 		return;
 	}
 
+	if (p_reliable && network_properties && network_properties->reliable_packet_loss > frand()) {
+		return;
+	}
+
 	std::shared_ptr<PendingPacket> packet = std::make_shared<PendingPacket>();
 
 	if (network_properties) {
@@ -180,6 +189,30 @@ void LocalNetworkInterface::decode(NS::VarData &r_val, DataBuffer &p_buffer) con
 	p_buffer.read_bits(reinterpret_cast<uint8_t *>(&r_val.data), sizeof(r_val.data) * 8);
 }
 
+bool LocalNetworkInterface::compare(const Variant &p_first, const Variant &p_second) const {
+	if (p_first.get_type() != p_second.get_type()) {
+		return false;
+	}
+
+	const real_t tolerance = 0.0001;
+	switch (p_first.get_type()) {
+		case Variant::FLOAT:
+			return Math::is_equal_approx(real_t(p_first), real_t(p_second), tolerance);
+		case Variant::VECTOR2: {
+			const Vector2 a = p_first;
+			const Vector2 b = p_second;
+			return Math::is_equal_approx(a.x, b.x, tolerance) && Math::is_equal_approx(a.y, b.y, tolerance);
+		}
+		case Variant::VECTOR3: {
+			const Vector3 a = p_first;
+			const Vector3 b = p_second;
+			return Math::is_equal_approx(a.x, b.x, tolerance) && Math::is_equal_approx(a.y, b.y, tolerance) && Math::is_equal_approx(a.z, b.z, tolerance);
+		}
+		default:
+			return p_first == p_second;
+	}
+}
+
 void LocalNetworkInterface::rpc_send(int p_peer_recipient, bool p_reliable, DataBuffer &&p_data_buffer) {
 	ERR_FAIL_COND(!network);
 	network->rpc_send(get_name(), p_peer_recipient, p_reliable, std::move(p_data_buffer));
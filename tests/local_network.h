@@ -7,12 +7,10 @@
 #include <functional>
 #include <map>
 #include <memory>
+#include <random>
 #include <string>
 #include <vector>
 
-// TODO remove this
-#include "modules/network_synchronizer/godot4/gd_network_interface.h"
-
 NS_NAMESPACE_BEGIN
 class LocalNetworkInterface;
 
@@ -25,6 +23,10 @@ struct LocalNetworkProps {
 
 	// From 0.0 to 1.0
 	float packet_loss = 0.0;
+
+	// From 0.0 to 1.0, as `packet_loss` but for the reliable packets: used to
+	// simulate the packets lost with a broken connection.
+	float reliable_packet_loss = 0.0;
 };
 
 struct PendingPacket {
@@ -47,9 +49,16 @@ class LocalNetwork {
 
 	std::vector<std::shared_ptr<PendingPacket>> sending_packets;
 
+	// Each network has its own random engine, so the networks can be processed
+	// concurrently.
+	std::minstd_rand random_engine;
+
 public:
 	LocalNetworkProps *network_properties = nullptr;
 
+	// Bytes sent to each peer, used by the benchmarks.
+	std::map<int, uint64_t> sent_bytes_per_peer;
+
 	NS::Processor<int> connected_event;
 	NS::Processor<int> disconnected_event;
 
@@ -68,6 +77,7 @@ public:
 	void process(float p_delta);
 
 private:
+	float frand();
 	void rpc_send_internal(const std::shared_ptr<PendingPacket> &p_packet);
 	void rpc_receive_internal(int p_peer_sender, const std::shared_ptr<PendingPacket> &p_packet);
 };
@@ -115,7 +125,7 @@ public:
 	virtual void decode(NS::VarData &r_val, DataBuffer &p_buffer) const override;
 
 	virtual bool compare(const VarData &p_A, const VarData &p_B) const override { return true; }
-	virtual bool compare(const Variant &p_first, const Variant &p_second) const override { return GdNetworkInterface::compare(p_first, p_second, 0.0001); }
+	virtual bool compare(const Variant &p_first, const Variant &p_second) const override;
 
 	virtual void rpc_send(int p_peer_recipient, bool p_reliable, DataBuffer &&p_data_buffer) override;
 };
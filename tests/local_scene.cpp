@@ -70,6 +70,39 @@ bool LocalSceneSynchronizer::get_variable(const ObjectHandle p_app_object_handle
 	}
 }
 
+bool LocalSceneSynchronizer::get_variables(ObjectHandle p_app_object_handle, const VarLayout &p_layout, std::vector<Variant> &r_values) const {
+	if (!bulk_variables_enabled) {
+		return false;
+	}
+	get_variables_count += 1;
+
+	const LocalSceneObject *lso = from_handle(p_app_object_handle);
+	r_values.resize(p_layout.names.size());
+	for (size_t v = 0; v < p_layout.names.size(); v++) {
+		auto element = lso->variables.find(p_layout.names[v]);
+		r_values[v] = element != lso->variables.end() ? element->second : Variant();
+	}
+	return true;
+}
+
+bool LocalSceneSynchronizer::set_variables(ObjectHandle p_app_object_handle, const VarLayout &p_layout, const std::vector<bool> &p_var_mask, const std::vector<Variant> &p_values) {
+	if (!bulk_variables_enabled) {
+		return false;
+	}
+	set_variables_count += 1;
+
+	LocalSceneObject *lso = from_handle(p_app_object_handle);
+	for (size_t v = 0; v < p_var_mask.size(); v++) {
+		if (p_var_mask[v]) {
+			auto element = lso->variables.find(p_layout.names[v]);
+			if (element != lso->variables.end()) {
+				element->second = p_values[v];
+			}
+		}
+	}
+	return true;
+}
+
 NS::NetworkedControllerBase *LocalSceneSynchronizer::extract_network_controller(ObjectHandle p_app_object_handle) {
 	return dynamic_cast<NS::NetworkedControllerBase *>(from_handle(p_app_object_handle));
 }
@@ -30,6 +30,12 @@ public:
 };
 
 class LocalSceneSynchronizer : public SceneSynchronizer<LocalSceneObject, LocalNetworkInterface>, public SynchronizerManager, public LocalSceneObject {
+public:
+	/// When true, `get_variables` and `set_variables` are implemented.
+	bool bulk_variables_enabled = false;
+	mutable int get_variables_count = 0;
+	int set_variables_count = 0;
+
 public:
 	LocalSceneSynchronizer();
 
@@ -46,6 +52,8 @@ public:
 	virtual void setup_synchronizer_for(ObjectHandle p_app_object_handle, ObjectLocalId p_id) override;
 	virtual void set_variable(ObjectHandle p_app_object_handle, const char *p_var_name, const Variant &p_val) override;
 	virtual bool get_variable(ObjectHandle p_app_object_handle, const char *p_var_name, Variant &p_val) const override;
+	virtual bool get_variables(ObjectHandle p_app_object_handle, const VarLayout &p_layout, std::vector<Variant> &r_values) const override;
+	virtual bool set_variables(ObjectHandle p_app_object_handle, const VarLayout &p_layout, const std::vector<bool> &p_var_mask, const std::vector<Variant> &p_values) override;
 	virtual NS::NetworkedControllerBase *extract_network_controller(ObjectHandle p_app_object_handle) override;
 	virtual const NS::NetworkedControllerBase *extract_network_controller(ObjectHandle p_app_object_handle) const override;
 };
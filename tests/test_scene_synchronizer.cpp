@@ -1,13 +1,22 @@
 #include "test_scene_synchronizer.h"
 
+#include "core/config/project_settings.h"
 #include "core/error/error_macros.h"
 #include "core/math/vector3.h"
+#include "core/object/callable_method_pointer.h"
 #include "core/variant/variant.h"
 #include "local_scene.h"
 #include "modules/network_synchronizer/core/core.h"
+#include "modules/network_synchronizer/data_buffer.h"
+#include "modules/network_synchronizer/deferred_kinematics.h"
 #include "modules/network_synchronizer/net_utilities.h"
+#include "modules/network_synchronizer/rewind_profiler.h"
+#include "modules/network_synchronizer/scene_diff.h"
+#include "modules/network_synchronizer/scene_synchronizer_debugger.h"
 #include "modules/network_synchronizer/tests/local_network.h"
 
+#include <memory>
+
 namespace NS_Test {
 
 void test_ids() {
@@ -82,6 +91,120 @@ public:
 	}
 };
 
+/// A controller which input is set by the test, so the dolls can mispredict it.
+class TestPredictedController : public LocalNetworkedController {
+public:
+	bool input = true;
+	int predict_calls = 0;
+	int decay_calls = 0;
+
+	virtual void collect_inputs(double p_delta, DataBuffer &r_buffer) override {
+		r_buffer.add_bool(input);
+	}
+
+	virtual bool predict_doll_input(int p_frames, DataBuffer &p_last_input, DataBuffer &r_predicted_input) override {
+		predict_calls += 1;
+		r_predicted_input.add_bool(!p_last_input.read_bool());
+		return true;
+	}
+
+	virtual bool decay_doll_input(double p_factor, DataBuffer &p_last_input, DataBuffer &r_decayed_input) override {
+		decay_calls += 1;
+		r_decayed_input.add_bool(p_last_input.read_bool() && p_factor >= 0.5);
+		return true;
+	}
+};
+
+/// A controller that sends the input size, so the receivers never count it.
+class TestPrefixedController : public LocalNetworkedController {
+public:
+	int count_calls = 0;
+
+	TestPrefixedController() {
+		set_input_size_prefixed(true);
+	}
+
+	virtual uint32_t count_input_size(DataBuffer &p_buffer) override {
+		count_calls += 1;
+		return LocalNetworkedController::count_input_size(p_buffer);
+	}
+};
+
+void test_peer_table() {
+	NS::PeerTable table;
+	CRASH_COND(!table.is_empty());
+	CRASH_COND(table.find(1) != nullptr);
+
+	for (int peer = 1; peer <= 256; peer++) {
+		table.insert(peer).sync_group_id = peer;
+	}
+	CRASH_COND(table.size() != 256);
+
+	// Insert an existing peer returns the existing data.
+	CRASH_COND(table.insert(10).sync_group_id != 10);
+	CRASH_COND(table.size() != 256);
+
+	// Remove from the middle moves the last peer into the freed slot.
+	CRASH_COND(!table.remove(10));
+	CRASH_COND(table.remove(10));
+	CRASH_COND(table.has(10));
+	CRASH_COND(table.find(10) != nullptr);
+	CRASH_COND(table.size() != 255);
+	CRASH_COND(table.find(256) == nullptr);
+	CRASH_COND(table.find(256)->sync_group_id != 256);
+
+	uint32_t iterated = 0;
+	for (const NS::PeerTable::Entry &entry : table) {
+		CRASH_COND(entry.peer == 10);
+		CRASH_COND(int(entry.data.sync_group_id) != entry.peer);
+		iterated += 1;
+	}
+	CRASH_COND(iterated != 255);
+
+	// Remove the last peer.
+	CRASH_COND(!table.remove(256));
+	CRASH_COND(table.find(255)->sync_group_id != 255);
+
+	table.clear();
+	CRASH_COND(!table.is_empty());
+	CRASH_COND(table.has(1));
+}
+
+void test_deferred_epoch_delta() {
+	// 20 bits: the last byte has only 4 meaningful bits.
+	const int bit_count = 20;
+	const uint8_t reference[3] = { 0x12, 0x34, 0x05 };
+	uint8_t data[3] = { 0x12, 0x35, 0x05 };
+
+	// The bits past `bit_count` don't affect the hash.
+	const uint8_t reference_dirty[3] = { 0x12, 0x34, 0xF5 };
+	CRASH_COND(NS::hash_bits(reference, bit_count) != NS::hash_bits(reference_dirty, bit_count));
+	CRASH_COND(NS::hash_bits(reference, bit_count) == NS::hash_bits(data, bit_count));
+
+	// Only the changed byte carries the XOR.
+	DataBuffer delta;
+	delta.begin_write(0);
+	NS::delta_encode_bits(reference, data, bit_count, delta);
+	CRASH_COND(delta.total_size() != NS::delta_encoded_bits_size(reference, data, bit_count));
+	CRASH_COND(delta.total_size() != 3 + 8);
+
+	uint8_t decoded[3] = {};
+	delta.begin_read();
+	CRASH_COND(!NS::delta_decode_bits(reference, bit_count, delta, decoded));
+	CRASH_COND(decoded[0] != data[0]);
+	CRASH_COND(decoded[1] != data[1]);
+	CRASH_COND((decoded[2] & 0x0F) != (data[2] & 0x0F));
+
+	// A truncated delta is rejected.
+	data[2] = 0x0A;
+	DataBuffer truncated;
+	truncated.begin_write(0);
+	NS::delta_encode_bits(reference, data, bit_count, truncated);
+	truncated.begin_read();
+	truncated.shrink_to(0, truncated.total_size() - 4);
+	CRASH_COND(NS::delta_decode_bits(reference, bit_count, truncated, decoded));
+}
+
 void test_client_and_server_initialization() {
 	NS::LocalScene server_scene;
 	server_scene.start_as_server();
@@ -142,6 +265,429 @@ public:
 	}
 };
 
+/// The deferred sync functions are called through `Callable`, so this has to
+/// be an `Object`.
+class TestEpochHandler : public Object {
+public:
+	int value = 0;
+	int collected_count = 0;
+	int received_value = -1;
+	double max_alpha = 0.0;
+
+	void collect_epoch(DataBuffer *p_buffer) {
+		collected_count += 1;
+		p_buffer->add_int(value, DataBuffer::COMPRESSION_LEVEL_1);
+		// Some padding, so the delta is smaller than the full epoch.
+		p_buffer->add_uint(0, DataBuffer::COMPRESSION_LEVEL_1);
+		p_buffer->add_uint(0, DataBuffer::COMPRESSION_LEVEL_1);
+	}
+
+	void apply_epoch(double p_delta, double p_alpha, DataBuffer *p_past_buffer, DataBuffer *p_future_buffer) {
+		received_value = p_future_buffer->read_int(DataBuffer::COMPRESSION_LEVEL_1);
+		max_alpha = MAX(max_alpha, p_alpha);
+	}
+};
+
+class TestDeferredObject : public TestSceneObject {
+public:
+	TestEpochHandler epoch_handler;
+
+	virtual void setup_synchronizer(NS::LocalSceneSynchronizer &p_scene_sync, NS::ObjectLocalId p_id) override {
+		TestSceneObject::setup_synchronizer(p_scene_sync, p_id);
+		p_scene_sync.setup_deferred_sync(
+				p_id,
+				callable_mp(&epoch_handler, &TestEpochHandler::collect_epoch),
+				callable_mp(&epoch_handler, &TestEpochHandler::apply_epoch));
+	}
+};
+
+void test_deferred_sync_delta() {
+	NS::LocalScene server_scene;
+	server_scene.start_as_server();
+
+	NS::LocalScene peer_1_scene;
+	peer_1_scene.start_as_client(server_scene);
+
+	server_scene.scene_sync =
+			server_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+	peer_1_scene.scene_sync =
+			peer_1_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+
+	server_scene.scene_sync->set_deferred_sync_delta_enabled(true);
+	server_scene.scene_sync->set_deferred_sync_keyframe_interval(4);
+	CRASH_COND(!server_scene.scene_sync->is_deferred_sync_delta_enabled());
+	CRASH_COND(server_scene.scene_sync->get_deferred_sync_keyframe_interval() != 4);
+
+	TestDeferredObject *server_obj = server_scene.add_object<TestDeferredObject>("obj_1", server_scene.get_peer());
+	TestDeferredObject *p1_obj = peer_1_scene.add_object<TestDeferredObject>("obj_1", server_scene.get_peer());
+
+	const SyncGroupId group = server_scene.scene_sync->sync_group_create();
+	server_scene.scene_sync->sync_group_add_node(server_scene.scene_sync->get_object_data(server_obj->find_local_id()), group, false);
+	server_scene.scene_sync->sync_group_set_deferred_update_rate(server_obj->find_local_id(), group, 1.0);
+	server_scene.scene_sync->sync_group_move_peer_to(peer_1_scene.get_peer(), group);
+
+	// Wait the client to receive the objects and the first epochs.
+	for (int i = 0; i < 30; i++) {
+		server_scene.process(delta);
+		peer_1_scene.process(delta);
+	}
+	CRASH_COND(p1_obj->epoch_handler.received_value != 0);
+
+	for (int v = 1; v <= 5; v++) {
+		// Each value is kept for some frames, so the epochs in between are
+		// unchanged and skipped.
+		server_obj->epoch_handler.value = v * 1000;
+		for (int i = 0; i < 8; i++) {
+			server_scene.process(delta);
+			peer_1_scene.process(delta);
+		}
+		CRASH_COND(p1_obj->epoch_handler.received_value != v * 1000);
+	}
+
+	// The state is still collected at every update, even when not sent.
+	CRASH_COND(server_obj->epoch_handler.collected_count < 20);
+}
+
+void test_deferred_sync_extrapolation() {
+	NS::LocalScene server_scene;
+	server_scene.start_as_server();
+
+	NS::LocalScene peer_1_scene;
+	peer_1_scene.start_as_client(server_scene);
+
+	server_scene.scene_sync =
+			server_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+	peer_1_scene.scene_sync =
+			peer_1_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+
+	// Make sure the unchanged epochs are not sent for a while.
+	server_scene.scene_sync->set_deferred_sync_keyframe_interval(1000);
+
+	TestDeferredObject *server_obj = server_scene.add_object<TestDeferredObject>("obj_1", server_scene.get_peer());
+	TestDeferredObject *p1_obj = peer_1_scene.add_object<TestDeferredObject>("obj_1", server_scene.get_peer());
+
+	const SyncGroupId group = server_scene.scene_sync->sync_group_create();
+	server_scene.scene_sync->sync_group_add_node(server_scene.scene_sync->get_object_data(server_obj->find_local_id()), group, false);
+	server_scene.scene_sync->sync_group_set_deferred_update_rate(server_obj->find_local_id(), group, 1.0);
+	server_scene.scene_sync->sync_group_move_peer_to(peer_1_scene.get_peer(), group);
+
+	const auto process_until_stalled = [&]() {
+		for (int i = 0; i < 60; i++) {
+			server_obj->epoch_handler.value += 1;
+			server_scene.process(delta);
+			peer_1_scene.process(delta);
+		}
+		// Stop changing, so the next epochs are not sent.
+		for (int i = 0; i < 60; i++) {
+			server_scene.process(delta);
+			peer_1_scene.process(delta);
+		}
+	};
+
+	// By default the client stops right after the last epoch.
+	process_until_stalled();
+	CRASH_COND(p1_obj->epoch_handler.max_alpha <= 0.0);
+	CRASH_COND(p1_obj->epoch_handler.max_alpha > 1.2 + 1.0);
+
+	peer_1_scene.scene_sync->set_deferred_max_extrapolation(p1_obj->find_local_id(), 3.0);
+	CRASH_COND(peer_1_scene.scene_sync->get_deferred_max_extrapolation(p1_obj->find_local_id()) != 3.0);
+
+	// Now it keeps applying, up to the max extrapolation.
+	p1_obj->epoch_handler.max_alpha = 0.0;
+	process_until_stalled();
+	CRASH_COND(p1_obj->epoch_handler.max_alpha < 3.0);
+	CRASH_COND(p1_obj->epoch_handler.max_alpha > 4.0 + 1.0);
+}
+
+void test_deferred_kinematics() {
+	NS::DeferredKinematics::State state;
+	state.position = Vector3(1.0, 0.0, 0.0);
+	state.velocity = Vector3(2.0, 0.0, 0.0);
+	state.acceleration = Vector3(0.0, -10.0, 0.0);
+
+	const NS::DeferredKinematics::State extrapolated = NS::DeferredKinematics::extrapolate(state, 0.5);
+	CRASH_COND(!Math::is_equal_approx(extrapolated.position.x, 2.0));
+	CRASH_COND(!Math::is_equal_approx(extrapolated.position.y, -1.25));
+	CRASH_COND(!Math::is_equal_approx(extrapolated.velocity.y, -5.0));
+
+	// The hermite interpolation reaches the two positions, and with a
+	// constant velocity it's linear.
+	NS::DeferredKinematics::State past;
+	past.velocity = Vector3(1.0, 0.0, 0.0);
+	NS::DeferredKinematics::State future;
+	future.position = Vector3(1.0, 0.0, 0.0);
+	future.velocity = Vector3(1.0, 0.0, 0.0);
+	CRASH_COND(!Math::is_equal_approx(NS::DeferredKinematics::interpolate(past, future, 1.0, 0.0).x, 0.0));
+	CRASH_COND(!Math::is_equal_approx(NS::DeferredKinematics::interpolate(past, future, 1.0, 0.5).x, 0.5));
+	CRASH_COND(!Math::is_equal_approx(NS::DeferredKinematics::interpolate(past, future, 1.0, 1.0).x, 1.0));
+
+	// Moving at 1 unit per second, with an epoch each 0.5 seconds.
+	const double frame_delta = 0.1;
+	const auto make_epoch = [](real_t p_position, real_t p_velocity) -> DataBuffer {
+		DataBuffer db;
+		db.begin_write(0);
+		NS::DeferredKinematics::State s;
+		s.position = Vector3(p_position, 0.0, 0.0);
+		s.velocity = Vector3(p_velocity, 0.0, 0.0);
+		NS::DeferredKinematics::write(db, s);
+		return db;
+	};
+
+	NS::DeferredKinematics kinematics;
+	DataBuffer epoch_0 = make_epoch(0.0, 1.0);
+	DataBuffer epoch_1 = make_epoch(0.5, 1.0);
+	Vector3 position;
+	for (int f = 1; f <= 10; f++) {
+		epoch_0.begin_read();
+		epoch_1.begin_read();
+		position = kinematics.apply(frame_delta, f * 0.2, epoch_0, epoch_1);
+	}
+	CRASH_COND(!Math::is_equal_approx(kinematics.get_interval(), 0.5));
+	// The next epoch is late: after 5 frames past the last one, it extrapolated.
+	CRASH_COND(!Math::is_equal_approx(position.x, 1.0));
+
+	// The next epoch reports the object stopped at 0.8: the object starts from
+	// where it is, then converges.
+	DataBuffer epoch_2 = make_epoch(0.8, 0.0);
+	epoch_1.begin_read();
+	epoch_2.begin_read();
+	position = kinematics.apply(frame_delta, 0.2, epoch_1, epoch_2);
+	CRASH_COND(!Math::is_equal_approx(position.x, 1.0));
+	CRASH_COND(kinematics.get_correction().length() <= 0.0);
+	for (int f = 2; f <= 10; f++) {
+		epoch_1.begin_read();
+		epoch_2.begin_read();
+		position = kinematics.apply(frame_delta, f * 0.2, epoch_1, epoch_2);
+	}
+	CRASH_COND(!Math::is_equal_approx(position.x, 0.8, 0.001));
+	CRASH_COND(kinematics.get_correction().length() > 0.001);
+
+	// A correction greater than the max one snaps.
+	kinematics.max_correction = 0.1;
+	DataBuffer epoch_3 = make_epoch(5.0, 0.0);
+	epoch_2.begin_read();
+	epoch_3.begin_read();
+	kinematics.apply(frame_delta, 0.2, epoch_2, epoch_3);
+	CRASH_COND(kinematics.get_correction() != Vector3());
+}
+
+void test_sync_group_lod() {
+	NS::LocalScene server_scene;
+	server_scene.start_as_server();
+	server_scene.scene_sync =
+			server_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+
+	std::vector<NS::ObjectLocalId> ids;
+	for (int i = 0; i < 6; i++) {
+		ids.push_back(server_scene.add_object<TestSceneObject>(("obj_" + std::to_string(i)).c_str(), server_scene.get_peer())->find_local_id());
+	}
+	NS::LocalSceneSynchronizer *scene_sync = server_scene.scene_sync;
+
+	const SyncGroupId group = scene_sync->sync_group_create();
+	NS::LodPolicy policy;
+	policy.thresholds[NS::LOD_TIER_REALTIME] = 10.0;
+	policy.thresholds[NS::LOD_TIER_DEFERRED_HIGH] = 20.0;
+	policy.thresholds[NS::LOD_TIER_DEFERRED_LOW] = 30.0;
+	policy.hysteresis = 2.0;
+	scene_sync->sync_group_set_lod_policy(group, policy);
+
+	// A node not managed by the LOD is kept as is.
+	scene_sync->sync_group_add_node(scene_sync->get_object_data(ids[5]), group, true);
+	CRASH_COND(scene_sync->sync_group_get_lod_tier(ids[5], group) != NS::LOD_TIER_COUNT);
+
+	const real_t metrics[5] = { 5.0, 15.0, 25.0, 35.0, 9.0 };
+	for (int i = 0; i < 5; i++) {
+		scene_sync->sync_group_set_lod_metric(ids[i], group, metrics[i]);
+	}
+	scene_sync->sync_group_update_lod(group);
+
+	CRASH_COND(scene_sync->sync_group_get_lod_tier(ids[0], group) != NS::LOD_TIER_REALTIME);
+	CRASH_COND(scene_sync->sync_group_get_lod_tier(ids[1], group) != NS::LOD_TIER_DEFERRED_HIGH);
+	CRASH_COND(scene_sync->sync_group_get_lod_tier(ids[2], group) != NS::LOD_TIER_DEFERRED_LOW);
+	CRASH_COND(scene_sync->sync_group_get_lod_tier(ids[3], group) != NS::LOD_TIER_CULLED);
+	CRASH_COND(scene_sync->sync_group_get_lod_tier(ids[4], group) != NS::LOD_TIER_REALTIME);
+
+	const NS::SyncGroup *sync_group = scene_sync->sync_group_get(group);
+	CRASH_COND(sync_group->get_realtime_sync_nodes().size() != 3);
+	CRASH_COND(sync_group->get_deferred_sync_nodes().size() != 2);
+	CRASH_COND(!Math::is_equal_approx(scene_sync->sync_group_get_deferred_update_rate(ids[1], group), policy.deferred_high_update_rate));
+	CRASH_COND(!Math::is_equal_approx(scene_sync->sync_group_get_deferred_update_rate(ids[2], group), policy.deferred_low_update_rate));
+
+	// Within the hysteresis margin nothing changes.
+	scene_sync->sync_group_set_lod_metric(ids[4], group, 11.0);
+	scene_sync->sync_group_set_lod_metric(ids[1], group, 9.0);
+	scene_sync->sync_group_update_lod(group);
+	CRASH_COND(scene_sync->sync_group_get_lod_tier(ids[4], group) != NS::LOD_TIER_REALTIME);
+	CRASH_COND(scene_sync->sync_group_get_lod_tier(ids[1], group) != NS::LOD_TIER_DEFERRED_HIGH);
+
+	// Past the margin the tiers change.
+	scene_sync->sync_group_set_lod_metric(ids[4], group, 12.5);
+	scene_sync->sync_group_set_lod_metric(ids[1], group, 7.5);
+	scene_sync->sync_group_update_lod(group);
+	CRASH_COND(scene_sync->sync_group_get_lod_tier(ids[4], group) != NS::LOD_TIER_DEFERRED_HIGH);
+	CRASH_COND(scene_sync->sync_group_get_lod_tier(ids[1], group) != NS::LOD_TIER_REALTIME);
+
+	// The budget demotes the nodes with the highest metric.
+	policy.max_realtime_nodes = 1;
+	policy.max_deferred_update_rate = policy.deferred_high_update_rate + policy.deferred_low_update_rate;
+	scene_sync->sync_group_set_lod_policy(group, policy);
+	scene_sync->sync_group_update_lod(group);
+	CRASH_COND(scene_sync->sync_group_get_lod_tier(ids[0], group) != NS::LOD_TIER_REALTIME);
+	CRASH_COND(scene_sync->sync_group_get_lod_tier(ids[1], group) != NS::LOD_TIER_DEFERRED_HIGH);
+	CRASH_COND(scene_sync->sync_group_get_lod_tier(ids[4], group) != NS::LOD_TIER_DEFERRED_LOW);
+	CRASH_COND(scene_sync->sync_group_get_lod_tier(ids[2], group) != NS::LOD_TIER_CULLED);
+	CRASH_COND(sync_group->get_realtime_sync_nodes().size() != 2);
+	CRASH_COND(sync_group->get_deferred_sync_nodes().size() != 2);
+
+	// Removing the node stops the LOD management.
+	scene_sync->sync_group_remove_node(scene_sync->get_object_data(ids[0]), group);
+	CRASH_COND(scene_sync->sync_group_get_lod_tier(ids[0], group) != NS::LOD_TIER_COUNT);
+	CRASH_COND(sync_group->get_lod_nodes().size() != 4);
+	scene_sync->sync_group_update_lod(group);
+	CRASH_COND(scene_sync->sync_group_get_lod_tier(ids[1], group) != NS::LOD_TIER_REALTIME);
+	CRASH_COND(sync_group->get_realtime_sync_nodes().size() != 2);
+
+	// Replacing the nodes stops the LOD management of the removed ones, so a
+	// tier change doesn't add them back.
+	LocalVector<NS::ObjectNetId> realtime_ids;
+	realtime_ids.push_back(scene_sync->get_object_data(ids[5])->get_net_id());
+	realtime_ids.push_back(scene_sync->get_object_data(ids[1])->get_net_id());
+	scene_sync->sync_group_replace_nodes_by_id(group, realtime_ids, LocalVector<NS::ObjectNetId>(), LocalVector<real_t>());
+	CRASH_COND(sync_group->get_lod_nodes().size() != 1);
+	CRASH_COND(scene_sync->sync_group_get_lod_tier(ids[4], group) != NS::LOD_TIER_COUNT);
+
+	scene_sync->sync_group_set_lod_metric(ids[1], group, 25.0);
+	scene_sync->sync_group_update_lod(group);
+	CRASH_COND(scene_sync->sync_group_get_lod_tier(ids[1], group) != NS::LOD_TIER_DEFERRED_LOW);
+	CRASH_COND(sync_group->get_realtime_sync_nodes().size() != 1);
+	CRASH_COND(sync_group->get_realtime_sync_nodes()[0].od->get_local_id() != ids[5]);
+	CRASH_COND(sync_group->get_deferred_sync_nodes().size() != 1);
+	CRASH_COND(sync_group->get_deferred_sync_nodes()[0].od->get_local_id() != ids[1]);
+
+	// Same when all the nodes are removed.
+	scene_sync->sync_group_remove_all_nodes(group);
+	CRASH_COND(!sync_group->get_lod_nodes().is_empty());
+	scene_sync->sync_group_set_lod_metric(ids[0], group, 5.0);
+	scene_sync->sync_group_update_lod(group);
+	CRASH_COND(sync_group->get_realtime_sync_nodes().size() != 1);
+	CRASH_COND(sync_group->get_realtime_sync_nodes()[0].od->get_local_id() != ids[0]);
+	CRASH_COND(!sync_group->get_deferred_sync_nodes().is_empty());
+}
+
+void test_sync_group_replace_nodes_by_id() {
+	NS::LocalScene server_scene;
+	server_scene.start_as_server();
+	server_scene.scene_sync =
+			server_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+	NS::LocalSceneSynchronizer *scene_sync = server_scene.scene_sync;
+
+	std::vector<NS::ObjectData *> ods;
+	std::vector<NS::ObjectNetId> ids;
+	for (int i = 0; i < 8; i++) {
+		const NS::ObjectLocalId id = server_scene.add_object<TestSceneObject>(("obj_" + std::to_string(i)).c_str(), server_scene.get_peer())->find_local_id();
+		ods.push_back(scene_sync->get_object_data(id));
+		ids.push_back(ods.back()->get_net_id());
+	}
+
+	auto is_realtime = [](const NS::SyncGroup *p_group, const NS::ObjectData *p_od) -> bool {
+		for (const NS::SyncGroup::RealtimeNodeInfo &info : p_group->get_realtime_sync_nodes()) {
+			if (info.od == p_od) {
+				return true;
+			}
+		}
+		return false;
+	};
+	auto is_deferred = [](const NS::SyncGroup *p_group, const NS::ObjectData *p_od) -> bool {
+		for (const NS::SyncGroup::DeferredNodeInfo &info : p_group->get_deferred_sync_nodes()) {
+			if (info.od == p_od) {
+				return true;
+			}
+		}
+		return false;
+	};
+
+	const SyncGroupId group = scene_sync->sync_group_create();
+	const NS::SyncGroup *sync_group = scene_sync->sync_group_get(group);
+
+	{
+		LocalVector<NS::ObjectNetId> realtime;
+		realtime.push_back(ids[0]);
+		realtime.push_back(ids[1]);
+		realtime.push_back(ids[2]);
+		LocalVector<NS::ObjectNetId> deferred;
+		deferred.push_back(ids[3]);
+		deferred.push_back(ids[4]);
+		LocalVector<real_t> rates;
+		rates.push_back(0.25);
+		rates.push_back(0.75);
+		scene_sync->sync_group_replace_nodes_by_id(group, realtime, deferred, rates);
+	}
+
+	CRASH_COND(sync_group->get_realtime_sync_nodes().size() != 3);
+	CRASH_COND(sync_group->get_deferred_sync_nodes().size() != 2);
+	CRASH_COND(!sync_group->is_realtime_node_list_changed());
+	CRASH_COND(!sync_group->is_deferred_node_list_changed());
+	CRASH_COND(!Math::is_equal_approx(scene_sync->sync_group_get_deferred_update_rate(ids[3], group), real_t(0.25)));
+	CRASH_COND(!Math::is_equal_approx(scene_sync->sync_group_get_deferred_update_rate(ids[4], group), real_t(0.75)));
+	for (const NS::SyncGroup::RealtimeNodeInfo &info : sync_group->get_realtime_sync_nodes()) {
+		// The new nodes are fully notified.
+		CRASH_COND(!info.change.unknown);
+		CRASH_COND(info.change.vars.size() != 1);
+	}
+
+	// The set difference: 0 is removed, 3 moves to realtime, 2 to deferred,
+	// 4 gets a new update rate and 5 is added.
+	{
+		LocalVector<NS::ObjectNetId> realtime;
+		realtime.push_back(ids[1]);
+		realtime.push_back(ids[3]);
+		LocalVector<NS::ObjectNetId> deferred;
+		deferred.push_back(ids[2]);
+		deferred.push_back(ids[4]);
+		deferred.push_back(ids[5]);
+		LocalVector<real_t> rates;
+		rates.push_back(0.5);
+		rates.push_back(0.1);
+		rates.push_back(0.2);
+		scene_sync->sync_group_replace_nodes_by_id(group, realtime, deferred, rates);
+	}
+
+	CRASH_COND(sync_group->get_realtime_sync_nodes().size() != 2);
+	CRASH_COND(sync_group->get_deferred_sync_nodes().size() != 3);
+	CRASH_COND(is_realtime(sync_group, ods[0]) || is_deferred(sync_group, ods[0]));
+	CRASH_COND(!is_realtime(sync_group, ods[1]));
+	CRASH_COND(!is_realtime(sync_group, ods[3]));
+	CRASH_COND(!is_deferred(sync_group, ods[2]));
+	CRASH_COND(!is_deferred(sync_group, ods[4]));
+	CRASH_COND(!is_deferred(sync_group, ods[5]));
+	CRASH_COND(!Math::is_equal_approx(scene_sync->sync_group_get_deferred_update_rate(ids[2], group), real_t(0.5)));
+	CRASH_COND(!Math::is_equal_approx(scene_sync->sync_group_get_deferred_update_rate(ids[4], group), real_t(0.1)));
+	CRASH_COND(!Math::is_equal_approx(scene_sync->sync_group_get_deferred_update_rate(ids[5], group), real_t(0.2)));
+
+	// Without the update rates, the deferred nodes use the default one.
+	{
+		LocalVector<NS::ObjectNetId> realtime;
+		realtime.push_back(ids[1]);
+		LocalVector<NS::ObjectNetId> deferred;
+		deferred.push_back(ids[6]);
+		scene_sync->sync_group_replace_nodes_by_id(group, realtime, deferred, LocalVector<real_t>());
+	}
+	CRASH_COND(sync_group->get_realtime_sync_nodes().size() != 1);
+	CRASH_COND(sync_group->get_deferred_sync_nodes().size() != 1);
+	CRASH_COND(!Math::is_equal_approx(scene_sync->sync_group_get_deferred_update_rate(ids[6], group), NS::SyncGroup::DeferredNodeInfo().update_rate));
+
+	// The nodes are removed with a single call.
+	{
+		LocalVector<NS::ObjectNetId> to_remove;
+		to_remove.push_back(ids[1]);
+		to_remove.push_back(ids[6]);
+		to_remove.push_back(ids[7]);
+		scene_sync->sync_group_remove_nodes_by_id(group, to_remove);
+	}
+	CRASH_COND(sync_group->get_realtime_sync_nodes().size() != 0);
+	CRASH_COND(sync_group->get_deferred_sync_nodes().size() != 0);
+}
+
 void test_state_notify() {
 	NS::LocalScene server_scene;
 	server_scene.start_as_server();
@@ -164,6 +710,8 @@ void test_state_notify() {
 	peer_1_scene.add_object<TestSceneObject>("obj_1", server_scene.get_peer());
 	peer_2_scene.add_object<TestSceneObject>("obj_1", server_scene.get_peer());
 
+	peer_1_scene.scene_sync->set_rewind_profiler_enabled(true);
+
 	for (int f = 0; f < 2; f++) {
 		// Test with notify interval set to 0
 		{
@@ -317,6 +865,44 @@ void test_state_notify() {
 			// NOTE: No need to check the peer_2, because it's not an authoritative controller anyway.
 		}
 	}
+
+	// The `peer_1` has the local controller, so it rewound to fix `var_1`.
+	const NS::RewindProfiler &profiler = peer_1_scene.scene_sync->get_rewind_profiler();
+	CRASH_COND(profiler.get_rewinds_count() == 0);
+	CRASH_COND(profiler.get_depth_frames().count != profiler.get_rewinds_count());
+	const std::vector<NS::RewindTriggerStats> triggers = profiler.get_triggers();
+	CRASH_COND(triggers.size() != 1);
+	CRASH_COND(triggers[0].object_name != "obj_1");
+	CRASH_COND(triggers[0].var_name != "var_1");
+	CRASH_COND(triggers[0].rewinds_count != profiler.get_rewinds_count());
+	// `var_1` is an integer, so each divergence is at least 1.
+	CRASH_COND(triggers[0].divergence.count != triggers[0].rewinds_count);
+	CRASH_COND(triggers[0].divergence.get_percentile(0.0) < 1.0);
+}
+
+void test_rewind_histogram() {
+	NS::RewindHistogram histogram(1.0);
+	histogram.add(0.5);
+	histogram.add(1.0);
+	histogram.add(3.0);
+	histogram.add(100.0);
+	CRASH_COND(histogram.count != 4);
+	CRASH_COND(histogram.buckets[0] != 1);
+	CRASH_COND(histogram.buckets[1] != 1);
+	CRASH_COND(histogram.buckets[2] != 1);
+	CRASH_COND(histogram.buckets[7] != 1);
+	CRASH_COND(!Math::is_equal_approx(histogram.max, 100.0));
+	CRASH_COND(!Math::is_equal_approx(histogram.get_average(), 26.125));
+	CRASH_COND(!Math::is_equal_approx(histogram.get_percentile(0.5), 2.0));
+	CRASH_COND(!Math::is_equal_approx(histogram.get_percentile(1.0), 100.0));
+
+	histogram.reset();
+	CRASH_COND(histogram.count != 0);
+	CRASH_COND(histogram.get_percentile(0.5) != 0.0);
+
+	CRASH_COND(!Math::is_equal_approx(NS::RewindProfiler::compute_divergence(Vector3(1.0, 0.0, 0.0), Vector3(1.0, 2.0, 0.0)), 2.0));
+	CRASH_COND(NS::RewindProfiler::compute_divergence(String("a"), String("b")) != 1.0);
+	CRASH_COND(NS::RewindProfiler::compute_divergence(String("a"), 1) != 1.0);
 }
 
 void test_processing_with_late_controller_registration() {
@@ -658,6 +1244,1293 @@ void test_variable_change_event() {
 	}
 }
 
+void test_scene_diff() {
+	NS::LocalScene server_scene;
+	server_scene.start_as_server();
+
+	NS::LocalScene peer_1_scene;
+	peer_1_scene.start_as_client(server_scene);
+
+	server_scene.scene_sync =
+			server_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+	peer_1_scene.scene_sync =
+			peer_1_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+
+	NS::ObjectLocalId server_obj_1_id = server_scene.add_object<TestSceneObject>("obj_1", server_scene.get_peer())->find_local_id();
+	peer_1_scene.add_object<TestSceneObject>("obj_1", server_scene.get_peer());
+
+	// Process a couple of times, so the client knows the objects.
+	server_scene.scene_sync->set_server_notify_state_interval(0.0);
+	for (int i = 0; i < 2; i++) {
+		server_scene.process(delta);
+		peer_1_scene.process(delta);
+	}
+
+	// From now on the client is updated only through the `SceneDiff`.
+	server_scene.scene_sync->set_server_notify_state_interval(100.0);
+
+	const NS::ObjectNetId obj_1_net_id = server_scene.scene_sync->get_object_data(server_obj_1_id)->get_net_id();
+	const NS::VarId var_1_id = server_scene.scene_sync->get_variable_id(server_obj_1_id, "var_1");
+
+	SceneDiff diff;
+	DataBuffer sync_data;
+
+	// Nothing changed while tracking.
+	server_scene.scene_sync->start_tracking_scene_changes(&diff);
+	server_scene.process(delta);
+	server_scene.scene_sync->stop_tracking_scene_changes(&diff);
+	CRASH_COND(diff.is_object_changed(obj_1_net_id));
+	CRASH_COND(server_scene.scene_sync->pop_scene_changes(&diff, sync_data));
+
+	// The change is recorded by the diff.
+	server_scene.scene_sync->start_tracking_scene_changes(&diff);
+	server_scene.fetch_object<TestSceneObject>("obj_1")->variables["var_1"] = 10;
+	server_scene.process(delta);
+	server_scene.scene_sync->stop_tracking_scene_changes(&diff);
+	CRASH_COND(diff.is_tracking_in_progress());
+	CRASH_COND(!diff.is_variable_changed(obj_1_net_id, var_1_id));
+
+	// The changes made while not tracking are not recorded.
+	server_scene.fetch_object<TestSceneObject>("obj_1")->variables["var_1"] = 11;
+	server_scene.process(delta);
+
+	CRASH_COND(!server_scene.scene_sync->pop_scene_changes(&diff, sync_data));
+	CRASH_COND(diff.is_object_changed(obj_1_net_id));
+
+	peer_1_scene.process(delta);
+	CRASH_COND(int(peer_1_scene.fetch_object<TestSceneObject>("obj_1")->variables["var_1"]) == 11);
+
+	// The client applies the changes, that contains the latest value.
+	peer_1_scene.scene_sync->apply_scene_changes(sync_data);
+	CRASH_COND(int(peer_1_scene.fetch_object<TestSceneObject>("obj_1")->variables["var_1"]) != 11);
+}
+
+void test_sleeping_objects() {
+	NS::LocalScene server_scene;
+	server_scene.start_as_server();
+
+	NS::LocalScene peer_1_scene;
+	peer_1_scene.start_as_client(server_scene);
+
+	server_scene.scene_sync =
+			server_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+	peer_1_scene.scene_sync =
+			peer_1_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+
+	NS::ObjectLocalId server_obj_1_id = server_scene.add_object<TestSceneObject>("obj_1", server_scene.get_peer())->find_local_id();
+	NS::ObjectLocalId server_obj_2_id = server_scene.add_object<TestSceneObject>("obj_2", server_scene.get_peer())->find_local_id();
+	NS::ObjectLocalId p1_obj_1_id = peer_1_scene.add_object<TestSceneObject>("obj_1", server_scene.get_peer())->find_local_id();
+	peer_1_scene.add_object<TestSceneObject>("obj_2", server_scene.get_peer());
+	server_scene.fetch_object<TestSceneObject>("obj_1")->variables["var_1"] = 0;
+	peer_1_scene.fetch_object<TestSceneObject>("obj_1")->variables["var_1"] = 0;
+
+	server_scene.scene_sync->set_server_notify_state_interval(0.0);
+
+	int server_obj_1_processed = 0;
+	server_scene.scene_sync->register_process(server_obj_1_id, PROCESSPHASE_PROCESS, [&server_obj_1_processed](float p_delta) {
+		server_obj_1_processed += 1;
+	});
+
+	const int idle_ticks = 3;
+	server_scene.scene_sync->set_sleep_idle_ticks(server_obj_1_id, idle_ticks);
+	peer_1_scene.scene_sync->set_sleep_idle_ticks(p1_obj_1_id, idle_ticks);
+	CRASH_COND(server_scene.scene_sync->get_sleep_idle_ticks(server_obj_1_id) != idle_ticks);
+
+	// The first process detects the initial values.
+	server_scene.process(delta);
+	peer_1_scene.process(delta);
+
+	for (int i = 0; i < idle_ticks; i++) {
+		CRASH_COND(server_scene.scene_sync->is_sleeping(server_obj_1_id));
+		server_scene.process(delta);
+		peer_1_scene.process(delta);
+	}
+
+	// Nothing changed, so both fell asleep.
+	CRASH_COND(!server_scene.scene_sync->is_sleeping(server_obj_1_id));
+	CRASH_COND(!peer_1_scene.scene_sync->is_sleeping(p1_obj_1_id));
+	// The objects not opted in never sleep.
+	CRASH_COND(server_scene.scene_sync->is_sleeping(server_obj_2_id));
+
+	// The sleeping objects are not processed.
+	const int processed_before_sleep = server_obj_1_processed;
+	for (int i = 0; i < 4; i++) {
+		server_scene.process(delta);
+		peer_1_scene.process(delta);
+	}
+	CRASH_COND(server_obj_1_processed != processed_before_sleep);
+
+	// The changes done while sleeping are not detected.
+	server_scene.fetch_object<TestSceneObject>("obj_1")->variables["var_1"] = 5;
+	server_scene.process(delta);
+	CRASH_COND(server_scene.scene_sync->get_object_data(server_obj_1_id)->vars[0].value.operator int() == 5);
+
+	// Once woken up, the change is detected and synced: the client wakes up too.
+	server_scene.scene_sync->wake_up(server_obj_1_id);
+	CRASH_COND(server_scene.scene_sync->is_sleeping(server_obj_1_id));
+	for (int i = 0; i < 2; i++) {
+		server_scene.process(delta);
+		peer_1_scene.process(delta);
+	}
+	CRASH_COND(server_obj_1_processed == processed_before_sleep);
+	CRASH_COND(server_scene.scene_sync->get_object_data(server_obj_1_id)->vars[0].value.operator int() != 5);
+	CRASH_COND(peer_1_scene.scene_sync->is_sleeping(p1_obj_1_id));
+	CRASH_COND(int(peer_1_scene.fetch_object<TestSceneObject>("obj_1")->variables["var_1"]) != 5);
+
+	// Fall asleep again, then wake up through the trigger.
+	for (int i = 0; i < idle_ticks; i++) {
+		server_scene.process(delta);
+	}
+	CRASH_COND(!server_scene.scene_sync->is_sleeping(server_obj_1_id));
+
+	server_scene.scene_sync->add_wake_trigger(server_obj_1_id, server_obj_2_id);
+	server_scene.fetch_object<TestSceneObject>("obj_2")->variables["var_1"] = 1;
+	server_scene.process(delta);
+	CRASH_COND(server_scene.scene_sync->is_sleeping(server_obj_1_id));
+
+	// Disabling the sleep wakes it up.
+	for (int i = 0; i < idle_ticks; i++) {
+		server_scene.process(delta);
+	}
+	CRASH_COND(!server_scene.scene_sync->is_sleeping(server_obj_1_id));
+	server_scene.scene_sync->set_sleep_idle_ticks(server_obj_1_id, 0);
+	CRASH_COND(server_scene.scene_sync->is_sleeping(server_obj_1_id));
+	for (int i = 0; i < idle_ticks * 2; i++) {
+		server_scene.process(delta);
+	}
+	CRASH_COND(server_scene.scene_sync->is_sleeping(server_obj_1_id));
+
+	// The dropped dependent is removed from the trigger, so the object that
+	// reuses its local id is not woken by it.
+	server_scene.remove_object("obj_1");
+	NS::ObjectLocalId server_obj_3_id = server_scene.add_object<TestSceneObject>("obj_3", server_scene.get_peer())->find_local_id();
+	CRASH_COND(server_obj_3_id != server_obj_1_id);
+	server_scene.scene_sync->set_sleep_idle_ticks(server_obj_3_id, idle_ticks);
+	for (int i = 0; i < idle_ticks + 1; i++) {
+		server_scene.process(delta);
+	}
+	CRASH_COND(!server_scene.scene_sync->is_sleeping(server_obj_3_id));
+	server_scene.fetch_object<TestSceneObject>("obj_2")->variables["var_1"] = 2;
+	server_scene.process(delta);
+	CRASH_COND(!server_scene.scene_sync->is_sleeping(server_obj_3_id));
+}
+
+void test_sleeping_object_wake_correction() {
+	NS::LocalScene server_scene;
+	server_scene.start_as_server();
+
+	NS::LocalScene peer_1_scene;
+	peer_1_scene.start_as_client(server_scene);
+
+	server_scene.scene_sync =
+			server_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+	peer_1_scene.scene_sync =
+			peer_1_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+
+	// The player controller makes the client compare the snapshots, rather
+	// than applying them right away.
+	server_scene.add_object<LocalNetworkedController>("controller_1", peer_1_scene.get_peer());
+	peer_1_scene.add_object<LocalNetworkedController>("controller_1", peer_1_scene.get_peer());
+
+	NS::ObjectLocalId server_obj_1_id = server_scene.add_object<TestSceneObject>("obj_1", server_scene.get_peer())->find_local_id();
+	NS::ObjectLocalId p1_obj_1_id = peer_1_scene.add_object<TestSceneObject>("obj_1", server_scene.get_peer())->find_local_id();
+	server_scene.fetch_object<TestSceneObject>("obj_1")->variables["var_1"] = 0;
+	peer_1_scene.fetch_object<TestSceneObject>("obj_1")->variables["var_1"] = 0;
+
+	server_scene.scene_sync->set_server_notify_state_interval(0.0);
+	server_scene.scene_sync->set_sleep_idle_ticks(server_obj_1_id, 3);
+	peer_1_scene.scene_sync->set_sleep_idle_ticks(p1_obj_1_id, 3);
+
+	for (int i = 0; i < 20; i++) {
+		server_scene.process(delta);
+		peer_1_scene.process(delta);
+	}
+	CRASH_COND(!server_scene.scene_sync->is_sleeping(server_obj_1_id));
+	CRASH_COND(!peer_1_scene.scene_sync->is_sleeping(p1_obj_1_id));
+
+	server_scene.fetch_object<TestSceneObject>("obj_1")->variables["var_1"] = 5;
+	server_scene.scene_sync->wake_up(server_obj_1_id);
+
+	// The snapshot that wakes the object also corrects it.
+	bool woken = false;
+	for (int i = 0; i < 10 && !woken; i++) {
+		server_scene.process(delta);
+		peer_1_scene.process(delta);
+		woken = !peer_1_scene.scene_sync->is_sleeping(p1_obj_1_id);
+	}
+	CRASH_COND(!woken);
+	CRASH_COND(int(peer_1_scene.fetch_object<TestSceneObject>("obj_1")->variables["var_1"]) != 5);
+}
+
+void test_process_rate_divisor() {
+	NS::LocalScene server_scene;
+	server_scene.start_as_server();
+
+	NS::LocalScene peer_1_scene;
+	peer_1_scene.start_as_client(server_scene);
+
+	server_scene.scene_sync =
+			server_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+	peer_1_scene.scene_sync =
+			peer_1_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+
+	NS::ObjectLocalId server_obj_1_id = server_scene.add_object<TestSceneObject>("obj_1", server_scene.get_peer())->find_local_id();
+	NS::ObjectLocalId server_obj_2_id = server_scene.add_object<TestSceneObject>("obj_2", server_scene.get_peer())->find_local_id();
+	NS::ObjectLocalId p1_obj_1_id = peer_1_scene.add_object<TestSceneObject>("obj_1", server_scene.get_peer())->find_local_id();
+
+	std::vector<float> server_obj_1_deltas;
+	int server_obj_2_processed = 0;
+	int p1_obj_1_processed = 0;
+	// The objects processed by the server, in order; 0 separates the ticks.
+	std::vector<int> server_processed;
+	server_scene.scene_sync->register_process(server_obj_1_id, PROCESSPHASE_PROCESS, [&server_obj_1_deltas, &server_processed](float p_delta) {
+		server_obj_1_deltas.push_back(p_delta);
+		server_processed.push_back(1);
+	});
+	server_scene.scene_sync->register_process(server_obj_2_id, PROCESSPHASE_PROCESS, [&server_obj_2_processed, &server_processed](float p_delta) {
+		server_obj_2_processed += 1;
+		server_processed.push_back(2);
+	});
+	peer_1_scene.scene_sync->register_process(p1_obj_1_id, PROCESSPHASE_PROCESS, [&p1_obj_1_processed](float p_delta) {
+		p1_obj_1_processed += 1;
+	});
+
+	const uint32_t divisor = 3;
+	// Only the server sets it.
+	server_scene.scene_sync->set_process_rate_divisor(server_obj_1_id, divisor);
+	CRASH_COND(server_scene.scene_sync->get_process_rate_divisor(server_obj_1_id) != divisor);
+	CRASH_COND(server_scene.scene_sync->get_process_rate_divisor(server_obj_2_id) != 1);
+
+	const int ticks = divisor * 4;
+	for (int i = 0; i < ticks; i++) {
+		server_scene.process(delta);
+		peer_1_scene.process(delta);
+		server_processed.push_back(0);
+	}
+
+	// The full rate objects are processed each tick.
+	CRASH_COND(server_obj_2_processed != ticks);
+
+	// The divided object is processed once every `divisor` ticks, with the accumulated delta.
+	CRASH_COND(server_obj_1_deltas.size() != 4);
+	float total_delta = 0.0;
+	for (size_t i = 0; i < server_obj_1_deltas.size(); i++) {
+		if (i > 0) {
+			CRASH_COND(!Math::is_equal_approx(server_obj_1_deltas[i], delta * divisor));
+		}
+		total_delta += server_obj_1_deltas[i];
+	}
+	CRASH_COND(total_delta > (delta * ticks) + 0.0001);
+
+	// The divided object keeps its place in the `NetId` order: it's processed
+	// before `obj_2` on the ticks it runs.
+	for (size_t i = 0; i < server_processed.size(); i++) {
+		if (server_processed[i] == 1) {
+			CRASH_COND(i + 1 >= server_processed.size() || server_processed[i + 1] != 2);
+			CRASH_COND(i > 0 && server_processed[i - 1] != 0);
+		}
+	}
+
+	// The client received the divisor, and doesn't predict the divided objects.
+	CRASH_COND(peer_1_scene.scene_sync->get_process_rate_divisor(p1_obj_1_id) != divisor);
+	CRASH_COND(p1_obj_1_processed != 0);
+
+	// Back to full rate.
+	server_scene.scene_sync->set_process_rate_divisor(server_obj_1_id, 1);
+	server_obj_1_deltas.clear();
+	server_scene.process(delta);
+	CRASH_COND(server_obj_1_deltas.size() != 1);
+	CRASH_COND(!Math::is_equal_approx(server_obj_1_deltas[0], delta));
+	peer_1_scene.process(delta);
+	CRASH_COND(peer_1_scene.scene_sync->get_process_rate_divisor(p1_obj_1_id) != 1);
+}
+
+void test_doll_inputs_relay() {
+	NS::LocalScene server_scene;
+	server_scene.start_as_server();
+
+	NS::LocalScene peer_1_scene;
+	peer_1_scene.start_as_client(server_scene);
+
+	NS::LocalScene peer_2_scene;
+	peer_2_scene.start_as_client(server_scene);
+
+	server_scene.scene_sync =
+			server_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+	peer_1_scene.scene_sync =
+			peer_1_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+	peer_2_scene.scene_sync =
+			peer_2_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+
+	server_scene.add_object<LocalNetworkedController>("controller_1", peer_1_scene.get_peer());
+	peer_1_scene.add_object<LocalNetworkedController>("controller_1", peer_1_scene.get_peer());
+	peer_2_scene.add_object<LocalNetworkedController>("controller_1", peer_1_scene.get_peer());
+
+	// The relayed input ids are converted to the receiving peer ones, so it
+	// needs a controller too.
+	server_scene.add_object<LocalNetworkedController>("controller_2", peer_2_scene.get_peer());
+	peer_1_scene.add_object<LocalNetworkedController>("controller_2", peer_2_scene.get_peer());
+	peer_2_scene.add_object<LocalNetworkedController>("controller_2", peer_2_scene.get_peer());
+
+	const NS::DollController *doll = peer_2_scene.fetch_object<LocalNetworkedController>("controller_1")->get_doll_controller();
+	CRASH_COND(doll == nullptr);
+
+	for (int i = 0; i < 60; i++) {
+		server_scene.process(delta);
+		peer_1_scene.process(delta);
+		peer_2_scene.process(delta);
+	}
+
+	// The doll on peer 2 receives the inputs relayed by the server.
+	CRASH_COND(doll->last_known_input() == UINT32_MAX);
+
+	// Move peer 2 into a group that doesn't contain the controller: the
+	// server stops relaying its inputs.
+	const SyncGroupId group_id = server_scene.scene_sync->sync_group_create();
+	server_scene.scene_sync->sync_group_move_peer_to(peer_2_scene.get_peer(), group_id);
+	for (int i = 0; i < 10; i++) {
+		server_scene.process(delta);
+		peer_1_scene.process(delta);
+		peer_2_scene.process(delta);
+	}
+	const uint32_t last_known_input = doll->last_known_input();
+	for (int i = 0; i < 30; i++) {
+		server_scene.process(delta);
+		peer_1_scene.process(delta);
+		peer_2_scene.process(delta);
+	}
+	CRASH_COND(doll->last_known_input() != last_known_input);
+
+	// The redundancy follows the packet loss measured on the peer inputs.
+	NS::ServerController *server_controller = server_scene.fetch_object<LocalNetworkedController>("controller_1")->get_server_controller();
+	CRASH_COND(server_controller == nullptr);
+	CRASH_COND(server_controller->compute_relay_redundancy(5) != 1);
+	CRASH_COND(server_controller->compute_relay_redundancy(0) != 0);
+	server_controller->packet_loss_watcher.reset(1.0);
+	CRASH_COND(!Math::is_equal_approx(server_controller->get_packet_loss(), 0.5));
+	CRASH_COND(server_controller->compute_relay_redundancy(5) != 5);
+	server_controller->packet_loss_watcher.reset(0.05);
+	CRASH_COND(server_controller->compute_relay_redundancy(5) != 2);
+}
+
+void test_doll_input_prediction() {
+	NS::LocalScene server_scene;
+	server_scene.start_as_server();
+
+	NS::LocalScene peer_1_scene;
+	peer_1_scene.start_as_client(server_scene);
+
+	NS::LocalScene peer_2_scene;
+	peer_2_scene.start_as_client(server_scene);
+
+	// The server loses some of the relayed inputs, so the doll has to predict.
+	NS::LocalNetworkProps network_properties;
+	network_properties.packet_loss = 0.4;
+	server_scene.get_network().network_properties = &network_properties;
+
+	server_scene.scene_sync =
+			server_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+	peer_1_scene.scene_sync =
+			peer_1_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+	peer_2_scene.scene_sync =
+			peer_2_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+
+	TestPredictedController *server_controller = server_scene.add_object<TestPredictedController>("controller_1", peer_1_scene.get_peer());
+	TestPredictedController *player = peer_1_scene.add_object<TestPredictedController>("controller_1", peer_1_scene.get_peer());
+	TestPredictedController *doll = peer_2_scene.add_object<TestPredictedController>("controller_1", peer_1_scene.get_peer());
+
+	server_scene.add_object<LocalNetworkedController>("controller_2", peer_2_scene.get_peer());
+	peer_1_scene.add_object<LocalNetworkedController>("controller_2", peer_2_scene.get_peer());
+	peer_2_scene.add_object<LocalNetworkedController>("controller_2", peer_2_scene.get_peer());
+
+	const NS::DollController *doll_controller = doll->get_doll_controller();
+	CRASH_COND(doll_controller == nullptr);
+	CRASH_COND(doll->get_doll_input_prediction() != NS::NetworkedControllerBase::DOLL_INPUT_PREDICTION_REPEAT_LAST);
+	CRASH_COND(doll->get_doll_misprediction_rate() != 0.0);
+
+	for (int i = 0; i < 300; i++) {
+		// Change the input every few frames, so repeating it is sometimes wrong.
+		player->input = (i / 4) % 2 == 0;
+		server_scene.process(delta);
+		peer_1_scene.process(delta);
+		peer_2_scene.process(delta);
+	}
+
+	CRASH_COND(doll_controller->verified_predictions_count == 0);
+	CRASH_COND(doll_controller->mispredictions_count == 0);
+	CRASH_COND(doll_controller->mispredictions_count > doll_controller->verified_predictions_count);
+	CRASH_COND(doll->get_doll_misprediction_rate() <= 0.0 || doll->get_doll_misprediction_rate() > 1.0);
+	// The mispredicted inputs are replayed by the client.
+	CRASH_COND(doll_controller->replay_from_input_id != UINT32_MAX);
+	CRASH_COND(doll->predict_calls != 0);
+
+	// The custom strategy asks the controller.
+	doll->set_doll_input_prediction(NS::NetworkedControllerBase::DOLL_INPUT_PREDICTION_CUSTOM);
+	for (int i = 0; i < 100; i++) {
+		player->input = (i / 4) % 2 == 0;
+		server_scene.process(delta);
+		peer_1_scene.process(delta);
+		peer_2_scene.process(delta);
+	}
+	CRASH_COND(doll->predict_calls == 0);
+
+	// The decay strategy fades the input itself, the delta is untouched.
+	doll->set_doll_input_prediction(NS::NetworkedControllerBase::DOLL_INPUT_PREDICTION_DECAY_TO_NEUTRAL);
+	const uint64_t mispredictions_count = doll_controller->mispredictions_count;
+	for (int i = 0; i < 100; i++) {
+		player->input = true;
+		server_scene.process(delta);
+		peer_1_scene.process(delta);
+		peer_2_scene.process(delta);
+	}
+	CRASH_COND(doll->decay_calls == 0);
+	// Once decayed the input differs from the received one, and is replayed.
+	CRASH_COND(doll_controller->mispredictions_count == mispredictions_count);
+
+	// Once all the real inputs are received, the replayed doll matches them.
+	server_scene.get_network().network_properties = nullptr;
+	for (int i = 0; i < 100; i++) {
+		player->input = false;
+		server_scene.process(delta);
+		peer_1_scene.process(delta);
+		peer_2_scene.process(delta);
+	}
+	CRASH_COND(doll_controller->replay_from_input_id != UINT32_MAX);
+	const float server_position = server_controller->variables["position"];
+	const float player_position = player->variables["position"];
+	const float doll_position = doll->variables["position"];
+	CRASH_COND(server_position <= 0.0);
+	CRASH_COND(!Math::is_equal_approx(server_position, player_position));
+	CRASH_COND(!Math::is_equal_approx(server_position, doll_position));
+
+	// Nothing is predicted when the max is 0.
+	server_scene.get_network().network_properties = &network_properties;
+	doll->set_doll_max_predicted_frames(0);
+	const int predict_calls = doll->predict_calls;
+	const int decay_calls = doll->decay_calls;
+	for (int i = 0; i < 100; i++) {
+		server_scene.process(delta);
+		peer_1_scene.process(delta);
+		peer_2_scene.process(delta);
+	}
+	CRASH_COND(doll->predict_calls != predict_calls);
+	CRASH_COND(doll->decay_calls != decay_calls);
+
+	server_scene.get_network().network_properties = nullptr;
+}
+
+void test_object_resync() {
+	// The requests are merged per object, and all the variables win.
+	LocalVector<NS::ObjectResync> resync;
+	NS::ObjectResync obj_1;
+	obj_1.net_id = NS::ObjectNetId{ 1 };
+	obj_1.vars.push_back(NS::VarId{ 2 });
+	NS::merge_object_resync(resync, obj_1);
+	obj_1.vars[0] = NS::VarId{ 0 };
+	NS::merge_object_resync(resync, obj_1);
+	NS::ObjectResync obj_4;
+	obj_4.net_id = NS::ObjectNetId{ 4 };
+	NS::merge_object_resync(resync, obj_4);
+	CRASH_COND(resync.size() != 2);
+	CRASH_COND(resync[0].vars.size() != 2);
+	CRASH_COND(resync[1].vars.size() != 0);
+
+	DataBuffer buffer;
+	buffer.begin_write(0);
+	NS::write_object_resync(resync, buffer);
+	buffer.dry();
+	buffer.begin_read();
+	LocalVector<NS::ObjectResync> read_resync;
+	CRASH_COND(!NS::read_object_resync(buffer, read_resync));
+	CRASH_COND(read_resync.size() != 2);
+	CRASH_COND(read_resync[0].net_id != NS::ObjectNetId{ 1 });
+	CRASH_COND(read_resync[0].vars.size() != 2);
+	CRASH_COND(read_resync[0].vars[0] != NS::VarId{ 0 });
+	CRASH_COND(read_resync[0].vars[1] != NS::VarId{ 2 });
+	CRASH_COND(read_resync[1].net_id != NS::ObjectNetId{ 4 });
+	CRASH_COND(read_resync[1].vars.size() != 0);
+
+	// The objects already requested are not asked again until the timeout,
+	// or until the server sends them.
+	NS::ObjectResyncTracker tracker;
+	LocalVector<NS::ObjectResync> request = resync;
+	tracker.filter(request, 0.0, 1.0);
+	CRASH_COND(request.size() != 2);
+	CRASH_COND(!tracker.is_requested(NS::ObjectNetId{ 1 }));
+	request = resync;
+	tracker.filter(request, 0.5, 1.0);
+	CRASH_COND(request.size() != 0);
+	tracker.notify_received(NS::ObjectNetId{ 4 });
+	CRASH_COND(tracker.is_requested(NS::ObjectNetId{ 4 }));
+	request = resync;
+	tracker.filter(request, 0.6, 1.0);
+	CRASH_COND(request.size() != 1);
+	CRASH_COND(request[0].net_id != NS::ObjectNetId{ 4 });
+	request = resync;
+	tracker.filter(request, 1.1, 1.0);
+	CRASH_COND(request.size() != 1);
+	CRASH_COND(request[0].net_id != NS::ObjectNetId{ 1 });
+	tracker.clear();
+	CRASH_COND(tracker.is_requested(NS::ObjectNetId{ 1 }));
+
+	// The variables not asked yet are sent as a follow-up request.
+	NS::ObjectResync obj_1_var_2;
+	obj_1_var_2.net_id = NS::ObjectNetId{ 1 };
+	obj_1_var_2.vars.push_back(NS::VarId{ 2 });
+	request.clear();
+	request.push_back(obj_1_var_2);
+	tracker.filter(request, 2.0, 1.0);
+	CRASH_COND(request.size() != 1);
+	request = resync;
+	tracker.filter(request, 2.1, 1.0);
+	CRASH_COND(request.size() != 2);
+	CRASH_COND(request[0].net_id != NS::ObjectNetId{ 1 });
+	CRASH_COND(request[0].vars.size() != 1);
+	CRASH_COND(request[0].vars[0] != NS::VarId{ 0 });
+	request = resync;
+	tracker.filter(request, 2.2, 1.0);
+	CRASH_COND(request.size() != 0);
+	// Asking all the variables follows a partial request too.
+	request.clear();
+	obj_1_var_2.vars.clear();
+	request.push_back(obj_1_var_2);
+	tracker.filter(request, 2.3, 1.0);
+	CRASH_COND(request.size() != 1);
+	CRASH_COND(request[0].vars.size() != 0);
+	tracker.clear();
+
+	// The object is created on the client after the full snapshot: the
+	// variables it missed are requested and sent with the next snapshot.
+	NS::LocalScene server_scene;
+	server_scene.start_as_server();
+
+	NS::LocalScene peer_1_scene;
+	peer_1_scene.start_as_client(server_scene);
+
+	server_scene.scene_sync =
+			server_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+	peer_1_scene.scene_sync =
+			peer_1_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+
+	server_scene.add_object<TestSceneObject>("obj_1", server_scene.get_peer())->variables["var_1"] = 7;
+
+	for (int i = 0; i < 10; i++) {
+		server_scene.process(delta);
+		peer_1_scene.process(delta);
+	}
+
+	TestSceneObject *p1_obj_1 = peer_1_scene.add_object<TestSceneObject>("obj_1", server_scene.get_peer());
+	p1_obj_1->variables["var_1"] = 0;
+
+	for (int i = 0; i < 150; i++) {
+		server_scene.process(delta);
+		peer_1_scene.process(delta);
+	}
+
+	CRASH_COND(int(p1_obj_1->variables["var_1"]) != 7);
+}
+
+void test_input_size_prefix() {
+	const uint32_t sizes[] = { 0, 1, 127, 128, 300, 16383, 16384, UINT32_MAX };
+	for (uint32_t size : sizes) {
+		uint8_t buffer[5];
+		const int written = NS::NetworkedControllerBase::__input_size_encode(size, buffer);
+		uint32_t read = 0;
+		CRASH_COND(NS::NetworkedControllerBase::__input_size_decode(buffer, written, read) != written);
+		CRASH_COND(read != size);
+		// A truncated prefix is rejected.
+		CRASH_COND(NS::NetworkedControllerBase::__input_size_decode(buffer, written - 1, read) != 0);
+	}
+
+	NS::LocalScene server_scene;
+	server_scene.start_as_server();
+
+	NS::LocalScene peer_1_scene;
+	peer_1_scene.start_as_client(server_scene);
+
+	NS::LocalScene peer_2_scene;
+	peer_2_scene.start_as_client(server_scene);
+
+	server_scene.scene_sync =
+			server_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+	peer_1_scene.scene_sync =
+			peer_1_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+	peer_2_scene.scene_sync =
+			peer_2_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+
+	TestPrefixedController *server_controller = server_scene.add_object<TestPrefixedController>("controller_1", peer_1_scene.get_peer());
+	peer_1_scene.add_object<TestPrefixedController>("controller_1", peer_1_scene.get_peer());
+	TestPrefixedController *doll_controller = peer_2_scene.add_object<TestPrefixedController>("controller_1", peer_1_scene.get_peer());
+
+	server_scene.add_object<TestPrefixedController>("controller_2", peer_2_scene.get_peer());
+	peer_1_scene.add_object<TestPrefixedController>("controller_2", peer_2_scene.get_peer());
+	peer_2_scene.add_object<TestPrefixedController>("controller_2", peer_2_scene.get_peer());
+
+	for (int i = 0; i < 60; i++) {
+		server_scene.process(delta);
+		peer_1_scene.process(delta);
+		peer_2_scene.process(delta);
+	}
+
+	// Both the server and the doll received the inputs, without counting them.
+	CRASH_COND(server_controller->get_server_controller()->last_known_input() == UINT32_MAX);
+	CRASH_COND(doll_controller->get_doll_controller()->last_known_input() == UINT32_MAX);
+	CRASH_COND(server_controller->count_calls != 0);
+	CRASH_COND(doll_controller->count_calls != 0);
+
+	// The position moved on the server, so the inputs were read correctly.
+	CRASH_COND(float(server_controller->variables["position"]) <= 0.0);
+}
+
+void test_join_streaming() {
+	NS::LocalScene server_scene;
+	server_scene.start_as_server();
+
+	NS::LocalScene peer_1_scene;
+	peer_1_scene.start_as_client(server_scene);
+
+	server_scene.scene_sync =
+			server_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+	peer_1_scene.scene_sync =
+			peer_1_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+
+	const int objects_count = 12;
+	for (int i = 0; i < objects_count; i++) {
+		const std::string name = "obj_" + std::to_string(i);
+		server_scene.add_object<TestSceneObject>(name, server_scene.get_peer())->variables["var_1"] = i + 1;
+		peer_1_scene.add_object<TestSceneObject>(name, server_scene.get_peer());
+	}
+
+	// The peer 1 gets the world in a single snapshot.
+	for (int i = 0; i < 90; i++) {
+		server_scene.process(delta);
+		peer_1_scene.process(delta);
+	}
+
+	// The peer 2 joins late, and gets the world streamed.
+	server_scene.scene_sync->set_join_stream_budget(4);
+
+	NS::LocalScene peer_2_scene;
+	peer_2_scene.start_as_client(server_scene);
+	peer_2_scene.scene_sync =
+			peer_2_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+
+	std::vector<TestSceneObject *> p2_objects;
+	for (int i = 0; i < objects_count; i++) {
+		TestSceneObject *p2_obj = peer_2_scene.add_object<TestSceneObject>("obj_" + std::to_string(i), server_scene.get_peer());
+		p2_obj->variables["var_1"] = 0;
+		p2_objects.push_back(p2_obj);
+	}
+	server_scene.add_object<LocalNetworkedController>("controller_2", peer_2_scene.get_peer());
+	LocalNetworkedController *p2_controller = peer_2_scene.add_object<LocalNetworkedController>("controller_2", peer_2_scene.get_peer());
+
+	auto count_known = [&]() -> int {
+		int known = 0;
+		for (TestSceneObject *obj : p2_objects) {
+			if (peer_2_scene.scene_sync->get_object_data(obj->local_id)->get_net_id() != NS::ObjectNetId::NONE) {
+				known += 1;
+			}
+		}
+		return known;
+	};
+
+	bool streaming_seen = false;
+	int previous_known = 0;
+	for (int i = 0; i < 30; i++) {
+		server_scene.process(delta);
+		peer_1_scene.process(delta);
+		peer_2_scene.process(delta);
+
+		const int known = count_known();
+		// Never more objects than the budget per snapshot.
+		CRASH_COND(known - previous_known > 4);
+		if (known > 0) {
+			// The controller comes first.
+			CRASH_COND(peer_2_scene.scene_sync->get_object_data(p2_controller->local_id)->get_net_id() == NS::ObjectNetId::NONE);
+		}
+		if (known < objects_count && peer_2_scene.scene_sync->is_join_streaming()) {
+			streaming_seen = true;
+		}
+		previous_known = known;
+	}
+
+	CRASH_COND(!streaming_seen);
+	CRASH_COND(peer_2_scene.scene_sync->is_join_streaming());
+	CRASH_COND(count_known() != objects_count);
+
+	// The values are applied once the client validates the snapshot.
+	for (int i = 0; i < 120; i++) {
+		server_scene.process(delta);
+		peer_1_scene.process(delta);
+		peer_2_scene.process(delta);
+	}
+	for (int i = 0; i < objects_count; i++) {
+		CRASH_COND(int(p2_objects[i]->variables["var_1"]) != i + 1);
+	}
+}
+
+void test_staggered_notifications() {
+	NS::LocalScene server_scene;
+	server_scene.start_as_server();
+	server_scene.scene_sync =
+			server_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+
+	// Each peer in its own group.
+	const int groups_count = 6;
+	std::vector<std::unique_ptr<NS::LocalScene>> peers;
+	std::vector<SyncGroupId> groups;
+	for (int i = 0; i < groups_count; i++) {
+		peers.push_back(std::make_unique<NS::LocalScene>());
+		peers.back()->start_as_client(server_scene);
+		peers.back()->scene_sync =
+				peers.back()->add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+		groups.push_back(server_scene.scene_sync->sync_group_create());
+	}
+
+	// The deferred nodes with the same update rate.
+	const int deferred_count = 8;
+	std::vector<TestDeferredObject *> deferred_objects;
+	for (int i = 0; i < deferred_count; i++) {
+		TestDeferredObject *obj = server_scene.add_object<TestDeferredObject>("obj_" + std::to_string(i), server_scene.get_peer());
+		server_scene.scene_sync->sync_group_add_node(server_scene.scene_sync->get_object_data(obj->find_local_id()), groups[0], false);
+		server_scene.scene_sync->sync_group_set_deferred_update_rate(obj->find_local_id(), groups[0], 0.25);
+		deferred_objects.push_back(obj);
+	}
+
+	for (int i = 0; i < groups_count; i++) {
+		server_scene.scene_sync->sync_group_move_peer_to(peers[i]->get_peer(), groups[i]);
+	}
+
+	auto process_all = [&]() {
+		server_scene.process(delta);
+		for (auto &peer : peers) {
+			peer->process(delta);
+		}
+	};
+
+	for (int i = 0; i < 30; i++) {
+		process_all();
+	}
+
+	// Two notify intervals.
+	int max_notified = 0;
+	int notified_sum = 0;
+	int max_collected = 0;
+	int collected_sum = 0;
+	const int ticks = 120;
+	for (int t = 0; t < ticks; t++) {
+		std::vector<real_t> timers;
+		for (SyncGroupId group : groups) {
+			timers.push_back(server_scene.scene_sync->sync_group_get(group)->state_notifier_timer);
+		}
+		int collected = 0;
+		for (TestDeferredObject *obj : deferred_objects) {
+			collected -= obj->epoch_handler.collected_count;
+		}
+
+		process_all();
+
+		int notified = 0;
+		for (int i = 0; i < groups_count; i++) {
+			if (server_scene.scene_sync->sync_group_get(groups[i])->state_notifier_timer < timers[i]) {
+				notified += 1;
+			}
+		}
+		for (TestDeferredObject *obj : deferred_objects) {
+			collected += obj->epoch_handler.collected_count;
+		}
+
+		max_notified = MAX(max_notified, notified);
+		notified_sum += notified;
+		max_collected = MAX(max_collected, collected);
+		collected_sum += collected;
+	}
+
+	// Each group notified once per interval, never on the same tick of
+	// another group.
+	CRASH_COND(notified_sum != groups_count * 2);
+	CRASH_COND(max_notified != 1);
+
+	// Each node collected once every 5 ticks, as the priority is reset after
+	// the collection, spread across them.
+	CRASH_COND(collected_sum != deferred_count * ticks / 5);
+	CRASH_COND(max_collected > 3);
+}
+
+/// Registered by `test_bulk_registration`, with `register_app_objects`.
+class TestBulkObject : public NS::LocalSceneObject {
+public:
+	virtual void on_scene_entry() override {
+		variables["var_1"] = Variant(0);
+		variables["var_2"] = Variant(0);
+	}
+
+	virtual void setup_synchronizer(NS::LocalSceneSynchronizer &p_scene_sync, NS::ObjectLocalId p_id) override {
+		p_scene_sync.register_variables(p_id, { { "var_1", false }, { "var_2", true } });
+	}
+
+	virtual void on_scene_exit() override {
+		get_scene()->scene_sync->on_app_object_removed(get_scene()->scene_sync->to_handle(this));
+	}
+};
+
+void test_bulk_registration() {
+	NS::LocalScene server_scene;
+	server_scene.start_as_server();
+
+	NS::LocalScene peer_scene;
+	peer_scene.start_as_client(server_scene);
+
+	server_scene.scene_sync =
+			server_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+	peer_scene.scene_sync =
+			peer_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+
+	const int objects_count = 50;
+	std::vector<TestBulkObject *> server_objects;
+	std::vector<TestBulkObject *> peer_objects;
+	std::vector<NS::ObjectHandle> server_handles;
+	std::vector<NS::ObjectHandle> peer_handles;
+	for (int i = 0; i < objects_count; i++) {
+		const std::string name = "obj_" + std::to_string(i);
+		server_objects.push_back(server_scene.add_object<TestBulkObject>(name, server_scene.get_peer()));
+		peer_objects.push_back(peer_scene.add_object<TestBulkObject>(name, server_scene.get_peer()));
+		server_handles.push_back(server_scene.scene_sync->to_handle(server_objects.back()));
+		peer_handles.push_back(peer_scene.scene_sync->to_handle(peer_objects.back()));
+	}
+
+	const NS::SyncGroup *global_group = server_scene.scene_sync->sync_group_get(NS::SceneSynchronizerBase::GLOBAL_SYNC_GROUP_ID);
+	const uint32_t initial_nodes_count = global_group->get_realtime_sync_nodes().size();
+
+	std::vector<NS::ObjectLocalId> server_ids;
+	server_scene.scene_sync->register_app_objects(server_handles, &server_ids);
+	peer_scene.scene_sync->register_app_objects(peer_handles);
+
+	CRASH_COND(server_ids.size() != size_t(objects_count));
+	for (int i = 0; i < objects_count; i++) {
+		CRASH_COND(server_ids[i] == NS::ObjectLocalId::NONE);
+		CRASH_COND(server_objects[i]->find_local_id() != server_ids[i]);
+		CRASH_COND(peer_objects[i]->find_local_id() == NS::ObjectLocalId::NONE);
+
+		const NS::ObjectData *od = server_scene.scene_sync->get_object_data(server_ids[i]);
+		CRASH_COND(od->bulk_registration_pending);
+		CRASH_COND(od->get_net_id() == NS::ObjectNetId::NONE);
+		CRASH_COND(od->vars.size() != 2);
+		CRASH_COND(od->vars[0].skip_rewinding);
+		CRASH_COND(!od->vars[1].skip_rewinding);
+	}
+
+	// All the objects are in the global group, once.
+	CRASH_COND(global_group->get_realtime_sync_nodes().size() != initial_nodes_count + objects_count);
+	for (uint32_t i = initial_nodes_count; i < global_group->get_realtime_sync_nodes().size(); i++) {
+		const NS::SyncGroup::RealtimeNodeInfo &info = global_group->get_realtime_sync_nodes()[i];
+		CRASH_COND(!info.change.unknown);
+		CRASH_COND(info.change.vars.size() != 2);
+	}
+
+	// Registering them again changes nothing.
+	std::vector<NS::ObjectLocalId> again_ids;
+	server_scene.scene_sync->register_app_objects(server_handles, &again_ids);
+	CRASH_COND(again_ids != server_ids);
+	CRASH_COND(global_group->get_realtime_sync_nodes().size() != initial_nodes_count + objects_count);
+
+	// The objects are synchronized as the ones registered one by one.
+	for (int i = 0; i < objects_count; i++) {
+		server_objects[i]->variables["var_1"] = Variant(i + 1);
+	}
+
+	for (int f = 0; f < 60; f++) {
+		server_scene.process(delta);
+		peer_scene.process(delta);
+	}
+
+	for (int i = 0; i < objects_count; i++) {
+		CRASH_COND(peer_objects[i]->variables["var_1"].operator int() != i + 1);
+	}
+}
+
+void test_var_layouts() {
+	NS::LocalScene server_scene;
+	server_scene.start_as_server();
+	server_scene.scene_sync =
+			server_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+
+	std::vector<TestSceneObject *> objects;
+	for (int i = 0; i < 5; i++) {
+		objects.push_back(server_scene.add_object<TestSceneObject>("obj_" + std::to_string(i), server_scene.get_peer()));
+	}
+	TestBulkObject *bulk_object = server_scene.add_object<TestBulkObject>("bulk_obj", server_scene.get_peer());
+	server_scene.scene_sync->register_app_object(server_scene.scene_sync->to_handle(bulk_object));
+
+	// The objects with the same variables share the same layout.
+	const NS::ObjectData *od_0 = server_scene.scene_sync->get_object_data(objects[0]->local_id);
+	const NS::VarLayout &layout = od_0->get_var_layout();
+	CRASH_COND(layout.names.size() != 1);
+	CRASH_COND(layout.names[0] != "var_1");
+	for (TestSceneObject *obj : objects) {
+		const NS::ObjectData *od = server_scene.scene_sync->get_object_data(obj->local_id);
+		CRASH_COND(&od->get_var_layout() != &layout);
+		CRASH_COND(od->find_variable_id("var_1") != NS::VarId{ 0 });
+		CRASH_COND(od->find_variable_id("var_2") != NS::VarId::NONE);
+	}
+
+	// While the values are per object.
+	objects[1]->variables["var_1"] = Variant(7);
+	server_scene.process(delta);
+	CRASH_COND(server_scene.scene_sync->get_object_data(objects[1]->local_id)->vars[0].value.operator int() != 7);
+	CRASH_COND(od_0->vars[0].value.operator int() == 7);
+
+	// An object with more variables has its own layout.
+	const NS::ObjectData *bulk_od = server_scene.scene_sync->get_object_data(bulk_object->find_local_id());
+	const NS::VarLayout &bulk_layout = bulk_od->get_var_layout();
+	CRASH_COND(&bulk_layout == &layout);
+	CRASH_COND(bulk_layout.names.size() != 2);
+	CRASH_COND(bulk_od->get_variable_name(NS::VarId{ 1 }) != "var_2");
+	CRASH_COND(bulk_od->find_variable_id("var_2") != NS::VarId{ 1 });
+
+	// Unregistering a variable keeps the layout, as the `VarId`s can't change.
+	server_scene.scene_sync->unregister_variable(objects[2]->local_id, "var_1");
+	CRASH_COND(&server_scene.scene_sync->get_object_data(objects[2]->local_id)->get_var_layout() != &layout);
+}
+
+void test_bulk_variables_access() {
+	NS::LocalScene server_scene;
+	server_scene.start_as_server();
+
+	NS::LocalScene peer_scene;
+	peer_scene.start_as_client(server_scene);
+
+	server_scene.scene_sync =
+			server_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+	peer_scene.scene_sync =
+			peer_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+	server_scene.scene_sync->bulk_variables_enabled = true;
+	peer_scene.scene_sync->bulk_variables_enabled = true;
+
+	TestBulkObject *server_obj = server_scene.add_object<TestBulkObject>("obj", server_scene.get_peer());
+	TestBulkObject *peer_obj = peer_scene.add_object<TestBulkObject>("obj", server_scene.get_peer());
+	server_scene.scene_sync->register_app_object(server_scene.scene_sync->to_handle(server_obj));
+	peer_scene.scene_sync->register_app_object(peer_scene.scene_sync->to_handle(peer_obj));
+
+	for (int f = 0; f < 10; f++) {
+		server_scene.process(delta);
+		peer_scene.process(delta);
+	}
+
+	// The server reads all the variables of the object with a single call.
+	const int server_gets = server_scene.scene_sync->get_variables_count;
+	CRASH_COND(server_gets <= 0);
+
+	server_obj->variables["var_1"] = Variant(3);
+	server_obj->variables["var_2"] = Variant(4);
+
+	for (int f = 0; f < 60; f++) {
+		server_scene.process(delta);
+		peer_scene.process(delta);
+	}
+
+	CRASH_COND(server_scene.scene_sync->get_variables_count <= server_gets);
+	CRASH_COND(server_scene.scene_sync->get_object_data(server_obj->find_local_id())->vars[0].value.operator int() != 3);
+	CRASH_COND(server_scene.scene_sync->get_object_data(server_obj->find_local_id())->vars[1].value.operator int() != 4);
+
+	// The peer writes both variables with a single call.
+	CRASH_COND(peer_scene.scene_sync->set_variables_count <= 0);
+	CRASH_COND(peer_obj->variables["var_1"].operator int() != 3);
+	CRASH_COND(peer_obj->variables["var_2"].operator int() != 4);
+}
+
+void test_batched_changes_listener() {
+	NS::LocalScene server_scene;
+	server_scene.start_as_server();
+	server_scene.scene_sync =
+			server_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+
+	TestSceneObject *obj_1 = server_scene.add_object<TestSceneObject>("obj_1", server_scene.get_peer());
+	TestSceneObject *obj_2 = server_scene.add_object<TestSceneObject>("obj_2", server_scene.get_peer());
+	obj_1->variables["var_1"] = 0;
+	obj_2->variables["var_1"] = 0;
+	server_scene.process(delta);
+
+	int calls_count = 0;
+	std::vector<NS::VarChange> changes;
+	NS::ListenerHandle lh = server_scene.scene_sync->track_variables_changes_batched(
+			{ obj_1->find_local_id(), obj_2->find_local_id() },
+			{ "var_1", "var_1" },
+			[&](const std::vector<NS::VarChange> &p_changes) {
+				calls_count += 1;
+				changes = p_changes;
+			},
+			NetEventFlag::CHANGE);
+	CRASH_COND(lh == NS::nulllistenerhandle);
+
+	// Nothing changed: the listener is not called.
+	server_scene.process(delta);
+	CRASH_COND(calls_count != 0);
+
+	// Only the changed variable is passed, with its old and new value.
+	obj_2->variables["var_1"] = 5;
+	server_scene.process(delta);
+	CRASH_COND(calls_count != 1);
+	CRASH_COND(changes.size() != 1);
+	CRASH_COND(changes[0].object_id != obj_2->find_local_id());
+	CRASH_COND(changes[0].var_id != NS::VarId{ 0 });
+	CRASH_COND(changes[0].old_value.operator int() != 0);
+	CRASH_COND(changes[0].new_value.operator int() != 5);
+
+	// Many changes in the same flush are passed with a single call.
+	obj_1->variables["var_1"] = 1;
+	obj_2->variables["var_1"] = 6;
+	server_scene.process(delta);
+	CRASH_COND(calls_count != 2);
+	CRASH_COND(changes.size() != 2);
+	CRASH_COND(changes[0].object_id != obj_1->find_local_id());
+	CRASH_COND(changes[0].old_value.operator int() != 0);
+	CRASH_COND(changes[0].new_value.operator int() != 1);
+	CRASH_COND(changes[1].object_id != obj_2->find_local_id());
+	CRASH_COND(changes[1].old_value.operator int() != 5);
+	CRASH_COND(changes[1].new_value.operator int() != 6);
+
+	server_scene.scene_sync->untrack_variable_changes(lh);
+	obj_1->variables["var_1"] = 2;
+	server_scene.process(delta);
+	CRASH_COND(calls_count != 2);
+}
+
+void test_spectator() {
+	NS::LocalScene server_scene;
+	server_scene.start_as_server();
+
+	NS::LocalScene spectator_scene;
+	spectator_scene.start_as_client(server_scene);
+
+	server_scene.scene_sync =
+			server_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+	spectator_scene.scene_sync =
+			spectator_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+	spectator_scene.scene_sync->set_spectator_mode(true);
+	spectator_scene.scene_sync->set_spectator_interpolation_delay(0.2);
+	server_scene.scene_sync->set_server_notify_state_interval(0.1);
+
+	CRASH_COND(!spectator_scene.scene_sync->is_spectator());
+	CRASH_COND(!spectator_scene.scene_sync->is_client());
+	CRASH_COND(server_scene.scene_sync->is_spectator());
+
+	TestSceneObject *server_obj = server_scene.add_object<TestSceneObject>("obj_1", server_scene.get_peer());
+	TestSceneObject *spectator_obj = spectator_scene.add_object<TestSceneObject>("obj_1", server_scene.get_peer());
+	server_obj->variables["var_1"] = 0;
+	spectator_obj->variables["var_1"] = 0;
+
+	for (int f = 0; f < 30; f++) {
+		server_scene.process(delta);
+		spectator_scene.process(delta);
+	}
+
+	int changes_count = 0;
+	spectator_scene.scene_sync->track_variable_changes(
+			spectator_obj->find_local_id(), "var_1", [&changes_count](const std::vector<Variant> &p_old_values) {
+				changes_count += 1;
+			},
+			NetEventFlag::CHANGE);
+
+	// The local changes are not detected, nor processed: the spectator
+	// doesn't predict.
+	spectator_obj->variables["var_1"] = 7;
+	spectator_scene.process(delta);
+	CRASH_COND(changes_count != 0);
+	spectator_obj->variables["var_1"] = 0;
+
+	// The integers (ids, enums) are not interpolated: they switch.
+	server_obj->variables["var_1"] = 5;
+	for (int f = 0; f < 60; f++) {
+		server_scene.process(delta);
+		spectator_scene.process(delta);
+
+		const int value = spectator_obj->variables["var_1"].operator int();
+		CRASH_COND(value != 0 && value != 5);
+	}
+	CRASH_COND(spectator_obj->variables["var_1"].operator int() != 5);
+	CRASH_COND(changes_count != 1);
+
+	// The spectator moves toward the new server value through the
+	// intermediate values.
+	server_obj->variables["var_1"] = 0.0;
+	for (int f = 0; f < 60; f++) {
+		server_scene.process(delta);
+		spectator_scene.process(delta);
+	}
+	server_obj->variables["var_1"] = 1000.0;
+	bool intermediate_found = false;
+	for (int f = 0; f < 60; f++) {
+		server_scene.process(delta);
+		spectator_scene.process(delta);
+
+		const double value = spectator_obj->variables["var_1"].operator double();
+		if (value > 0.0 && value < 1000.0) {
+			intermediate_found = true;
+		}
+	}
+	CRASH_COND(!intermediate_found);
+	CRASH_COND(Math::abs(spectator_obj->variables["var_1"].operator double() - 1000.0) > 0.01);
+	CRASH_COND(changes_count <= 3);
+
+	// The server knows the spectator.
+	CRASH_COND(!server_scene.scene_sync->is_peer_spectator(spectator_scene.get_peer()));
+
+	// A player that becomes a spectator doesn't receive the doll inputs.
+	NS::LocalScene peer_scene;
+	peer_scene.start_as_client(server_scene);
+	peer_scene.scene_sync =
+			peer_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+	server_scene.add_object<LocalNetworkedController>("controller_1", peer_scene.get_peer());
+	peer_scene.add_object<LocalNetworkedController>("controller_1", peer_scene.get_peer());
+	spectator_scene.add_object<LocalNetworkedController>("controller_1", peer_scene.get_peer());
+	server_scene.add_object<LocalNetworkedController>("controller_2", spectator_scene.get_peer());
+	peer_scene.add_object<LocalNetworkedController>("controller_2", spectator_scene.get_peer());
+	spectator_scene.add_object<LocalNetworkedController>("controller_2", spectator_scene.get_peer());
+	CRASH_COND(server_scene.scene_sync->is_peer_spectator(peer_scene.get_peer()));
+
+	spectator_scene.scene_sync->set_spectator_mode(false);
+	for (int f = 0; f < 60; f++) {
+		server_scene.process(delta);
+		peer_scene.process(delta);
+		spectator_scene.process(delta);
+	}
+	CRASH_COND(server_scene.scene_sync->is_peer_spectator(spectator_scene.get_peer()));
+
+	// No snapshot is sent in the meantime: only the doll inputs.
+	server_scene.scene_sync->set_server_notify_state_interval(100.0);
+	server_scene.process(delta);
+	peer_scene.process(delta);
+	spectator_scene.process(delta);
+	uint64_t sent_bytes = server_scene.get_network().sent_bytes_per_peer[spectator_scene.get_peer()];
+	for (int f = 0; f < 30; f++) {
+		server_scene.process(delta);
+		peer_scene.process(delta);
+		spectator_scene.process(delta);
+	}
+	CRASH_COND(server_scene.get_network().sent_bytes_per_peer[spectator_scene.get_peer()] == sent_bytes);
+
+	spectator_scene.scene_sync->set_spectator_mode(true);
+	server_scene.process(delta);
+	peer_scene.process(delta);
+	spectator_scene.process(delta);
+	CRASH_COND(!server_scene.scene_sync->is_peer_spectator(spectator_scene.get_peer()));
+	sent_bytes = server_scene.get_network().sent_bytes_per_peer[spectator_scene.get_peer()];
+	for (int f = 0; f < 30; f++) {
+		server_scene.process(delta);
+		peer_scene.process(delta);
+		spectator_scene.process(delta);
+	}
+	CRASH_COND(server_scene.get_network().sent_bytes_per_peer[spectator_scene.get_peer()] != sent_bytes);
+}
+
+void test_spectator_object_resync() {
+	NS::LocalScene server_scene;
+	server_scene.start_as_server();
+
+	NS::LocalScene spectator_scene;
+	spectator_scene.start_as_client(server_scene);
+
+	server_scene.scene_sync =
+			server_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+	spectator_scene.scene_sync =
+			spectator_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+	spectator_scene.scene_sync->set_spectator_mode(true);
+	server_scene.scene_sync->set_server_notify_state_interval(0.0);
+
+	for (int f = 0; f < 10; f++) {
+		server_scene.process(delta);
+		spectator_scene.process(delta);
+	}
+
+	// The snapshot with the object name is lost, so the spectator asks it.
+	NS::LocalNetworkProps network_properties;
+	network_properties.reliable_packet_loss = 1.0;
+	server_scene.get_network().network_properties = &network_properties;
+
+	TestSceneObject *server_obj = server_scene.add_object<TestSceneObject>("obj_1", server_scene.get_peer());
+	TestSceneObject *spectator_obj = spectator_scene.add_object<TestSceneObject>("obj_1", server_scene.get_peer());
+	server_obj->variables["var_1"] = 0;
+	spectator_obj->variables["var_1"] = 0;
+
+	int value = 0;
+	for (int f = 0; f < 3; f++) {
+		server_obj->variables["var_1"] = ++value;
+		server_scene.process(delta);
+		spectator_scene.process(delta);
+	}
+
+	// The snapshot that triggers the request arrives, its response is lost.
+	server_scene.get_network().network_properties = nullptr;
+	server_obj->variables["var_1"] = ++value;
+	server_scene.process(delta);
+	spectator_scene.process(delta);
+	server_scene.get_network().network_properties = &network_properties;
+	for (int f = 0; f < 3; f++) {
+		server_obj->variables["var_1"] = ++value;
+		server_scene.process(delta);
+		spectator_scene.process(delta);
+	}
+	server_scene.get_network().network_properties = nullptr;
+
+	// The spectator asks it again after the timeout.
+	for (int f = 0; f < 150; f++) {
+		server_obj->variables["var_1"] = ++value;
+		server_scene.process(delta);
+		spectator_scene.process(delta);
+	}
+	CRASH_COND(spectator_obj->variables["var_1"].operator int() <= 7);
+}
+
+void test_log_settings() {
+	const Variant log_messages = GLOBAL_GET("NetworkSynchronizer/log_debug_warnings_and_messages");
+	const Variant log_rewindings = GLOBAL_GET("NetworkSynchronizer/log_debug_rewindings");
+
+	ProjectSettings::get_singleton()->set_setting("NetworkSynchronizer/log_debug_warnings_and_messages", false);
+	ProjectSettings::get_singleton()->set_setting("NetworkSynchronizer/log_debug_rewindings", true);
+
+	SceneSynchronizerDebugger *debugger = SceneSynchronizerDebugger::singleton();
+	debugger->load_log_settings();
+#ifdef DEBUG_ENABLED
+	CRASH_COND(debugger->get_log_level() != SceneSynchronizerDebugger::LOG_LEVEL_ERROR);
+	CRASH_COND(debugger->is_log_enabled(SceneSynchronizerDebugger::LOG_LEVEL_INFO, SceneSynchronizerDebugger::LOG_CATEGORY_REWIND));
+	CRASH_COND(!debugger->is_log_enabled(SceneSynchronizerDebugger::LOG_LEVEL_ERROR, SceneSynchronizerDebugger::LOG_CATEGORY_REWIND));
+	CRASH_COND(debugger->is_log_enabled(SceneSynchronizerDebugger::LOG_LEVEL_ERROR, SceneSynchronizerDebugger::LOG_CATEGORY_RELEVANCY));
+#else
+	CRASH_COND(debugger->is_log_enabled(SceneSynchronizerDebugger::LOG_LEVEL_ERROR, SceneSynchronizerDebugger::LOG_CATEGORY_GENERAL));
+#endif
+
+	{
+		// The rewind debugging depends only on its own setting, not on the
+		// log level.
+		NS::LocalScene server_scene;
+		server_scene.start_as_server();
+		server_scene.scene_sync =
+				server_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+		CRASH_COND(!server_scene.scene_sync->is_debug_rewindings_enabled());
+	}
+
+	ProjectSettings::get_singleton()->set_setting("NetworkSynchronizer/log_debug_rewindings", false);
+	ProjectSettings::get_singleton()->set_setting("NetworkSynchronizer/log_debug_warnings_and_messages", true);
+	debugger->load_log_settings();
+#ifdef DEBUG_ENABLED
+	CRASH_COND(!debugger->is_log_enabled(SceneSynchronizerDebugger::LOG_LEVEL_INFO, SceneSynchronizerDebugger::LOG_CATEGORY_GENERAL));
+	CRASH_COND(debugger->is_log_enabled(SceneSynchronizerDebugger::LOG_LEVEL_INFO, SceneSynchronizerDebugger::LOG_CATEGORY_REWIND));
+#endif
+
+	{
+		NS::LocalScene server_scene;
+		server_scene.start_as_server();
+		server_scene.scene_sync =
+				server_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+		CRASH_COND(server_scene.scene_sync->is_debug_rewindings_enabled());
+	}
+
+	ProjectSettings::get_singleton()->set_setting("NetworkSynchronizer/log_debug_warnings_and_messages", log_messages);
+	ProjectSettings::get_singleton()->set_setting("NetworkSynchronizer/log_debug_rewindings", log_rewindings);
+	debugger->load_log_settings();
+}
+
 void test_controller_processing() {
 	// TODO implement this.
 }
@@ -668,14 +2541,39 @@ void test_streaming() {
 
 void test_scene_synchronizer() {
 	test_ids();
+	test_peer_table();
+	test_deferred_epoch_delta();
+	test_deferred_sync_delta();
+	test_deferred_sync_extrapolation();
+	test_deferred_kinematics();
+	test_sync_group_lod();
+	test_sync_group_replace_nodes_by_id();
 	test_client_and_server_initialization();
 	test_state_notify();
+	test_rewind_histogram();
 	test_processing_with_late_controller_registration();
 	test_snapshot_generation();
 	test_rewinding();
 	test_state_notify_for_no_rewind_properties();
 	test_doll_simulation_rewindings();
 	test_variable_change_event();
+	test_scene_diff();
+	test_sleeping_objects();
+	test_sleeping_object_wake_correction();
+	test_process_rate_divisor();
+	test_doll_inputs_relay();
+	test_doll_input_prediction();
+	test_object_resync();
+	test_input_size_prefix();
+	test_join_streaming();
+	test_staggered_notifications();
+	test_bulk_registration();
+	test_var_layouts();
+	test_bulk_variables_access();
+	test_batched_changes_listener();
+	test_spectator();
+	test_spectator_object_resync();
+	test_log_settings();
 	test_controller_processing();
 	test_streaming();
 }
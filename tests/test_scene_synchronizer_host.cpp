@@ -0,0 +1,141 @@
+#include "test_scene_synchronizer_host.h"
+
+#include "core/config/project_settings.h"
+#include "core/error/error_macros.h"
+#include "core/variant/variant.h"
+#include "local_scene.h"
+#include "modules/network_synchronizer/scene_synchronizer_debugger.h"
+#include "modules/network_synchronizer/scene_synchronizer_host.h"
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace NS_Test {
+
+class HostTestObject : public NS::LocalSceneObject {
+public:
+	virtual void on_scene_entry() override {
+		variables["var_1"] = 0;
+		get_scene()->scene_sync->register_app_object(get_scene()->scene_sync->to_handle(this));
+	}
+
+	virtual void setup_synchronizer(NS::LocalSceneSynchronizer &p_scene_sync, NS::ObjectLocalId p_id) override {
+		p_scene_sync.register_variable(p_id, "var_1");
+	}
+
+	virtual void on_scene_exit() override {
+		get_scene()->scene_sync->on_app_object_removed(get_scene()->scene_sync->to_handle(this));
+	}
+};
+
+/// A match with a server and a client, processed by the same host worker.
+struct HostTestMatch {
+	NS::LocalScene server_scene;
+	NS::LocalScene peer_scene;
+	SceneSynchronizerDebugger *debugger = nullptr;
+
+	std::thread::id processed_by;
+	bool processed_by_changed = false;
+	bool wrong_debugger = false;
+
+	HostTestMatch(int p_value) {
+		server_scene.start_as_server();
+		peer_scene.start_as_client(server_scene);
+
+		server_scene.scene_sync = server_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+		peer_scene.scene_sync = peer_scene.add_object<NS::LocalSceneSynchronizer>("sync", server_scene.get_peer());
+		server_scene.scene_sync->set_server_notify_state_interval(0.0);
+
+		server_scene.add_object<HostTestObject>("obj_1", server_scene.get_peer());
+		peer_scene.add_object<HostTestObject>("obj_1", server_scene.get_peer());
+		server_scene.fetch_object<HostTestObject>("obj_1")->variables["var_1"] = p_value;
+
+		debugger = memnew(SceneSynchronizerDebugger);
+	}
+
+	~HostTestMatch() {
+		memdelete(debugger);
+	}
+
+	void process(double p_delta) {
+		if (processed_by != std::thread::id() && processed_by != std::this_thread::get_id()) {
+			processed_by_changed = true;
+		}
+		processed_by = std::this_thread::get_id();
+
+		if (SceneSynchronizerDebugger::singleton() != debugger) {
+			wrong_debugger = true;
+		}
+
+		server_scene.process(p_delta);
+		peer_scene.process(p_delta);
+	}
+};
+
+void test_scene_synchronizer_host() {
+	SceneSynchronizerDebugger *global_debugger = SceneSynchronizerDebugger::singleton();
+
+	std::vector<std::unique_ptr<HostTestMatch>> matches;
+	for (int i = 0; i < 6; i++) {
+		matches.push_back(std::make_unique<HostTestMatch>(i + 10));
+	}
+
+	const Variant log_messages = GLOBAL_GET("NetworkSynchronizer/log_debug_warnings_and_messages");
+	ProjectSettings::get_singleton()->set_setting("NetworkSynchronizer/log_debug_warnings_and_messages", false);
+
+	{
+		NS::SceneSynchronizerHost host(3);
+		CRASH_COND(host.get_workers_count() != 3);
+
+		// The workers never use the global debugger.
+		CRASH_COND(host.add_instance([](double p_delta) {}, nullptr) != NS::SceneSynchronizerHost::NONE);
+		CRASH_COND(host.get_instances_count() != 0);
+
+		std::vector<NS::HostInstanceId> ids;
+		for (std::unique_ptr<HostTestMatch> &match : matches) {
+			HostTestMatch *m = match.get();
+			ids.push_back(host.add_instance([m](double p_delta) { m->process(p_delta); }, m->debugger));
+		}
+		CRASH_COND(host.get_instances_count() != 6);
+#ifdef DEBUG_ENABLED
+		// Each debugger got the project log settings.
+		for (std::unique_ptr<HostTestMatch> &match : matches) {
+			CRASH_COND(match->debugger->get_log_level() != SceneSynchronizerDebugger::LOG_LEVEL_ERROR);
+		}
+#endif
+
+		// The instances are distributed across the workers.
+		for (int w = 0; w < 3; w++) {
+			CRASH_COND(host.get_instance_worker(ids[w]) != w);
+			CRASH_COND(host.get_instance_worker(ids[w + 3]) != w);
+		}
+
+		for (int f = 0; f < 10; f++) {
+			host.process(1.0 / 60.0);
+		}
+
+		host.remove_instance(ids[5]);
+		CRASH_COND(host.get_instances_count() != 5);
+		CRASH_COND(host.get_instance_worker(ids[5]) != -1);
+
+		host.process(1.0 / 60.0);
+	}
+
+	for (int i = 0; i < int(matches.size()); i++) {
+		HostTestMatch &match = *matches[i];
+		// Each match is pinned to a single thread, and uses its own debugger.
+		CRASH_COND(match.processed_by == std::thread::id());
+		CRASH_COND(match.processed_by == std::this_thread::get_id());
+		CRASH_COND(match.processed_by_changed);
+		CRASH_COND(match.wrong_debugger);
+
+		// Each match is synchronized independently.
+		CRASH_COND(int(match.peer_scene.fetch_object<HostTestObject>("obj_1")->variables["var_1"]) != i + 10);
+	}
+
+	// The calling thread still uses the global debugger.
+	CRASH_COND(SceneSynchronizerDebugger::singleton() != global_debugger);
+
+	ProjectSettings::get_singleton()->set_setting("NetworkSynchronizer/log_debug_warnings_and_messages", log_messages);
+}
+}; //namespace NS_Test
@@ -0,0 +1,5 @@
+#pragma once
+
+namespace NS_Test {
+void test_scene_synchronizer_host();
+};
@@ -3,10 +3,12 @@
 #include "local_network.h"
 #include "test_processor.h"
 #include "test_scene_synchronizer.h"
+#include "test_scene_synchronizer_host.h"
 
 void NS_Test::test_all() {
 	// TODO test DataBuffer.
 	test_processor();
 	test_local_network();
 	test_scene_synchronizer();
+	test_scene_synchronizer_host();
 }
\ No newline at end of file